@@ -0,0 +1,242 @@
+#ifndef BLOOM_RENDERER_H
+#define BLOOM_RENDERER_H
+/*
+	bloom_renderer.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > 텍스쳐 및 프레임버퍼 관련 OpenGL 함수가 필요하니까!
+
+#include <vector> // mip level 별 텍스쳐를 동적 배열로 보관하기 위해 include
+
+#include "shader_s.h" // downsampling 및 upsampling 쉐이더 객체를 생성하기 위해 include
+
+/*
+	BloomMip 구조체
+
+	bloom mip chain 의 각 level 에 해당하는 텍스쳐 객체와 해상도를 저장
+*/
+struct BloomMip
+{
+	unsigned int width;
+	unsigned int height;
+	unsigned int texture;
+};
+
+/*
+	BloomRenderer 클래스
+
+	HDR 씬 텍스쳐를 절반씩 축소(13-tap downsampling)해 나가면서 mip chain 을 만든 뒤,
+	가장 작은 mip 부터 tent filter 로 확대(upsampling)하여 큰 mip 에 누적하는 방식으로
+	bloom 을 계산하는 클래스! (bloom_downsample.fs, bloom_upsample.fs 하단 필기 참고)
+
+	최종 결과는 가장 큰 mip(= 스크린 해상도의 절반) 텍스쳐에 저장되며, bloomTexture() 로 가져올 수 있음.
+
+	쉐이더 파일은 MyShaders/bloom_mip.vs, MyShaders/bloom_downsample.fs, MyShaders/bloom_upsample.fs 를 사용함.
+*/
+class BloomRenderer
+{
+public:
+	// 생성자에서 쉐이더, 프레임버퍼, mip chain 텍스쳐 생성
+	BloomRenderer(unsigned int width, unsigned int height, unsigned int mipCount)
+		: downsampleShader("MyShaders/bloom_mip.vs", "MyShaders/bloom_downsample.fs"),
+		upsampleShader("MyShaders/bloom_mip.vs", "MyShaders/bloom_upsample.fs")
+	{
+		glGenFramebuffers(1, &FBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+
+		// mipCount 개의 mip 텍스쳐 생성 (메모리 할당은 resize() 에서 처리)
+		for (unsigned int i = 0; i < mipCount; i++)
+		{
+			BloomMip mip;
+			mip.width = 0;
+			mip.height = 0;
+
+			glGenTextures(1, &mip.texture);
+			glBindTexture(GL_TEXTURE_2D, mip.texture);
+
+			// 13-tap, tent filter 모두 GL_LINEAR 필터링으로 주변 texel 을 함께 샘플링하는 것을 전제로 함
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+			mips.push_back(mip);
+		}
+		resize(width, height);
+
+		// 첫 번째 mip 텍스쳐를 attach 해서 프레임버퍼 설정 완료 여부 검사
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mips[0].texture, 0);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cout << "Bloom Framebuffer is not complete!" << std::endl;
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		// bloom_mip.vs 는 gl_VertexID 만으로 full-screen triangle 을 만들기 때문에 정점 데이터가 필요 없지만,
+		// core-profile 에서는 그리기 명령 호출 시 반드시 VAO 가 바인딩되어 있어야 하므로 빈 VAO 를 생성해 둠
+		glGenVertexArrays(1, &emptyVAO);
+
+		// 각 쉐이더의 uniform sampler 변수에 texture unit 위치값 전송
+		downsampleShader.use();
+		downsampleShader.setInt("srcTexture", 0);
+		upsampleShader.use();
+		upsampleShader.setInt("srcTexture", 0);
+	}
+
+	// 스크린 해상도가 바뀌면, 절반 해상도부터 시작하는 mip chain 텍스쳐들을 새로운 크기로 재할당
+	// (텍스쳐 파라미터 및 프레임버퍼 설정은 그대로 유지됨)
+	void resize(unsigned int width, unsigned int height)
+	{
+		unsigned int mipWidth = width;
+		unsigned int mipHeight = height;
+		for (unsigned int i = 0; i < mips.size(); i++)
+		{
+			mipWidth = mipWidth > 1 ? mipWidth / 2 : 1;
+			mipHeight = mipHeight > 1 ? mipHeight / 2 : 1;
+
+			mips[i].width = mipWidth;
+			mips[i].height = mipHeight;
+
+			// bloom 에는 alpha 채널이 필요 없으므로, texel 당 8 byte 인 GL_RGBA16F 대신
+			// texel 당 4 byte 인 GL_R11F_G11F_B10F 포맷을 사용하여 메모리 대역폭을 절반으로 줄임
+			glBindTexture(GL_TEXTURE_2D, mips[i].texture);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_R11F_G11F_B10F, mipWidth, mipHeight, 0, GL_RGB, GL_FLOAT, NULL);
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	/*
+		HDR 씬 텍스쳐로부터 bloom 계산
+
+		threshold 보다 밝은 영역만 bloom 에 기여하며, knee 는 threshold 주변을 부드럽게 이어줄 구간의 너비,
+		filterRadius 는 upsampling 시 tent filter 의 반경(texel 단위)임.
+	*/
+	void render(unsigned int srcTexture, float threshold, float knee, float filterRadius)
+	{
+		// 호출하는 쪽의 뷰포트를 기억해 두었다가 마지막에 복구
+		GLint prevViewport[4];
+		glGetIntegerv(GL_VIEWPORT, prevViewport);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		glBindVertexArray(emptyVAO);
+		glActiveTexture(GL_TEXTURE0);
+
+		/* Downsampling (원본 씬 -> mips[0] -> mips[1] -> ... -> 가장 작은 mip) */
+		downsampleShader.use();
+		downsampleShader.setFloat("threshold", threshold);
+		downsampleShader.setFloat("knee", knee);
+		glBindTexture(GL_TEXTURE_2D, srcTexture);
+		for (unsigned int i = 0; i < mips.size(); i++)
+		{
+			// threshold 및 Karis average 는 원본 씬을 축소하는 첫 번째 pass 에서만 적용
+			downsampleShader.setBool("firstPass", i == 0);
+
+			glViewport(0, 0, mips[i].width, mips[i].height);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mips[i].texture, 0);
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+
+			// 방금 렌더링한 mip 을 다음 pass 에서 축소할 텍스쳐로 사용
+			glBindTexture(GL_TEXTURE_2D, mips[i].texture);
+		}
+
+		/* Upsampling (가장 작은 mip -> ... -> mips[0], 각 단계의 결과를 더 큰 mip 에 가산 혼합) */
+		upsampleShader.use();
+		upsampleShader.setFloat("filterRadius", filterRadius);
+
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_ONE);
+		glBlendEquation(GL_FUNC_ADD);
+		for (unsigned int i = (unsigned int)mips.size() - 1; i > 0; i--)
+		{
+			glBindTexture(GL_TEXTURE_2D, mips[i].texture);
+
+			glViewport(0, 0, mips[i - 1].width, mips[i - 1].height);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mips[i - 1].texture, 0);
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+		}
+		glDisable(GL_BLEND);
+
+		glBindVertexArray(0);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+	}
+
+	// 최종 bloom 결과가 누적된 텍스쳐 반환
+	unsigned int bloomTexture() const
+	{
+		return mips[0].texture;
+	}
+
+	// mip level 개수 반환
+	unsigned int mipCount() const
+	{
+		return (unsigned int)mips.size();
+	}
+
+	/*
+		한 프레임 동안 읽고 쓰는 텍스쳐 메모리 양(byte) 추정
+
+		각 pass 마다 입력 텍스쳐 전체를 1번 읽고 출력 텍스쳐 전체를 1번 쓴다고 가정하며,
+		가산 혼합하는 upsampling pass 는 출력 텍스쳐를 읽고 다시 써야 하므로 2번으로 계산함.
+		(texture cache 덕분에 13-tap, 9-tap 샘플링이 겹치는 texel 은 다시 읽지 않는다고 가정)
+
+		srcBytes 는 원본 씬 텍스쳐 전체의 크기(byte)임.
+	*/
+	double bytesPerFrame(double srcBytes) const
+	{
+		const double bytesPerTexel = 4.0; // GL_R11F_G11F_B10F
+
+		double bytes = srcBytes;
+		for (unsigned int i = 0; i < mips.size(); i++)
+		{
+			double mipBytes = (double)mips[i].width * mips[i].height * bytesPerTexel;
+
+			// downsampling pass 의 출력 + 다음 downsampling pass 의 입력
+			bytes += mipBytes * 2.0;
+
+			// upsampling pass 의 입력(가장 큰 mip 제외) 및 가산 혼합 출력(가장 작은 mip 제외)
+			if (i > 0)
+			{
+				bytes += mipBytes;
+			}
+			if (i + 1 < mips.size())
+			{
+				bytes += mipBytes * 2.0;
+			}
+		}
+
+		return bytes;
+	}
+
+private:
+	Shader downsampleShader; // 13-tap downsampling 쉐이더
+	Shader upsampleShader; // tent filter upsampling 쉐이더
+	unsigned int FBO; // 각 mip 텍스쳐를 attach 해서 렌더링할 프레임버퍼
+	unsigned int emptyVAO; // full-screen triangle 을 그릴 때 바인딩할 빈 VAO
+	std::vector<BloomMip> mips; // mip level 별 텍스쳐 (mips[0] 이 가장 큰 mip)
+};
+
+
+#endif // !BLOOM_RENDERER_H
+
+/*
+	mip chain bloom 과 ping-pong Gaussian blur 비교
+
+
+	기존의 ping-pong Gaussian blur 는
+	스크린 해상도 그대로 9-tap blur 를 수평 / 수직 방향으로 5번씩, 총 10번 반복하는데,
+
+	blur 반경이 반복 횟수에 비례해서 넓어지므로
+	bloom 을 넓게 퍼뜨리려면 full-res pass 를 계속 늘려야 하고,
+	그만큼 메모리 대역폭도 선형으로 늘어나게 됨.
+
+
+	반면, mip chain bloom 은 해상도를 절반씩 줄여 나가면서 blur 를 적용하므로,
+	mip level 이 하나 늘어날 때마다 blur 반경은 2배로 넓어지지만
+	추가되는 비용은 이전 level 의 1/4 밖에 되지 않음.
+
+	또한, 가장 큰 mip 도 스크린 해상도의 절반(= pixel 개수는 1/4)이므로,
+	모든 pass 를 합쳐도 full-res pass 1번 정도의 대역폭만으로
+	훨씬 넓은 범위의 bloom 을 계산할 수 있음!
+*/
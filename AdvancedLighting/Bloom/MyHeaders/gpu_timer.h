@@ -0,0 +1,118 @@
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+/*
+	gpu_timer.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > query 객체 관련 OpenGL 함수가 필요하니까!
+
+/*
+	GpuTimer 클래스
+
+	GL_TIME_ELAPSED 타입의 query 객체로
+	begin() ~ end() 사이에 호출된 렌더링 명령들이
+	GPU 에서 실제로 실행되는 데 걸린 시간을 측정하는 클래스!
+
+	query 결과를 곧바로 읽으면 GPU 가 명령을 다 처리할 때까지
+	CPU 가 멈춰서 기다려야 하므로(stall), query 객체를 여러 개 만들어두고
+	몇 프레임 전에 측정한 결과를 읽어오는 방식을 사용함. (하단 필기 참고)
+*/
+class GpuTimer
+{
+public:
+	// 돌아가며 사용할 query 객체 개수 (결과를 몇 프레임 늦게 읽어올 지 결정)
+	static const unsigned int QUERY_COUNT = 3;
+
+	// 생성자에서 query 객체들을 미리 생성해 둠
+	GpuTimer()
+		: current(0), lastElapsedMs(0.0)
+	{
+		glGenQueries(QUERY_COUNT, queries);
+		for (unsigned int i = 0; i < QUERY_COUNT; i++)
+		{
+			pending[i] = false;
+		}
+	}
+
+	// 측정 시작
+	// (GL_TIME_ELAPSED query 는 동시에 하나만 활성화할 수 있으므로, 여러 GpuTimer 의 begin() ~ end() 구간이 겹치면 안 됨!)
+	void begin()
+	{
+		// 이번에 사용할 query 객체의 이전 결과를 아직 읽지 않았다면, 먼저 읽어서 보관 (이 경우에만 CPU 가 기다릴 수 있음)
+		if (pending[current])
+		{
+			readResult(current);
+		}
+
+		glBeginQuery(GL_TIME_ELAPSED, queries[current]);
+	}
+
+	// 측정 종료
+	void end()
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		pending[current] = true;
+
+		// 다음 프레임에 사용할 query 객체로 넘어감
+		current = (current + 1) % QUERY_COUNT;
+
+		// 다음에 사용할 query 객체(== 가장 오래 전에 측정한 query)의 결과가 준비되었다면, CPU 를 멈추지 않고 읽어옴
+		if (pending[current])
+		{
+			GLint available = 0;
+			glGetQueryObjectiv(queries[current], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (available)
+			{
+				readResult(current);
+			}
+		}
+	}
+
+	// 가장 최근에 읽어온 측정 결과 반환 (millisecond 단위)
+	double elapsedMs() const
+	{
+		return lastElapsedMs;
+	}
+
+private:
+	unsigned int queries[QUERY_COUNT]; // 생성된 query 객체들의 참조 id
+	bool pending[QUERY_COUNT]; // 측정은 끝났지만 아직 결과를 읽지 않은 query 객체인지 여부
+	unsigned int current; // 이번 프레임에 사용할 query 객체의 인덱스
+	double lastElapsedMs; // 가장 최근에 읽어온 측정 결과
+
+	// query 객체에 저장된 측정 결과(nanosecond 단위)를 읽어서 millisecond 단위로 변환
+	void readResult(unsigned int index)
+	{
+		GLuint64 elapsedNs = 0;
+		glGetQueryObjectui64v(queries[index], GL_QUERY_RESULT, &elapsedNs);
+		lastElapsedMs = (double)elapsedNs / 1000000.0;
+		pending[index] = false;
+	}
+};
+
+
+#endif // !GPU_TIMER_H
+
+/*
+	GPU 에서 걸린 시간을 측정하는 방법
+
+
+	렌더링 명령은 CPU 에서 호출한 즉시 실행되는 게 아니라,
+	드라이버의 command buffer 에 쌓여있다가 나중에 GPU 에서 실행됨.
+
+	그래서 glfwGetTime() 같은 CPU 타이머로 렌더링 명령 앞뒤의 시간을 재면
+	'명령을 쌓는 데 걸린 시간'만 측정될 뿐, GPU 에서 실제로 걸린 시간은 알 수 없음.
+
+
+	OpenGL 3.3 부터 core 로 포함된 timer query(GL_TIME_ELAPSED) 를 사용하면,
+	glBeginQuery() ~ glEndQuery() 사이의 명령들이 GPU 에서 실행되는 데 걸린 시간을
+	query 객체에 nanosecond 단위로 기록해 줌.
+
+
+	다만, 측정 결과는 GPU 가 해당 명령들을 모두 처리한 뒤에야 준비되므로,
+	glEndQuery() 직후에 GL_QUERY_RESULT 를 읽으면 CPU 가 GPU 를 기다리게 됨.
+
+	그래서 query 객체를 3개 정도 돌려가며 사용하고,
+	2 프레임 전에 측정한 결과를 읽어오는 방식으로 이러한 stall 을 피하는 것!
+*/
@@ -0,0 +1,204 @@
+#ifndef LINEAR_GAUSSIAN_KERNEL_H
+#define LINEAR_GAUSSIAN_KERNEL_H
+/*
+	linear_gaussian_kernel.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <string> // 쉐이더에 삽입할 #define 문자열을 만들기 위해 include
+#include <sstream> // 실수값을 문자열로 변환하기 위해 include
+#include <iomanip> // std::setprecision() 을 사용하기 위해 include
+
+/*
+	LinearGaussianKernel 구조체
+
+	반경이 radius 인 1차원 가우시안 blur 를 bilinear 샘플링으로 계산하기 위한
+	샘플링 위치(offsets, texel 단위) 및 가중치(weights)를 저장하는 구조체 (하단 필기 참고)
+
+	offsets, weights 에는 음수 방향 ~ 양수 방향 순서로 실제로 샘플링할 tap 들이 모두 저장되며,
+	(2 * radius + 1) 개의 texel 을 (radius + 1) 번의 샘플링만으로 계산함.
+
+	constexpr 함수로 생성하면 가중치 계산이 모두 컴파일 타임에 끝나고,
+	런타임에는 계산된 상수 배열을 #define 문자열로 변환하여 쉐이더에 삽입하기만 하면 됨.
+*/
+const int LINEAR_GAUSSIAN_MAX_RADIUS = 16;
+
+struct LinearGaussianKernel
+{
+	float sigma;
+	int radius;
+	int tapCount;
+	float offsets[LINEAR_GAUSSIAN_MAX_RADIUS + 1];
+	float weights[LINEAR_GAUSSIAN_MAX_RADIUS + 1];
+};
+
+/*
+	컴파일 타임에 계산 가능한 exp(x) (x <= 0)
+
+	std::exp() 는 constexpr 함수가 아니므로,
+	x 가 [-0.5, 0] 범위에 들어올 때까지 절반으로 나눈 뒤 테일러 급수로 계산하고,
+	나눈 횟수만큼 다시 제곱해서 되돌림. (exp(x) = exp(x / 2)^2)
+*/
+constexpr double constexprExp(double x)
+{
+	int halvings = 0;
+	while (x < -0.5)
+	{
+		x *= 0.5;
+		halvings++;
+	}
+
+	double term = 1.0;
+	double sum = 1.0;
+	for (int n = 1; n < 16; n++)
+	{
+		term *= x / n;
+		sum += term;
+	}
+
+	for (int i = 0; i < halvings; i++)
+	{
+		sum *= sum;
+	}
+
+	return sum;
+}
+
+// 표준편차가 sigma, 반경이 radius 인 가우시안 가중치를 인접한 texel 끼리 합쳐서 bilinear 샘플링용 tap 으로 변환
+constexpr LinearGaussianKernel makeLinearGaussianKernel(float sigma, int radius)
+{
+	LinearGaussianKernel kernel{ sigma, radius, 0, {}, {} };
+
+	// 중심 ~ 양수 방향 texel 의 가우시안 가중치 계산 및 전체 합이 1 이 되도록 정규화
+	double w[LINEAR_GAUSSIAN_MAX_RADIUS + 2] = {};
+	double sum = 0.0;
+	for (int i = 0; i <= radius; i++)
+	{
+		w[i] = constexprExp(-(double)(i * i) / (2.0 * sigma * sigma));
+		sum += (i == 0) ? w[i] : 2.0 * w[i];
+	}
+	for (int i = 0; i <= radius; i++)
+	{
+		w[i] /= sum;
+	}
+
+	// 양수 방향의 tap 들을 먼저 계산
+	double positiveOffsets[LINEAR_GAUSSIAN_MAX_RADIUS + 1] = {};
+	double positiveWeights[LINEAR_GAUSSIAN_MAX_RADIUS + 1] = {};
+	int positiveCount = 0;
+
+	// 반경이 짝수면 중심 texel 을 단독 tap 으로 두고 (1, 2), (3, 4), ... 번째 texel 을 짝지음
+	// 반경이 홀수면 중심 texel 의 가중치를 양쪽으로 절반씩 나눠서 (0, 1), (2, 3), ... 번째 texel 을 짝지음
+	bool centerSplit = (radius % 2) == 1;
+	int first = centerSplit ? 0 : 1;
+	for (int i = first; i <= radius; i += 2)
+	{
+		double w0 = (i == 0) ? w[0] * 0.5 : w[i];
+		double w1 = (i + 1 <= radius) ? w[i + 1] : 0.0;
+
+		// 두 texel 사이를 가중치 비율만큼 보간한 위치를 샘플링하면, GL_LINEAR 필터링이 두 texel 의 가중 평균을 계산해 줌
+		positiveWeights[positiveCount] = w0 + w1;
+		positiveOffsets[positiveCount] = (i * w0 + (i + 1) * w1) / (w0 + w1);
+		positiveCount++;
+	}
+
+	// 음수 방향 tap (양수 방향을 뒤집은 순서) -> 중심 tap -> 양수 방향 tap 순서로 저장
+	for (int i = positiveCount - 1; i >= 0; i--)
+	{
+		kernel.offsets[kernel.tapCount] = (float)-positiveOffsets[i];
+		kernel.weights[kernel.tapCount] = (float)positiveWeights[i];
+		kernel.tapCount++;
+	}
+	if (!centerSplit)
+	{
+		kernel.offsets[kernel.tapCount] = 0.0f;
+		kernel.weights[kernel.tapCount] = (float)w[0];
+		kernel.tapCount++;
+	}
+	for (int i = 0; i < positiveCount; i++)
+	{
+		kernel.offsets[kernel.tapCount] = (float)positiveOffsets[i];
+		kernel.weights[kernel.tapCount] = (float)positiveWeights[i];
+		kernel.tapCount++;
+	}
+
+	return kernel;
+}
+
+// 가중치의 합이 1 인지 컴파일 타임에 검증하기 위한 함수
+constexpr bool isNormalized(const LinearGaussianKernel& kernel)
+{
+	double sum = 0.0;
+	for (int i = 0; i < kernel.tapCount; i++)
+	{
+		sum += kernel.weights[i];
+	}
+	return sum > 0.9999 && sum < 1.0001;
+}
+
+// (2 * radius + 1) 개의 texel 을 (radius + 1) 번의 샘플링으로 계산하는지, 가중치의 합이 1 인지 컴파일 타임에 검증
+static_assert(makeLinearGaussianKernel(1.0f, 4).tapCount == 5 && makeLinearGaussianKernel(1.0f, 3).tapCount == 4, "linear sampling must merge adjacent taps");
+static_assert(isNormalized(makeLinearGaussianKernel(2.0f, 8)), "gaussian weights must sum to 1");
+
+/*
+	계산된 kernel 을 쉐이더에 삽입할 #define 문자열로 변환
+
+	ex> 반경 4 인 kernel
+	#define KERNEL_TAP_COUNT 5
+	#define KERNEL_OFFSETS float[KERNEL_TAP_COUNT](-3.2..., -1.3..., 0.0, 1.3..., 3.2...)
+	#define KERNEL_WEIGHTS float[KERNEL_TAP_COUNT](0.07..., 0.31..., 0.22..., 0.31..., 0.07...)
+*/
+inline std::string linearGaussianDefines(const LinearGaussianKernel& kernel)
+{
+	std::ostringstream defines;
+	defines << std::setprecision(9) << std::fixed;
+
+	defines << "#define KERNEL_TAP_COUNT " << kernel.tapCount << "\n";
+
+	defines << "#define KERNEL_OFFSETS float[KERNEL_TAP_COUNT](";
+	for (int i = 0; i < kernel.tapCount; i++)
+	{
+		defines << (i > 0 ? ", " : "") << kernel.offsets[i];
+	}
+	defines << ")\n";
+
+	defines << "#define KERNEL_WEIGHTS float[KERNEL_TAP_COUNT](";
+	for (int i = 0; i < kernel.tapCount; i++)
+	{
+		defines << (i > 0 ? ", " : "") << kernel.weights[i];
+	}
+	defines << ")\n";
+
+	return defines.str();
+}
+
+
+#endif // !LINEAR_GAUSSIAN_KERNEL_H
+
+/*
+	linear sampling 으로 Gaussian blur 샘플링 횟수 줄이기
+
+
+	GL_LINEAR 필터링이 적용된 텍스쳐에서 두 texel 사이의 위치를 샘플링하면,
+	GPU 가 두 texel 을 거리에 따라 보간한 값을 '공짜로' 계산해 줌.
+
+	즉, 가중치가 w0, w1 인 인접한 두 texel 을 각각 샘플링해서 더하는 대신,
+
+	offset = (i * w0 + (i + 1) * w1) / (w0 + w1)
+	weight = w0 + w1
+
+	위치를 1번만 샘플링해서 weight 를 곱해주면
+	w0 * texel[i] + w1 * texel[i + 1] 과 똑같은 결과를 얻을 수 있음!
+
+
+	그래서 반경이 짝수일 때는 중심 texel 을 따로 샘플링하고 나머지 texel 을 2개씩 짝짓고,
+	반경이 홀수일 때는 중심 texel 의 가중치를 양쪽으로 절반씩 나눠서 중심 texel 까지 짝지으면,
+
+	어느 경우든 (2 * radius + 1) 개의 texel 을
+	(radius + 1) 번의 샘플링만으로 계산할 수 있음.
+
+
+	단, 샘플링 위치가 정확히 인접한 texel 사이여야 하므로,
+	offset 은 반드시 texel 단위로 계산해야 하고,
+	텍스쳐의 필터링 모드도 GL_LINEAR 여야 함!
+*/
@@ -0,0 +1,211 @@
+#ifndef POST_PROCESS_STACK_H
+#define POST_PROCESS_STACK_H
+/*
+	post_process_stack.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > 텍스쳐 바인딩 및 그리기 관련 OpenGL 함수가 필요하니까!
+#include <glm/glm.hpp> // color grading 의 색상 필터를 glm::vec3 로 전달받기 위해 include
+
+#include <map> // 단계 조합(bitmask)별로 컴파일한 쉐이더를 캐싱하기 위해 include
+#include <string>
+
+#include "shader_s.h" // 단계 조합마다 #define 을 삽입한 uber shader 객체를 생성하기 위해 include
+
+/*
+	후처리 단계 bitmask
+
+	PostProcessStack::render() 에 활성화할 단계들을 OR 연산으로 묶어서 전달함.
+	(쉐이더 안에서 적용되는 순서는 아래 선언 순서와 같음)
+*/
+const unsigned int POST_BLOOM = 1 << 0;
+const unsigned int POST_TONEMAP = 1 << 1;
+const unsigned int POST_COLOR_GRADING = 1 << 2;
+const unsigned int POST_VIGNETTE = 1 << 3;
+const unsigned int POST_GAMMA = 1 << 4;
+const unsigned int POST_GRAYSCALE = 1 << 5;
+const unsigned int POST_INVERSION = 1 << 6;
+const unsigned int POST_STAGE_COUNT = 7;
+
+/*
+	PostProcessSettings 구조체
+
+	각 후처리 단계에서 사용할 파라미터 (비활성화된 단계의 값은 무시됨)
+*/
+struct PostProcessSettings
+{
+	float bloomStrength;
+	float exposure;
+	float contrast;
+	float saturation;
+	glm::vec3 colorFilter;
+	float vignetteRadius;
+	float vignetteIntensity;
+};
+
+/*
+	PostProcessStack 클래스
+
+	per-pixel 후처리 단계들(bloom 가산 혼합, tone mapping, color grading, vignette, gamma correction, 흑백 변환, 색상 반전)을
+	하나의 uber shader(MyShaders/post_uber.fs) 로 합쳐서 단일 full-screen pass 로 처리하는 클래스! (post_uber.fs 하단 필기 참고)
+
+	활성화된 단계 조합(bitmask)마다 필요한 #define 만 삽입한 쉐이더를 처음 사용할 때 컴파일하고,
+	이후에는 캐싱된 쉐이더를 재사용함.
+
+	쉐이더 파일은 MyShaders/bloom_mip.vs, MyShaders/post_uber.fs 를 사용함.
+*/
+class PostProcessStack
+{
+public:
+	// 생성자에서 full-screen triangle 을 그릴 빈 VAO 생성 (쉐이더는 render() 에서 필요할 때 컴파일)
+	PostProcessStack()
+	{
+		// bloom_mip.vs 는 gl_VertexID 만으로 full-screen triangle 을 만들기 때문에 정점 데이터가 필요 없지만,
+		// core-profile 에서는 그리기 명령 호출 시 반드시 VAO 가 바인딩되어 있어야 하므로 빈 VAO 를 생성해 둠
+		glGenVertexArrays(1, &emptyVAO);
+	}
+
+	/*
+		현재 바인딩된 프레임버퍼에 stages 로 지정한 후처리 단계들을 단일 pass 로 적용
+
+		sceneTexture 는 HDR 범위로 원본 씬을 렌더링한 텍스쳐이고,
+		bloomTexture 는 POST_BLOOM 단계에서 가산 혼합할 bloom 텍스쳐임.
+	*/
+	void render(unsigned int stages, unsigned int sceneTexture, unsigned int bloomTexture, const PostProcessSettings& settings)
+	{
+		Shader& shader = permutation(stages);
+		shader.use();
+
+		if (stages & POST_BLOOM)
+		{
+			shader.setFloat("bloomStrength", settings.bloomStrength);
+		}
+		if (stages & POST_TONEMAP)
+		{
+			shader.setFloat("exposure", settings.exposure);
+		}
+		if (stages & POST_COLOR_GRADING)
+		{
+			shader.setFloat("contrast", settings.contrast);
+			shader.setFloat("saturation", settings.saturation);
+			shader.setVec3("colorFilter", settings.colorFilter);
+		}
+		if (stages & POST_VIGNETTE)
+		{
+			shader.setFloat("vignetteRadius", settings.vignetteRadius);
+			shader.setFloat("vignetteIntensity", settings.vignetteIntensity);
+		}
+
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, sceneTexture);
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, bloomTexture);
+		glActiveTexture(GL_TEXTURE0);
+
+		glBindVertexArray(emptyVAO);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+		glBindVertexArray(0);
+	}
+
+	// 지금까지 컴파일되어 캐싱된 쉐이더 개수 반환
+	unsigned int cachedPermutationCount() const
+	{
+		return (unsigned int)permutations.size();
+	}
+
+	// 활성화된 단계 개수 = 단계마다 별도의 full-screen pass 로 처리했을 때의 pass 개수
+	static unsigned int unfusedPassCount(unsigned int stages)
+	{
+		unsigned int count = 0;
+		for (unsigned int i = 0; i < POST_STAGE_COUNT; i++)
+		{
+			if (stages & (1u << i))
+			{
+				count++;
+			}
+		}
+		return count;
+	}
+
+	/*
+		한 프레임 동안 후처리에서 읽고 쓰는 텍스쳐 메모리 양(byte) 추정
+
+		fused 가 true 면 단일 pass 로, false 면 단계마다 별도의 full-screen pass 로 처리한다고 가정하며,
+		별도의 pass 사이에서 주고받는 중간 텍스쳐는 HDR 범위를 유지할 수 있는 GL_RGBA16F(texel 당 8 byte)로 계산함.
+
+		sceneBytes, bloomBytes 는 원본 씬 텍스쳐 및 bloom 텍스쳐 전체의 크기(byte)이고,
+		최종 결과는 width * height 크기의 default framebuffer(texel 당 4 byte)에 씀.
+	*/
+	static double bytesPerFrame(unsigned int stages, bool fused, unsigned int width, unsigned int height, double sceneBytes, double bloomBytes)
+	{
+		const double intermediateBytes = (double)width * height * 8.0;
+		const double outputBytes = (double)width * height * 4.0;
+
+		double bytes = sceneBytes + outputBytes;
+		if (stages & POST_BLOOM)
+		{
+			bytes += bloomBytes;
+		}
+
+		// 별도의 pass 로 처리하면 마지막 pass 를 제외한 모든 pass 가 중간 텍스쳐를 쓰고, 다음 pass 가 이를 다시 읽음
+		unsigned int passes = unfusedPassCount(stages);
+		if (!fused && passes > 1)
+		{
+			bytes += intermediateBytes * 2.0 * (passes - 1);
+		}
+
+		return bytes;
+	}
+
+private:
+	std::map<unsigned int, Shader> permutations; // 단계 조합(bitmask)별로 컴파일된 uber shader
+	unsigned int emptyVAO; // full-screen triangle 을 그릴 때 바인딩할 빈 VAO
+
+	// 단계 조합에 해당하는 쉐이더를 캐시에서 찾고, 없으면 새로 컴파일해서 캐싱
+	Shader& permutation(unsigned int stages)
+	{
+		std::map<unsigned int, Shader>::iterator it = permutations.find(stages);
+		if (it != permutations.end())
+		{
+			return it->second;
+		}
+
+		Shader shader("MyShaders/bloom_mip.vs", "MyShaders/post_uber.fs", stageDefines(stages));
+
+		// uniform sampler 변수에 texture unit 위치값 전송은 컴파일 직후 1번만 하면 됨
+		shader.use();
+		shader.setInt("scene", 0);
+		if (stages & POST_BLOOM)
+		{
+			shader.setInt("bloomBlur", 1);
+		}
+
+		std::cout << "compiled post-process permutation 0x" << std::hex << stages << std::dec
+			<< " (" << unfusedPassCount(stages) << " stages in 1 pass, " << permutations.size() + 1 << " cached)" << std::endl;
+
+		return permutations.insert(std::make_pair(stages, shader)).first->second;
+	}
+
+	// 단계 조합을 post_uber.fs 에 삽입할 #define 문자열로 변환
+	static std::string stageDefines(unsigned int stages)
+	{
+		// 단계 bitmask 의 bit 순서와 같은 순서로 선언된 #define 이름
+		static const char* stageNames[POST_STAGE_COUNT] = {
+			"POST_BLOOM", "POST_TONEMAP", "POST_COLOR_GRADING", "POST_VIGNETTE", "POST_GAMMA", "POST_GRAYSCALE", "POST_INVERSION"
+		};
+
+		std::string defines;
+		for (unsigned int i = 0; i < POST_STAGE_COUNT; i++)
+		{
+			if (stages & (1u << i))
+			{
+				defines += std::string("#define ") + stageNames[i] + "\n";
+			}
+		}
+		return defines;
+	}
+};
+
+
+#endif // !POST_PROCESS_STACK_H
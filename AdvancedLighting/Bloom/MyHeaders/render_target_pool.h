@@ -0,0 +1,366 @@
+#ifndef RENDER_TARGET_POOL_H
+#define RENDER_TARGET_POOL_H
+/*
+	render_target_pool.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > 텍스쳐 및 프레임버퍼 관련 OpenGL 함수가 필요하니까!
+
+#include <vector> // pool 에 보관 중인 텍스쳐들을 동적 배열로 보관하기 위해 include
+#include <algorithm>
+#include <iostream>
+
+/*
+	RenderTargetDesc 구조체
+
+	pass 가 요청하는 render target 의 조건 (해상도, 내부 포맷, MSAA sample 개수, 필터링 모드)
+	조건이 완전히 같은 텍스쳐끼리만 서로 재사용될 수 있음.
+*/
+struct RenderTargetDesc
+{
+	unsigned int width;
+	unsigned int height;
+	GLenum internalFormat;
+	unsigned int samples; // 0 이면 일반 텍스쳐, 1 이상이면 multisample 텍스쳐
+	GLenum filter; // GL_NEAREST 또는 GL_LINEAR (multisample 텍스쳐에서는 무시됨)
+
+	bool operator==(const RenderTargetDesc& other) const
+	{
+		return width == other.width && height == other.height && internalFormat == other.internalFormat
+			&& samples == other.samples && filter == other.filter;
+	}
+};
+
+/*
+	RenderTargetPool 클래스
+
+	pass 마다 고정된 프레임버퍼와 텍스쳐를 프로그램이 끝날 때까지 들고 있는 대신,
+	매 프레임 pass 가 필요한 render target 을 (해상도, 포맷, sample 개수) 조건으로 요청(acquire)하고
+	다 쓴 뒤에는 반납(release)하도록 해서,
+	사용 기간(lifetime)이 겹치지 않는 pass 끼리 같은 텍스쳐를 재사용(aliasing)하는 클래스! (하단 필기 참고)
+
+	요청한 텍스쳐는 bindTargets() 로 pool 이 관리하는 프레임버퍼에 attach 해서 렌더링하며,
+	maxIdleFrames 프레임 동안 한 번도 요청되지 않은 텍스쳐는 endFrame() 에서 해제됨.
+*/
+class RenderTargetPool
+{
+public:
+	// 생성자에서 요청된 텍스쳐들을 attach 해서 렌더링할 프레임버퍼 생성
+	RenderTargetPool(unsigned int maxIdleFrames = 2)
+		: maxIdle(maxIdleFrames), frameIndex(0), frameRequestedBytes(0.0), peakRequested(0.0), peakAllocated(0.0)
+	{
+		glGenFramebuffers(1, &FBO);
+	}
+
+	// 조건에 맞는 텍스쳐를 요청 (반납된 텍스쳐 중 조건이 같은 것이 있으면 재사용하고, 없으면 새로 생성)
+	unsigned int acquire(unsigned int width, unsigned int height, GLenum internalFormat, unsigned int samples = 0, GLenum filter = GL_NEAREST)
+	{
+		RenderTargetDesc desc = { width, height, internalFormat, samples, filter };
+
+		// 이번 프레임에 요청된 텍스쳐 크기를 모두 더한 값 (재사용하지 않고 pass 마다 텍스쳐를 따로 만들었을 때의 메모리 양)
+		frameRequestedBytes += textureBytes(desc);
+		peakRequested = std::max(peakRequested, frameRequestedBytes);
+
+		for (unsigned int i = 0; i < entries.size(); i++)
+		{
+			if (!entries[i].inUse && entries[i].desc == desc)
+			{
+				entries[i].inUse = true;
+				entries[i].lastUsedFrame = frameIndex;
+				return entries[i].texture;
+			}
+		}
+
+		Entry entry;
+		entry.desc = desc;
+		entry.inUse = true;
+		entry.lastUsedFrame = frameIndex;
+		entry.texture = createTexture(desc);
+		entries.push_back(entry);
+
+		peakAllocated = std::max(peakAllocated, allocatedBytes());
+		return entry.texture;
+	}
+
+	// 다 쓴 텍스쳐를 반납 -> 이후에 같은 조건으로 요청하는 pass 가 재사용할 수 있음
+	// (반납한 텍스쳐의 내용은 다른 pass 가 덮어쓸 수 있으므로, 반납 이후에는 샘플링하면 안 됨!)
+	void release(unsigned int texture)
+	{
+		for (unsigned int i = 0; i < entries.size(); i++)
+		{
+			if (entries[i].texture == texture)
+			{
+				entries[i].inUse = false;
+				return;
+			}
+		}
+	}
+
+	/*
+		요청한 텍스쳐들을 pool 의 프레임버퍼에 attach 하고 바인딩
+
+		color 포맷 텍스쳐는 배열 순서대로 GL_COLOR_ATTACHMENT0, 1, ... 에,
+		depth 포맷 텍스쳐는 GL_DEPTH_ATTACHMENT 에 attach 됨.
+	*/
+	void bindTargets(const unsigned int* textures, unsigned int count)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+
+		// 이전에 attach 되어 있던 텍스쳐가 남지 않도록, 이번에 사용하지 않는 attachment 는 모두 비워줌
+		unsigned int colorCount = 0;
+		bool hasDepth = false;
+		unsigned int drawBuffers[MAX_COLOR_TARGETS];
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const Entry* entry = find(textures[i]);
+			if (!entry)
+			{
+				continue;
+			}
+
+			GLenum target = entry->desc.samples > 0 ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
+			if (isDepthFormat(entry->desc.internalFormat))
+			{
+				glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, target, textures[i], 0);
+				hasDepth = true;
+			}
+			else if (colorCount < MAX_COLOR_TARGETS)
+			{
+				glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + colorCount, target, textures[i], 0);
+				drawBuffers[colorCount] = GL_COLOR_ATTACHMENT0 + colorCount;
+				colorCount++;
+			}
+		}
+		for (unsigned int i = colorCount; i < attachedColorCount; i++)
+		{
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, 0, 0);
+		}
+		if (!hasDepth)
+		{
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, 0, 0);
+		}
+		attachedColorCount = colorCount;
+
+		glDrawBuffers(colorCount, drawBuffers);
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cout << "Render Target Pool Framebuffer is not complete!" << std::endl;
+		}
+	}
+
+	// 텍스쳐 1개만 color attachment 로 attach 하고 바인딩
+	void bindTarget(unsigned int texture)
+	{
+		bindTargets(&texture, 1);
+	}
+
+	/*
+		프레임 마지막에 호출
+
+		반납되지 않은 텍스쳐가 있으면 경고 후 강제로 반납하고,
+		maxIdleFrames 프레임 동안 요청되지 않은 텍스쳐는 해제함.
+	*/
+	void endFrame()
+	{
+		for (unsigned int i = 0; i < entries.size(); )
+		{
+			if (entries[i].inUse)
+			{
+				std::cout << "Render Target Pool: texture " << entries[i].texture << " was not released this frame" << std::endl;
+				entries[i].inUse = false;
+			}
+
+			if (frameIndex - entries[i].lastUsedFrame >= maxIdle)
+			{
+				glDeleteTextures(1, &entries[i].texture);
+				entries.erase(entries.begin() + i);
+			}
+			else
+			{
+				i++;
+			}
+		}
+
+		frameRequestedBytes = 0.0;
+		frameIndex++;
+	}
+
+	// 현재 pool 이 할당하고 있는 텍스쳐 메모리 양 (byte)
+	double allocatedBytes() const
+	{
+		double bytes = 0.0;
+		for (unsigned int i = 0; i < entries.size(); i++)
+		{
+			bytes += textureBytes(entries[i].desc);
+		}
+		return bytes;
+	}
+
+	// pool 이 할당했던 텍스쳐 메모리 양의 최댓값 (byte)
+	double peakAllocatedBytes() const
+	{
+		return peakAllocated;
+	}
+
+	// 한 프레임 동안 요청된 텍스쳐 크기 합의 최댓값 (byte) = 재사용 없이 요청마다 텍스쳐를 만들었다면 필요했을 메모리 양
+	double peakRequestedBytes() const
+	{
+		return peakRequested;
+	}
+
+	// 현재 pool 이 보관 중인 텍스쳐 개수
+	unsigned int textureCount() const
+	{
+		return (unsigned int)entries.size();
+	}
+
+	/*
+		텍스쳐 1개의 메모리 양(byte) 추정
+
+		GL_RED, GL_RGBA 처럼 크기가 지정되지 않은 포맷은 드라이버가 보통 채널당 8 bit 로 할당한다고 가정하며,
+		GL_RGB16F 처럼 3채널 포맷도 실제로는 4채널로 padding 되는 경우가 많으므로 4채널로 계산함.
+	*/
+	static double textureBytes(const RenderTargetDesc& desc)
+	{
+		return (double)desc.width * desc.height * bytesPerTexel(desc.internalFormat) * (desc.samples > 0 ? desc.samples : 1);
+	}
+
+	static double textureBytes(unsigned int width, unsigned int height, GLenum internalFormat, unsigned int samples = 0)
+	{
+		RenderTargetDesc desc = { width, height, internalFormat, samples, GL_NEAREST };
+		return textureBytes(desc);
+	}
+
+private:
+	static const unsigned int MAX_COLOR_TARGETS = 8;
+
+	// pool 에 보관 중인 텍스쳐 1개의 정보
+	struct Entry
+	{
+		unsigned int texture;
+		RenderTargetDesc desc;
+		bool inUse; // 현재 프레임에서 요청된 뒤 아직 반납되지 않았는 지 여부
+		unsigned int lastUsedFrame; // 마지막으로 요청된 프레임 번호
+	};
+
+	std::vector<Entry> entries;
+	unsigned int FBO; // 요청된 텍스쳐들을 attach 해서 렌더링할 프레임버퍼
+	unsigned int attachedColorCount = 0; // 현재 FBO 에 attach 되어 있는 color attachment 개수
+	unsigned int maxIdle;
+	unsigned int frameIndex;
+	double frameRequestedBytes;
+	double peakRequested;
+	double peakAllocated;
+
+	const Entry* find(unsigned int texture) const
+	{
+		for (unsigned int i = 0; i < entries.size(); i++)
+		{
+			if (entries[i].texture == texture)
+			{
+				return &entries[i];
+			}
+		}
+		return NULL;
+	}
+
+	static bool isDepthFormat(GLenum internalFormat)
+	{
+		return internalFormat == GL_DEPTH_COMPONENT || internalFormat == GL_DEPTH_COMPONENT16 || internalFormat == GL_DEPTH_COMPONENT24
+			|| internalFormat == GL_DEPTH_COMPONENT32F || internalFormat == GL_DEPTH24_STENCIL8 || internalFormat == GL_DEPTH32F_STENCIL8;
+	}
+
+	static unsigned int bytesPerTexel(GLenum internalFormat)
+	{
+		switch (internalFormat)
+		{
+		case GL_RED:
+		case GL_R8:
+			return 1;
+		case GL_RG:
+		case GL_RG8:
+		case GL_R16F:
+		case GL_DEPTH_COMPONENT16:
+			return 2;
+		case GL_RGBA16F:
+		case GL_RGB16F:
+		case GL_RG32F:
+		case GL_DEPTH32F_STENCIL8:
+			return 8;
+		case GL_RGBA32F:
+		case GL_RGB32F:
+			return 16;
+		default:
+			// GL_RGBA, GL_RGBA8, GL_RG16F, GL_R32F, GL_R11F_G11F_B10F, GL_DEPTH_COMPONENT(24/32F), GL_DEPTH24_STENCIL8 등
+			return 4;
+		}
+	}
+
+	// 요청 조건에 맞는 텍스쳐 생성 및 메모리 할당
+	static unsigned int createTexture(const RenderTargetDesc& desc)
+	{
+		unsigned int texture;
+		glGenTextures(1, &texture);
+
+		if (desc.samples > 0)
+		{
+			glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, texture);
+			glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, desc.samples, desc.internalFormat, desc.width, desc.height, GL_TRUE);
+			glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+			return texture;
+		}
+
+		// 메모리만 할당하므로 format, type 은 내부 포맷의 종류(color / depth / depth-stencil)만 맞춰주면 됨
+		GLenum format = GL_RGBA;
+		GLenum type = GL_FLOAT;
+		if (desc.internalFormat == GL_DEPTH24_STENCIL8 || desc.internalFormat == GL_DEPTH32F_STENCIL8)
+		{
+			format = GL_DEPTH_STENCIL;
+			type = GL_UNSIGNED_INT_24_8;
+		}
+		else if (isDepthFormat(desc.internalFormat))
+		{
+			format = GL_DEPTH_COMPONENT;
+		}
+
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexImage2D(GL_TEXTURE_2D, 0, desc.internalFormat, desc.width, desc.height, 0, format, type, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, desc.filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, desc.filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		return texture;
+	}
+};
+
+
+#endif // !RENDER_TARGET_POOL_H
+
+/*
+	render target aliasing
+
+
+	deferred shading, SSAO, bloom 처럼 pass 가 여러 개인 렌더링 파이프라인에서는
+	중간 결과를 저장하는 텍스쳐가 pass 마다 하나씩 필요하지만,
+
+	대부분의 중간 결과는 '바로 다음 pass 에서 한 번 읽히고 나면' 더 이상 필요 없음.
+
+
+	예를 들어 SSAO 의 separable blur 에서
+	occlusion factor 텍스쳐는 수평 blur pass 가 읽고 나면 쓸모가 없어지므로,
+	수직 blur pass 의 결과는 새 텍스쳐 대신 occlusion factor 텍스쳐에 덮어써도 아무 문제가 없음.
+
+
+	그래서 각 텍스쳐가 '처음 쓰이는 pass ~ 마지막으로 읽히는 pass' 구간(lifetime)을 기준으로,
+	구간이 겹치지 않으면서 해상도와 포맷이 같은 텍스쳐끼리 같은 메모리를 공유하도록 하면,
+
+	pass 개수가 늘어나도 실제로 필요한 메모리는
+	'같은 시점에 동시에 살아있는 텍스쳐'의 최대치만큼으로 줄어듦.
+
+
+	또한 모드를 바꿔서 더 이상 요청되지 않는 텍스쳐(ex> 저해상도 SSAO 를 끄면 저해상도 버퍼들)는
+	몇 프레임 뒤에 자동으로 해제되므로, 사용하지 않는 기능의 텍스쳐가 메모리를 계속 차지하지 않음.
+*/
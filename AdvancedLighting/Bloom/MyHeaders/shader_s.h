@@ -32,7 +32,8 @@ public:
 
 	// Shader 클래스 생성자 (shader 파일 읽기 및 compile, linking 등의 작업 담당)
 	// 생성자 인자로 쉐이더 파일 경로 문자열에 대한 참조 (포인터)를 전달받음.
-	Shader(const GLchar* vertexPath, const GLchar* fragmentPath)
+	// fragmentDefines 로 #define 문자열을 전달하면, 프래그먼트 쉐이더의 #version 바로 다음 줄에 삽입함.
+	Shader(const GLchar* vertexPath, const GLchar* fragmentPath, const std::string& fragmentDefines = "")
 	{
 		// 쉐이더 코드를 std::string(문자열) 타입으로 파싱하여 저장할 변수 선언 
 		std::string vertexCode;
@@ -94,6 +95,13 @@ public:
 			// 저장해둔 문자열 스트림을 실제 문자열로 파싱
 			vertexCode = vShaderStream.str();
 			fragmentCode = fShaderStream.str();
+
+			// #version 지시문은 항상 쉐이더 코드의 첫 줄에 있어야 하므로, 그 다음 줄에 #define 문자열 삽입
+			if (!fragmentDefines.empty())
+			{
+				size_t versionLineEnd = fragmentCode.find('\n');
+				fragmentCode.insert(versionLineEnd == std::string::npos ? fragmentCode.size() : versionLineEnd + 1, fragmentDefines);
+			}
 		}
 		catch (std::ifstream::failure e)
 		{
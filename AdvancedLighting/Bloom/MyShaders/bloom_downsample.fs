@@ -0,0 +1,146 @@
+#version 330 core
+
+out vec4 FragColor;
+
+// 버텍스 쉐이더에서 전송받은 텍스쳐 좌표 입력변수 선언
+in vec2 TexCoords;
+
+/* uniform 변수 선언 */
+
+// 축소할 이전 mip 텍스쳐 (첫 번째 pass 에서는 HDR 범위로 원본 씬을 렌더링한 텍스쳐)
+uniform sampler2D srcTexture;
+
+// 첫 번째 pass 여부 (첫 번째 pass 에서만 밝기 threshold 및 Karis average 적용)
+uniform bool firstPass;
+
+// 밝기 threshold 및 threshold 주변을 부드럽게 이어줄 knee 구간의 너비
+uniform float threshold;
+uniform float knee;
+
+// 색상의 밝기값 계산 (bloom.fs 와 동일한 grayscale 가중치 사용)
+float luminance(vec3 color) {
+  return dot(color, vec3(0.2126, 0.7152, 0.0722));
+}
+
+// threshold 보다 어두운 색상을 걸러내되, knee 구간에서는 2차 곡선으로 부드럽게 감쇄 (하단 필기 참고)
+vec3 prefilter(vec3 color) {
+  float brightness = luminance(color);
+
+  float soft = clamp(brightness - threshold + knee, 0.0, 2.0 * knee);
+  soft = soft * soft / (4.0 * knee + 0.00001);
+
+  float contribution = max(soft, brightness - threshold) / max(brightness, 0.00001);
+  return color * contribution;
+}
+
+// 4개 texel 의 평균을 밝기값의 역수로 가중치를 주어 계산 (Karis average, 하단 필기 참고)
+vec3 karisAverage(vec3 a, vec3 b, vec3 c, vec3 d) {
+  float wa = 1.0 / (1.0 + luminance(a));
+  float wb = 1.0 / (1.0 + luminance(b));
+  float wc = 1.0 / (1.0 + luminance(c));
+  float wd = 1.0 / (1.0 + luminance(d));
+  return (a * wa + b * wb + c * wc + d * wd) / (wa + wb + wc + wd);
+}
+
+void main() {
+  // 이전 mip 텍스쳐의 texel 1개 크기
+  vec2 texel = 1.0 / vec2(textureSize(srcTexture, 0));
+
+  /*
+    13-tap downsampling (하단 필기 참고)
+
+    a - b - c
+    - j - k -
+    d - e - f
+    - l - m -
+    g - h - i
+
+    (GL_LINEAR 필터링으로 샘플링하므로, 각 tap 은 이전 mip 텍스쳐의 2*2 texel 평균이 됨)
+  */
+  vec3 a = texture(srcTexture, TexCoords + texel * vec2(-2.0, 2.0)).rgb;
+  vec3 b = texture(srcTexture, TexCoords + texel * vec2(0.0, 2.0)).rgb;
+  vec3 c = texture(srcTexture, TexCoords + texel * vec2(2.0, 2.0)).rgb;
+
+  vec3 d = texture(srcTexture, TexCoords + texel * vec2(-2.0, 0.0)).rgb;
+  vec3 e = texture(srcTexture, TexCoords).rgb;
+  vec3 f = texture(srcTexture, TexCoords + texel * vec2(2.0, 0.0)).rgb;
+
+  vec3 g = texture(srcTexture, TexCoords + texel * vec2(-2.0, -2.0)).rgb;
+  vec3 h = texture(srcTexture, TexCoords + texel * vec2(0.0, -2.0)).rgb;
+  vec3 i = texture(srcTexture, TexCoords + texel * vec2(2.0, -2.0)).rgb;
+
+  vec3 j = texture(srcTexture, TexCoords + texel * vec2(-1.0, 1.0)).rgb;
+  vec3 k = texture(srcTexture, TexCoords + texel * vec2(1.0, 1.0)).rgb;
+  vec3 l = texture(srcTexture, TexCoords + texel * vec2(-1.0, -1.0)).rgb;
+  vec3 m = texture(srcTexture, TexCoords + texel * vec2(1.0, -1.0)).rgb;
+
+  vec3 result;
+
+  if(firstPass) {
+    // 첫 번째 pass 에서는 각 tap 에 threshold 를 먼저 적용
+    a = prefilter(a);
+    b = prefilter(b);
+    c = prefilter(c);
+    d = prefilter(d);
+    e = prefilter(e);
+    f = prefilter(f);
+    g = prefilter(g);
+    h = prefilter(h);
+    i = prefilter(i);
+    j = prefilter(j);
+    k = prefilter(k);
+    l = prefilter(l);
+    m = prefilter(m);
+
+    // 5개의 2*2 블록마다 Karis average 를 적용하여 firefly(하나의 아주 밝은 pixel 이 깜빡이는 현상) 억제
+    result = karisAverage(j, k, l, m) * 0.5;
+    result += karisAverage(a, b, d, e) * 0.125;
+    result += karisAverage(b, c, e, f) * 0.125;
+    result += karisAverage(d, e, g, h) * 0.125;
+    result += karisAverage(e, f, h, i) * 0.125;
+  } else {
+    // 중앙의 2*2 블록(j, k, l, m) 에 0.5, 나머지 4개의 겹치는 2*2 블록에 각각 0.125 의 가중치를 적용한 결과를 풀어서 정리한 것
+    result = e * 0.125;
+    result += (a + c + g + i) * 0.03125;
+    result += (b + d + f + h) * 0.0625;
+    result += (j + k + l + m) * 0.125;
+  }
+
+  // 음수나 NaN 이 다음 mip 으로 전파되지 않도록 방지
+  FragColor = vec4(max(result, vec3(0.0001)), 1.0);
+}
+
+/*
+  13-tap downsampling
+
+
+  mip chain 을 만들 때 2*2 texel 을 단순히 평균내면(= GL_LINEAR 1번 샘플링),
+  작은 밝은 영역이 texel 격자와의 위치 관계에 따라
+  다음 mip 에 남기도 하고 사라지기도 하면서 카메라가 움직일 때 깜빡거림.
+
+  그래서 Call of Duty: Advanced Warfare 의 bloom 에서는
+  현재 texel 을 중심으로 겹쳐진 5개의 2*2 블록(= 4*4 영역)을
+  13번의 bilinear 샘플링으로 읽어 가중 평균을 내는데,
+
+  이렇게 하면 축소와 동시에 약한 blur 가 적용되어
+  mip 을 거듭해서 축소해도 밝은 영역이 안정적으로 유지됨.
+
+
+  또한, 첫 번째 pass 에서는 각 2*2 블록의 평균을 낼 때
+  밝기값의 역수(1 / (1 + luma))로 가중치를 주는 Karis average 를 사용함.
+
+  이렇게 하면 주변보다 훨씬 밝은 단일 pixel 의 영향력이 줄어들어서,
+  HDR 씬에서 자주 발생하는 firefly 현상을 억제할 수 있음.
+*/
+
+/*
+  threshold 와 knee
+
+
+  bloom.fs 처럼 밝기값이 1.0 을 넘는 지 여부로만 색상을 걸러내면,
+  threshold 경계에서 bloom 이 갑자기 켜지고 꺼지면서 뚜렷한 경계선이 생김.
+
+  그래서 [threshold - knee, threshold + knee] 구간에서는
+  기여도가 0 에서부터 2차 곡선을 따라 부드럽게 증가하도록 하고,
+  그보다 밝은 영역에서는 (밝기값 - threshold) 만큼만 bloom 에 기여하도록 함.
+*/
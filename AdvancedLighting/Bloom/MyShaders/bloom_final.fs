@@ -16,6 +16,9 @@ uniform sampler2D bloomBlur;
 // bloom 효과 활성화 여부
 uniform bool bloom;
 
+// bloom 색상을 가산 혼합할 때 곱해줄 세기 (mip chain bloom 은 여러 mip 의 결과가 누적되어 있으므로 1 보다 작은 값을 사용)
+uniform float bloomStrength;
+
 // tone mapping 에 사용할 노출값 (빛이 많을 때 / 적을 때 인간의 홍채, 카메라 조리개와 같은 역할!)
 uniform float exposure;
 
@@ -32,7 +35,7 @@ void main() {
   // bloom 상태값 여부에 따라 가산 혼합 적용
   if(bloom) {
     // 'HDR 범위로 렌더링된 원본 씬'에 '광원 큐브 영역의 two-pass Gaussian blur' 색상을 가산 혼합(additive blending)
-    hdrColor += bloomColor;
+    hdrColor += bloomColor * bloomStrength;
   }
 
   /*
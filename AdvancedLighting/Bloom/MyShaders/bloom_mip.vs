@@ -0,0 +1,20 @@
+#version 330 core
+
+/* 프래그먼트 쉐이더 단계로 보간하여 전송할 텍스쳐 좌표 출력 변수 선언 */
+out vec2 TexCoords;
+
+void main() {
+  /*
+    정점 데이터 없이 gl_VertexID(0, 1, 2) 만으로
+    화면 전체를 덮는 커다란 삼각형(full-screen triangle)의 정점 좌표 계산
+
+    gl_VertexID 가 0, 1, 2 일 때 각각 (0, 0), (2, 0), (0, 2) 가 계산되고,
+    이를 NDC 좌표계로 맵핑하면 (-1, -1), (3, -1), (-1, 3) 이 되어
+    [-1, 1] 범위의 화면 전체를 덮게 됨. (화면 밖의 영역은 clipping 됨)
+  */
+  vec2 pos = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+
+  // 화면 안쪽 영역에서는 pos 가 곧 [0, 1] 범위의 텍스쳐 좌표가 됨
+  TexCoords = pos;
+  gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+}
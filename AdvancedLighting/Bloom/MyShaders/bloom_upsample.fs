@@ -0,0 +1,62 @@
+#version 330 core
+
+out vec4 FragColor;
+
+// 버텍스 쉐이더에서 전송받은 텍스쳐 좌표 입력변수 선언
+in vec2 TexCoords;
+
+/* uniform 변수 선언 */
+
+// 확대할 더 작은 mip 텍스쳐
+uniform sampler2D srcTexture;
+
+// tent filter 의 반경 (srcTexture 의 texel 단위)
+uniform float filterRadius;
+
+void main() {
+  // srcTexture 기준 filterRadius 만큼의 uv offset
+  vec2 offset = filterRadius / vec2(textureSize(srcTexture, 0));
+
+  /*
+    3*3 tent filter 로 확대 (하단 필기 참고)
+
+    1 2 1
+    2 4 2  * 1 / 16
+    1 2 1
+  */
+  vec3 a = texture(srcTexture, TexCoords + vec2(-offset.x, offset.y)).rgb;
+  vec3 b = texture(srcTexture, TexCoords + vec2(0.0, offset.y)).rgb;
+  vec3 c = texture(srcTexture, TexCoords + vec2(offset.x, offset.y)).rgb;
+
+  vec3 d = texture(srcTexture, TexCoords + vec2(-offset.x, 0.0)).rgb;
+  vec3 e = texture(srcTexture, TexCoords).rgb;
+  vec3 f = texture(srcTexture, TexCoords + vec2(offset.x, 0.0)).rgb;
+
+  vec3 g = texture(srcTexture, TexCoords + vec2(-offset.x, -offset.y)).rgb;
+  vec3 h = texture(srcTexture, TexCoords + vec2(0.0, -offset.y)).rgb;
+  vec3 i = texture(srcTexture, TexCoords + vec2(offset.x, -offset.y)).rgb;
+
+  vec3 result = e * 4.0;
+  result += (b + d + f + h) * 2.0;
+  result += (a + c + g + i);
+  result *= 1.0 / 16.0;
+
+  // 이 결과는 glBlendFunc(GL_ONE, GL_ONE) 으로 더 큰 mip 텍스쳐에 가산 혼합됨
+  FragColor = vec4(result, 1.0);
+}
+
+/*
+  tent filter upsampling
+
+
+  가장 작은 mip 부터 시작해서,
+  작은 mip 을 tent filter 로 확대한 결과를 바로 위의 큰 mip 에 더해주는 과정을
+  가장 큰 mip 까지 반복하면,
+
+  각 mip level 에서 blur 된 결과가 모두 누적되면서
+  좁은 범위의 밝은 빛 번짐 + 넓은 범위의 부드러운 빛 번짐이 합쳐진
+  자연스러운 bloom 을 얻을 수 있음.
+
+  작은 mip 의 texel 1개는 화면상에서 넓은 영역을 덮으므로,
+  9번의 샘플링만으로도 화면 기준으로는 아주 넓은 반경의 blur 가 적용되는 것!
+*/
@@ -13,36 +13,27 @@ uniform sampler2D image;
 // blur 처리 방향 변수
 uniform bool horizontal;
 
-// 각 blur 방향으로 샘플링된 texel 에 적용할 가중치 kernel (= convolution matrix)
-uniform float weight[5] = float[](0.2270270270, 0.1945945946, 0.1216216216, 0.0540540541, 0.0162162162);
+/*
+  각 blur 방향으로 샘플링할 위치(texel 단위) 및 가중치 kernel (= convolution matrix)
+
+  KERNEL_TAP_COUNT, KERNEL_OFFSETS, KERNEL_WEIGHTS 는
+  bloom.cpp 에서 컴파일 타임에 계산한 가우시안 kernel 을 #define 문자열로 변환하여 삽입해 줌.
+  (인접한 두 texel 을 1번의 bilinear 샘플링으로 합친 offset 및 가중치임. linear_gaussian_kernel.h 하단 필기 참고)
+*/
+const float offsets[KERNEL_TAP_COUNT] = KERNEL_OFFSETS;
+const float weights[KERNEL_TAP_COUNT] = KERNEL_WEIGHTS;
 
 void main() {
-  // 각 blur 방향의 주변 texel 좌표 계산을 위해 더해줄 offset 값 -> 단일 texel 사이즈에 해당
+  // 단일 texel 사이즈
   vec2 tex_offset = 1.0 / textureSize(image, 0);
 
-  // 현재 texel 을 중심으로 가중치를 적용하여 누산할 변수 result 선언 및 초기화
-  // blur 를 적용할 현재 texel (= kernel 의 중점) 에 첫 번째 가중치를 곱하여 누산값 초기화 
-  vec3 result = texture(image, TexCoords).rgb * weight[0];
-
-  // 현재 texel 을 중심으로, blur 처리 방향(= horizontal)을 따라 4개(5개에서 현재 texel 1개 제외)의 주변 texel 을 샘플링하여 가중치 적용 및 누산
-  if(horizontal) {
-    // 수평 방향 blur 처리
-    for(int i = 1; i < 5; i++) {
-      // 현재 texel 의 오른쪽 방향 주변 texel 들에 대해 가중치 적용 및 누산
-      result += texture(image, TexCoords + vec2(tex_offset.x * i, 0.0)).rgb * weight[i];
-
-      // 현재 texel 의 왼쪽 방향 주변 texel 들에 대해 가중치 적용 및 누산
-      result += texture(image, TexCoords - vec2(tex_offset.x * i, 0.0)).rgb * weight[i];
-    }
-  } else {
-    // 수직 방향 blur 처리
-    for(int i = 1; i < 5; i++) {
-      // 현재 texel 의 위쪽 방향 주변 texel 들에 대해 가중치 적용 및 누산
-      result += texture(image, TexCoords + vec2(0.0, tex_offset.y * i)).rgb * weight[i];
-
-      // 현재 texel 의 아래쪽 방향 주변 texel 들에 대해 가중치 적용 및 누산
-      result += texture(image, TexCoords - vec2(0.0, tex_offset.y * i)).rgb * weight[i];
-    }
+  // blur 처리 방향(= horizontal)으로 1 texel 만큼 이동할 uv offset
+  vec2 direction = horizontal ? vec2(tex_offset.x, 0.0) : vec2(0.0, tex_offset.y);
+
+  // blur 처리 방향을 따라 kernel 의 각 tap 위치를 샘플링하여 가중치 적용 및 누산
+  vec3 result = vec3(0.0);
+  for(int i = 0; i < KERNEL_TAP_COUNT; i++) {
+    result += texture(image, TexCoords + direction * offsets[i]).rgb * weights[i];
   }
 
   // 누산된 최종 색상값을 출력 변수에 저장
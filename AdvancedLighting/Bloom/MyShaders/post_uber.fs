@@ -0,0 +1,122 @@
+#version 330 core
+
+/*
+  post_process_stack.h 에서 활성화된 단계에 따라
+  #version 바로 다음 줄에 아래 #define 들을 삽입해서 컴파일함. (하단 필기 참고)
+
+  POST_BLOOM : bloom 가산 혼합
+  POST_TONEMAP : exposure tone mapping
+  POST_COLOR_GRADING : contrast, saturation, color filter
+  POST_VIGNETTE : 화면 가장자리 어둡게 처리
+  POST_GAMMA : gamma correction
+  POST_GRAYSCALE : 흑백 변환
+  POST_INVERSION : 색상 반전
+*/
+
+out vec4 FragColor;
+
+// 버텍스 쉐이더에서 전송받은 텍스쳐 좌표 입력변수 선언
+in vec2 TexCoords;
+
+/* uniform 변수 선언 */
+
+// scene 텍스쳐 (HDR 범위로 원본 씬을 렌더링한 텍스쳐 객체)
+uniform sampler2D scene;
+
+#ifdef POST_BLOOM
+// blur 를 적용한 bloom 텍스쳐 및 가산 혼합할 세기
+uniform sampler2D bloomBlur;
+uniform float bloomStrength;
+#endif
+
+#ifdef POST_TONEMAP
+// tone mapping 에 사용할 노출값
+uniform float exposure;
+#endif
+
+#ifdef POST_COLOR_GRADING
+// 대비(contrast), 채도(saturation) 및 곱해줄 색상 필터
+uniform float contrast;
+uniform float saturation;
+uniform vec3 colorFilter;
+#endif
+
+#ifdef POST_VIGNETTE
+// 화면 중심으로부터 어두워지기 시작하는 거리 및 어두워지는 세기
+uniform float vignetteRadius;
+uniform float vignetteIntensity;
+#endif
+
+// 색상의 휘도(luminance)값 계산 (흑백 변환 및 채도 조절에 사용)
+float luminance(vec3 color) {
+  return dot(color, vec3(0.2126, 0.7152, 0.0722));
+}
+
+void main() {
+  vec3 color = texture(scene, TexCoords).rgb;
+
+#ifdef POST_BLOOM
+  // HDR 범위의 원본 씬에 bloom 색상을 가산 혼합
+  color += texture(bloomBlur, TexCoords).rgb * bloomStrength;
+#endif
+
+#ifdef POST_TONEMAP
+  // exposure tone mapping 으로 HDR -> LDR 변환
+  color = vec3(1.0) - exp(-color * exposure);
+#endif
+
+#ifdef POST_COLOR_GRADING
+  // 0.5 를 기준으로 대비 조절 -> 휘도값과 보간하여 채도 조절 -> 색상 필터 적용 (linear space 에서 처리)
+  color = clamp((color - 0.5) * contrast + 0.5, 0.0, 1.0);
+  color = mix(vec3(luminance(color)), color, saturation);
+  color *= colorFilter;
+#endif
+
+#ifdef POST_VIGNETTE
+  // 화면 중심으로부터의 거리가 vignetteRadius 를 넘어가면 점점 어둡게 처리
+  float dist = length(TexCoords - vec2(0.5));
+  color *= 1.0 - smoothstep(vignetteRadius, vignetteRadius + 0.5, dist) * vignetteIntensity;
+#endif
+
+#ifdef POST_GAMMA
+  // linear space 색 공간 유지를 위해 gamma correction 적용
+  const float gamma = 2.2;
+  color = pow(color, vec3(1.0 / gamma));
+#endif
+
+#ifdef POST_GRAYSCALE
+  // 흑백 변환 (AdvancedOpenGL/Framebuffers 의 framebuffers_screen_grayscale.fs 와 동일한 가중치)
+  color = vec3(0.2126 * color.r + 0.7152 * color.g + 0.0722 * color.b);
+#endif
+
+#ifdef POST_INVERSION
+  // 색상 반전 (AdvancedOpenGL/Framebuffers 의 framebuffers_screen_inversion.fs 와 동일)
+  color = vec3(1.0) - color;
+#endif
+
+  FragColor = vec4(color, 1.0);
+}
+
+/*
+  uber shader 로 후처리 단계 합치기
+
+
+  tone mapping, bloom 가산 혼합, gamma correction, 흑백 변환 등의 후처리를
+  각각 별도의 full-screen pass 로 처리하면,
+
+  pass 마다 이전 pass 의 결과 텍스쳐 전체를 읽고,
+  다시 새로운 텍스쳐 전체에 써야 하므로
+  단계가 늘어날수록 메모리 대역폭이 선형으로 늘어남.
+
+
+  그런데 이 단계들은 모두 'pixel 하나의 색상만 보고 pixel 하나의 색상을 계산'하는
+  per-pixel 연산이므로, 주변 pixel 을 샘플링하는 blur 같은 단계와 달리
+  하나의 fragment shader 안에서 순서대로 이어서 계산해도 결과가 똑같음.
+
+
+  그래서 모든 단계를 하나의 uber shader 에 #ifdef 로 작성해 두고,
+  활성화된 단계 조합마다 필요한 #define 만 삽입해서 컴파일하면,
+
+  사용하지 않는 단계의 분기나 uniform 이 아예 컴파일되지 않으면서도,
+  원본 씬을 1번 읽고 최종 결과를 1번 쓰는 단일 pass 로 모든 후처리를 끝낼 수 있음!
+*/
@@ -13,6 +13,12 @@
 
 #include "MyHeaders/shader_s.h"
 #include "MyHeaders/camera.h"
+#include "MyHeaders/gpu_timer.h"
+#include "MyHeaders/bloom_renderer.h"
+#include "MyHeaders/linear_gaussian_kernel.h"
+#include "MyHeaders/post_process_stack.h"
+#include "MyHeaders/render_target_pool.h"
+#include "MyHeaders/render_target_registry.h"
 
 #include <iostream>
 
@@ -46,6 +52,10 @@ void renderQuad();
 const unsigned int SCR_WIDTH = 800; // 윈도우 창 너비
 const unsigned int SCR_HEIGHT = 600; // 윈도우 창 높이
 
+// 윈도우 framebuffer 크기(출력 해상도)를 추적할 registry 생성 (render_target_registry.h 필기 참고)
+// -> pool 에 요청하는 render target 들과 bloom mip chain 은 크기 변경이 멈춘 뒤 갱신된 이 크기를 사용함
+RenderTargetRegistry outputTargets(SCR_WIDTH, SCR_HEIGHT);
+
 // bloom 활성화 상태값 초기화
 bool bloom = true;
 bool bloomKeyPressed = false;
@@ -53,6 +63,32 @@ bool bloomKeyPressed = false;
 // tone mapping 알고리즘에 사용할 노출값 초기화
 float exposure = 1.0f;
 
+// mip chain bloom 활성화 상태값 초기화 (false 면 기존 ping-pong Gaussian blur 사용)
+bool mipChainBloom = true;
+bool mipChainKeyPressed = false;
+
+// mip chain bloom 에 사용할 밝기 threshold 및 knee 초기화
+float bloomThreshold = 1.0f;
+float bloomKnee = 0.5f;
+
+// ping-pong Gaussian blur 에 사용할 반경 4 (9-tap) 가우시안 kernel 을 컴파일 타임에 계산
+// (기존 blur.fs 에 하드코딩되어 있던 가중치와 비슷한 분포가 되도록 표준편차를 1.75 로 지정)
+constexpr LinearGaussianKernel blurKernel = makeLinearGaussianKernel(1.75f, 4);
+
+// 후처리 단계들을 uber shader 하나로 합친 단일 pass 사용 여부 초기화 (false 면 기존 bloom_final.fs 사용)
+bool fusedPost = true;
+bool fusedPostKeyPressed = false;
+
+// uber shader 에서 추가로 적용할 후처리 단계들의 활성화 상태값 초기화
+bool colorGrading = false;
+bool colorGradingKeyPressed = false;
+bool vignette = false;
+bool vignetteKeyPressed = false;
+bool grayscale = false;
+bool grayscaleKeyPressed = false;
+bool inversion = false;
+bool inversionKeyPressed = false;
+
 // 카메라 클래스 생성 (카메라 위치값만 매개변수로 전달함.)
 Camera camera(glm::vec3(0.0f, 0.0f, 5.0f));
 
@@ -141,120 +177,48 @@ int main()
 	// 광원 큐브에 적용할 쉐이더 객체 생성
 	Shader shaderLight("MyShaders/bloom.vs", "MyShaders/light_box.fs");
 
-	// Gaussian blur 를 QuadMesh 에 적용할 쉐이더 객체 생성
-	Shader shaderBlur("MyShaders/blur.vs", "MyShaders/blur.fs");
+	// Gaussian blur 를 QuadMesh 에 적용할 쉐이더 객체 생성 (컴파일 타임에 계산한 kernel 을 #define 문자열로 삽입)
+	Shader shaderBlur("MyShaders/blur.vs", "MyShaders/blur.fs", linearGaussianDefines(blurKernel));
+
+	// 한 방향 blur 에 사용되는 texel 개수 및 실제 샘플링 횟수 콘솔 출력
+	std::cout << "blur kernel | radius: " << blurKernel.radius << " | sigma: " << blurKernel.sigma
+		<< " | taps: " << 2 * blurKernel.radius + 1 << " | texture fetches: " << blurKernel.tapCount << std::endl;
 
 	// 최종 후처리로 gamma correction 및 tone mapping 을 적용할 쉐이더 객체 생성
 	Shader shaderBloomFinal("MyShaders/bloom_final.vs", "MyShaders/bloom_final.fs");
 
+	// bloom 가산 혼합, tone mapping, gamma correction 등을 단일 pass 로 처리할 후처리 스택 생성
+	PostProcessStack postStack;
 
-	/* HDR 효과를 적용할 프레임버퍼(Floating point framebuffer) 생성 및 설정 */
-	/* 또한, 이 프레임버퍼는 Multiple Render Target(MRT) 로 설정. */
-
-	// FBO(FrameBufferObject) 객체 생성 및 바인딩
-	unsigned int hdrFBO;
-	glGenFramebuffers(1, &hdrFBO);
-	glBindFramebuffer(GL_FRAMEBUFFER, hdrFBO);
-
-	// FBO 객체에 attach 할 텍스쳐 객체 생성
-	unsigned int colorBuffers[2];
-	glGenTextures(2, colorBuffers);
-
-	// MRT 프레임버퍼 생성을 위해, 2개의 텍스쳐 객체(= 색상 버퍼) 생성 및 바인딩 (하단 필기 참고)
-	for (unsigned int i = 0; i < 2; i++)
-	{
-		glBindTexture(GL_TEXTURE_2D, colorBuffers[i]);
-
-		// 텍스쳐 객체 메모리 공간 할당 (loadTexture() 와 달리 할당된 메모리에 이미지 데이터를 덮어쓰지 않음! -> 대신 FBO 에서 렌더링된 데이터를 덮어쓸 거니까!)
-		// 텍스쳐 객체의 해상도는 스크린 해상도와 일치시킴 -> 왜냐? 이 텍스쳐는 '스크린 평면'에 적용할 거니까!
-		// 또한, 현재 프레임버퍼를 Floating point framebuffer (부동소수점 지원 프레임버퍼)로 만들기 위해 색상 버퍼 내부 포맷을 GL_RGBA16F 로 지정 (하단 필기 참고)
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_FLOAT, NULL);
-
-		// Texture Filtering(텍셀 필터링(보간)) 모드 설정
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// Texture Wrapping 모드 설정
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-		// FBO 객체에 생성한 텍스쳐 객체 attach (자세한 매개변수 설명은 LearnOpenGL 본문 참고!)
-		// floating point framebuffer 에 렌더링 시, 텍스쳐 객체에는 최종 color buffer 만 저장하면 되므로, color attachment 만 적용함!
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, colorBuffers[i], 0);
-	}
-
-	// FBO 객체에 attach 할 RBO(RenderBufferObject) 객체 생성 및 바인딩
-	unsigned int rboDepth;
-	glGenRenderbuffers(1, &rboDepth);
-	glBindRenderbuffer(GL_RENDERBUFFER, rboDepth);
-
-	// RBO 객체 메모리 공간 할당
-	// 단일 Renderbuffer 에 depth 값만 저장하는 데이터 포맷 지정 -> GL_DEPTH_COMPONENT 
-	// 또한, 텍스쳐 객체와 마찬가지로 스크린 해상도와 Renderbuffer 해상도를 일치시킴 -> 그래야 SCR_WIDTH * SCR_HEIGHT 개수 만큼의 데이터 저장 공간 확보 가능!
-	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT, SCR_WIDTH, SCR_HEIGHT);
-
-	// 생성했던 FBO 객체 바인딩
-	glBindFramebuffer(GL_FRAMEBUFFER, hdrFBO);
-
-	// FBO 객체에 생성한 RBO 객체 attach (자세한 매개변수 설명은 LearnOpenGL 본문 참고!)
-	// off-screen framebuffer 에 렌더링 시, RBO 객체에는 depth 값만 저장할 것이므로, GL_DEPTH_STENCIL_ATTACHMENT 를 적용함!
-	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rboDepth);
-
-	// MRT 프레임버퍼 사용을 위해, OpenGL 에게 하나의 프레임버퍼가 2개의 color attachment 에 각각 렌더링할 수 있도록 명시함
-	unsigned int attachments[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
-	glDrawBuffers(2, attachments);
-
-	// 현재 GL_FRAMEBUFFER 상태에 바인딩된 FBO 객체 설정 완료 여부 검사 (설정 완료 조건은 LearnOpenGL 본문 참고)
-	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-	{
-		// FBO 객체가 제대로 설정되지 않았을 시 에러 메시지 출력
-		std::cout << "Framebuffer is not complete!" << std::endl;
-	}
-
-	// 생성한 FBO 객체 설정 완료 후, 다시 default framebuffer 바인딩하여 원상복구 (참고로, default framebuffer 의 참조 id 가 0임!)
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	// high-DPI 모니터에서는 framebuffer 크기가 윈도우 크기(SCR_WIDTH * SCR_HEIGHT)와 다를 수 있으므로,
+	// render target 들을 생성하기 전에 실제 framebuffer 크기로 출력 해상도를 맞춰줌
+	int framebufferWidth, framebufferHeight;
+	glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+	outputTargets.resize(framebufferWidth, framebufferHeight);
 
+	// 스크린 해상도의 절반부터 6단계로 축소되는 mip chain bloom 렌더러 생성
+	BloomRenderer bloomRenderer(outputTargets.width(), outputTargets.height(), 6);
 
-	/* two-pass Gaussian blur 를 구현하기 위한 ping-pong 프레임버퍼 생성 및 설정 (하단 필기 참고) */
-
-	// 2개의 FBO(FrameBufferObject)와 각 FBO 객체에 attach 할 2개의 텍스쳐 객체 생성
-	unsigned int pingpongFBO[2];
-	unsigned int pingpongColorBuffers[2];
-	glGenFramebuffers(2, pingpongFBO);
-	glGenTextures(2, pingpongColorBuffers);
-
-	// 각 ping-pong 프레임버퍼 설정 및 텍스쳐 객체(= 색상 버퍼) 바인딩
-	for (unsigned int i = 0; i < 2; i++)
-	{
-		// ping-pong 프레임버퍼 바인딩
-		glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[i]);
-
-		// attach 할 텍스쳐 객체 바인딩
-		glBindTexture(GL_TEXTURE_2D, pingpongColorBuffers[i]);
+	/*
+		각 bloom 방식이 GPU 에서 실행되는 데 걸린 시간을 측정할 타이머 생성
+		(현재 선택된 방식만 실행되므로, 다른 방식의 타이머에는 마지막으로 측정된 값이 남아 있음)
+	*/
+	GpuTimer pingpongTimer;
+	GpuTimer mipChainTimer;
 
-		// 텍스쳐 객체 메모리 공간 할당 (loadTexture() 와 달리 할당된 메모리에 이미지 데이터를 덮어쓰지 않음! -> 대신 FBO 에서 렌더링된 데이터를 덮어쓸 거니까!)
-		// 또한, 현재 프레임버퍼를 Floating point framebuffer (부동소수점 지원 프레임버퍼)로 만들기 위해 색상 버퍼 내부 포맷을 GL_RGBA16F 로 지정 (하단 필기 참고)
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_FLOAT, NULL);
 
-		// Texture Filtering(텍셀 필터링(보간)) 모드 설정
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	/*
+		HDR 씬을 렌더링할 MRT 텍스쳐들과 ping-pong blur 텍스쳐들을 관리할 render target pool 생성 (render_target_pool.h 필기 참고)
 
-		// Texture Wrapping 모드 설정
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		이전에는 HDR 프레임버퍼(색상 버퍼 2장 + depth renderbuffer)와 ping-pong 프레임버퍼(색상 버퍼 2장)를 고정으로 할당했지만,
+		이제는 매 프레임 pool 에 요청해서 사용하고 다 쓰면 바로 반납하므로,
 
-		// FBO 객체에 생성한 텍스쳐 객체 attach (자세한 매개변수 설명은 LearnOpenGL 본문 참고!)
-		// floating point framebuffer 에 렌더링 시, 텍스쳐 객체에는 최종 color buffer 만 저장하면 되므로, color attachment 만 적용함!
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, pingpongColorBuffers[i], 0);
+		- 광원 큐브만 추출한 색상 버퍼(brightBuffer)는 첫 번째 blur 에서 읽고 나면 ping-pong 텍스쳐로 재사용되고,
+		- mip chain bloom 모드에서는 사용하지 않는 brightBuffer 와 ping-pong 텍스쳐들이 자동으로 해제됨.
 
-		// 현재 GL_FRAMEBUFFER 상태에 바인딩된 FBO 객체 설정 완료 여부 검사 (설정 완료 조건은 LearnOpenGL 본문 참고)
-		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-		{
-			// FBO 객체가 제대로 설정되지 않았을 시 에러 메시지 출력
-			std::cout << "Framebuffer is not complete!" << std::endl;
-		}
-	}
+		(mip chain bloom 의 mip 텍스쳐들은 BloomRenderer 가 직접 관리하므로 pool 에 넣지 않음)
+	*/
+	RenderTargetPool targetPool;
 
 
 	/* 텍스쳐 객체 생성 및 쉐이더 프로그램 전송 */
@@ -321,16 +285,49 @@ int main()
 		/* 여기서부터 루프에서 실행시킬 모든 렌더링 명령(rendering commands)을 작성함. */
 
 
+		/* 출력 해상도 결정 */
+
+		// 윈도우 크기 변경이 멈춘 뒤 일정 시간이 지났다면, 출력 해상도 및 bloom mip chain 을 새로운 framebuffer 크기로 갱신
+		// (pool 의 render target 들은 새로운 크기로 요청되고, 이전 크기의 텍스쳐들은 몇 프레임 뒤 endFrame() 에서 해제됨)
+		if (outputTargets.update(glfwGetTime()))
+		{
+			bloomRenderer.resize(outputTargets.width(), outputTargets.height());
+			std::cout << "output resolution changed to " << outputTargets.width() << "x" << outputTargets.height() << std::endl;
+		}
+		unsigned int outputWidth = outputTargets.width();
+		unsigned int outputHeight = outputTargets.height();
+
+		// 각 bloom 방식이 한 프레임 동안 읽고 쓰는 텍스쳐 메모리 양(MB) 추정
+		// ping-pong blur 는 매 pass 마다 GL_RGBA16F(texel 당 8 byte) full-res 텍스쳐를 1번 읽고 1번 씀
+		double fullResBytes = (double)outputWidth * outputHeight * 8.0;
+		double pingpongMB = fullResBytes * 2.0 * 10.0 / (1024.0 * 1024.0);
+		double mipChainMB = bloomRenderer.bytesPerFrame(fullResBytes) / (1024.0 * 1024.0);
+
+		// pool 도입 이전처럼 HDR 프레임버퍼와 ping-pong 프레임버퍼를 고정 할당했을 때의 메모리 양 (GL_RGBA16F 4장 + depth renderbuffer)
+		double fixedTargetBytes = 4.0 * RenderTargetPool::textureBytes(outputWidth, outputHeight, GL_RGBA16F)
+			+ RenderTargetPool::textureBytes(outputWidth, outputHeight, GL_DEPTH_COMPONENT24);
+
+
 		/* First Pass (Floating point framebuffer(또한, MRT 프레임버퍼) 에 HDR 효과를 적용할 씬 렌더링) */
 
-		// MRT framebuffer 바인딩
-		glBindFramebuffer(GL_FRAMEBUFFER, hdrFBO);
+		// HDR 씬과 광원 큐브만 추출한 색상을 렌더링할 GL_RGBA16F 텍스쳐 및 깊이 텍스쳐를 pool 에 요청하여 MRT 로 바인딩
+		// mip chain bloom 모드에서는 원본 씬에서 직접 밝은 영역을 걸러내므로 brightBuffer 를 요청하지 않음
+		// (attach 되지 않은 1번 출력 변수(BrightColor)의 결과는 그냥 버려짐)
+		unsigned int sceneBuffer = targetPool.acquire(outputWidth, outputHeight, GL_RGBA16F, 0, GL_LINEAR);
+		unsigned int brightBuffer = mipChainBloom ? 0 : targetPool.acquire(outputWidth, outputHeight, GL_RGBA16F, 0, GL_LINEAR);
+		unsigned int depthBuffer = targetPool.acquire(outputWidth, outputHeight, GL_DEPTH_COMPONENT24);
+		// (color 포맷 텍스쳐는 배열 순서대로 color attachment 0, 1 에, 깊이 텍스쳐는 depth attachment 에 attach 됨)
+		unsigned int hdrTargets[3] = { sceneBuffer, depthBuffer, brightBuffer };
+		targetPool.bindTargets(hdrTargets, mipChainBloom ? 2 : 3);
+
+		// pool 의 render target 들은 출력 해상도로 요청했으므로, 뷰포트도 출력 해상도에 맞춤
+		glViewport(0, 0, outputWidth, outputHeight);
 
 		// 현재 바인딩된 framebuffer 의 색상 및 깊이 버퍼 초기화
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		// 카메라의 zoom 값으로부터 투영 행렬 계산
-		glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+		glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)outputWidth / (float)outputHeight, 0.1f, 100.0f);
 
 		// 카메라 클래스로부터 뷰 행렬(= LookAt 행렬) 가져오기
 		glm::mat4 view = camera.GetViewMatrix();
@@ -446,83 +443,214 @@ int main()
 		// default framebuffer 로 바인딩 복구
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
+		/*
+			깊이 텍스쳐는 위의 씬 및 광원 큐브 그리기 명령이 마지막 사용이므로, First Pass 가 끝난 이 시점에 반납
+			-> 반납한 뒤에 acquire() 로 요청한 같은 포맷의 target 은 이 텍스쳐를 재사용(aliasing)할 수 있으므로,
+			   release() 는 반드시 해당 target 을 읽거나 쓰는 마지막 그리기 명령 뒤에 호출해야 함!
+		*/
+		targetPool.release(depthBuffer);
+
 
-		/* Second Pass (ping-pong 프레임버퍼를 사용하여 two-pass Gaussian blur 구현) */
-		
-		// 샘플링 방향(수평 or 수직) 상태값 초기화
-		bool horizontal = true;
+		/* Second Pass (mip chain bloom 또는 ping-pong 프레임버퍼를 사용한 two-pass Gaussian blur 로 bloom 텍스쳐 계산) */
 
-		// 총 10번의 샘플링 중, 최초 샘플링 여부를 캐싱하는 상태값 초기화
-		bool first_iteration = true;
+		// Third Pass 에서 씬에 가산 혼합할 bloom 텍스쳐
+		unsigned int bloomTexture = 0;
 
-		// 총 샘플링 횟수 상태값 초기화
-		unsigned int amount = 10;
+		if (mipChainBloom)
+		{
+			/*
+				mip chain bloom
 
-		// two-pass Gaussian blur 쉐이더 바인딩
-		shaderBlur.use();
+				HDR 씬 전체(sceneBuffer)를 threshold, knee 로 걸러내면서 축소한 뒤 다시 확대하여 누적
+				(MRT 로 걸러낸 brightBuffer 대신 원본 씬을 사용하므로, 밝기 threshold 를 런타임에 조절할 수 있음)
+			*/
+			mipChainTimer.begin();
+			bloomRenderer.render(sceneBuffer, bloomThreshold, bloomKnee, 1.0f);
+			mipChainTimer.end();
 
-		// 수평 <-> 수직 방향을 번걸아가며 각각 5번씩, 총 10번 Gaussian blur 샘플링 수행
-		for (unsigned int i = 0; i < amount; i++)
+			bloomTexture = bloomRenderer.bloomTexture();
+		}
+		else
 		{
-			// horizontal 변수의 암시적 형변환에 의해 ping-pong 프레임버퍼 바인딩 (하단 필기 참고)
-			glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[horizontal]);
+			// 샘플링 방향(수평 or 수직) 상태값 초기화
+			bool horizontal = true;
 
-			// two-pass Gaussian blur 쉐이더 프로그램에 blur 처리 방향값 전달
-			shaderBlur.setInt("horizontal", horizontal);
+			// 총 10번의 샘플링 중, 최초 샘플링 여부를 캐싱하는 상태값 초기화
+			bool first_iteration = true;
 
-			// blur 처리를 적용할 텍스쳐 객체(= color attachment)를 찾아 바인딩
-			// 최초 샘플링은 광원 큐브만 추출하여 저장된 텍스쳐 객체(= color attachment) 인 colorBuffers[1] 로부터 가져옴
-			glBindTexture(GL_TEXTURE_2D, first_iteration ? colorBuffers[1] : pingpongColorBuffers[!horizontal]);
+			// 총 샘플링 횟수 상태값 초기화
+			unsigned int amount = 10;
 
-			// 현재 바인딩된 ping-pong 프레임버퍼에 blur 처리 결과를 시각화할 QuadMesh 렌더링
-			renderQuad();
+			// ping-pong 텍스쳐들은 처음 렌더링할 때 pool 에 요청함
+			unsigned int pingpongColorBuffers[2] = { 0, 0 };
 
-			// 다음 순회에서 적용할 horizontal 방향 변경
-			horizontal = !horizontal;
+			// ping-pong Gaussian blur 의 GPU 소요 시간 측정 시작
+			pingpongTimer.begin();
 
-			// 만약 최초 샘플링이 끝났다면, 최초 샘플링 여부를 false 로 변경
-			if (first_iteration)
+			// two-pass Gaussian blur 쉐이더 바인딩
+			shaderBlur.use();
+
+			// 수평 <-> 수직 방향을 번걸아가며 각각 5번씩, 총 10번 Gaussian blur 샘플링 수행
+			for (unsigned int i = 0; i < amount; i++)
 			{
-				first_iteration = false;
+				// horizontal 변수의 암시적 형변환에 의해 ping-pong 텍스쳐 바인딩 (하단 필기 참고)
+				if (pingpongColorBuffers[horizontal] == 0)
+				{
+					pingpongColorBuffers[horizontal] = targetPool.acquire(outputWidth, outputHeight, GL_RGBA16F, 0, GL_LINEAR);
+				}
+				targetPool.bindTarget(pingpongColorBuffers[horizontal]);
+
+				// two-pass Gaussian blur 쉐이더 프로그램에 blur 처리 방향값 전달
+				shaderBlur.setInt("horizontal", horizontal);
+
+				// blur 처리를 적용할 텍스쳐 객체(= color attachment)를 찾아 바인딩
+				// 최초 샘플링은 광원 큐브만 추출하여 저장된 텍스쳐 객체(= color attachment) 인 brightBuffer 로부터 가져옴
+				glBindTexture(GL_TEXTURE_2D, first_iteration ? brightBuffer : pingpongColorBuffers[!horizontal]);
+
+				// 현재 바인딩된 ping-pong 프레임버퍼에 blur 처리 결과를 시각화할 QuadMesh 렌더링
+				renderQuad();
+
+				// 다음 순회에서 적용할 horizontal 방향 변경
+				horizontal = !horizontal;
+
+				// 만약 최초 샘플링이 끝났다면, 최초 샘플링 여부를 false 로 변경
+				// 또한, brightBuffer 는 더 이상 읽지 않으므로 반납 -> 바로 다음 순회에서 요청하는 ping-pong 텍스쳐로 재사용됨
+				if (first_iteration)
+				{
+					first_iteration = false;
+					targetPool.release(brightBuffer);
+				}
 			}
-		}
 
-		// default framebuffer 로 바인딩 복구
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			// default framebuffer 로 바인딩 복구
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+			pingpongTimer.end();
+
+			bloomTexture = pingpongColorBuffers[!horizontal];
+
+			// 마지막 blur 결과(bloomTexture)는 Third Pass 에서 읽어야 하므로, 나머지 ping-pong 텍스쳐만 먼저 반납
+			targetPool.release(pingpongColorBuffers[horizontal]);
+		}
 
 
 		/* Third Pass (HDR 톤매핑 및 bloom 효과를 QuadMesh 에 시각화) */
 
+		// 뷰포트를 현재 윈도우 framebuffer 크기로 복구 (출력 해상도 갱신 대기 중에는 이전 크기의 결과를 늘려서 출력함)
+		glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+		glViewport(0, 0, framebufferWidth, framebufferHeight);
+
 		// 현재 바인딩된 default framebuffer 의 깊이 버퍼 및 색상 버퍼 초기화
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-		// QuadMesh 렌더링에 사용할 쉐이더 객체 바인딩
-		shaderBloomFinal.use();
+		// 현재 활성화된 후처리 단계 조합 (tone mapping 및 gamma correction 은 항상 적용)
+		unsigned int postStages = POST_TONEMAP | POST_GAMMA;
+		if (bloom)
+		{
+			postStages |= POST_BLOOM;
+		}
+		if (colorGrading)
+		{
+			postStages |= POST_COLOR_GRADING;
+		}
+		if (vignette)
+		{
+			postStages |= POST_VIGNETTE;
+		}
+		if (grayscale)
+		{
+			postStages |= POST_GRAYSCALE;
+		}
+		if (inversion)
+		{
+			postStages |= POST_INVERSION;
+		}
 
-		// HDR 범위로 원본 씬을 렌더링한 텍스쳐 객체를 바인딩할 0번 texture unit 활성화
-		glActiveTexture(GL_TEXTURE0);
+		// 현재 선택된 bloom 방식의 결과 텍스쳐 크기 (mip chain 은 스크린 절반 해상도의 GL_R11F_G11F_B10F, ping-pong 은 full-res GL_RGBA16F)
+		double bloomBytes = mipChainBloom ? (double)(outputWidth / 2) * (outputHeight / 2) * 4.0 : fullResBytes;
+
+		// 단계마다 별도의 pass 로 처리했을 때와 단일 pass 로 처리했을 때 읽고 쓰는 텍스쳐 메모리 양(MB) 추정
+		double unfusedPostMB = PostProcessStack::bytesPerFrame(postStages, false, outputWidth, outputHeight, fullResBytes, bloomBytes) / (1024.0 * 1024.0);
+		double fusedPostMB = PostProcessStack::bytesPerFrame(postStages, true, outputWidth, outputHeight, fullResBytes, bloomBytes) / (1024.0 * 1024.0);
 
-		// HDR 범위로 원본 씬을 렌더링한 텍스쳐 객체 바인딩
-		glBindTexture(GL_TEXTURE_2D, colorBuffers[0]);
+		if (fusedPost)
+		{
+			// 각 후처리 단계에 사용할 파라미터
+			PostProcessSettings postSettings;
+			postSettings.bloomStrength = mipChainBloom ? 1.0f / bloomRenderer.mipCount() : 1.0f;
+			postSettings.exposure = exposure;
+			postSettings.contrast = 1.1f;
+			postSettings.saturation = 1.2f;
+			postSettings.colorFilter = glm::vec3(1.0f, 0.95f, 0.85f);
+			postSettings.vignetteRadius = 0.3f;
+			postSettings.vignetteIntensity = 0.8f;
+
+			// 활성화된 단계 조합에 해당하는 uber shader 로 단일 full-screen pass 렌더링
+			postStack.render(postStages, sceneBuffer, bloomTexture, postSettings);
+		}
+		else
+		{
+			// QuadMesh 렌더링에 사용할 쉐이더 객체 바인딩
+			shaderBloomFinal.use();
 
-		// two-pass Gaussian blur 를 적용한 텍스쳐 객체를 바인딩할 1번 texture unit 활성화
-		glActiveTexture(GL_TEXTURE1);
+			// HDR 범위로 원본 씬을 렌더링한 텍스쳐 객체를 바인딩할 0번 texture unit 활성화
+			glActiveTexture(GL_TEXTURE0);
 
-		// two-pass Gaussian blur 를 적용한 텍스쳐 객체 바인딩
-		glBindTexture(GL_TEXTURE_2D, pingpongColorBuffers[!horizontal]);
+			// HDR 범위로 원본 씬을 렌더링한 텍스쳐 객체 바인딩
+			glBindTexture(GL_TEXTURE_2D, sceneBuffer);
 
-		// bloom 효과 활성화 상태값 전송
-		shaderBloomFinal.setBool("bloom", bloom);
+			// bloom 텍스쳐 객체를 바인딩할 1번 texture unit 활성화
+			glActiveTexture(GL_TEXTURE1);
 
-		// tone mapping 알고리즘에 사용할 노출값 전송
-		shaderBloomFinal.setFloat("exposure", exposure);
-		
-		// QuadMesh 렌더링
-		renderQuad();
+			// 현재 선택된 방식으로 blur 를 적용한 bloom 텍스쳐 객체 바인딩
+			glBindTexture(GL_TEXTURE_2D, bloomTexture);
 
+			// mip chain bloom 은 모든 mip level 의 blur 결과가 누적되어 있으므로, mip 개수로 나눠서 ping-pong blur 와 밝기를 맞춤
+			shaderBloomFinal.setFloat("bloomStrength", mipChainBloom ? 1.0f / bloomRenderer.mipCount() : 1.0f);
+
+			// bloom 효과 활성화 상태값 전송
+			shaderBloomFinal.setBool("bloom", bloom);
+
+			// tone mapping 알고리즘에 사용할 노출값 전송
+			shaderBloomFinal.setFloat("exposure", exposure);
+
+			// QuadMesh 렌더링
+			renderQuad();
+		}
+
+		// 씬 텍스쳐와 ping-pong blur 결과 텍스쳐 반납 (mip chain bloom 결과는 BloomRenderer 가 관리하므로 반납하지 않음)
+		targetPool.release(sceneBuffer);
+		if (!mipChainBloom)
+		{
+			targetPool.release(bloomTexture);
+		}
 
-		// bloom 활성화 여부 및 노출값 콘솔 출력
-		std::cout << "bloom: " << (bloom ? "on" : "off") << "| exposure: " << exposure << std::endl;
+
+		// bloom 활성화 여부, bloom 방식, 각 방식의 GPU 소요 시간 및 메모리 대역폭 추정치, 노출값 콘솔 출력
+		std::cout << "bloom: " << (bloom ? "on" : "off")
+			<< " | mode: " << (mipChainBloom ? "mip-chain" : "ping-pong")
+			<< " | threshold: " << bloomThreshold << " | knee: " << bloomKnee
+			<< " | ping-pong: " << pingpongTimer.elapsedMs() << " ms, " << pingpongMB << " MB"
+			<< " | mip-chain: " << mipChainTimer.elapsedMs() << " ms, " << mipChainMB << " MB"
+			<< " | exposure: " << exposure << std::endl;
+
+		// 후처리 방식, 활성화된 단계 개수, 단일 pass / 단계별 pass 로 처리할 때의 pass 개수 및 텍스쳐 메모리 양, 캐싱된 uber shader 개수 콘솔 출력
+		// (bloom_final.fs 는 bloom, tone mapping, gamma correction 만 처리하므로 나머지 단계는 무시됨)
+		std::cout << "post: " << (fusedPost ? "uber-pass" : "bloom_final")
+			<< " | stages: " << PostProcessStack::unfusedPassCount(postStages)
+			<< " | fused: 1 pass, " << fusedPostMB << " MB"
+			<< " | unfused: " << PostProcessStack::unfusedPassCount(postStages) << " passes, " << unfusedPostMB << " MB"
+			<< " | cached permutations: " << postStack.cachedPermutationCount() << std::endl;
+
+		// 렌더 타겟 메모리 사용량 콘솔 출력
+		// fixed: pool 도입 이전의 고정 할당량, no-alias: 요청마다 텍스쳐를 따로 만들었을 때의 최대 메모리 양, pooled: 실제로 pool 이 할당한 최대 메모리 양
+		std::cout << "render targets peak VRAM | fixed: " << fixedTargetBytes / (1024.0 * 1024.0) << " MB"
+			<< " | no-alias: " << targetPool.peakRequestedBytes() / (1024.0 * 1024.0) << " MB"
+			<< " | pooled: " << targetPool.peakAllocatedBytes() / (1024.0 * 1024.0) << " MB"
+			<< " (now " << targetPool.allocatedBytes() / (1024.0 * 1024.0) << " MB, " << targetPool.textureCount() << " textures)" << std::endl;
+
+		// 반납되지 않은 텍스쳐 검사 및 오랫동안 요청되지 않은 텍스쳐 해제
+		targetPool.endFrame();
 
 
 		// Double Buffer 상에서 Back Buffer 에 픽셀들이 모두 그려지면, Front Buffer 와 교체(swap)해버림.
@@ -735,6 +863,9 @@ void renderQuad()
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
 	glViewport(0, 0, width, height); // GLFWwindow 상에 렌더링될 뷰포트 영역을 정의. (뷰포트 영역의 좌상단 좌표, 뷰포트 영역의 너비와 높이)
+
+	// 출력 해상도는 곧바로 바꾸지 않고, 크기 변경이 멈춘 뒤 렌더링 루프에서 한 번만 갱신
+	outputTargets.requestResize(width, height, glfwGetTime());
 }
 
 // GLFW 윈도우에 마우스 입력 감지 시, 호출할 콜백함수 정의
@@ -834,6 +965,98 @@ void processInput(GLFWwindow* window)
 	{
 		exposure += 0.001f;
 	}
+
+	// M 키 입력 시, mip chain bloom <-> ping-pong Gaussian blur 전환
+	if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS && !mipChainKeyPressed)
+	{
+		mipChainBloom = !mipChainBloom;
+		mipChainKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_M) == GLFW_RELEASE)
+	{
+		mipChainKeyPressed = false;
+	}
+
+	// F 키 입력 시, uber shader 단일 pass <-> 기존 bloom_final.fs 전환
+	if (glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS && !fusedPostKeyPressed)
+	{
+		fusedPost = !fusedPost;
+		fusedPostKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_F) == GLFW_RELEASE)
+	{
+		fusedPostKeyPressed = false;
+	}
+
+	// G 키 입력 시, color grading 단계 활성화 상태값 변경
+	if (glfwGetKey(window, GLFW_KEY_G) == GLFW_PRESS && !colorGradingKeyPressed)
+	{
+		colorGrading = !colorGrading;
+		colorGradingKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_G) == GLFW_RELEASE)
+	{
+		colorGradingKeyPressed = false;
+	}
+
+	// N 키 입력 시, vignette 단계 활성화 상태값 변경
+	if (glfwGetKey(window, GLFW_KEY_N) == GLFW_PRESS && !vignetteKeyPressed)
+	{
+		vignette = !vignette;
+		vignetteKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_N) == GLFW_RELEASE)
+	{
+		vignetteKeyPressed = false;
+	}
+
+	// K 키 입력 시, 흑백 변환 단계 활성화 상태값 변경
+	if (glfwGetKey(window, GLFW_KEY_K) == GLFW_PRESS && !grayscaleKeyPressed)
+	{
+		grayscale = !grayscale;
+		grayscaleKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_K) == GLFW_RELEASE)
+	{
+		grayscaleKeyPressed = false;
+	}
+
+	// I 키 입력 시, 색상 반전 단계 활성화 상태값 변경
+	if (glfwGetKey(window, GLFW_KEY_I) == GLFW_PRESS && !inversionKeyPressed)
+	{
+		inversion = !inversion;
+		inversionKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_I) == GLFW_RELEASE)
+	{
+		inversionKeyPressed = false;
+	}
+
+	/*
+		Z 키 입력 시, threshold 감소시키고,
+		X 키 입력 시, threshold 증가시킴.
+	*/
+	if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_PRESS)
+	{
+		bloomThreshold = std::max(bloomThreshold - 0.001f, 0.0f);
+	}
+	else if (glfwGetKey(window, GLFW_KEY_X) == GLFW_PRESS)
+	{
+		bloomThreshold += 0.001f;
+	}
+
+	/*
+		C 키 입력 시, knee 감소시키고,
+		V 키 입력 시, knee 증가시킴.
+	*/
+	if (glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS)
+	{
+		bloomKnee = std::max(bloomKnee - 0.001f, 0.0f);
+	}
+	else if (glfwGetKey(window, GLFW_KEY_V) == GLFW_PRESS)
+	{
+		bloomKnee += 0.001f;
+	}
 }
 
 // 텍스쳐 이미지 로드 및 객체 생성 함수 구현부 (텍스쳐 객체 참조 id 반환)
@@ -0,0 +1,241 @@
+#ifndef HIZ_BUILDER_H
+#define HIZ_BUILDER_H
+/*
+	hiz_builder.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > 텍스쳐 및 프레임버퍼 관련 OpenGL 함수가 필요하니까!
+
+#include <vector> // mip level 별 해상도 및 타이머를 동적 배열로 보관하기 위해 include
+
+#include "shader_s.h" // 깊이 버퍼를 변환 및 축소할 쉐이더 객체를 생성하기 위해 include
+#include "gpu_timer.h" // mip level 별 GPU 소요 시간을 측정하기 위해 include
+
+/*
+	HiZBuilder 클래스
+
+	G-buffer 의 깊이 버퍼를 linear depth 로 변환한 뒤,
+	각 texel 이 덮는 영역의 최소(min) / 최대(max) 깊이값을 저장하는
+	hierarchical depth(Hi-Z) mip chain 을 생성하는 클래스! (하단 필기 참고)
+
+	OpenGL 3.3 에는 compute shader 가 없으므로,
+	mip level 마다 fragment shader 로 full-screen pass 를 1번씩 실행하여 축소함.
+
+	생성된 mip chain 텍스쳐는 GL_RG32F 포맷으로,
+	r 성분에는 최소 깊이값(카메라에서 가장 가까운 깊이), g 성분에는 최대 깊이값을 저장함.
+	(깊이값은 카메라로부터의 view space 거리(양수)로 저장됨)
+
+	쉐이더 파일은 MyShaders/hiz.vs, MyShaders/hiz_init.fs, MyShaders/hiz_reduce.fs 를 사용함.
+*/
+class HiZBuilder
+{
+public:
+	unsigned int ID; // Hi-Z mip chain 텍스쳐 객체의 참조 id
+
+	// 생성자에서 쉐이더, 프레임버퍼, mip chain 텍스쳐 생성
+	HiZBuilder(unsigned int width, unsigned int height)
+		: initShader("MyShaders/hiz.vs", "MyShaders/hiz_init.fs"),
+		reduceShader("MyShaders/hiz.vs", "MyShaders/hiz_reduce.fs"),
+		width(0), height(0)
+	{
+		// mip chain 텍스쳐 및 각 mip level 을 attach 해서 렌더링할 프레임버퍼 생성
+		glGenTextures(1, &ID);
+		glGenFramebuffers(1, &FBO);
+
+		// hiz.vs 는 gl_VertexID 만으로 full-screen triangle 을 만들기 때문에 정점 데이터가 필요 없지만,
+		// core-profile 에서는 그리기 명령 호출 시 반드시 VAO 가 바인딩되어 있어야 하므로 빈 VAO 를 생성해 둠
+		glGenVertexArrays(1, &emptyVAO);
+
+		// 각 쉐이더의 uniform sampler 변수에 texture unit 위치값 전송
+		initShader.use();
+		initShader.setInt("depthMap", 0);
+		reduceShader.use();
+		reduceShader.setInt("prevLevel", 0);
+
+		resize(width, height);
+	}
+
+	// 깊이 버퍼 해상도가 바뀌면 mip chain 을 새로운 해상도로 재할당
+	void resize(unsigned int newWidth, unsigned int newHeight)
+	{
+		if (newWidth == width && newHeight == height)
+		{
+			return;
+		}
+
+		width = newWidth;
+		height = newHeight;
+
+		// 각 mip level 의 해상도 계산
+		// non-power-of-two 해상도에서도 OpenGL 의 mipmap 크기 규칙과 동일하게 max(1, floor(size / 2)) 로 계산함
+		levelSizes.clear();
+		unsigned int w = width;
+		unsigned int h = height;
+		levelSizes.push_back(w);
+		levelSizes.push_back(h);
+		while (w > 1 || h > 1)
+		{
+			w = w > 1 ? w / 2 : 1;
+			h = h > 1 ? h / 2 : 1;
+			levelSizes.push_back(w);
+			levelSizes.push_back(h);
+		}
+
+		// mip level 마다 메모리 공간 할당
+		glBindTexture(GL_TEXTURE_2D, ID);
+		for (unsigned int level = 0; level < levelCount(); level++)
+		{
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RG32F, levelWidth(level), levelHeight(level), 0, GL_RG, GL_FLOAT, NULL);
+		}
+
+		// min/max 값은 보간하면 의미가 없어지므로 항상 GL_NEAREST 계열로 샘플링
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount() - 1);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		// mip level 개수가 늘어났다면, 늘어난 만큼 타이머 추가 생성
+		while (timers.size() < levelCount())
+		{
+			timers.push_back(GpuTimer());
+		}
+	}
+
+	/*
+		깊이 텍스쳐로부터 Hi-Z mip chain 생성
+
+		depthTexture 는 G-buffer 에 attach 된 깊이 텍스쳐(GL_DEPTH_COMPONENT)이고,
+		nearPlane, farPlane 은 G-buffer 를 렌더링할 때 사용한 투영 행렬의 near, far 값임.
+
+		(다른 GpuTimer 의 begin() ~ end() 구간 안에서 호출하면 안 됨!)
+	*/
+	void build(unsigned int depthTexture, float nearPlane, float farPlane)
+	{
+		// 호출하는 쪽의 뷰포트를 기억해 두었다가 마지막에 복구
+		GLint prevViewport[4];
+		glGetIntegerv(GL_VIEWPORT, prevViewport);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		glBindVertexArray(emptyVAO);
+		glActiveTexture(GL_TEXTURE0);
+
+		/* level 0 : 깊이 버퍼를 linear depth 로 변환하여 저장 */
+		timers[0].begin();
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ID, 0);
+		glViewport(0, 0, levelWidth(0), levelHeight(0));
+		initShader.use();
+		initShader.setFloat("nearPlane", nearPlane);
+		initShader.setFloat("farPlane", farPlane);
+		glBindTexture(GL_TEXTURE_2D, depthTexture);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+		timers[0].end();
+
+		/* level 1 ~ : 이전 level 의 2*2 (NPOT 경계에서는 최대 3*3) texel 을 min/max 로 축소 */
+		reduceShader.use();
+		glBindTexture(GL_TEXTURE_2D, ID);
+		for (unsigned int level = 1; level < levelCount(); level++)
+		{
+			timers[level].begin();
+
+			// 읽어올 이전 level 만 샘플링 가능하도록 base/max level 을 제한
+			// -> 같은 텍스쳐의 다른 level 에 렌더링하는 중에 해당 level 을 샘플링하는 feedback loop 를 방지함
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level - 1);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level - 1);
+
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ID, level);
+			glViewport(0, 0, levelWidth(level), levelHeight(level));
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+
+			timers[level].end();
+		}
+
+		// 모든 level 을 다시 샘플링할 수 있도록 base/max level 복구
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount() - 1);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		glBindVertexArray(0);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+	}
+
+	// mip level 개수 반환
+	unsigned int levelCount() const
+	{
+		return (unsigned int)levelSizes.size() / 2;
+	}
+
+	// mip level 별 해상도 반환
+	unsigned int levelWidth(unsigned int level) const
+	{
+		return levelSizes[level * 2];
+	}
+
+	unsigned int levelHeight(unsigned int level) const
+	{
+		return levelSizes[level * 2 + 1];
+	}
+
+	// mip level 별 GPU 소요 시간 반환 (millisecond 단위, 몇 프레임 전에 측정된 값)
+	double levelCostMs(unsigned int level) const
+	{
+		return timers[level].elapsedMs();
+	}
+
+	// 모든 mip level 의 GPU 소요 시간 합계 반환
+	double totalCostMs() const
+	{
+		double total = 0.0;
+		for (unsigned int level = 0; level < levelCount(); level++)
+		{
+			total += timers[level].elapsedMs();
+		}
+		return total;
+	}
+
+private:
+	Shader initShader; // 깊이 버퍼를 linear depth 로 변환하는 쉐이더
+	Shader reduceShader; // 이전 level 을 min/max 로 축소하는 쉐이더
+	unsigned int FBO; // 각 mip level 을 attach 해서 렌더링할 프레임버퍼
+	unsigned int emptyVAO; // full-screen triangle 을 그릴 때 바인딩할 빈 VAO
+	unsigned int width; // level 0 의 너비
+	unsigned int height; // level 0 의 높이
+	std::vector<unsigned int> levelSizes; // mip level 별 (너비, 높이) 를 순서대로 저장
+	std::vector<GpuTimer> timers; // mip level 별 GPU 타이머
+};
+
+
+#endif // !HIZ_BUILDER_H
+
+/*
+	Hierarchical Depth (Hi-Z) 란 무엇인가?
+
+
+	깊이 버퍼를 mipmap 처럼 절반씩 축소해 나가되,
+	평균값 대신 축소되는 영역의 최소 / 최대 깊이값을 저장해두면,
+
+	mip level k 의 texel 하나만 읽어도
+	원본 깊이 버퍼의 (2^k * 2^k) 영역 전체의 깊이 범위를 알 수 있음.
+
+
+	그래서 SSAO 나 screen-space ray tracing 에서 멀리 떨어진 영역을 샘플링할 때는
+	높은 mip level 을 읽어 샘플링 횟수를 줄이거나,
+
+	occlusion culling 에서 물체의 bounding box 가 덮는 화면 영역의 최대 깊이값보다
+	물체가 더 멀리 있다면 그리지 않거나,
+
+	tiled light culling 에서 타일 하나의 최소 / 최대 깊이값으로
+	광원의 영향 범위가 타일과 겹치는 지 빠르게 검사할 수 있음.
+
+
+	이때 해상도가 2의 거듭제곱이 아니라면(non-power-of-two),
+	예를 들어 너비가 5 인 level 을 축소하면 너비가 2 가 되는데,
+	2 * 2 = 4 개의 texel 만 읽으면 마지막 열의 texel 1개가 누락되어 버림.
+
+	그래서 hiz_reduce.fs 에서는 이전 level 의 크기가 홀수일 때,
+	마지막 행 / 열의 texel 이 그 옆 texel 까지 함께 읽도록 처리함.
+*/
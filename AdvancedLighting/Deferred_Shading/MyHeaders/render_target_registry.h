@@ -0,0 +1,279 @@
+#ifndef RENDER_TARGET_REGISTRY_H
+#define RENDER_TARGET_REGISTRY_H
+/*
+	render_target_registry.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > 텍스쳐 및 Renderbuffer 메모리 할당 관련 OpenGL 함수가 필요하니까!
+
+#include <vector> // 등록된 render target 들을 동적 배열로 보관하기 위해 include
+#include <algorithm>
+
+/*
+	RenderTargetRegistry 클래스
+
+	off-screen 프레임버퍼에 attach 하는 텍스쳐 및 Renderbuffer 객체들을 등록해두면,
+	윈도우의 framebuffer 크기가 바뀌었을 때 등록된 모든 render target 의 메모리를 새로운 크기로 다시 할당해주는 클래스! (하단 필기 참고)
+
+	각 render target 은 내부 포맷, MSAA sample 개수, 출력 해상도 대비 크기 비율(scale)과 함께 등록하며,
+	재할당 시에도 같은 포맷과 sample 개수를 유지함.
+
+	윈도우 크기를 마우스로 드래그하는 동안에는 framebuffer_size_callback 이 매 프레임 호출되므로,
+	requestResize() 로 바뀐 크기만 기록해두고, 마지막 요청 이후 debounceSeconds 만큼 크기 변경이 없을 때
+	update() 에서 한꺼번에 재할당함. (재할당 전까지는 이전 크기의 render target 을 그대로 늘려서 사용)
+
+	생성자에서는 OpenGL 함수를 호출하지 않으므로, OpenGL 컨텍스트 생성 이전에 전역변수로 선언해도 됨.
+*/
+class RenderTargetRegistry
+{
+public:
+	// 생성자에서 출력 해상도 및 재할당 지연 시간 초기화
+	RenderTargetRegistry(unsigned int width, unsigned int height, double debounceSeconds = 0.2)
+		: outputWidth(width), outputHeight(height), debounce(debounceSeconds),
+		resizePending(false), pendingWidth(width), pendingHeight(height), lastRequestTime(0.0), reallocations(0)
+	{
+	}
+
+	// GL_TEXTURE_2D 텍스쳐를 등록하고, 현재 출력 해상도 * scale 크기로 메모리 할당
+	// (format, type 은 메모리만 할당하므로 내부 포맷의 종류(color / depth / depth-stencil)만 맞춰주면 됨)
+	void registerTexture(unsigned int texture, GLenum internalFormat, GLenum format, GLenum type, float scale = 1.0f)
+	{
+		Target target = { texture, TARGET_TEXTURE, internalFormat, format, type, 0, scale, 0, 0 };
+		allocate(target);
+		targets.push_back(target);
+	}
+
+	// GL_TEXTURE_2D_MULTISAMPLE 텍스쳐를 등록하고, 현재 출력 해상도 * scale 크기로 메모리 할당
+	void registerMultisampleTexture(unsigned int texture, unsigned int samples, GLenum internalFormat, float scale = 1.0f)
+	{
+		Target target = { texture, TARGET_MULTISAMPLE_TEXTURE, internalFormat, GL_NONE, GL_NONE, samples, scale, 0, 0 };
+		allocate(target);
+		targets.push_back(target);
+	}
+
+	// Renderbuffer 를 등록하고, 현재 출력 해상도 * scale 크기로 메모리 할당 (samples 가 1 이상이면 multisample Renderbuffer)
+	void registerRenderbuffer(unsigned int renderbuffer, GLenum internalFormat, unsigned int samples = 0, float scale = 1.0f)
+	{
+		Target target = { renderbuffer, TARGET_RENDERBUFFER, internalFormat, GL_NONE, GL_NONE, samples, scale, 0, 0 };
+		allocate(target);
+		targets.push_back(target);
+	}
+
+	// framebuffer_size_callback 에서 호출 -> 바뀐 크기와 요청 시각만 기록하고, 실제 재할당은 update() 에서 처리
+	void requestResize(int width, int height, double time)
+	{
+		// 윈도우가 최소화되면 framebuffer 크기가 0 으로 전달되므로, 이때는 기존 render target 을 그대로 유지함
+		if (width <= 0 || height <= 0)
+		{
+			return;
+		}
+
+		pendingWidth = (unsigned int)width;
+		pendingHeight = (unsigned int)height;
+		lastRequestTime = time;
+		resizePending = (pendingWidth != outputWidth || pendingHeight != outputHeight);
+	}
+
+	// 매 프레임 렌더링 전에 호출 -> 마지막 크기 변경 요청 이후 debounceSeconds 가 지났다면 재할당 (재할당했다면 true 반환)
+	bool update(double time)
+	{
+		if (!resizePending || time - lastRequestTime < debounce)
+		{
+			return false;
+		}
+
+		resize(pendingWidth, pendingHeight);
+		return true;
+	}
+
+	// 지연 없이 곧바로 등록된 모든 render target 을 새로운 출력 해상도에 맞게 재할당
+	void resize(unsigned int width, unsigned int height)
+	{
+		outputWidth = width;
+		outputHeight = height;
+		pendingWidth = width;
+		pendingHeight = height;
+		resizePending = false;
+
+		for (unsigned int i = 0; i < targets.size(); i++)
+		{
+			allocate(targets[i]);
+		}
+		reallocations++;
+	}
+
+	// 현재 render target 들이 할당된 출력 해상도 (재할당 대기 중에는 이전 크기)
+	unsigned int width() const
+	{
+		return outputWidth;
+	}
+
+	unsigned int height() const
+	{
+		return outputHeight;
+	}
+
+	// 출력 해상도 대비 scale 비율로 등록한 render target 의 크기
+	unsigned int scaledWidth(float scale) const
+	{
+		return scaledSize(outputWidth, scale);
+	}
+
+	unsigned int scaledHeight(float scale) const
+	{
+		return scaledSize(outputHeight, scale);
+	}
+
+	// 재할당 대기 중인 크기 변경 요청이 있는 지 여부
+	bool isResizePending() const
+	{
+		return resizePending;
+	}
+
+	// 등록된 render target 개수
+	unsigned int targetCount() const
+	{
+		return (unsigned int)targets.size();
+	}
+
+	// 지금까지 재할당한 횟수
+	unsigned int reallocationCount() const
+	{
+		return reallocations;
+	}
+
+	// 등록된 render target 들이 차지하는 메모리 양 추정 (byte)
+	double allocatedBytes() const
+	{
+		double bytes = 0.0;
+		for (unsigned int i = 0; i < targets.size(); i++)
+		{
+			bytes += (double)targets[i].width * targets[i].height * bytesPerTexel(targets[i].internalFormat)
+				* (targets[i].samples > 0 ? targets[i].samples : 1);
+		}
+		return bytes;
+	}
+
+private:
+	enum TargetType
+	{
+		TARGET_TEXTURE,
+		TARGET_MULTISAMPLE_TEXTURE,
+		TARGET_RENDERBUFFER
+	};
+
+	// 등록된 render target 1개의 정보
+	struct Target
+	{
+		unsigned int id; // 텍스쳐 또는 Renderbuffer 객체의 참조 id
+		TargetType type;
+		GLenum internalFormat;
+		GLenum format;
+		GLenum dataType;
+		unsigned int samples;
+		float scale; // 출력 해상도 대비 크기 비율
+		unsigned int width; // 현재 할당된 크기
+		unsigned int height;
+	};
+
+	std::vector<Target> targets;
+	unsigned int outputWidth;
+	unsigned int outputHeight;
+	double debounce;
+	bool resizePending;
+	unsigned int pendingWidth;
+	unsigned int pendingHeight;
+	double lastRequestTime;
+	unsigned int reallocations;
+
+	static unsigned int scaledSize(unsigned int size, float scale)
+	{
+		return std::max(1u, (unsigned int)(size * scale + 0.5f));
+	}
+
+	// render target 을 현재 출력 해상도 * scale 크기로 (재)할당 (포맷 및 sample 개수는 등록할 때의 값을 유지)
+	// 텍스쳐 필터링, wrapping 모드 같은 텍스쳐 파라미터와 프레임버퍼 attachment 는 메모리를 재할당해도 그대로 유지됨
+	void allocate(Target& target)
+	{
+		target.width = scaledSize(outputWidth, target.scale);
+		target.height = scaledSize(outputHeight, target.scale);
+
+		if (target.type == TARGET_TEXTURE)
+		{
+			glBindTexture(GL_TEXTURE_2D, target.id);
+			glTexImage2D(GL_TEXTURE_2D, 0, target.internalFormat, target.width, target.height, 0, target.format, target.dataType, NULL);
+			glBindTexture(GL_TEXTURE_2D, 0);
+		}
+		else if (target.type == TARGET_MULTISAMPLE_TEXTURE)
+		{
+			glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, target.id);
+			glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, target.samples, target.internalFormat, target.width, target.height, GL_TRUE);
+			glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+		}
+		else
+		{
+			glBindRenderbuffer(GL_RENDERBUFFER, target.id);
+			if (target.samples > 0)
+			{
+				glRenderbufferStorageMultisample(GL_RENDERBUFFER, target.samples, target.internalFormat, target.width, target.height);
+			}
+			else
+			{
+				glRenderbufferStorage(GL_RENDERBUFFER, target.internalFormat, target.width, target.height);
+			}
+			glBindRenderbuffer(GL_RENDERBUFFER, 0);
+		}
+	}
+
+	// texel 1개의 크기(byte) 추정 (크기가 지정되지 않은 포맷은 채널당 8 bit, 3채널 포맷은 4채널로 padding 된다고 가정)
+	static unsigned int bytesPerTexel(GLenum internalFormat)
+	{
+		switch (internalFormat)
+		{
+		case GL_RED:
+		case GL_R8:
+			return 1;
+		case GL_RG:
+		case GL_RG8:
+		case GL_R16F:
+		case GL_DEPTH_COMPONENT16:
+			return 2;
+		case GL_RGBA16F:
+		case GL_RGB16F:
+		case GL_RG32F:
+		case GL_DEPTH32F_STENCIL8:
+			return 8;
+		case GL_RGBA32F:
+		case GL_RGB32F:
+			return 16;
+		default:
+			return 4;
+		}
+	}
+};
+
+
+#endif // !RENDER_TARGET_REGISTRY_H
+
+/*
+	윈도우 크기 변경에 따른 render target 재할당
+
+
+	off-screen 프레임버퍼의 텍스쳐와 Renderbuffer 를 SCR_WIDTH * SCR_HEIGHT 로 고정 할당하면,
+	윈도우 크기를 키우거나 high-DPI 모니터에서 framebuffer 크기가 윈도우 크기보다 커질 때
+	작은 render target 을 늘려서 출력하므로 화면이 흐려지고,
+	반대로 윈도우를 줄이면 화면에 보이지도 않는 texel 들이 메모리를 계속 차지함.
+
+
+	그렇다고 framebuffer_size_callback 이 호출될 때마다 곧바로 재할당하면,
+	윈도우 가장자리를 드래그하는 동안 매 프레임 모든 render target 의 메모리를 해제하고 새로 할당하게 되어
+	드라이버가 메모리를 정리하느라 프레임이 끊길 수 있음.
+
+	그래서 크기 변경 요청은 기록만 해두고, 일정 시간(debounce) 동안 추가 요청이 없을 때,
+	즉 사용자가 드래그를 멈췄을 때 한 번만 재할당함. (그 사이에는 이전 크기의 render target 을 늘려서 출력)
+
+
+	또한 bloom 이나 SSAO 처럼 낮은 해상도로도 충분한 render target 은
+	출력 해상도 대비 비율(scale)로 등록해두면, 재할당할 때 항상 같은 비율을 유지할 수 있음.
+*/
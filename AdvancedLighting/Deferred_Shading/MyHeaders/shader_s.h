@@ -148,6 +148,15 @@ public:
 		glDeleteShader(fragment);
 	}
 
+	// 모든 Shader 객체가 공유하는 glUniform~() 호출 횟수 카운터
+	// (함수 내부의 static 지역변수는 프로그램 전체에서 1개만 존재하므로, 헤더에서도 중복 정의 없이 공유 가능)
+	// 렌더링 루프에서 매 프레임 값을 출력한 뒤 0 으로 초기화하여, 프레임당 uniform 전송 횟수를 확인하는 용도
+	static unsigned int& uniformCallCount()
+	{
+		static unsigned int count = 0;
+		return count;
+	}
+
 	// ShaderProgram 객체 활성화(바인딩)
 	void use()
 	{
@@ -215,16 +224,19 @@ public:
 		// 그래서 glUniform1i(1 int) 로 유니폼 변수를 전송함.
 		// 또한, OpenGL 함수들은 C 스타일 문자열만 받는다고 했으니까 유니폼 변수명 문자열을
 		// std::string 타입에서 c 스타일 문자열로 변환하여 전달함.
+		uniformCallCount()++;
 		glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
 	}
 
 	void setInt(const std::string& name, int value) const
 	{
+		uniformCallCount()++;
 		glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
 	}
 
 	void setFloat(const std::string& name, float value) const
 	{
+		uniformCallCount()++;
 		glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
 	}
 
@@ -248,6 +260,7 @@ public:
 			즉, glUniform2fv() 는 vec2 타입 데이터를 '배열' 형태로 미리 저장해놨다가
 			포인터(배열의 첫 번째 요소의 주소값)로 전달하는 구조임.
 		*/
+		uniformCallCount()++;
 		glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
 	}
 
@@ -267,30 +280,35 @@ public:
 			즉, glUniform2f() 는 vec2 의 요소 x, y 를
 			실제 float 타입 데이터로 직접 전달하는 구조임.
 		*/
+		uniformCallCount()++;
 		glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
 	}
 
 	// vec3 타입 데이터를 배열 형태로 전달하는 메서드
 	void setVec3(const std::string& name, const glm::vec3& value) const
 	{
+		uniformCallCount()++;
 		glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
 	}
 
 	// vec3 타입 데이터를 직접 전달하는 메서드
 	void setVec3(const std::string& name, float x, float y, float z) const
 	{
+		uniformCallCount()++;
 		glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
 	}
 
 	// vec4 타입 데이터를 배열 형태로 전달하는 메서드
 	void setVec4(const std::string& name, const glm::vec4& value) const
 	{
+		uniformCallCount()++;
 		glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
 	}
 
 	// vec4 타입 데이터를 직접 전달하는 메서드
 	void setVec4(const std::string& name, float x, float y, float z, float w) const
 	{
+		uniformCallCount()++;
 		glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
 	}
 
@@ -317,18 +335,21 @@ public:
 			즉, glUniformMatrix2fv() 는 mat2 타입 데이터를 '다차원 배열' 형태로 미리 저장해놨다가
 			포인터(배열의 첫 번째 요소의 주소값)로 전달하는 구조임.
 		*/
+		uniformCallCount()++;
 		glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
 	}
 
 	// mat3 타입 데이터를 2차원 배열로 전달하는 메서드
 	void setMat3(const std::string& name, const glm::mat3& mat) const
 	{
+		uniformCallCount()++;
 		glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
 	}
 
 	// mat4 타입 데이터를 2차원 배열로 전달하는 메서드
 	void setMat4(const std::string& name, const glm::mat4& mat) const
 	{
+		uniformCallCount()++;
 		glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
 	}
 
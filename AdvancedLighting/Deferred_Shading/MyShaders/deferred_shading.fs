@@ -12,12 +12,19 @@ uniform sampler2D gNormal;
 uniform sampler2D gAlbedoSpec;
 
 /* 각 조명의 정보를 저장할 구조체 선언 */
+/*
+  std140 레이아웃 기준으로 vec3 는 16 bytes 단위로 정렬되므로,
+  vec3 뒤에 float 를 선언하여 남는 4 bytes 자리를 채워줌.
+
+  C++ 코드의 LightData 구조체(light_buffer.h)와 멤버 순서 및 크기가 정확히 일치해야 함!
+*/
 struct Light {
   vec3 Position; // 조명 위치
-  vec3 Color; // 조명 색상
-
   float Linear; // 거리에 따른 조명 감쇄 계산식에서 사용할 Linear 항의 계수
+
+  vec3 Color; // 조명 색상
   float Quadratic; // 거리에 따른 조명 감쇄 계산식에서 사용할 Quadratic 항의 계수
+
   float Radius; // light volume 의 반경
 };
 
@@ -28,8 +35,11 @@ struct Light {
 // 조명 개수를 상수로 선언
 const int NR_LIGHTS = 32;
 
-// NR_LIGHTS 개의 조명 정보를 전송받은 정적 배열 선언
-uniform Light lights[NR_LIGHTS]; 
+// NR_LIGHTS 개의 조명 정보를 UBO 로부터 전송받는 uniform block 선언
+// -> 개별 uniform 변수로 전송받지 않고, UBO 에 std140 레이아웃으로 패킹된 배열을 그대로 인덱싱함.
+layout(std140) uniform Lights {
+  Light lights[NR_LIGHTS];
+};
 
 // 카메라 위치값
 uniform vec3 viewPos;
@@ -0,0 +1,14 @@
+#version 330 core
+
+void main() {
+  /*
+    정점 데이터 없이 gl_VertexID(0, 1, 2) 만으로
+    화면 전체를 덮는 커다란 삼각형(full-screen triangle)의 정점 좌표 계산
+
+    gl_VertexID 가 0, 1, 2 일 때 각각 (0, 0), (2, 0), (0, 2) 가 계산되고,
+    이를 NDC 좌표계로 맵핑하면 (-1, -1), (3, -1), (-1, 3) 이 되어
+    [-1, 1] 범위의 화면 전체를 덮게 됨. (화면 밖의 영역은 clipping 됨)
+  */
+  vec2 pos = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+  gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+}
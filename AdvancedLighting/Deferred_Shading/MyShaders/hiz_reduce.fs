@@ -0,0 +1,56 @@
+#version 330 core
+
+// Hi-Z mip chain 텍스쳐의 내부 포맷이 GL_RG32F 이므로, vec2 타입으로 (min, max) 깊이값 출력
+out vec2 FragColor;
+
+/*
+  OpenGL 에서 전송해 줄 uniform 변수들 선언
+*/
+
+// 이전 mip level 만 샘플링 가능하도록 base/max level 이 제한된 Hi-Z 텍스쳐의 sampler 변수 선언
+// (따라서 texelFetch() 의 lod 0 이 곧 이전 mip level 을 의미함)
+uniform sampler2D prevLevel;
+
+// 이전 level 의 texel 하나를 읽어서 현재까지의 min/max 값에 누적
+void accumulate(ivec2 coord, ivec2 prevSize, inout vec2 result) {
+  vec2 texel = texelFetch(prevLevel, min(coord, prevSize - 1), 0).rg;
+  result.x = min(result.x, texel.x);
+  result.y = max(result.y, texel.y);
+}
+
+void main() {
+  // 이전 level 의 해상도 및 현재 pixel 에 대응되는 이전 level 의 2*2 블록 시작 좌표
+  ivec2 prevSize = textureSize(prevLevel, 0);
+  ivec2 coord = ivec2(gl_FragCoord.xy);
+  ivec2 prevCoord = coord * 2;
+
+  // 2*2 블록의 min/max 깊이값 계산
+  vec2 result = vec2(1e30, -1e30);
+  accumulate(prevCoord, prevSize, result);
+  accumulate(prevCoord + ivec2(1, 0), prevSize, result);
+  accumulate(prevCoord + ivec2(0, 1), prevSize, result);
+  accumulate(prevCoord + ivec2(1, 1), prevSize, result);
+
+  /*
+    non-power-of-two 처리 (hiz_builder.h 필기 참고)
+
+    이전 level 의 너비(높이)가 홀수라면, 현재 level 의 마지막 열(행)이
+    이전 level 의 마지막 열(행)까지 함께 덮도록 3번째 texel 을 추가로 읽음.
+  */
+  bool extraColumn = (prevSize.x & 1) == 1 && coord.x == prevSize.x / 2 - 1;
+  bool extraRow = (prevSize.y & 1) == 1 && coord.y == prevSize.y / 2 - 1;
+
+  if(extraColumn) {
+    accumulate(prevCoord + ivec2(2, 0), prevSize, result);
+    accumulate(prevCoord + ivec2(2, 1), prevSize, result);
+  }
+  if(extraRow) {
+    accumulate(prevCoord + ivec2(0, 2), prevSize, result);
+    accumulate(prevCoord + ivec2(1, 2), prevSize, result);
+  }
+  if(extraColumn && extraRow) {
+    accumulate(prevCoord + ivec2(2, 2), prevSize, result);
+  }
+
+  FragColor = result;
+}
@@ -14,6 +14,10 @@
 #include "MyHeaders/shader_s.h"
 #include "MyHeaders/camera.h"
 #include "MyHeaders/model.h"
+#include "MyHeaders/light_buffer.h"
+#include "MyHeaders/hiz_builder.h"
+#include "MyHeaders/render_target_registry.h"
+#include "MyHeaders/dynamic_resolution.h"
 
 #include <iostream>
 #include <cstdlib> // srand() 및 rand() 함수 사용을 위해 포함
@@ -45,6 +49,20 @@ void renderQuad();
 const unsigned int SCR_WIDTH = 800; // 윈도우 창 너비
 const unsigned int SCR_HEIGHT = 600; // 윈도우 창 높이
 
+// 윈도우 framebuffer 크기(출력 해상도)를 추적할 registry 생성 (render_target_registry.h 필기 참고)
+// -> 크기 변경이 멈춘 뒤에만 출력 해상도를 갱신하고, 내부 해상도 render target 들은 이 크기에 배율을 곱해서 internalTargets 가 재할당함
+RenderTargetRegistry outputTargets(SCR_WIDTH, SCR_HEIGHT);
+
+// Hi-Z mip chain 의 level 별 해상도 및 GPU 소요 시간 출력 요청 상태값 초기화
+// (아직 Hi-Z 를 샘플링하는 pass 가 없으므로, 출력을 요청한 뒤 남은 프레임 동안에만 mip chain 을 생성함)
+unsigned int hiZReportFramesLeft = 0;
+bool hiZReportKeyPressed = false;
+
+// dynamic resolution 활성화 여부 및 목표 GPU 프레임 시간(millisecond 단위) 초기화 (R 키로 on/off, 위/아래 방향키로 목표 시간 조절)
+bool dynamicResolution = false;
+bool dynamicResolutionKeyPressed = false;
+float dynamicResolutionTargetMs = 16.6f;
+
 // 카메라 클래스 생성 (카메라 위치값만 매개변수로 전달함.)
 Camera camera(glm::vec3(0.0f, 0.0f, 5.0f));
 
@@ -158,6 +176,13 @@ int main()
 	objectPositions.push_back(glm::vec3(3.0, -0.5, 3.0));
 
 
+	// high-DPI 모니터에서는 framebuffer 크기가 윈도우 크기(SCR_WIDTH * SCR_HEIGHT)와 다를 수 있으므로,
+	// render target 들을 생성하기 전에 실제 framebuffer 크기로 출력 해상도를 맞춰줌
+	int framebufferWidth, framebufferHeight;
+	glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+	outputTargets.resize(framebufferWidth, framebufferHeight);
+
+
 	/* G-buffer 로 사용할 프레임버퍼(Floating point framebuffer) 생성 및 설정 */
 	/* 또한, 이 프레임버퍼는 Multiple Render Target(MRT) 로 설정. */
 
@@ -203,19 +228,25 @@ int main()
 	unsigned int attachments[3] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 };
 	glDrawBuffers(3, attachments);
 
-	// FBO 객체에 attach 할 RBO(RenderBufferObject) 객체 생성 및 바인딩
-	unsigned int rboDepth;
-	glGenRenderbuffers(1, &rboDepth);
-	glBindRenderbuffer(GL_RENDERBUFFER, rboDepth);
+	// FBO 객체에 attach 할 깊이 텍스쳐 객체 생성 및 바인딩
+	/*
+		Hi-Z mip chain 생성 시 깊이 버퍼를 샘플링해야 하므로,
+		RBO(RenderBufferObject) 대신 샘플링 가능한 텍스쳐 객체를 깊이 버퍼로 사용함.
 
-	// RBO 객체 메모리 공간 할당
-	// 단일 Renderbuffer 에 depth 값만 저장하는 데이터 포맷 지정 -> GL_DEPTH_COMPONENT 
-	// 또한, 텍스쳐 객체와 마찬가지로 스크린 해상도와 Renderbuffer 해상도를 일치시킴 -> 그래야 SCR_WIDTH * SCR_HEIGHT 개수 만큼의 데이터 저장 공간 확보 가능!
-	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT, SCR_WIDTH, SCR_HEIGHT);
+		단일 텍스쳐에 depth 값만 저장하는 데이터 포맷 지정 -> GL_DEPTH_COMPONENT
+		(Lighting Pass 이후 default framebuffer 로 깊이 버퍼를 복사(blit)할 때에도 그대로 사용됨)
+	*/
+	unsigned int gDepth;
+	glGenTextures(1, &gDepth);
+	glBindTexture(GL_TEXTURE_2D, gDepth);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, SCR_WIDTH, SCR_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-	// FBO 객체에 생성한 RBO 객체 attach (자세한 매개변수 설명은 LearnOpenGL 본문 참고!)
-	// off-screen framebuffer 에 렌더링 시, RBO 객체에는 depth 값만 저장할 것이므로, GL_DEPTH_STENCIL_ATTACHMENT 를 적용함!
-	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rboDepth);
+	// FBO 객체에 생성한 깊이 텍스쳐 객체 attach
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, gDepth, 0);
 
 	// 현재 GL_FRAMEBUFFER 상태에 바인딩된 FBO 객체 설정 완료 여부 검사 (설정 완료 조건은 LearnOpenGL 본문 참고)
 	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
@@ -228,6 +259,47 @@ int main()
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
 
+	/* 내부 해상도로 lighting pass 결과를 렌더링할 프레임버퍼 생성 (dynamic_resolution.h 필기 참고) */
+
+	// 내부 해상도가 출력 해상도보다 작을 때만 사용하며, 이후 upscale pass 에서 default framebuffer 로 확대해서 출력함
+	unsigned int sceneFBO;
+	glGenFramebuffers(1, &sceneFBO);
+	glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+
+	// 확대할 때 bilinear 보간을 적용하기 위해 GL_LINEAR 필터링 모드 사용
+	unsigned int sceneColor;
+	glGenTextures(1, &sceneColor);
+	glBindTexture(GL_TEXTURE_2D, sceneColor);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, sceneColor, 0);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Framebuffer is not complete!" << std::endl;
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	// G-buffer 및 lighting pass 결과 텍스쳐들을 등록해두고, 내부 해상도 배율이 바뀔 때마다 한꺼번에 재할당
+	RenderTargetRegistry internalTargets(outputTargets.width(), outputTargets.height());
+	internalTargets.registerTexture(gPosition, GL_RGBA16F, GL_RGBA, GL_FLOAT);
+	internalTargets.registerTexture(gNormal, GL_RGBA16F, GL_RGBA, GL_FLOAT);
+	internalTargets.registerTexture(gAlbedoSpec, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
+	internalTargets.registerTexture(gDepth, GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT, GL_FLOAT);
+	internalTargets.registerTexture(sceneColor, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
+
+	// GPU 프레임 시간을 측정해서 내부 해상도 배율을 50% ~ 100% 범위에서 조절할 controller 생성
+	DynamicResolution resolution(dynamicResolutionTargetMs);
+
+	// 내부 해상도로 렌더링한 lighting pass 결과를 출력 해상도로 확대할 쉐이더 객체 생성
+	Shader shaderUpscale("MyShaders/deferred_shading.vs", "MyShaders/upscale.fs");
+	shaderUpscale.use();
+	shaderUpscale.setInt("sceneTexture", 0);
+
+
 	/*
 		lighting pass(조명 계산 단계)에 적용할 쉐이더에 선언된 
 		각 G-buffer 들의 uniform sampler 변수들에
@@ -282,6 +354,39 @@ int main()
 		// 랜덤한 색상값을 동적 배열에 추가
 		lightColors.push_back(glm::vec3(rColor, gColor, bColor));
 	}
+
+
+	/* 광원 데이터를 std140 레이아웃으로 패킹하여 저장할 UBO 생성 (light_buffer.h 필기 참고) */
+
+	// NR_LIGHTS 개의 광원 데이터를 저장할 UBO 를 생성하고 0번 binding point 에 연결
+	LightBuffer lightBuffer(NR_LIGHTS, 0);
+
+	// lighting pass 쉐이더의 Lights uniform block 을 UBO 와 동일한 0번 binding point 에 연결
+	lightBuffer.bindBlock(shaderLightPass, "Lights");
+
+	// 광원 전체 갯수만큼 반복문을 순회하며 UBO 에 저장할 광원 데이터 초기화
+	for (unsigned int i = 0; i < lightPositions.size(); i++)
+	{
+		lightBuffer.setPosition(i, lightPositions[i]);
+		lightBuffer.setColor(i, lightColors[i]);
+
+		// attenuation(감쇄) 계산에 필요한 계수들 초기화
+		const float constant = 1.0f; // attenuation 계산식의 상수항
+		const float linear = 0.7f;
+		const float quadratic = 1.8f;
+
+		// 현재 광원의 조명 색상을 기준으로 최대 밝기값 계산
+		const float maxBrightness = std::fmaxf(std::fmaxf(lightColors[i].r, lightColors[i].g), lightColors[i].b);
+
+		// 현재 광원을 중심으로 한 light volume 의 반경(Radius)을 계산 (하단 필기 참고)
+		float radius = (-linear + std::sqrt(linear * linear - 4 * quadratic * (constant - (256.0f / 5.0f) * maxBrightness))) / (2.0f * quadratic);
+
+		// 감쇄 계수 및 light volume 의 radius 를 UBO 에 저장할 광원 데이터에 반영
+		lightBuffer.setAttenuation(i, linear, quadratic, radius);
+	}
+
+	// G-buffer 깊이 버퍼로부터 min/max 깊이값 mip chain 을 생성할 Hi-Z builder 생성
+	HiZBuilder hiZ(outputTargets.width(), outputTargets.height());
 	
 
 	// while 문으로 렌더링 루프 구현
@@ -302,6 +407,43 @@ int main()
 		// 윈도우 창 및 키 입력 감지 밎 이벤트 처리
 		processInput(window);
 
+		// 이번 프레임의 GPU 소요 시간 측정 시작
+		resolution.beginFrame();
+
+
+		/* 출력 해상도 및 내부 해상도 결정 */
+
+		// 윈도우 크기 변경이 멈춘 뒤 일정 시간이 지났다면, 출력 해상도를 새로운 framebuffer 크기로 갱신
+		if (outputTargets.update(glfwGetTime()))
+		{
+			std::cout << "output resolution changed to " << outputTargets.width() << "x" << outputTargets.height() << std::endl;
+		}
+
+		// default framebuffer 에 렌더링하는 pass 는 현재 윈도우 framebuffer 크기를 사용
+		// (출력 해상도 갱신 대기 중에는 이전 크기의 결과를 늘려서 출력함)
+		glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+
+		// dynamic resolution 을 끄면 배율을 100% 로 되돌리고, GPU 시간만 측정함
+		resolution.targetMs = dynamicResolutionTargetMs;
+		resolution.enabled = dynamicResolution;
+		if (!dynamicResolution && resolution.scale() != resolution.maxScale)
+		{
+			resolution.reset();
+		}
+
+		// 배율은 scaleStep 단위로만 바뀌므로, 내부 해상도가 실제로 바뀐 프레임에서만 render target 들을 재할당함
+		unsigned int internalWidth = resolution.scaledSize(outputTargets.width());
+		unsigned int internalHeight = resolution.scaledSize(outputTargets.height());
+		if (internalWidth != internalTargets.width() || internalHeight != internalTargets.height())
+		{
+			internalTargets.resize(internalWidth, internalHeight);
+			hiZ.resize(internalWidth, internalHeight);
+			std::cout << "internal render targets resized to " << internalWidth << "x" << internalHeight << std::endl;
+		}
+
+		// 내부 해상도가 윈도우 framebuffer 크기와 다르다면, lighting pass 결과를 sceneFBO 에 렌더링한 뒤 확대해서 출력
+		bool upscale = internalWidth != (unsigned int)framebufferWidth || internalHeight != (unsigned int)framebufferHeight;
+
 		// 현재까지 저장되어 있는 프레임 버퍼(그 중에서도 색상 버퍼) 초기화하기
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
@@ -317,11 +459,14 @@ int main()
 		// MRT framebuffer 바인딩
 		glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
 
+		// G-buffer 는 내부 해상도로 할당되어 있으므로, 뷰포트도 내부 해상도에 맞춤
+		glViewport(0, 0, internalWidth, internalHeight);
+
 		// 현재 바인딩된 framebuffer 의 색상 및 깊이 버퍼 초기화
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		// 카메라의 zoom 값으로부터 투영 행렬 계산
-		glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+		glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)outputTargets.width() / (float)outputTargets.height(), 0.1f, 100.0f);
 
 		// 카메라 클래스로부터 뷰 행렬(= LookAt 행렬) 가져오기
 		glm::mat4 view = camera.GetViewMatrix();
@@ -357,8 +502,38 @@ int main()
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
 
+		/* Hi-Z Pass (G-buffer 의 깊이 버퍼로부터 min/max linear depth mip chain 생성) */
+		// M 키 입력 시에만 몇 프레임 동안 생성한 뒤, Hi-Z mip chain 의 level 별 해상도 및 GPU 소요 시간 출력
+		if (hiZReportFramesLeft > 0)
+		{
+			hiZ.build(gDepth, 0.1f, 100.0f);
+			hiZReportFramesLeft--;
+
+			if (hiZReportFramesLeft == 0)
+			{
+				for (unsigned int level = 0; level < hiZ.levelCount(); level++)
+				{
+					std::cout << "Hi-Z level " << level << " | " << hiZ.levelWidth(level) << "x" << hiZ.levelHeight(level)
+						<< " | " << hiZ.levelCostMs(level) << " ms" << std::endl;
+				}
+				std::cout << "Hi-Z total | " << hiZ.levelCount() << " levels | " << hiZ.totalCostMs() << " ms" << std::endl;
+			}
+		}
+
+
 		/* Lighting Pass (G-buffer 에서 pixel 단위로 데이터를 샘플링하여 조명 연산하여 QuadMesh 에 렌더링) */
 
+		// 확대가 필요하다면 내부 해상도의 sceneFBO 에, 아니라면 곧바로 default framebuffer 에 렌더링
+		if (upscale)
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+			glViewport(0, 0, internalWidth, internalHeight);
+		}
+		else
+		{
+			glViewport(0, 0, framebufferWidth, framebufferHeight);
+		}
+
 		// 현재 바인딩된 framebuffer 의 색상 및 깊이 버퍼 초기화
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -373,28 +548,9 @@ int main()
 		glActiveTexture(GL_TEXTURE2);
 		glBindTexture(GL_TEXTURE_2D, gAlbedoSpec);
 
-		// 반복문을 광원 갯수만큼 순회하며 array uniform 에 조명 데이터 전송
-		for (unsigned int i = 0; i < lightPositions.size(); i++)
-		{
-			shaderLightPass.setVec3("lights[" + std::to_string(i) + "].Position", lightPositions[i]);
-			shaderLightPass.setVec3("lights[" + std::to_string(i) + "].Color", lightColors[i]);
-
-			// attenuation(감쇄) 계산에 필요한 데이터들 추가 전송
-			const float constant = 1.0f; // attenuation 계산식의 상수항
-			const float linear = 0.7f;
-			const float quadratic = 1.8f;
-			shaderLightPass.setFloat("lights[" + std::to_string(i) + "].Linear", linear);
-			shaderLightPass.setFloat("lights[" + std::to_string(i) + "].Quadratic", quadratic);
-
-			// 현재 광원의 조명 색상을 기준으로 최대 밝기값 계산
-			const float maxBrightness = std::fmaxf(std::fmaxf(lightColors[i].r, lightColors[i].g), lightColors[i].b);
-
-			// 현재 광원을 중심으로 한 light volume 의 반경(Radius)을 계산 (하단 필기 참고)
-			float radius = (-linear + std::sqrt(linear * linear - 4 * quadratic * (constant - (256.0f / 5.0f) * maxBrightness))) / (2.0f * quadratic);
-
-			// 계산된 light volume 의 radius 를 쉐이더 프로그램에 전송
-			shaderLightPass.setFloat("lights[" + std::to_string(i) + "].Radius", radius);
-		}
+		// 변경된 광원 데이터가 있다면, 변경된 범위만 glBufferSubData() 1번으로 UBO 에 업로드
+		// (광원 데이터가 변경되지 않은 프레임에서는 OpenGL 호출 없이 바로 반환됨)
+		lightBuffer.upload();
 
 		// 카메라 위치값을 쉐이더 프로그램에 전송
 		shaderLightPass.setVec3("viewPos", camera.Position);
@@ -403,6 +559,19 @@ int main()
 		renderQuad();
 
 
+		/* Upscale Pass (내부 해상도의 lighting pass 결과를 출력 해상도의 default framebuffer 로 확대) */
+		if (upscale)
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glViewport(0, 0, framebufferWidth, framebufferHeight);
+
+			shaderUpscale.use();
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, sceneColor);
+			renderQuad();
+		}
+
+
 		/* Blit 기법으로 Forward rendering 과 Deferred rendering 결합하기 (하단 필기 참고) */
 
 		// Blitting source framebuffer(G-buffer) 는 GL_READ_FRAMEBUFFER 상태에 바인딩 
@@ -412,7 +581,8 @@ int main()
 		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
 
 		// G-buffer 에 작성된 깊이 버퍼를 default framebuffer 로 복사(Blit)
-		glBlitFramebuffer(0, 0, SCR_WIDTH, SCR_HEIGHT, 0, 0, SCR_WIDTH, SCR_HEIGHT, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+		// (내부 해상도가 더 작다면 출력 해상도로 늘려서 복사하며, 깊이값은 보간할 수 없으므로 GL_NEAREST 만 사용 가능)
+		glBlitFramebuffer(0, 0, internalWidth, internalHeight, 0, 0, framebufferWidth, framebufferHeight, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
 
 		// default framebuffer 로 바인딩 복구
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -448,6 +618,20 @@ int main()
 		}
 
 
+		// 이번 프레임의 GPU 소요 시간 측정 종료 (몇 프레임 전에 측정한 결과가 준비되었다면 배율 조절)
+		resolution.endFrame();
+
+
+		// 현재 프레임에서 호출된 glUniform~() 횟수 콘솔 출력 후 카운터 초기화
+		std::cout << "uniform calls: " << Shader::uniformCallCount() << std::endl;
+		Shader::uniformCallCount() = 0;
+
+		// 이번 프레임에 사용한 내부 해상도 배율 및 GPU 프레임 시간 콘솔 출력
+		std::cout << "dynamic resolution " << (dynamicResolution ? "on" : "off") << " | scale " << resolution.scale() * 100.0f << "% | "
+			<< internalWidth << "x" << internalHeight << " | GPU " << resolution.gpuFrameMs() << " ms / target " << resolution.targetMs
+			<< " ms | changes " << resolution.changeCount() << " | dropped " << resolution.droppedCount() << std::endl;
+
+
 		// Double Buffer 상에서 Back Buffer 에 픽셀들이 모두 그려지면, Front Buffer 와 교체(swap)해버림.
 		glfwSwapBuffers(window);
 
@@ -658,6 +842,9 @@ void renderQuad()
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
 	glViewport(0, 0, width, height); // GLFWwindow 상에 렌더링될 뷰포트 영역을 정의. (뷰포트 영역의 좌상단 좌표, 뷰포트 영역의 너비와 높이)
+
+	// 출력 해상도는 곧바로 바꾸지 않고, 크기 변경이 멈춘 뒤 렌더링 루프에서 한 번만 갱신 (내부 해상도 render target 들도 그때 재할당됨)
+	outputTargets.requestResize(width, height, glfwGetTime());
 }
 
 // GLFW 윈도우에 마우스 입력 감지 시, 호출할 콜백함수 정의
@@ -705,6 +892,42 @@ void processInput(GLFWwindow* window)
 		glfwSetWindowShouldClose(window, true); // GLFWwindow 의 WindowShouldClose 플래그(상태값)을 true 로 설정 -> main() 함수의 while 조건문에서 렌더링 루프 탈출 > 렌더링 종료!
 	}
 
+	// M 키 입력 시, Hi-Z mip chain 의 level 별 GPU 소요 시간 출력 요청
+	if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS && !hiZReportKeyPressed)
+	{
+		// GpuTimer 는 몇 프레임 전에 측정한 결과를 읽어오므로, query 개수보다 1 프레임 더 생성한 뒤에 출력
+		if (hiZReportFramesLeft == 0)
+		{
+			hiZReportFramesLeft = GpuTimer::QUERY_COUNT + 1;
+		}
+		hiZReportKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_M) == GLFW_RELEASE)
+	{
+		hiZReportKeyPressed = false;
+	}
+
+	// R 키 입력 시, dynamic resolution on/off
+	if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS && !dynamicResolutionKeyPressed)
+	{
+		dynamicResolution = !dynamicResolution;
+		dynamicResolutionKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_R) == GLFW_RELEASE)
+	{
+		dynamicResolutionKeyPressed = false;
+	}
+
+	// 위/아래 방향키를 누르고 있는 동안 dynamic resolution 의 목표 GPU 프레임 시간 조절 (초당 5 ms)
+	if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
+	{
+		dynamicResolutionTargetMs += 5.0f * deltaTime;
+	}
+	if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
+	{
+		dynamicResolutionTargetMs = std::max(1.0f, dynamicResolutionTargetMs - 5.0f * deltaTime);
+	}
+
 	// 카메라 이동속도 보정 (기본 속도 2.5 가 어느 컴퓨터에서든 유지될 수 있도록 deltaTime 값으로 속도 보정)
 	float cameraSpeed = static_cast<float>(2.5 * deltaTime);
 
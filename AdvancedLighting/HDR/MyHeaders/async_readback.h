@@ -0,0 +1,463 @@
+#ifndef ASYNC_READBACK_H
+#define ASYNC_READBACK_H
+/*
+	async_readback.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > PBO, fence 관련 OpenGL 함수가 필요하니까!
+
+#include <vector> // PBO ring 슬롯 및 인코딩할 pixel 데이터를 동적 배열로 보관하기 위해 include
+#include <queue> // worker thread 에 넘길 인코딩 작업을 대기열로 보관하기 위해 include
+#include <string> // 인코딩한 이미지를 저장할 파일 경로를 보관하기 위해 include
+#include <fstream> // 인코딩한 이미지를 파일로 저장하기 위해 include
+#include <iostream>
+#include <thread> // 인코딩 작업을 렌더링 thread 와 분리된 worker thread 에서 처리하기 위해 include
+#include <mutex> // 인코딩 작업 대기열을 두 thread 에서 안전하게 접근하기 위해 include
+#include <condition_variable> // 인코딩 작업이 들어올 때까지 worker thread 를 재우기 위해 include
+#include <atomic> // 완료된 인코딩 작업 개수를 두 thread 에서 안전하게 읽고 쓰기 위해 include
+
+/*
+	ReadbackResult 구조체
+
+	readback 이 완료되었을 때 콜백 함수로 전달되는 결과 데이터
+
+	data 는 PBO 를 CPU 메모리 공간에 맵핑한 포인터이므로 콜백 함수 안에서만 유효함.
+	콜백 함수가 반환된 이후에도 데이터가 필요하다면 반드시 복사해 둬야 함!
+*/
+struct ReadbackResult
+{
+	int x;
+	int y;
+	int width;
+	int height;
+	GLenum format;
+	GLenum type;
+	unsigned int issuedFrame; // 요청한 시점의 프레임 번호 (poll() 호출 횟수)
+	unsigned int latencyFrames; // 요청한 시점부터 결과가 전달되기까지 지난 프레임 수
+	const unsigned char* data; // 맵핑된 pixel 데이터 (GL_PACK_ALIGNMENT 1, 아래쪽 행부터 저장)
+	size_t size; // data 의 크기 (byte)
+};
+
+// readback 이 완료되었을 때 호출할 콜백 함수 타입 (userData 는 요청할 때 전달한 포인터를 그대로 돌려줌)
+typedef void (*ReadbackCallback)(const ReadbackResult& result, void* userData);
+
+/*
+	AsyncReadback 클래스
+
+	glReadPixels() 로 프레임버퍼의 pixel 데이터를 읽어올 때,
+	CPU 메모리로 곧바로 복사하는 대신 PBO(Pixel Buffer Object) ring 으로 비동기 복사를 요청하고,
+	복사가 끝난 데이터를 몇 프레임 뒤에 콜백 함수로 전달해 주는 클래스! (하단 필기 참고)
+
+	사용 방법
+	1. 읽어올 프레임버퍼를 GL_READ_FRAMEBUFFER 에 바인딩한 상태에서 request() 로 readback 요청
+	2. 매 프레임 poll() 을 1번씩 호출하면, 복사가 완료된 요청의 콜백 함수가 요청한 순서대로 호출됨
+
+	request() 와 poll() 은 GPU 를 절대 기다리지 않으며,
+	ring 의 모든 슬롯이 아직 복사 중이라면 새 요청은 기다리는 대신 버려짐(droppedCount() 로 확인).
+*/
+class AsyncReadback
+{
+public:
+	// 생성자에서 slotCount 개의 PBO 생성 (PBO 메모리는 첫 요청 시 필요한 크기만큼 할당)
+	AsyncReadback(unsigned int slotCount = 3)
+		: slots(slotCount), writeIndex(0), readIndex(0), pending(0), frameIndex(0), dropped(0), delivered(0)
+	{
+		for (unsigned int i = 0; i < slots.size(); i++)
+		{
+			glGenBuffers(1, &slots[i].PBO);
+			slots[i].capacity = 0;
+			slots[i].fence = 0;
+		}
+	}
+
+	// 소멸자에서 GPU 가 아직 복사 중인 fence 및 PBO 메모리 해제 (release() 참고)
+	~AsyncReadback()
+	{
+		release();
+	}
+
+	/*
+		복사 중인 요청을 기다린 뒤 fence 와 PBO 를 모두 삭제 (콜백 함수는 호출하지 않음)
+
+		소멸자에서도 호출되지만, OpenGL 컨텍스트가 살아있을 때 호출되어야 하므로
+		glfwTerminate() 이후에 소멸되는 객체라면 그 전에 직접 호출해 둘 것! (여러 번 호출해도 괜찮음)
+	*/
+	void release()
+	{
+		while (pending > 0)
+		{
+			// PBO 를 삭제하기 전에 GPU 의 복사가 끝나도록 최대 1초까지 기다린 뒤 fence 삭제
+			Slot& slot = slots[readIndex];
+			glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+			glDeleteSync(slot.fence);
+			slot.fence = 0;
+			readIndex = (readIndex + 1) % slots.size();
+			pending--;
+		}
+
+		for (unsigned int i = 0; i < slots.size(); i++)
+		{
+			if (slots[i].PBO != 0)
+			{
+				glDeleteBuffers(1, &slots[i].PBO);
+				slots[i].PBO = 0;
+				slots[i].capacity = 0;
+			}
+		}
+	}
+
+	/*
+		현재 GL_READ_FRAMEBUFFER 에 바인딩된 프레임버퍼의 (x, y, width, height) 영역 readback 요청
+
+		복사가 완료되면 poll() 에서 callback(result, userData) 가 호출됨.
+		모든 슬롯이 복사 중이라 요청이 버려졌다면 false 반환.
+	*/
+	bool request(int x, int y, int width, int height, GLenum format, GLenum type, ReadbackCallback callback, void* userData)
+	{
+		if (pending == slots.size())
+		{
+			dropped++;
+			return false;
+		}
+
+		Slot& slot = slots[writeIndex];
+		size_t size = (size_t)width * height * componentCount(format) * typeSize(type);
+
+		// 요청한 영역이 PBO 보다 크다면 PBO 메모리를 다시 할당 (해상도가 바뀌지 않는 한 첫 요청에서만 발생)
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.PBO);
+		if (slot.capacity < size)
+		{
+			glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+			slot.capacity = size;
+		}
+
+		// GL_RGB 처럼 pixel 당 byte 수가 4의 배수가 아닌 경우에도 행 사이에 padding 이 생기지 않도록 alignment 를 1 로 지정
+		GLint prevAlignment;
+		glGetIntegerv(GL_PACK_ALIGNMENT, &prevAlignment);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+		// PBO 가 GL_PIXEL_PACK_BUFFER 에 바인딩되어 있으면, 마지막 인자는 CPU 메모리 주소가 아니라 PBO 내의 offset 이 되고 함수는 즉시 반환됨
+		glReadPixels(x, y, width, height, format, type, (void*)0);
+
+		glPixelStorei(GL_PACK_ALIGNMENT, prevAlignment);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		// 복사 명령 바로 뒤에 fence 를 삽입해서, 나중에 복사가 끝났는 지 기다리지 않고 확인할 수 있도록 함
+		slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		slot.x = x;
+		slot.y = y;
+		slot.width = width;
+		slot.height = height;
+		slot.format = format;
+		slot.type = type;
+		slot.size = size;
+		slot.issuedFrame = frameIndex;
+		slot.callback = callback;
+		slot.userData = userData;
+
+		writeIndex = (writeIndex + 1) % slots.size();
+		pending++;
+		return true;
+	}
+
+	/*
+		복사가 완료된 요청들의 콜백 함수를 요청한 순서대로 호출 (매 프레임 1번씩 호출)
+
+		fence 상태만 확인하고 GPU 를 기다리지는 않으므로, 아직 복사 중인 요청은 다음 프레임으로 넘어감.
+	*/
+	void poll()
+	{
+		while (pending > 0)
+		{
+			// timeout 을 0 으로 지정하면 GPU 를 기다리지 않고 현재 상태만 확인함
+			// 단, fence 가 아직 driver 의 command buffer 에만 쌓여 있다면 영원히 signal 되지 않을 수 있으므로, GL_SYNC_FLUSH_COMMANDS_BIT 으로 GPU 제출을 보장함
+			GLenum status = glClientWaitSync(slots[readIndex].fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+			if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+			{
+				// fence 는 삽입된 순서대로 signal 되므로, 가장 오래된 요청이 아직이면 나머지도 아직임
+				break;
+			}
+			deliver(slots[readIndex]);
+		}
+
+		frameIndex++;
+	}
+
+	// 대기 중인 모든 요청이 완료될 때까지 기다린 뒤 콜백 함수 호출 (종료 시점이나 벤치마크처럼 stall 이 허용되는 경우에만 사용)
+	void flush()
+	{
+		while (pending > 0)
+		{
+			// GL_SYNC_FLUSH_COMMANDS_BIT 으로 fence 까지의 명령이 GPU 에 제출되도록 보장한 뒤, 최대 1초까지 기다림
+			glClientWaitSync(slots[readIndex].fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+			deliver(slots[readIndex]);
+		}
+	}
+
+	// 복사 중인 요청 개수 반환
+	unsigned int pendingCount() const
+	{
+		return pending;
+	}
+
+	// 슬롯이 모두 복사 중이라 버려진 요청 개수 반환
+	unsigned int droppedCount() const
+	{
+		return dropped;
+	}
+
+	// 콜백 함수까지 전달된 요청 개수 반환
+	unsigned int deliveredCount() const
+	{
+		return delivered;
+	}
+
+	// pixel format 별 성분 개수
+	static unsigned int componentCount(GLenum format)
+	{
+		switch (format)
+		{
+		case GL_RED:
+		case GL_DEPTH_COMPONENT:
+			return 1;
+		case GL_RG:
+			return 2;
+		case GL_RGB:
+		case GL_BGR:
+			return 3;
+		default:
+			return 4;
+		}
+	}
+
+	// pixel type 별 성분 1개의 크기 (byte)
+	static unsigned int typeSize(GLenum type)
+	{
+		switch (type)
+		{
+		case GL_UNSIGNED_BYTE:
+			return 1;
+		case GL_HALF_FLOAT:
+			return 2;
+		default:
+			return 4;
+		}
+	}
+
+private:
+	// PBO 와 fence 를 소유하므로 복사 금지 (복사본이 소멸하면서 같은 PBO 를 삭제하지 않도록)
+	AsyncReadback(const AsyncReadback&);
+	AsyncReadback& operator=(const AsyncReadback&);
+
+	// PBO ring 의 슬롯 1개 (PBO 객체와 진행 중인 요청 정보)
+	struct Slot
+	{
+		unsigned int PBO;
+		size_t capacity; // 할당된 PBO 메모리 크기 (byte)
+		GLsync fence; // 복사 완료 여부를 확인할 fence 객체
+		int x;
+		int y;
+		int width;
+		int height;
+		GLenum format;
+		GLenum type;
+		size_t size;
+		unsigned int issuedFrame;
+		ReadbackCallback callback;
+		void* userData;
+	};
+
+	std::vector<Slot> slots; // PBO ring
+	unsigned int writeIndex; // 다음 요청을 기록할 슬롯 인덱스
+	unsigned int readIndex; // 가장 오래된 요청의 슬롯 인덱스
+	unsigned int pending; // 복사 중인 요청 개수
+	unsigned int frameIndex; // poll() 호출 횟수
+	unsigned int dropped;
+	unsigned int delivered;
+
+	// 가장 오래된 슬롯의 PBO 를 CPU 메모리 공간에 맵핑해서 콜백 함수에 전달한 뒤 슬롯 반환
+	void deliver(Slot& slot)
+	{
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.PBO);
+		const unsigned char* data = (const unsigned char*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.size, GL_MAP_READ_BIT);
+		if (data && slot.callback)
+		{
+			ReadbackResult result;
+			result.x = slot.x;
+			result.y = slot.y;
+			result.width = slot.width;
+			result.height = slot.height;
+			result.format = slot.format;
+			result.type = slot.type;
+			result.issuedFrame = slot.issuedFrame;
+			result.latencyFrames = frameIndex - slot.issuedFrame;
+			result.data = data;
+			result.size = slot.size;
+			slot.callback(result, slot.userData);
+		}
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		glDeleteSync(slot.fence);
+		slot.fence = 0;
+
+		readIndex = (readIndex + 1) % slots.size();
+		pending--;
+		delivered++;
+	}
+};
+
+/*
+	EncodeJob 구조체
+
+	worker thread 에서 이미지 파일로 인코딩할 pixel 데이터 (GL_UNSIGNED_BYTE, 아래쪽 행부터 저장)
+*/
+struct EncodeJob
+{
+	std::string path;
+	unsigned int width;
+	unsigned int height;
+	unsigned int components; // pixel 당 성분 개수 (3 또는 4, 4 면 alpha 는 버림)
+	std::vector<unsigned char> pixels;
+};
+
+/*
+	ImageEncodeWorker 클래스
+
+	readback 으로 받아온 pixel 데이터를 렌더링 thread 와 분리된 worker thread 에서
+	이미지 파일(binary PPM)로 인코딩해서 저장하는 클래스!
+
+	AsyncReadback 의 콜백 함수 안에서 맵핑된 데이터를 EncodeJob 으로 복사해서 submit() 으로 넘기면,
+	파일 인코딩 및 디스크 쓰기는 모두 worker thread 에서 처리되므로 렌더링 루프가 멈추지 않음.
+	(OpenGL 함수는 컨텍스트가 만들어진 thread 에서만 호출할 수 있으므로, worker thread 에서는 OpenGL 함수를 사용하지 않음)
+*/
+class ImageEncodeWorker
+{
+public:
+	// 생성자에서 worker thread 실행
+	ImageEncodeWorker()
+		: running(true), completed(0), worker(&ImageEncodeWorker::run, this)
+	{
+	}
+
+	// 소멸자에서 대기열에 남은 작업을 모두 처리할 때까지 기다린 뒤 worker thread 종료
+	~ImageEncodeWorker()
+	{
+		{
+			std::lock_guard<std::mutex> lock(jobsMutex);
+			running = false;
+		}
+		jobsCondition.notify_one();
+		worker.join();
+	}
+
+	// 인코딩 작업을 대기열에 추가하고 worker thread 를 깨움
+	void submit(EncodeJob& job)
+	{
+		{
+			std::lock_guard<std::mutex> lock(jobsMutex);
+			jobs.push(EncodeJob());
+			std::swap(jobs.back(), job);
+		}
+		jobsCondition.notify_one();
+	}
+
+	// 인코딩이 완료된 작업 개수 반환
+	unsigned int completedCount() const
+	{
+		return completed.load();
+	}
+
+private:
+	std::queue<EncodeJob> jobs; // 인코딩 작업 대기열
+	std::mutex jobsMutex;
+	std::condition_variable jobsCondition;
+	bool running;
+	std::atomic<unsigned int> completed;
+	std::thread worker; // 다른 멤버 변수가 모두 초기화된 뒤 thread 가 실행되도록 마지막에 선언
+
+	// worker thread 에서 실행될 함수 (대기열이 비어있으면 작업이 들어올 때까지 잠듦)
+	void run()
+	{
+		while (true)
+		{
+			EncodeJob job;
+			{
+				std::unique_lock<std::mutex> lock(jobsMutex);
+				while (jobs.empty() && running)
+				{
+					jobsCondition.wait(lock);
+				}
+				if (jobs.empty())
+				{
+					return;
+				}
+				std::swap(job, jobs.front());
+				jobs.pop();
+			}
+
+			encode(job);
+			completed++;
+		}
+	}
+
+	// pixel 데이터를 binary PPM 파일로 저장 (OpenGL 은 아래쪽 행부터 저장하므로 행 순서를 뒤집어서 기록)
+	static void encode(const EncodeJob& job)
+	{
+		std::ofstream file(job.path.c_str(), std::ios::binary);
+		if (!file)
+		{
+			std::cout << "Failed to write image at path: " << job.path << std::endl;
+			return;
+		}
+
+		file << "P6\n" << job.width << " " << job.height << "\n255\n";
+
+		std::vector<unsigned char> row(job.width * 3);
+		for (unsigned int y = 0; y < job.height; y++)
+		{
+			const unsigned char* src = &job.pixels[(size_t)(job.height - 1 - y) * job.width * job.components];
+			for (unsigned int x = 0; x < job.width; x++)
+			{
+				row[x * 3 + 0] = src[x * job.components + 0];
+				row[x * 3 + 1] = src[x * job.components + 1];
+				row[x * 3 + 2] = src[x * job.components + 2];
+			}
+			file.write((const char*)row.data(), row.size());
+		}
+	}
+};
+
+
+#endif // !ASYNC_READBACK_H
+
+/*
+	PBO ring 으로 비동기 readback
+
+
+	glReadPixels() 로 CPU 메모리에 곧바로 pixel 데이터를 복사하면,
+	드라이버는 그 프레임버퍼에 대한 렌더링 명령이 GPU 에서 모두 끝날 때까지 기다린 뒤 복사해야 하므로,
+
+	CPU 는 그동안 아무것도 못하고 멈춰있고(stall),
+	GPU 도 CPU 가 다음 명령을 보내줄 때까지 놀게 됨.
+
+
+	반면, GL_PIXEL_PACK_BUFFER 에 PBO 를 바인딩한 상태에서 glReadPixels() 를 호출하면,
+	GPU 메모리의 PBO 로 복사하라는 명령만 요청하고 즉시 반환됨.
+
+	그리고 glFenceSync() 로 복사 명령 바로 뒤에 fence 를 삽입해두면,
+	나중에 glClientWaitSync() 를 timeout 0 으로 호출해서
+	GPU 가 해당 지점까지 명령을 처리했는지 기다리지 않고 확인할 수 있음.
+
+
+	그래서 PBO 를 여러 개 만들어두고 번갈아가며 복사를 요청한 뒤,
+	fence 가 signal 된 PBO 만 glMapBufferRange() 로 읽어오면,
+
+	결과는 몇 프레임 늦게 도착하지만 CPU 가 GPU 를 기다리는 일은 절대 발생하지 않음!
+
+
+	단, 맵핑한 데이터를 파일로 인코딩하는 작업처럼 CPU 에서 오래 걸리는 작업까지
+	렌더링 thread 에서 처리하면 결국 그만큼 프레임이 멈추게 되므로,
+	ImageEncodeWorker 처럼 데이터만 복사해서 별도의 worker thread 로 넘겨주는 것이 좋음.
+*/
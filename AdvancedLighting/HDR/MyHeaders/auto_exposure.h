@@ -0,0 +1,304 @@
+#ifndef AUTO_EXPOSURE_H
+#define AUTO_EXPOSURE_H
+/*
+	auto_exposure.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > 텍스쳐 및 프레임버퍼 관련 OpenGL 함수가 필요하니까!
+
+#include "shader_s.h" // 휘도값 계산, 히스토그램, 노출 적응 쉐이더 객체를 생성하기 위해 include
+#include "async_readback.h" // 적응된 평균 휘도값을 stall 없이 CPU 로 읽어오기 위해 include
+
+/*
+	AutoExposure 클래스
+
+	HDR 색상 버퍼의 평균 휘도값을 GPU 에서 계산하고,
+	시간에 따라 천천히 적응(eye adaptation)시킨 평균 휘도값을 1*1 텍스쳐에 저장하는 클래스!
+
+	tone mapping 쉐이더는 adaptedLuminanceTexture() 를 직접 샘플링해서 노출값을 계산하므로,
+	CPU 는 평균 휘도값을 기다릴 필요가 전혀 없음. (하단 필기 참고)
+
+	콘솔 출력 등 CPU 에서 평균 휘도값이 필요한 경우를 위해,
+	AsyncReadback 으로 몇 프레임 늦게 읽어온 값을 readbackLuminance() 로 제공함.
+
+	쉐이더 파일은 MyShaders/auto_exposure.vs, luminance.fs, histogram.vs, histogram.fs, adapt_exposure.fs 를 사용함.
+*/
+class AutoExposure
+{
+public:
+	static const unsigned int LUMINANCE_SIZE = 256; // log 휘도값 텍스쳐 해상도 (mipmap 이 1*1 까지 줄어들도록 2의 거듭제곱으로 지정)
+	static const unsigned int BIN_COUNT = 64; // 히스토그램 bin 개수
+
+	// 히스토그램 모드 사용 여부 (false 면 log 휘도값 mipmap 의 평균 사용)
+	bool useHistogram;
+
+	// 밝아질 때 / 어두워질 때의 적응 속도 (클수록 빨리 적응함)
+	float speedUp;
+	float speedDown;
+
+	// 히스토그램 모드에서 평균에서 제외할 가장 어두운 / 가장 밝은 texel 의 비율
+	float lowPercent;
+	float highPercent;
+
+	// 히스토그램으로 나눌 log 휘도값의 범위 (log2 단위)
+	float minLogLuminance;
+	float maxLogLuminance;
+
+	// 생성자에서 쉐이더, 텍스쳐, 프레임버퍼 생성
+	AutoExposure()
+		: useHistogram(false), speedUp(3.0f), speedDown(1.0f), lowPercent(0.5f), highPercent(0.95f),
+		minLogLuminance(-8.0f), maxLogLuminance(4.0f),
+		luminanceShader("MyShaders/auto_exposure.vs", "MyShaders/luminance.fs"),
+		histogramShader("MyShaders/histogram.vs", "MyShaders/histogram.fs"),
+		adaptShader("MyShaders/auto_exposure.vs", "MyShaders/adapt_exposure.fs"),
+		current(0), historyValid(false), readback(3), readbackLum(0.0f), readbackFrames(0)
+	{
+		/* log 휘도값 텍스쳐 (LUMINANCE_SIZE * LUMINANCE_SIZE, mipmap 으로 1*1 까지 평균을 냄) */
+		maxLevel = 0;
+		for (unsigned int size = LUMINANCE_SIZE; size > 1; size /= 2)
+		{
+			maxLevel++;
+		}
+
+		glGenTextures(1, &luminanceTexture);
+		glBindTexture(GL_TEXTURE_2D, luminanceTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R16F, LUMINANCE_SIZE, LUMINANCE_SIZE, 0, GL_RED, GL_FLOAT, NULL);
+		glGenerateMipmap(GL_TEXTURE_2D);
+
+		// texelFetch() 로 mip level 을 직접 지정해서 읽을 것이므로, mipmap 을 사용하는 필터링 모드로 지정해야 함
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		glGenFramebuffers(1, &luminanceFBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, luminanceFBO);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, luminanceTexture, 0);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cout << "Luminance Framebuffer is not complete!" << std::endl;
+		}
+
+		/* 히스토그램 텍스쳐 (BIN_COUNT * 1, 가산 혼합으로 개수를 누적해야 하므로 GL_R32F 사용) */
+		glGenTextures(1, &histogramTexture);
+		glBindTexture(GL_TEXTURE_2D, histogramTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, BIN_COUNT, 1, 0, GL_RED, GL_FLOAT, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+		glGenFramebuffers(1, &histogramFBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, histogramFBO);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, histogramTexture, 0);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cout << "Histogram Framebuffer is not complete!" << std::endl;
+		}
+
+		/* 적응된 평균 휘도값 텍스쳐 (1*1, 이전 프레임 결과를 읽으면서 새 결과를 써야 하므로 2개를 번갈아 사용) */
+		glGenTextures(2, adaptedTextures);
+		glGenFramebuffers(2, adaptedFBOs);
+		for (unsigned int i = 0; i < 2; i++)
+		{
+			glBindTexture(GL_TEXTURE_2D, adaptedTextures[i]);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, 1, 1, 0, GL_RED, GL_FLOAT, NULL);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+			glBindFramebuffer(GL_FRAMEBUFFER, adaptedFBOs[i]);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, adaptedTextures[i], 0);
+			if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			{
+				std::cout << "Adapted Luminance Framebuffer is not complete!" << std::endl;
+			}
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		// full-screen triangle 및 히스토그램 point 는 정점 데이터 없이 gl_VertexID 만으로 그리지만,
+		// core-profile 에서는 그리기 명령 호출 시 반드시 VAO 가 바인딩되어 있어야 하므로 빈 VAO 를 생성해 둠
+		glGenVertexArrays(1, &emptyVAO);
+
+		// 각 쉐이더의 uniform sampler 변수에 texture unit 위치값 전송
+		luminanceShader.use();
+		luminanceShader.setInt("hdrBuffer", 0);
+		histogramShader.use();
+		histogramShader.setInt("logLuminance", 0);
+		adaptShader.use();
+		adaptShader.setInt("logLuminance", 0);
+		adaptShader.setInt("histogram", 1);
+		adaptShader.setInt("prevAdaptedLuminance", 2);
+	}
+
+	/*
+		HDR 색상 버퍼의 평균 휘도값을 계산하여 이전 프레임까지 적응된 값에 반영
+
+		hdrTexture 는 씬이 렌더링된 HDR 색상 버퍼이고, deltaTime 은 이전 프레임으로부터의 시간 간격(초)임.
+	*/
+	void update(unsigned int hdrTexture, float deltaTime)
+	{
+		// 호출하는 쪽의 뷰포트를 기억해 두었다가 마지막에 복구
+		GLint prevViewport[4];
+		glGetIntegerv(GL_VIEWPORT, prevViewport);
+
+		GLboolean depthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
+		glDisable(GL_DEPTH_TEST);
+
+		glBindVertexArray(emptyVAO);
+
+		/* 1. HDR 색상 버퍼 -> log 휘도값 텍스쳐 */
+		glBindFramebuffer(GL_FRAMEBUFFER, luminanceFBO);
+		glViewport(0, 0, LUMINANCE_SIZE, LUMINANCE_SIZE);
+		luminanceShader.use();
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, hdrTexture);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+
+		if (useHistogram)
+		{
+			/* 2-a. log 휘도값 텍스쳐의 texel 마다 point 를 그려서 bin 별 개수 누적 (histogram.vs 하단 필기 참고) */
+			glBindFramebuffer(GL_FRAMEBUFFER, histogramFBO);
+			glViewport(0, 0, BIN_COUNT, 1);
+			glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			histogramShader.use();
+			histogramShader.setFloat("minLogLuminance", minLogLuminance);
+			histogramShader.setFloat("maxLogLuminance", maxLogLuminance);
+			histogramShader.setInt("binCount", BIN_COUNT);
+			glBindTexture(GL_TEXTURE_2D, luminanceTexture);
+
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_ONE, GL_ONE);
+			glDrawArrays(GL_POINTS, 0, LUMINANCE_SIZE * LUMINANCE_SIZE);
+			glDisable(GL_BLEND);
+		}
+		else
+		{
+			/* 2-b. log 휘도값 텍스쳐의 mipmap 을 생성하면 가장 작은(1*1) level 에 전체 평균이 저장됨 */
+			glBindTexture(GL_TEXTURE_2D, luminanceTexture);
+			glGenerateMipmap(GL_TEXTURE_2D);
+		}
+
+		/* 3. 이전 프레임까지 적응된 평균 휘도값을 목표값을 향해 갱신 */
+		unsigned int next = 1 - current;
+		glBindFramebuffer(GL_FRAMEBUFFER, adaptedFBOs[next]);
+		glViewport(0, 0, 1, 1);
+
+		adaptShader.use();
+		adaptShader.setBool("useHistogram", useHistogram);
+		adaptShader.setInt("maxLevel", maxLevel);
+		adaptShader.setFloat("minLogLuminance", minLogLuminance);
+		adaptShader.setFloat("maxLogLuminance", maxLogLuminance);
+		adaptShader.setInt("binCount", BIN_COUNT);
+		adaptShader.setFloat("lowPercent", lowPercent);
+		adaptShader.setFloat("highPercent", highPercent);
+		adaptShader.setFloat("deltaTime", deltaTime);
+		adaptShader.setFloat("speedUp", speedUp);
+		adaptShader.setFloat("speedDown", speedDown);
+		adaptShader.setBool("historyValid", historyValid);
+
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, luminanceTexture);
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, histogramTexture);
+		glActiveTexture(GL_TEXTURE2);
+		glBindTexture(GL_TEXTURE_2D, adaptedTextures[current]);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+		glActiveTexture(GL_TEXTURE0);
+
+		current = next;
+		historyValid = true;
+
+		/* 4. 완료된 readback 결과를 받아온 뒤, 방금 계산된 평균 휘도값을 PBO 로 비동기 복사 요청 */
+		readback.poll();
+		readback.request(0, 0, 1, 1, GL_RED, GL_FLOAT, &AutoExposure::onReadback, this);
+
+		glBindVertexArray(0);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+		if (depthTestEnabled)
+		{
+			glEnable(GL_DEPTH_TEST);
+		}
+	}
+
+	// tone mapping 쉐이더에서 샘플링할, 적응된 평균 휘도값이 저장된 1*1 텍스쳐 반환
+	unsigned int adaptedLuminanceTexture() const
+	{
+		return adaptedTextures[current];
+	}
+
+	// PBO ring 으로 읽어온 가장 최근의 적응된 평균 휘도값 반환 (readbackLatency() 프레임 전에 계산된 값)
+	float readbackLuminance() const
+	{
+		return readbackLum;
+	}
+
+	// 가장 최근에 읽어온 값이 몇 프레임 전에 계산된 값인지 반환
+	unsigned int readbackLatency() const
+	{
+		return readbackFrames;
+	}
+
+private:
+	Shader luminanceShader; // HDR 색상 -> log 휘도값 변환 쉐이더
+	Shader histogramShader; // log 휘도값 히스토그램 누적 쉐이더
+	Shader adaptShader; // 평균 휘도값 계산 및 노출 적응 쉐이더
+
+	unsigned int luminanceTexture; // log 휘도값 텍스쳐 (mipmap 포함)
+	unsigned int luminanceFBO;
+	int maxLevel; // log 휘도값 텍스쳐의 가장 작은(1*1) mip level
+
+	unsigned int histogramTexture; // BIN_COUNT * 1 히스토그램 텍스쳐
+	unsigned int histogramFBO;
+
+	unsigned int adaptedTextures[2]; // 적응된 평균 휘도값 텍스쳐 (ping-pong)
+	unsigned int adaptedFBOs[2];
+	unsigned int current; // 가장 최근에 갱신된 적응 텍스쳐 인덱스
+	bool historyValid; // 이전 프레임의 적응 결과가 있는 지 여부
+
+	AsyncReadback readback; // 적응된 평균 휘도값을 비동기로 읽어올 PBO ring
+	float readbackLum; // 가장 최근에 읽어온 적응된 평균 휘도값
+	unsigned int readbackFrames; // 가장 최근에 읽어온 값의 지연 프레임 수
+
+	unsigned int emptyVAO; // full-screen triangle 및 히스토그램 point 를 그릴 때 바인딩할 빈 VAO
+
+	// readback 이 완료되면 호출되는 콜백 함수 (userData 로 AutoExposure 객체를 전달받음)
+	static void onReadback(const ReadbackResult& result, void* userData)
+	{
+		AutoExposure* self = (AutoExposure*)userData;
+		self->readbackLum = *(const float*)result.data;
+		self->readbackFrames = result.latencyFrames;
+	}
+};
+
+
+#endif // !AUTO_EXPOSURE_H
+
+/*
+	GPU 에서 평균 휘도값 계산하기
+
+
+	자동 노출을 구현하려면 화면 전체의 평균 밝기를 알아야 하는데,
+	glReadPixels() 로 HDR 색상 버퍼를 CPU 로 읽어와서 평균을 내면,
+
+	CPU 는 GPU 가 지금까지 요청된 렌더링 명령을 모두 처리할 때까지 기다려야 하고(stall),
+	그동안 GPU 도 다음 프레임의 명령을 받지 못해서 놀게 됨.
+
+
+	그래서 평균 계산부터 노출 적응까지 모두 GPU 에서 처리하고,
+	그 결과를 1*1 텍스쳐에 저장해서 tone mapping 쉐이더가 직접 샘플링하도록 하면,
+	CPU 는 평균 휘도값을 전혀 몰라도 자동 노출을 적용할 수 있음.
+
+
+	이때, 평균을 낼 때 휘도값 대신 log 휘도값의 평균을 구한 뒤 exp2() 로 되돌리면
+	산술 평균 대신 기하 평균(geometric mean)이 계산되는데,
+
+	기하 평균은 화면 일부의 아주 밝은 광원에 덜 민감해서
+	사람이 느끼는 '전체적인 밝기'에 더 가까움.
+
+
+	또한, 히스토그램 모드에서는 가장 어두운 하위 50% 와 가장 밝은 상위 5% 를 제외하고 평균을 내므로,
+	어두운 배경이나 작은 광원 같은 outlier 때문에 노출이 흔들리는 현상을 더 줄일 수 있음.
+*/
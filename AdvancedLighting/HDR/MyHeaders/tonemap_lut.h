@@ -0,0 +1,226 @@
+#ifndef TONEMAP_LUT_H
+#define TONEMAP_LUT_H
+/*
+	tonemap_lut.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > 3D 텍스쳐 관련 OpenGL 함수가 필요하니까!
+#include <glm/glm.hpp> // color grading 의 색상 필터를 glm::vec3 로 전달받기 위해 include
+
+#include <vector> // LUT 데이터 및 worker thread 들을 동적 배열로 보관하기 위해 include
+#include <thread> // LUT 를 여러 thread 로 나눠서 계산하기 위해 include
+#include <chrono> // LUT 생성에 걸린 시간을 측정하기 위해 include
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+
+/*
+	TonemapLUTParams 구조체
+
+	LUT 에 미리 계산해 둘 tone mapping 이후의 고정 곡선 파라미터
+	(값이 바뀌었을 때만 LUT 를 다시 생성하기 위해 이전 값과 비교함)
+*/
+struct TonemapLUTParams
+{
+	float gamma;
+	bool colorGrading;
+	float contrast;
+	float saturation;
+	glm::vec3 colorFilter;
+
+	// color grading 이 꺼져 있다면 grading 파라미터가 바뀌어도 LUT 결과는 같으므로 비교하지 않음
+	bool operator==(const TonemapLUTParams& other) const
+	{
+		if (gamma != other.gamma || colorGrading != other.colorGrading)
+		{
+			return false;
+		}
+		return !colorGrading || (contrast == other.contrast && saturation == other.saturation && colorFilter == other.colorFilter);
+	}
+};
+
+/*
+	TonemapLUT 클래스
+
+	노출값을 곱한 HDR 색상을 log 로 인코딩한 좌표로 샘플링하면,
+	exposure tone mapping + color grading + gamma correction 이 모두 적용된 최종 색상을 반환하는
+	32*32*32 크기의 3D LUT(Look-Up Table) 텍스쳐를 관리하는 클래스! (하단 필기 참고)
+
+	노출값은 매 프레임 바뀔 수 있으므로 LUT 에 포함하지 않고 쉐이더에서 먼저 곱해주며,
+	LUT 는 update() 에 전달한 파라미터가 이전과 달라졌을 때만 CPU 에서 여러 thread 로 나눠 다시 계산함.
+*/
+class TonemapLUT
+{
+public:
+	static const int LUT_SIZE = 32; // LUT 한 변의 크기
+
+	// log 인코딩할 범위 (log2 단위, 노출값을 곱한 뒤의 HDR 색상 기준)
+	// 2^4 = 16 이상은 exposure tone mapping 결과가 1.0 에 수렴하므로 그 이상의 범위는 필요 없음
+	static constexpr float MIN_LOG2 = -12.0f;
+	static constexpr float MAX_LOG2 = 4.0f;
+
+	unsigned int ID; // 3D LUT 텍스쳐 객체의 참조 id
+
+	// 생성자에서 3D 텍스쳐 객체 생성 및 메모리 할당 (LUT 데이터는 첫 update() 에서 계산)
+	TonemapLUT()
+		: hasParams(false), generationCount(0), lastGenerationMs(0.0), lastThreadCount(0)
+	{
+		glGenTextures(1, &ID);
+		glBindTexture(GL_TEXTURE_3D, ID);
+		glTexImage3D(GL_TEXTURE_3D, 0, GL_RGB16F, LUT_SIZE, LUT_SIZE, LUT_SIZE, 0, GL_RGB, GL_FLOAT, NULL);
+
+		// 인접한 LUT 항목 사이를 trilinear 보간으로 채우기 위해 GL_LINEAR 사용
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_3D, 0);
+
+		data.resize(LUT_SIZE * LUT_SIZE * LUT_SIZE * 3);
+	}
+
+	// 파라미터가 이전과 달라졌을 때만 LUT 를 다시 계산해서 텍스쳐에 업로드 (다시 계산했다면 true 반환)
+	bool update(const TonemapLUTParams& newParams)
+	{
+		if (hasParams && newParams == params)
+		{
+			return false;
+		}
+		params = newParams;
+		hasParams = true;
+
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+		// LUT 의 z 축 slice 들을 thread 개수만큼 나눠서 동시에 계산
+		unsigned int threadCount = std::max(1u, std::min(std::thread::hardware_concurrency(), (unsigned int)LUT_SIZE));
+		std::vector<std::thread> workers;
+		for (unsigned int t = 0; t < threadCount; t++)
+		{
+			int firstSlice = LUT_SIZE * t / threadCount;
+			int lastSlice = LUT_SIZE * (t + 1) / threadCount;
+			workers.push_back(std::thread(&TonemapLUT::fillSlices, this, firstSlice, lastSlice));
+		}
+		for (unsigned int t = 0; t < workers.size(); t++)
+		{
+			workers[t].join();
+		}
+
+		// OpenGL 함수는 컨텍스트가 만들어진 thread 에서만 호출할 수 있으므로, 업로드는 모든 thread 가 끝난 뒤 현재 thread 에서 처리
+		glBindTexture(GL_TEXTURE_3D, ID);
+		glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, LUT_SIZE, LUT_SIZE, LUT_SIZE, GL_RGB, GL_FLOAT, data.data());
+		glBindTexture(GL_TEXTURE_3D, 0);
+
+		std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+		lastGenerationMs = std::chrono::duration<double, std::milli>(end - start).count();
+		generationCount++;
+		lastThreadCount = threadCount;
+
+		return true;
+	}
+
+	// LUT 를 다시 계산한 횟수 반환
+	unsigned int regenerationCount() const
+	{
+		return generationCount;
+	}
+
+	// 마지막으로 LUT 를 계산 및 업로드하는 데 걸린 시간 반환 (millisecond 단위)
+	double lastRegenerationMs() const
+	{
+		return lastGenerationMs;
+	}
+
+	// 마지막으로 LUT 를 계산할 때 사용한 thread 개수 반환
+	unsigned int lastRegenerationThreads() const
+	{
+		return lastThreadCount;
+	}
+
+private:
+	TonemapLUTParams params; // 현재 LUT 에 반영된 파라미터
+	bool hasParams; // LUT 가 한 번이라도 계산되었는 지 여부
+	std::vector<float> data; // CPU 에서 계산한 LUT 데이터 (RGB, x 가 가장 빠르게 변함)
+	unsigned int generationCount;
+	double lastGenerationMs;
+	unsigned int lastThreadCount;
+
+	// LUT 좌표(0 ~ LUT_SIZE - 1)를 노출값이 곱해진 HDR 색상 성분으로 디코딩 (hdr.fs 의 인코딩과 반대)
+	static float decode(int index)
+	{
+		// 가장 어두운 항목은 정확히 0 으로 맵핑해서, 완전히 검은색인 pixel 이 gamma 곡선에 의해 떠오르지 않도록 함
+		if (index == 0)
+		{
+			return 0.0f;
+		}
+		float t = (float)index / (LUT_SIZE - 1);
+		return std::exp2(MIN_LOG2 + t * (MAX_LOG2 - MIN_LOG2));
+	}
+
+	// [firstSlice, lastSlice) 범위의 z 축 slice 들을 계산 (worker thread 에서 실행되므로 OpenGL 함수를 호출하지 않음)
+	void fillSlices(int firstSlice, int lastSlice)
+	{
+		for (int b = firstSlice; b < lastSlice; b++)
+		{
+			for (int g = 0; g < LUT_SIZE; g++)
+			{
+				for (int r = 0; r < LUT_SIZE; r++)
+				{
+					glm::vec3 color(decode(r), decode(g), decode(b));
+
+					// exposure tone mapping (노출값은 쉐이더에서 이미 곱해진 상태)
+					color = glm::vec3(1.0f) - glm::exp(-color);
+
+					// 0.5 를 기준으로 대비 조절 -> 휘도값과 보간하여 채도 조절 -> 색상 필터 적용 (linear space 에서 처리)
+					if (params.colorGrading)
+					{
+						color = glm::clamp((color - glm::vec3(0.5f)) * params.contrast + glm::vec3(0.5f), 0.0f, 1.0f);
+						float luminance = glm::dot(color, glm::vec3(0.2126f, 0.7152f, 0.0722f));
+						color = glm::clamp(glm::mix(glm::vec3(luminance), color, params.saturation), 0.0f, 1.0f);
+						color *= params.colorFilter;
+					}
+
+					// gamma correction
+					color = glm::pow(color, glm::vec3(1.0f / params.gamma));
+
+					size_t offset = ((size_t)(b * LUT_SIZE + g) * LUT_SIZE + r) * 3;
+					data[offset + 0] = color.r;
+					data[offset + 1] = color.g;
+					data[offset + 2] = color.b;
+				}
+			}
+		}
+	}
+};
+
+
+#endif // !TONEMAP_LUT_H
+
+/*
+	3D LUT 로 tone mapping 및 color grading 하기
+
+
+	tone mapping, color grading, gamma correction 은
+	모두 입력 색상만으로 출력 색상이 결정되는 고정된 함수이므로,
+
+	가능한 입력 색상들에 대한 결과를 미리 3D 텍스쳐에 계산해 두면,
+	fragment shader 에서는 exp(), pow() 같은 연산 대신 텍스쳐 샘플링 1번만으로 같은 결과를 얻을 수 있음.
+
+	또한, color grading 처럼 단계가 늘어나더라도
+	LUT 를 계산하는 CPU 비용만 늘어날 뿐, pixel 당 GPU 비용은 항상 샘플링 1번으로 똑같음!
+
+
+	단, HDR 색상은 [0, 1] 범위를 벗어나므로,
+	선형 좌표로 LUT 를 샘플링하면 1.0 이상의 값이 모두 잘려버리고,
+	반대로 범위를 넓히면 어두운 영역에 할당되는 LUT 항목이 너무 적어짐.
+
+	그래서 log2 로 인코딩한 좌표로 샘플링하면,
+	2^-12 ~ 2^4 범위의 밝기마다 같은 개수의 LUT 항목이 할당되어,
+	32 개의 항목만으로도 어두운 영역부터 밝은 영역까지 고르게 표현할 수 있음.
+
+
+	이때, LUT 의 첫 번째 / 마지막 항목의 중심이 정확히 인코딩 범위의 양 끝에 오도록
+	텍스쳐 좌표를 (LUT_SIZE - 1) / LUT_SIZE 로 scale 하고 0.5 / LUT_SIZE 만큼 offset 해서 샘플링해야
+	항목 사이의 trilinear 보간이 올바르게 계산됨. (hdr.fs 참고)
+*/
@@ -0,0 +1,110 @@
+#version 330 core
+
+// 적응된 평균 휘도값 텍스쳐의 내부 포맷이 GL_R32F 이므로, float 타입의 값만 출력함
+out float FragColor;
+
+/*
+  OpenGL 에서 전송해 줄 uniform 변수들 선언
+*/
+
+// mipmap 까지 생성된 log 휘도값 텍스쳐
+uniform sampler2D logLuminance;
+
+// bin 마다 texel 개수가 누적된 히스토그램 텍스쳐
+uniform sampler2D histogram;
+
+// 이전 프레임까지 적응된 평균 휘도값 텍스쳐 (1*1)
+uniform sampler2D prevAdaptedLuminance;
+
+// 히스토그램 모드 여부 (false 면 mipmap 의 가장 작은 level 에 저장된 log 휘도값 평균 사용)
+uniform bool useHistogram;
+
+// log 휘도값 텍스쳐의 가장 작은(1*1) mip level
+uniform int maxLevel;
+
+// 히스토그램으로 나눈 log 휘도값의 범위 및 bin 개수
+uniform float minLogLuminance;
+uniform float maxLogLuminance;
+uniform int binCount;
+
+// 평균에서 제외할 가장 어두운 / 가장 밝은 texel 의 비율 (ex> 0.5, 0.95 면 하위 50%, 상위 5% 제외)
+uniform float lowPercent;
+uniform float highPercent;
+
+// 이전 프레임으로부터의 시간 간격 및 밝아질 때 / 어두워질 때의 적응 속도
+uniform float deltaTime;
+uniform float speedUp;
+uniform float speedDown;
+
+// 이전 프레임의 적응 결과가 유효한 지 여부 (첫 프레임에는 목표 휘도값을 그대로 사용)
+uniform bool historyValid;
+
+// 히스토그램에서 하위 lowPercent ~ 상위 highPercent 구간의 log 휘도값 평균 계산
+float histogramAverage() {
+  // 전체 texel 개수
+  float total = 0.0;
+  for(int i = 0; i < binCount; i++) {
+    total += texelFetch(histogram, ivec2(i, 0), 0).r;
+  }
+
+  // 평균에 포함시킬 누적 개수 구간
+  float low = total * lowPercent;
+  float high = total * highPercent;
+
+  float sum = 0.0;
+  float count = 0.0;
+  float cumulative = 0.0;
+  for(int i = 0; i < binCount; i++) {
+    float binValue = texelFetch(histogram, ivec2(i, 0), 0).r;
+
+    // 현재 bin 이 덮는 누적 개수 구간 [cumulative, cumulative + binValue] 중 [low, high] 와 겹치는 개수만 포함
+    float included = max(min(cumulative + binValue, high) - max(cumulative, low), 0.0);
+    cumulative += binValue;
+
+    // bin 중심의 log 휘도값을 포함된 개수만큼 누산
+    float binLogLum = mix(minLogLuminance, maxLogLuminance, (float(i) + 0.5) / float(binCount));
+    sum += binLogLum * included;
+    count += included;
+  }
+
+  return sum / max(count, 1.0);
+}
+
+void main() {
+  // 현재 프레임의 평균 log 휘도값 계산
+  float avgLogLum = useHistogram ? histogramAverage() : texelFetch(logLuminance, ivec2(0, 0), maxLevel).r;
+
+  // log2 -> 선형 휘도값으로 변환 (기하 평균)
+  float targetLum = exp2(avgLogLum);
+
+  if(!historyValid) {
+    FragColor = targetLum;
+    return;
+  }
+
+  /*
+    시간에 따른 노출 적응 (하단 필기 참고)
+
+    프레임레이트와 관계없이 같은 속도로 적응하도록,
+    deltaTime 을 지수에 곱한 비율만큼 목표값에 가까워짐
+  */
+  float prevLum = texelFetch(prevAdaptedLuminance, ivec2(0, 0), 0).r;
+  float speed = targetLum > prevLum ? speedUp : speedDown;
+  FragColor = prevLum + (targetLum - prevLum) * (1.0 - exp(-deltaTime * speed));
+}
+
+/*
+  노출 적응 (eye adaptation)
+
+
+  어두운 터널에서 밝은 출구를 보거나,
+  밝은 곳에서 갑자기 어두운 곳으로 들어가면,
+  사람의 눈은 바로 적응하지 못하고 몇 초에 걸쳐서 천천히 적응함.
+
+  그래서 매 프레임 계산된 평균 휘도값을 곧바로 노출값에 반영하지 않고,
+  이전 프레임까지 적응된 값에서 목표값을 향해 조금씩 가까워지도록 하면,
+  자연스러운 노출 변화를 표현할 수 있고, 작은 광원 하나 때문에 노출이 깜빡거리는 현상도 줄어듦.
+
+  보통 눈은 밝아질 때보다 어두워질 때 더 천천히 적응하므로,
+  두 경우의 적응 속도를 따로 지정함.
+*/
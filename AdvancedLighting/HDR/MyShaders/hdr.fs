@@ -16,6 +16,35 @@ uniform bool hdr;
 // tone mapping 에 사용할 노출값 (빛이 많을 때 / 적을 때 인간의 홍채, 카메라 조리개와 같은 역할!)
 uniform float exposure;
 
+// 자동 노출 활성화 여부
+uniform bool autoExposure;
+
+// GPU 에서 계산 및 적응된 평균 휘도값이 저장된 1*1 텍스쳐 (auto_exposure.h 참고)
+uniform sampler2D adaptedLuminance;
+
+// 자동 노출 시 평균 휘도값을 맞춰줄 목표 밝기 (middle grey, 보통 0.18 사용)
+uniform float keyValue;
+
+// tone mapping, color grading, gamma correction 을 미리 계산해 둔 3D LUT 사용 여부
+uniform bool useLut;
+
+// 3D LUT 텍스쳐 및 LUT 좌표로 log 인코딩할 범위 (log2 단위, tonemap_lut.h 참고)
+uniform sampler3D tonemapLut;
+uniform float lutMinLog2;
+uniform float lutMaxLog2;
+
+// 노출값이 곱해진 HDR 색상을 log 인코딩한 좌표로 3D LUT 샘플링 (tonemap_lut.h 하단 필기 참고)
+vec3 sampleTonemapLut(vec3 exposedColor) {
+  const float lutSize = 32.0;
+
+  // log2 범위 [lutMinLog2, lutMaxLog2] 를 [0, 1] 범위로 인코딩
+  vec3 encoded = clamp((log2(max(exposedColor, vec3(exp2(lutMinLog2)))) - lutMinLog2) / (lutMaxLog2 - lutMinLog2), 0.0, 1.0);
+
+  // 첫 번째 / 마지막 LUT 항목의 중심을 샘플링하도록 scale 및 offset 적용
+  vec3 uvw = encoded * ((lutSize - 1.0) / lutSize) + 0.5 / lutSize;
+  return texture(tonemapLut, uvw).rgb;
+}
+
 void main() {
   // gamma correction 에 사용할 gamma 값
   const float gamma = 2.2;
@@ -34,8 +63,22 @@ void main() {
     // Reinhard Tone mapping 알고리즘을 사용하여 HDR -> LDR 변환
     // vec3 result = hdrColor / (hdrColor + vec3(1.0));
 
+    // 자동 노출이 활성화되어 있으면, 평균 휘도값이 keyValue 로 맵핑되도록 노출값 계산
+    // (CPU 로 읽어오지 않고 텍스쳐를 직접 샘플링하므로, 평균 휘도값을 기다리느라 stall 이 발생하지 않음)
+    float exposureValue = exposure;
+    if(autoExposure) {
+      float avgLuminance = texelFetch(adaptedLuminance, ivec2(0, 0), 0).r;
+      exposureValue = keyValue / max(avgLuminance, 0.0001);
+    }
+
+    // 3D LUT 를 사용하면 tone mapping 부터 gamma correction 까지 텍스쳐 샘플링 1번으로 처리
+    if(useLut) {
+      FragColor = vec4(sampleTonemapLut(hdrColor * exposureValue), 1.0);
+      return;
+    }
+
     // exposure tone mapping 적용
-    vec3 result = vec3(1.0) - exp(-hdrColor * exposure);
+    vec3 result = vec3(1.0) - exp(-hdrColor * exposureValue);
 
     // linear space 색 공간 유지를 위해 gamma correction 적용하여 최종 색상 출력 (하단 필기 참고)
     result = pow(result, vec3(1.0 / gamma));
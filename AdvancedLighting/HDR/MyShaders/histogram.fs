@@ -0,0 +1,9 @@
+#version 330 core
+
+// 히스토그램 텍스쳐의 내부 포맷이 GL_R32F 이므로, float 타입의 값만 출력함
+out float FragColor;
+
+void main() {
+  // 가산 혼합으로 bin 마다 point 개수를 세기 위해 1.0 출력
+  FragColor = 1.0;
+}
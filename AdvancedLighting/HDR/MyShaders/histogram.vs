@@ -0,0 +1,48 @@
+#version 330 core
+
+/*
+  OpenGL 에서 전송해 줄 uniform 변수들 선언
+*/
+
+// log 휘도값 텍스쳐 (level 0)
+uniform sampler2D logLuminance;
+
+// 히스토그램으로 나눌 log 휘도값의 범위 (log2 단위)
+uniform float minLogLuminance;
+uniform float maxLogLuminance;
+
+// 히스토그램 bin 개수
+uniform int binCount;
+
+void main() {
+  /*
+    정점 데이터 없이 gl_VertexID 만으로
+    log 휘도값 텍스쳐의 texel 1개당 point 1개를 그림 (하단 필기 참고)
+  */
+  int width = textureSize(logLuminance, 0).x;
+  ivec2 coord = ivec2(gl_VertexID % width, gl_VertexID / width);
+  float logLum = texelFetch(logLuminance, coord, 0).r;
+
+  // log 휘도값이 속한 bin 인덱스 계산
+  float t = clamp((logLum - minLogLuminance) / (maxLogLuminance - minLogLuminance), 0.0, 1.0);
+  float bin = min(floor(t * float(binCount)), float(binCount - 1));
+
+  // binCount * 1 크기의 히스토그램 텍스쳐에서 bin 인덱스에 해당하는 pixel 중심으로 point 를 이동
+  gl_Position = vec4((bin + 0.5) / float(binCount) * 2.0 - 1.0, 0.0, 0.0, 1.0);
+  gl_PointSize = 1.0;
+}
+
+/*
+  compute shader 없이 히스토그램 만들기
+
+
+  OpenGL 3.3 에는 compute shader 나 atomic 연산이 없어서
+  각 texel 이 속한 bin 의 개수를 직접 셀 수가 없음.
+
+  대신, texel 마다 point 를 1개씩 그리되,
+  vertex shader 에서 point 의 위치를 해당 texel 이 속한 bin 의 pixel 로 옮기고,
+  fragment shader 에서 1.0 을 출력하면서 glBlendFunc(GL_ONE, GL_ONE) 으로 가산 혼합하면,
+
+  각 bin 에 해당하는 pixel 에는
+  그 bin 에 속한 texel 의 개수가 누적되는 것!
+*/
@@ -0,0 +1,36 @@
+#version 330 core
+
+// log 휘도값 텍스쳐의 내부 포맷이 GL_R16F 이므로, float 타입의 값만 출력함
+out float FragColor;
+
+// 버텍스 쉐이더에서 전송받은 텍스쳐 좌표 입력변수 선언
+in vec2 TexCoords;
+
+/* uniform 변수 선언 */
+
+// hdrBuffer 텍스쳐 (Floating point framebuffer 에 저장된 색상 버퍼)
+uniform sampler2D hdrBuffer;
+
+// 색상의 휘도(luminance)값 계산 (https://github.com/jooo0922/opengl-study/blob/main/AdvancedLighting/Bloom/MyShaders/bloom.fs 참고)
+float luminance(vec3 color) {
+  return dot(color, vec3(0.2126, 0.7152, 0.0722));
+}
+
+void main() {
+  /*
+    log 휘도값 텍스쳐는 스크린보다 해상도가 낮으므로,
+    texel 1개가 덮는 스크린 영역 안에서 4개 위치를 샘플링하여 평균을 냄.
+    (hdrBuffer 는 GL_NEAREST 로 필터링되므로, 4개 위치에서 서로 다른 pixel 이 샘플링됨)
+  */
+  // fwidth() 로 인접 pixel 간 텍스쳐 좌표 차이, 즉 log 휘도값 텍스쳐의 texel 1개 크기(uv 단위)를 구한 뒤 1/4 로 나눔
+  vec2 quarterTexel = 0.25 * fwidth(TexCoords);
+
+  float logLuminance = 0.0;
+  logLuminance += log2(luminance(texture(hdrBuffer, TexCoords + vec2(-quarterTexel.x, -quarterTexel.y)).rgb) + 0.0001);
+  logLuminance += log2(luminance(texture(hdrBuffer, TexCoords + vec2(quarterTexel.x, -quarterTexel.y)).rgb) + 0.0001);
+  logLuminance += log2(luminance(texture(hdrBuffer, TexCoords + vec2(-quarterTexel.x, quarterTexel.y)).rgb) + 0.0001);
+  logLuminance += log2(luminance(texture(hdrBuffer, TexCoords + vec2(quarterTexel.x, quarterTexel.y)).rgb) + 0.0001);
+
+  // 휘도값 대신 log 휘도값을 저장해두면, mipmap 으로 평균을 냈을 때 산술 평균 대신 기하 평균이 계산됨 (auto_exposure.h 하단 필기 참고)
+  FragColor = logLuminance * 0.25;
+}
@@ -13,8 +13,13 @@
 
 #include "MyHeaders/shader_s.h"
 #include "MyHeaders/camera.h"
+#include "MyHeaders/auto_exposure.h"
+#include "MyHeaders/async_readback.h"
+#include "MyHeaders/tonemap_lut.h"
+#include "MyHeaders/render_target_registry.h"
 
 #include <iostream>
+#include <chrono> // readback 벤치마크에서 CPU 가 멈춰있던 시간을 측정하기 위해 include
 
 
 /* 콜백함수 전방선언 */
@@ -40,12 +45,21 @@ void renderCube();
 // shadow map 을 샘플링하여 깊이 버퍼를 시각화할 QuadMesh 를 렌더링하는 함수 선언
 void renderQuad();
 
+// 스크린샷 readback 이 완료되면 호출할 콜백함수 선언 (pixel 데이터를 복사해서 worker thread 로 넘김)
+void onScreenshotReadback(const ReadbackResult& result, void* userData);
+
+// 동기 / 비동기 readback 의 CPU stall 시간을 비교하는 벤치마크 함수 선언
+void benchmarkReadback(unsigned int width, unsigned int height, unsigned int hdrTexture);
+
 
 // 윈도우 창 생성 옵션
 // 너비와 높이는 음수가 없으므로, 부호가 없는 정수형 타입으로 심볼릭 상수 지정 (가급적 전역변수 사용 자제...)
 const unsigned int SCR_WIDTH = 800; // 윈도우 창 너비
 const unsigned int SCR_HEIGHT = 600; // 윈도우 창 높이
 
+// 윈도우 framebuffer 크기가 바뀌면 HDR 프레임버퍼의 render target 들을 재할당할 registry 생성 (render_target_registry.h 필기 참고)
+RenderTargetRegistry renderTargets(SCR_WIDTH, SCR_HEIGHT);
+
 // hdr 활성화 상태값 초기화
 bool hdr = true;
 bool hdrKeyPressed = false;
@@ -53,6 +67,35 @@ bool hdrKeyPressed = false;
 // tone mapping 알고리즘에 사용할 노출값 초기화
 float exposure = 1.0f;
 
+// 자동 노출 활성화 상태값 초기화
+bool autoExposure = true;
+bool autoExposureKeyPressed = false;
+
+// 자동 노출의 평균 휘도값 계산 시 히스토그램 모드 사용 여부 초기화
+bool useHistogram = false;
+bool useHistogramKeyPressed = false;
+
+// 자동 노출 시 평균 휘도값을 맞춰줄 목표 밝기 (middle grey)
+float keyValue = 0.18f;
+
+// tone mapping 에 3D LUT 사용 여부 및 LUT 에 color grading 포함 여부 초기화
+bool useLut = true;
+bool useLutKeyPressed = false;
+bool colorGrading = false;
+bool colorGradingKeyPressed = false;
+
+// color grading 에 사용할 채도값 초기화
+float saturation = 1.2f;
+
+// 스크린샷 및 readback 벤치마크 요청 상태값 초기화
+bool screenshotRequested = false;
+bool screenshotKeyPressed = false;
+bool benchmarkRequested = false;
+bool benchmarkKeyPressed = false;
+
+// 저장한 스크린샷 개수 (파일 이름에 사용)
+unsigned int screenshotCount = 0;
+
 // 카메라 클래스 생성 (카메라 위치값만 매개변수로 전달함.)
 Camera camera(glm::vec3(0.0f, 0.0f, 5.0f));
 
@@ -144,6 +187,12 @@ int main()
 
 	/* HDR 효과를 적용할 프레임버퍼(Floating point framebuffer) 생성 및 설정 */
 
+	// high-DPI 모니터에서는 framebuffer 크기가 윈도우 크기(SCR_WIDTH * SCR_HEIGHT)와 다를 수 있으므로,
+	// render target 들을 등록하기 전에 실제 framebuffer 크기로 출력 해상도를 맞춰줌
+	int framebufferWidth, framebufferHeight;
+	glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+	renderTargets.resize(framebufferWidth, framebufferHeight);
+
 	// FBO(FrameBufferObject) 객체 생성
 	unsigned int hdrFBO;
 	glGenFramebuffers(1, &hdrFBO);
@@ -153,11 +202,6 @@ int main()
 	glGenTextures(1, &colorBuffer);
 	glBindTexture(GL_TEXTURE_2D, colorBuffer);
 
-	// 텍스쳐 객체 메모리 공간 할당 (loadTexture() 와 달리 할당된 메모리에 이미지 데이터를 덮어쓰지 않음! -> 대신 FBO 에서 렌더링된 데이터를 덮어쓸 거니까!)
-	// 텍스쳐 객체의 해상도는 스크린 해상도와 일치시킴 -> 왜냐? 이 텍스쳐는 '스크린 평면'에 적용할 거니까!
-	// 또한, 현재 프레임버퍼를 Floating point framebuffer (부동소수점 지원 프레임버퍼)로 만들기 위해 색상 버퍼 내부 포맷을 GL_RGBA16F 로 지정 (하단 필기 참고)
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-
 	// Texture Filtering(텍셀 필터링(보간)) 모드 설정
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -166,6 +210,12 @@ int main()
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
+	// 텍스쳐 객체 메모리 공간 할당 (loadTexture() 와 달리 할당된 메모리에 이미지 데이터를 덮어쓰지 않음! -> 대신 FBO 에서 렌더링된 데이터를 덮어쓸 거니까!)
+	// 텍스쳐 객체의 해상도는 스크린(framebuffer) 해상도와 일치시킴 -> 왜냐? 이 텍스쳐는 '스크린 평면'에 적용할 거니까!
+	// 또한, 현재 프레임버퍼를 Floating point framebuffer (부동소수점 지원 프레임버퍼)로 만들기 위해 색상 버퍼 내부 포맷을 GL_RGBA16F 로 지정 (하단 필기 참고)
+	// -> registry 에 등록하면 윈도우 크기가 바뀌어도 같은 포맷으로 다시 할당해 줌 (registry 가 텍스쳐 바인딩을 해제하므로, 텍스쳐 파라미터를 먼저 설정한 뒤에 등록)
+	renderTargets.registerTexture(colorBuffer, GL_RGBA16F, GL_RGBA, GL_UNSIGNED_BYTE);
+
 	// FBO 객체에 attach 할 RBO(RenderBufferObject) 객체 생성 및 바인딩
 	unsigned int rboDepth;
 	glGenRenderbuffers(1, &rboDepth);
@@ -173,8 +223,8 @@ int main()
 
 	// RBO 객체 메모리 공간 할당
 	// 단일 Renderbuffer 에 depth 값만 저장하는 데이터 포맷 지정 -> GL_DEPTH_COMPONENT 
-	// 또한, 텍스쳐 객체와 마찬가지로 스크린 해상도와 Renderbuffer 해상도를 일치시킴 -> 그래야 SCR_WIDTH * SCR_HEIGHT 개수 만큼의 데이터 저장 공간 확보 가능!
-	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT, SCR_WIDTH, SCR_HEIGHT);
+	// 또한, 텍스쳐 객체와 마찬가지로 스크린 해상도와 Renderbuffer 해상도를 일치시킴 -> 그래야 framebuffer 너비 * 높이 개수 만큼의 데이터 저장 공간 확보 가능!
+	renderTargets.registerRenderbuffer(rboDepth, GL_DEPTH_COMPONENT);
 
 	// 생성했던 FBO 객체 바인딩
 	glBindFramebuffer(GL_FRAMEBUFFER, hdrFBO);
@@ -211,6 +261,18 @@ int main()
 	shader.setInt("diffuseTexture", 0);
 	hdrShader.use();
 	hdrShader.setInt("hdrBuffer", 0);
+	hdrShader.setInt("adaptedLuminance", 1);
+	hdrShader.setInt("tonemapLut", 2);
+
+	// tone mapping, color grading, gamma correction 을 미리 계산해 둘 3D LUT 생성
+	TonemapLUT tonemapLut;
+
+	// HDR 색상 버퍼의 평균 휘도값을 GPU 에서 계산할 자동 노출 객체 생성
+	AutoExposure autoExposureRenderer;
+
+	// 스크린샷을 비동기로 읽어올 PBO ring 및 파일 인코딩을 처리할 worker thread 생성
+	AsyncReadback screenshotReadback(2);
+	ImageEncodeWorker encodeWorker;
 
 
 	/* 광원 정보 초기화 */
@@ -260,14 +322,24 @@ int main()
 
 		/* First Pass (Floating point framebuffer 에 HDR 효과를 적용할 씬 렌더링) */
 
+		// 윈도우 크기 변경이 멈춘 뒤 일정 시간이 지났다면, HDR 프레임버퍼의 render target 들을 새로운 framebuffer 크기로 재할당
+		if (renderTargets.update(glfwGetTime()))
+		{
+			std::cout << "render targets resized to " << renderTargets.width() << "x" << renderTargets.height()
+				<< " | " << renderTargets.targetCount() << " targets, " << renderTargets.allocatedBytes() / (1024.0 * 1024.0) << " MB"
+				<< " | reallocations: " << renderTargets.reallocationCount() << std::endl;
+		}
+
 		// shadow map 텍스쳐 객체가 attach 된 framebuffer 바인딩
+		// (재할당 대기 중에는 윈도우 크기와 render target 크기가 다를 수 있으므로, 뷰포트는 render target 크기에 맞춤)
 		glBindFramebuffer(GL_FRAMEBUFFER, hdrFBO);
+		glViewport(0, 0, renderTargets.width(), renderTargets.height());
 
 		// 현재 바인딩된 framebuffer 의 색상 및 깊이 버퍼 초기화
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		// 카메라의 zoom 값으로부터 투영 행렬 계산
-		glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+		glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)renderTargets.width() / (float)renderTargets.height(), 0.1f, 100.0f);
 
 		// 카메라 클래스로부터 뷰 행렬(= LookAt 행렬) 가져오기
 		glm::mat4 view = camera.GetViewMatrix();
@@ -311,8 +383,20 @@ int main()
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
 
+		/* Auto Exposure (HDR 색상 버퍼의 평균 휘도값 계산 및 노출 적응) */
+		if (autoExposure)
+		{
+			autoExposureRenderer.useHistogram = useHistogram;
+			autoExposureRenderer.update(colorBuffer, deltaTime);
+		}
+
+
 		/* Second Pass (HDR 효과를 QuadMesh 에 시각화) */
 
+		// 뷰포트를 현재 윈도우 framebuffer 크기로 복구
+		glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+		glViewport(0, 0, framebufferWidth, framebufferHeight);
+
 		// 현재 바인딩된 default framebuffer 의 깊이 버퍼 및 색상 버퍼 초기화
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -331,12 +415,72 @@ int main()
 		// tone mapping 알고리즘에 사용할 노출값 전송
 		hdrShader.setFloat("exposure", exposure);
 
+		// 자동 노출 활성화 여부 및 목표 밝기 전송
+		hdrShader.setBool("autoExposure", autoExposure);
+		hdrShader.setFloat("keyValue", keyValue);
+
+		// 적응된 평균 휘도값 텍스쳐를 1번 texture unit 에 바인딩
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, autoExposureRenderer.adaptedLuminanceTexture());
+
+		// LUT 파라미터가 바뀌었을 때만 CPU 에서 LUT 를 다시 계산한 뒤, 2번 texture unit 에 바인딩
+		TonemapLUTParams lutParams;
+		lutParams.gamma = 2.2f;
+		lutParams.colorGrading = colorGrading;
+		lutParams.contrast = 1.1f;
+		lutParams.saturation = saturation;
+		lutParams.colorFilter = glm::vec3(1.0f, 0.95f, 0.85f);
+		if (tonemapLut.update(lutParams))
+		{
+			std::cout << "tonemap LUT regenerated (#" << tonemapLut.regenerationCount() << ") in " << tonemapLut.lastRegenerationMs()
+				<< " ms on " << tonemapLut.lastRegenerationThreads() << " threads" << std::endl;
+		}
+		glActiveTexture(GL_TEXTURE2);
+		glBindTexture(GL_TEXTURE_3D, tonemapLut.ID);
+		glActiveTexture(GL_TEXTURE0);
+
+		// 3D LUT 사용 여부 및 log 인코딩 범위 전송
+		hdrShader.setBool("useLut", useLut);
+		hdrShader.setFloat("lutMinLog2", TonemapLUT::MIN_LOG2);
+		hdrShader.setFloat("lutMaxLog2", TonemapLUT::MAX_LOG2);
+
 		// QuadMesh 렌더링
 		renderQuad();
 
 
+		/* Readback (스크린샷 및 벤치마크) */
+
+		// 이전 프레임들에서 요청한 스크린샷 중 복사가 완료된 것이 있으면 worker thread 로 넘김
+		screenshotReadback.poll();
+
+		// P 키로 스크린샷이 요청되었다면, tone mapping 까지 끝난 default framebuffer 의 back buffer 를 비동기로 복사 요청
+		if (screenshotRequested)
+		{
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+			if (!screenshotReadback.request(0, 0, framebufferWidth, framebufferHeight, GL_RGB, GL_UNSIGNED_BYTE, onScreenshotReadback, &encodeWorker))
+			{
+				std::cout << "screenshot dropped: previous readbacks are still in flight" << std::endl;
+			}
+			screenshotRequested = false;
+		}
+
+		// B 키로 벤치마크가 요청되었다면, 1080p 및 4K 해상도에서 동기 / 비동기 readback 비교
+		if (benchmarkRequested)
+		{
+			benchmarkReadback(1920, 1080, colorBuffer);
+			benchmarkReadback(3840, 2160, colorBuffer);
+			glViewport(0, 0, framebufferWidth, framebufferHeight);
+			benchmarkRequested = false;
+		}
+
+
 		// hdr 활성화 여부 및 노출값 콘솔 출력
-		std::cout << "hdr: " << (hdr ? "on" : "off") << "| exposure: " << exposure << std::endl;
+		// (자동 노출의 평균 휘도값은 PBO 로 몇 프레임 늦게 읽어온 값이므로, 지연 프레임 수도 함께 출력)
+		std::cout << "hdr: " << (hdr ? "on" : "off") << "| exposure: " << exposure
+			<< "| auto exposure: " << (autoExposure ? (useHistogram ? "histogram" : "mipmap") : "off")
+			<< "| avg luminance: " << autoExposureRenderer.readbackLuminance()
+			<< " (" << autoExposureRenderer.readbackLatency() << " frames late)"
+			<< "| tonemap: " << (useLut ? "3D LUT" : "ALU") << (colorGrading ? " + grading" : "") << "| saturation: " << saturation << std::endl;
 
 
 		// Double Buffer 상에서 Back Buffer 에 픽셀들이 모두 그려지면, Front Buffer 와 교체(swap)해버림.
@@ -348,6 +492,12 @@ int main()
 
 
 	// while 렌더링 루프 탈출 시, GLFWwindow 종료 및 리소스 메모리 해제
+	// 종료 전에 대기 중인 스크린샷 readback 을 모두 받아서 worker thread 로 넘김 (worker thread 는 encodeWorker 소멸 시 남은 작업을 마치고 종료됨)
+	screenshotReadback.flush();
+
+	// screenshotReadback 은 glfwTerminate() 이후에 소멸되므로, OpenGL 컨텍스트가 살아있을 때 PBO 를 미리 해제
+	screenshotReadback.release();
+
 	glfwTerminate();
 
 	return 0;
@@ -545,10 +695,133 @@ void renderQuad()
 }
 
 
+// 스크린샷 readback 이 완료되면 호출할 콜백함수 구현
+void onScreenshotReadback(const ReadbackResult& result, void* userData)
+{
+	ImageEncodeWorker* encodeWorker = (ImageEncodeWorker*)userData;
+
+	// 맵핑된 PBO 데이터는 콜백함수 안에서만 유효하므로, 복사해서 worker thread 로 넘김 (파일 인코딩 및 쓰기는 worker thread 에서 처리)
+	EncodeJob job;
+	job.path = "screenshot_" + std::to_string(screenshotCount++) + ".ppm";
+	job.width = result.width;
+	job.height = result.height;
+	job.components = AsyncReadback::componentCount(result.format);
+	job.pixels.assign(result.data, result.data + result.size);
+
+	std::cout << "screenshot " << job.path << " read back " << result.latencyFrames << " frames after request" << std::endl;
+	encodeWorker->submit(job);
+}
+
+// readback 벤치마크에서 비동기 readback 결과를 집계할 구조체
+struct ReadbackBenchmarkStats
+{
+	unsigned int delivered;
+	unsigned int latencySum;
+};
+
+// 비동기 readback 벤치마크의 콜백함수 (결과 데이터는 사용하지 않고 전달된 개수 및 지연 프레임 수만 집계)
+void onBenchmarkReadback(const ReadbackResult& result, void* userData)
+{
+	ReadbackBenchmarkStats* stats = (ReadbackBenchmarkStats*)userData;
+	stats->delivered++;
+	stats->latencySum += result.latencyFrames;
+}
+
+/*
+	동기 / 비동기 readback 의 CPU stall 시간을 비교하는 벤치마크 함수 구현
+
+	width * height 크기의 GL_RGBA8 프레임버퍼에 tone mapping pass 를 그린 뒤 읽어오는 작업을 반복하면서,
+	glReadPixels() 를 CPU 메모리로 곧바로 호출할 때와 AsyncReadback 으로 요청할 때
+	CPU 가 OpenGL 함수 안에서 멈춰있던 시간을 각각 측정함.
+
+	tone mapping pass 는 Second Pass 에서 바인딩한 쉐이더 및 uniform 상태를 그대로 사용하며, hdrTexture 는 샘플링할 HDR 색상 버퍼임.
+*/
+void benchmarkReadback(unsigned int width, unsigned int height, unsigned int hdrTexture)
+{
+	const int iterations = 16;
+
+	// 벤치마크용 프레임버퍼 생성
+	unsigned int benchFBO, benchTexture;
+	glGenFramebuffers(1, &benchFBO);
+	glBindFramebuffer(GL_FRAMEBUFFER, benchFBO);
+	glGenTextures(1, &benchTexture);
+	glBindTexture(GL_TEXTURE_2D, benchTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, benchTexture, 0);
+	glViewport(0, 0, width, height);
+
+	// tone mapping pass 가 샘플링할 hdrBuffer 텍스쳐를 0번 texture unit 에 다시 바인딩
+	// (벤치마크용 텍스쳐를 생성하면서 0번 texture unit 의 바인딩이 바뀌었으므로)
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, hdrTexture);
+
+	std::vector<unsigned char> cpuBuffer((size_t)width * height * 4);
+
+	/* 동기 readback : glReadPixels() 가 GPU 의 렌더링 및 복사가 끝날 때까지 CPU 를 멈춤 */
+	double syncMs = 0.0;
+	for (int i = 0; i < iterations; i++)
+	{
+		renderQuad();
+
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, cpuBuffer.data());
+		std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+		syncMs += std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	/* 비동기 readback : request() 및 poll() 은 GPU 를 기다리지 않고 즉시 반환됨 */
+	AsyncReadback asyncReadback(3);
+	ReadbackBenchmarkStats stats = { 0, 0 };
+	double asyncMs = 0.0;
+	for (int i = 0; i < iterations; i++)
+	{
+		renderQuad();
+
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		asyncReadback.poll();
+		asyncReadback.request(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, onBenchmarkReadback, &stats);
+		std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+		asyncMs += std::chrono::duration<double, std::milli>(end - start).count();
+
+		// 실제 렌더링 루프에서는 요청 사이에 1 프레임이 지나가므로, 측정 구간 밖에서 GPU 가 이번 프레임을 끝낼 때까지 기다려 프레임 경계를 흉내냄
+		// -> 16 번의 요청을 한 프레임 안에 몰아서 보내면 슬롯이 가득 차서 대부분 버려지고, 버려진 요청이 '빠른 readback' 으로 집계되어 버림
+		glFinish();
+	}
+
+	// 남은 요청은 기다려서 받아옴 (실제 렌더링 루프에서는 다음 프레임들의 poll() 에서 받아오므로 stall 이 아님)
+	std::chrono::high_resolution_clock::time_point flushStart = std::chrono::high_resolution_clock::now();
+	asyncReadback.flush();
+	std::chrono::high_resolution_clock::time_point flushEnd = std::chrono::high_resolution_clock::now();
+	double flushMs = std::chrono::duration<double, std::milli>(flushEnd - flushStart).count();
+
+	// 버려진 요청은 실제로 읽어오지 않았으므로, 슬롯에 들어간 요청 개수로만 평균을 냄
+	unsigned int accepted = iterations - asyncReadback.droppedCount();
+
+	std::cout << "[readback benchmark " << width << "x" << height << "] "
+		<< "sync: " << syncMs / iterations << " ms/read"
+		<< "| async: " << (accepted > 0 ? asyncMs / accepted : 0.0) << " ms/read"
+		<< "| delivered: " << stats.delivered << "/" << iterations
+		<< " (avg latency " << (stats.delivered > 0 ? (float)stats.latencySum / stats.delivered : 0.0f) << " frames"
+		<< ", dropped " << asyncReadback.droppedCount() << ")"
+		<< "| final flush: " << flushMs << " ms" << std::endl;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glDeleteTextures(1, &benchTexture);
+	glDeleteFramebuffers(1, &benchFBO);
+
+	// asyncReadback 의 PBO ring 은 함수 종료 시 소멸자에서 해제됨 (B 키를 누를 때마다 full-res PBO 3개가 새로 할당되므로 해제 필수!)
+}
+
+
 // GLFWwindow 윈도우 창 리사이징 감지 시, 호출할 콜백 함수 정의
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
 	glViewport(0, 0, width, height); // GLFWwindow 상에 렌더링될 뷰포트 영역을 정의. (뷰포트 영역의 좌상단 좌표, 뷰포트 영역의 너비와 높이)
+
+	// HDR 프레임버퍼의 render target 들은 곧바로 재할당하지 않고, 크기 변경이 멈춘 뒤 렌더링 루프에서 한 번만 재할당
+	renderTargets.requestResize(width, height, glfwGetTime());
 }
 
 // GLFW 윈도우에 마우스 입력 감지 시, 호출할 콜백함수 정의
@@ -629,6 +902,97 @@ void processInput(GLFWwindow* window)
 		hdrKeyPressed = false;
 	}
 
+	// X 키 입력 시, 자동 노출 상태값 변경
+	if (glfwGetKey(window, GLFW_KEY_X) == GLFW_PRESS && !autoExposureKeyPressed)
+	{
+		autoExposure = !autoExposure;
+		autoExposureKeyPressed = true;
+	}
+
+	// X 키 입력 해제
+	if (glfwGetKey(window, GLFW_KEY_X) == GLFW_RELEASE)
+	{
+		autoExposureKeyPressed = false;
+	}
+
+	// H 키 입력 시, 평균 휘도값 계산 모드(mipmap <-> 히스토그램) 변경
+	if (glfwGetKey(window, GLFW_KEY_H) == GLFW_PRESS && !useHistogramKeyPressed)
+	{
+		useHistogram = !useHistogram;
+		useHistogramKeyPressed = true;
+	}
+
+	// H 키 입력 해제
+	if (glfwGetKey(window, GLFW_KEY_H) == GLFW_RELEASE)
+	{
+		useHistogramKeyPressed = false;
+	}
+
+	// P 키 입력 시, 스크린샷 요청
+	if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS && !screenshotKeyPressed)
+	{
+		screenshotRequested = true;
+		screenshotKeyPressed = true;
+	}
+
+	// P 키 입력 해제
+	if (glfwGetKey(window, GLFW_KEY_P) == GLFW_RELEASE)
+	{
+		screenshotKeyPressed = false;
+	}
+
+	// B 키 입력 시, readback 벤치마크 요청
+	if (glfwGetKey(window, GLFW_KEY_B) == GLFW_PRESS && !benchmarkKeyPressed)
+	{
+		benchmarkRequested = true;
+		benchmarkKeyPressed = true;
+	}
+
+	// B 키 입력 해제
+	if (glfwGetKey(window, GLFW_KEY_B) == GLFW_RELEASE)
+	{
+		benchmarkKeyPressed = false;
+	}
+
+	// L 키 입력 시, 3D LUT <-> ALU tone mapping 전환
+	if (glfwGetKey(window, GLFW_KEY_L) == GLFW_PRESS && !useLutKeyPressed)
+	{
+		useLut = !useLut;
+		useLutKeyPressed = true;
+	}
+
+	// L 키 입력 해제
+	if (glfwGetKey(window, GLFW_KEY_L) == GLFW_RELEASE)
+	{
+		useLutKeyPressed = false;
+	}
+
+	// G 키 입력 시, LUT 에 color grading 포함 여부 변경 (LUT 재생성)
+	if (glfwGetKey(window, GLFW_KEY_G) == GLFW_PRESS && !colorGradingKeyPressed)
+	{
+		colorGrading = !colorGrading;
+		colorGradingKeyPressed = true;
+	}
+
+	// G 키 입력 해제
+	if (glfwGetKey(window, GLFW_KEY_G) == GLFW_RELEASE)
+	{
+		colorGradingKeyPressed = false;
+	}
+
+	/*
+		T 키 입력 시, 채도값 감소시키고,
+		Y 키 입력 시, 채도값 증가시킴. (키를 누르고 있는 동안 매 프레임 LUT 재생성)
+	*/
+	if (glfwGetKey(window, GLFW_KEY_T) == GLFW_PRESS)
+	{
+		saturation = std::max(saturation - 0.001f, 0.0f);
+	}
+	else if (glfwGetKey(window, GLFW_KEY_Y) == GLFW_PRESS)
+	{
+		saturation += 0.001f;
+	}
+
 	/*
 		Q 키 입력 시, 노출값 감소시키고,
 		E 키 입력 시, 노출값 증가시킴.
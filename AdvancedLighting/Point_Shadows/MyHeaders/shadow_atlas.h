@@ -0,0 +1,256 @@
+#ifndef SHADOW_ATLAS_H
+#define SHADOW_ATLAS_H
+/*
+	shadow_atlas.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > 텍스쳐 및 프레임버퍼 관련 OpenGL 함수가 필요하니까!
+
+// 행렬 및 벡터 계산에서 사용할 Header Only 라이브러리 include
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <iostream>
+
+/*
+	ShadowAtlas 클래스
+
+	여러 광원의 shadow map 을 큰 깊이 텍스쳐 1장에 타일(tile) 단위로 나눠서 저장하는 클래스! (하단 필기 참고)
+
+	- 타일 크기는 maxTileSize 를 절반씩 나눈 2의 거듭제곱 크기(maxTileSize, maxTileSize / 2, ...) 만 사용하며,
+	- 큰 타일을 4등분해서 작은 타일을 만들고(quadtree), 반납된 타일의 형제 4개가 모두 비어 있으면 다시 합쳐서
+	  광원마다 해상도가 바뀌어도 atlas 공간이 조각나지 않도록 관리함.
+	- beginTile() 로 타일 영역에만 뷰포트와 scissor 를 설정하고 깊이 버퍼를 초기화한 뒤 렌더링하면 됨.
+*/
+class ShadowAtlas
+{
+public:
+	// atlas 안에서 할당된 타일 1개의 위치 및 크기 (texel 단위)
+	struct Tile
+	{
+		unsigned int x;
+		unsigned int y;
+		unsigned int size; // 0 이면 할당되지 않은 타일
+	};
+
+	unsigned int ID; // atlas 깊이 텍스쳐 객체의 참조 id
+
+	// 생성자에서 atlas 깊이 텍스쳐 및 프레임버퍼 생성
+	ShadowAtlas(unsigned int atlasSize, unsigned int maxTile, unsigned int minTile)
+		: size(atlasSize), maxTileSize(maxTile), minTileSize(minTile), used(0)
+	{
+		glGenTextures(1, &ID);
+		glBindTexture(GL_TEXTURE_2D, ID);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, size, size, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+
+		// sampler2DShadow 로 샘플링할 때 주변 2x2 texel 의 깊이 비교 결과가 bilinear 필터링되도록 설정
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		glGenFramebuffers(1, &FBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, ID, 0);
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cout << "Shadow atlas framebuffer is not complete!" << std::endl;
+		}
+
+		// 아직 아무것도 그리지 않은 atlas 는 '그림자 없음(깊이 1.0)' 으로 초기화
+		glClear(GL_DEPTH_BUFFER_BIT);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		// 가장 큰 타일 크기 단위로 atlas 전체를 빈 타일 목록에 등록
+		for (unsigned int s = maxTileSize; s >= minTileSize; s /= 2)
+		{
+			freeLists.push_back(std::vector<Tile>());
+		}
+		for (unsigned int y = 0; y + maxTileSize <= size; y += maxTileSize)
+		{
+			for (unsigned int x = 0; x + maxTileSize <= size; x += maxTileSize)
+			{
+				freeLists[0].push_back({ x, y, maxTileSize });
+			}
+		}
+	}
+
+	// tileSize 크기의 타일 할당 (공간이 없으면 size 가 0 인 타일 반환)
+	Tile allocate(unsigned int tileSize)
+	{
+		Tile tile = { 0, 0, 0 };
+		int level = levelOf(tileSize);
+		if (level < 0 || !take(level, tile))
+		{
+			return { 0, 0, 0 };
+		}
+		used += tile.size * tile.size;
+		return tile;
+	}
+
+	// 타일 반납 (형제 타일 4개가 모두 비어 있으면 한 단계 큰 타일로 합침)
+	void release(Tile& tile)
+	{
+		if (tile.size == 0)
+		{
+			return;
+		}
+		used -= tile.size * tile.size;
+		giveBack(levelOf(tile.size), tile);
+		tile.size = 0;
+	}
+
+	// atlas 프레임버퍼 바인딩
+	void bind()
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+	}
+
+	// 타일 영역에만 렌더링되도록 뷰포트와 scissor 를 설정하고, 타일의 깊이 버퍼만 초기화
+	// (glClear 는 뷰포트가 아니라 scissor 영역의 영향을 받으므로, scissor test 를 켜둬야 다른 타일이 지워지지 않음)
+	void beginTile(const Tile& tile)
+	{
+		glViewport(tile.x, tile.y, tile.size, tile.size);
+		glEnable(GL_SCISSOR_TEST);
+		glScissor(tile.x, tile.y, tile.size, tile.size);
+		glClear(GL_DEPTH_BUFFER_BIT);
+	}
+
+	// 타일 렌더링을 마친 뒤 scissor test 비활성화
+	void endTiles()
+	{
+		glDisable(GL_SCISSOR_TEST);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	// 쉐이더에서 타일 안의 [0, 1] uv 좌표를 atlas uv 좌표로 변환할 때 사용할 (offset.x, offset.y, scale, 반 texel 크기)
+	glm::vec4 uvRect(const Tile& tile) const
+	{
+		return glm::vec4((float)tile.x / size, (float)tile.y / size, (float)tile.size / size, 0.5f / size);
+	}
+
+	unsigned int atlasSize() const
+	{
+		return size;
+	}
+
+	// atlas 에서 사용 중인 texel 비율
+	float occupancy() const
+	{
+		return (float)used / ((float)size * size);
+	}
+
+private:
+	unsigned int FBO;
+	unsigned int size;
+	unsigned int maxTileSize;
+	unsigned int minTileSize;
+	unsigned int used; // 할당된 texel 개수
+	std::vector<std::vector<Tile>> freeLists; // 타일 크기 단계별 빈 타일 목록 (0 번이 maxTileSize)
+
+	// 타일 크기에 해당하는 단계 (지원하지 않는 크기면 -1)
+	int levelOf(unsigned int tileSize) const
+	{
+		int level = 0;
+		for (unsigned int s = maxTileSize; s >= minTileSize; s /= 2, level++)
+		{
+			if (s == tileSize)
+			{
+				return level;
+			}
+		}
+		return -1;
+	}
+
+	// level 단계의 빈 타일을 하나 꺼냄 (없으면 한 단계 큰 타일을 4등분해서 만듦)
+	bool take(int level, Tile& tile)
+	{
+		if (freeLists[level].empty())
+		{
+			Tile parent;
+			if (level == 0 || !take(level - 1, parent))
+			{
+				return false;
+			}
+
+			unsigned int half = parent.size / 2;
+			freeLists[level].push_back({ parent.x + half, parent.y + half, half });
+			freeLists[level].push_back({ parent.x, parent.y + half, half });
+			freeLists[level].push_back({ parent.x + half, parent.y, half });
+			freeLists[level].push_back({ parent.x, parent.y, half });
+		}
+
+		tile = freeLists[level].back();
+		freeLists[level].pop_back();
+		return true;
+	}
+
+	// level 단계의 타일을 빈 타일 목록에 돌려놓고, 형제 타일이 모두 비어 있으면 합쳐서 한 단계 큰 타일로 돌려놓음
+	void giveBack(int level, const Tile& tile)
+	{
+		if (level > 0)
+		{
+			unsigned int parentSize = tile.size * 2;
+			unsigned int px = tile.x - tile.x % parentSize;
+			unsigned int py = tile.y - tile.y % parentSize;
+
+			// 형제 타일 3개가 빈 타일 목록에 있는 지 찾음
+			std::vector<unsigned int> siblings;
+			for (unsigned int i = 0; i < freeLists[level].size(); i++)
+			{
+				const Tile& t = freeLists[level][i];
+				if (t.x - t.x % parentSize == px && t.y - t.y % parentSize == py)
+				{
+					siblings.push_back(i);
+				}
+			}
+
+			if (siblings.size() == 3)
+			{
+				// 뒤쪽 인덱스부터 지워야 앞쪽 인덱스가 바뀌지 않음
+				for (int i = 2; i >= 0; i--)
+				{
+					freeLists[level].erase(freeLists[level].begin() + siblings[i]);
+				}
+				giveBack(level - 1, { px, py, parentSize });
+				return;
+			}
+		}
+
+		freeLists[level].push_back(tile);
+	}
+};
+
+
+#endif // !SHADOW_ATLAS_H
+
+/*
+	Shadow atlas
+
+
+	point light 마다 큐브맵 텍스쳐를 따로 만들면,
+	광원 개수만큼 텍스쳐를 바인딩해야 해서 쉐이더에서 사용할 수 있는 texture unit 개수에 금방 막히고,
+	화면에서 아주 작게 보이는 광원도 가까운 광원과 똑같이 1024 * 1024 * 6 면의 메모리와 렌더링 비용을 차지함.
+
+
+	그래서 큰 깊이 텍스쳐 1장(atlas)을 타일로 나눠서
+	각 광원의 큐브맵 6면을 타일 6개에 나눠 담으면,
+
+	1. 텍스쳐 1개만 바인딩해서 모든 광원의 그림자를 샘플링할 수 있고,
+	2. 광원이 화면에서 차지하는 크기(screen coverage)에 따라 타일 크기를 다르게 배분해서
+	   같은 메모리로 화면에 보이는 그림자 품질을 최대한 높일 수 있음.
+
+
+	단, 큐브맵처럼 방향벡터로 곧바로 샘플링할 수는 없으므로,
+	쉐이더에서 방향벡터의 가장 큰 성분으로 큐브맵의 면을 고르고,
+	그 면 안에서의 uv 좌표를 계산한 뒤, 해당 면이 저장된 타일의 위치와 크기로 atlas uv 좌표를 직접 계산해야 함.
+
+	이때 hardware PCF 의 bilinear 필터링이 이웃한 다른 광원의 타일까지 샘플링하지 않도록,
+	타일 안의 uv 좌표를 반 texel 만큼 안쪽으로 clamping 해야 함.
+*/
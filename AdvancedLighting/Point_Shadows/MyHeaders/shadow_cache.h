@@ -0,0 +1,213 @@
+#ifndef SHADOW_CACHE_H
+#define SHADOW_CACHE_H
+/*
+	shadow_cache.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > 텍스쳐 및 프레임버퍼 관련 OpenGL 함수가 필요하니까!
+
+// 행렬 및 벡터 계산에서 사용할 Header Only 라이브러리 include
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <iostream>
+
+/*
+	ShadowCache 클래스
+
+	움직이지 않는 그림자 caster(static caster) 들의 깊이만 따로 렌더링해서 보관해두는 캐시 깊이 텍스쳐를 관리하는 클래스! (하단 필기 참고)
+
+	- shadow map 과 같은 종류(GL_TEXTURE_2D_ARRAY 또는 GL_TEXTURE_CUBE_MAP), 같은 포맷, 같은 해상도의 캐시 텍스쳐를 만들어두고,
+	- layer(cascade 또는 큐브맵의 면) 별로 light space 행렬과 static 씬의 버전을 기억해뒀다가,
+	  둘 중 하나라도 바뀐 layer 만 dirty 로 표시해서 static caster 를 다시 렌더링하게 함.
+	- 매 프레임에는 restore() 로 캐시 layer 를 실제 shadow map layer 에 복사(blit)한 뒤,
+	  그 위에 움직이는 caster(dynamic caster) 만 추가로 렌더링하면 됨.
+*/
+class ShadowCache
+{
+public:
+	unsigned int ID; // static caster 깊이를 보관하는 캐시 텍스쳐 객체의 참조 id
+
+	// 생성자에서 캐시 텍스쳐 및 프레임버퍼 생성 (target 은 GL_TEXTURE_2D_ARRAY 또는 GL_TEXTURE_CUBE_MAP)
+	ShadowCache(GLenum textureTarget, GLenum internalFormat, unsigned int resolution, unsigned int layerCount)
+		: target(textureTarget), size(resolution), layers(textureTarget == GL_TEXTURE_CUBE_MAP ? 6 : layerCount),
+		staticVersion(0), renders(0), restores(0)
+	{
+		glGenTextures(1, &ID);
+		glBindTexture(target, ID);
+		if (target == GL_TEXTURE_CUBE_MAP)
+		{
+			for (unsigned int i = 0; i < 6; i++)
+			{
+				glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, internalFormat, size, size, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+			}
+		}
+		else
+		{
+			glTexImage3D(target, 0, internalFormat, size, size, layers, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+		}
+
+		// 캐시 텍스쳐는 쉐이더에서 샘플링하지 않고 blit 의 원본으로만 사용함
+		glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glBindTexture(target, 0);
+
+		// static caster 를 렌더링할 프레임버퍼 (모든 layer 를 attach 해서 geometry shader 의 gl_Layer 로 렌더링할 수 있도록 함)
+		glGenFramebuffers(1, &FBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, ID, 0);
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cout << "Shadow cache framebuffer is not complete!" << std::endl;
+		}
+
+		// layer 하나씩 깊이를 복사할 때 사용할 read / draw 프레임버퍼
+		glGenFramebuffers(1, &readFBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, readFBO);
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+		glGenFramebuffers(1, &drawFBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, drawFBO);
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		dirty.assign(layers, true);
+		keys.assign(layers, glm::mat4(0.0f));
+	}
+
+	// layer 의 light space 행렬이 이전에 캐시를 렌더링할 때와 달라졌다면 dirty 로 표시 (광원이나 cascade 영역이 바뀐 경우)
+	void track(unsigned int layer, const glm::mat4& lightSpaceMatrix)
+	{
+		if (keys[layer] != lightSpaceMatrix)
+		{
+			keys[layer] = lightSpaceMatrix;
+			dirty[layer] = true;
+		}
+	}
+
+	// static 씬의 버전이 바뀌었다면 모든 layer 를 dirty 로 표시 (static caster 를 옮기거나 추가 / 삭제한 경우)
+	void trackStaticScene(unsigned int version)
+	{
+		if (version != staticVersion)
+		{
+			staticVersion = version;
+			invalidate();
+		}
+	}
+
+	// 모든 layer 를 강제로 dirty 로 표시
+	void invalidate()
+	{
+		dirty.assign(layers, true);
+	}
+
+	bool isDirty(unsigned int layer) const
+	{
+		return dirty[layer];
+	}
+
+	// static caster 를 다시 렌더링한 layer 를 최신 상태로 표시
+	void markClean(unsigned int layer)
+	{
+		dirty[layer] = false;
+		renders++;
+	}
+
+	// 모든 layer 를 attach 해서 바인딩 (geometry shader 로 여러 layer 에 static caster 를 렌더링하는 용도)
+	void bindLayered()
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, ID, 0);
+	}
+
+	// layer 하나만 attach 해서 바인딩 (layer 마다 따로 static caster 를 렌더링하는 용도)
+	void bindLayer(unsigned int layer)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		attach(GL_FRAMEBUFFER, ID, layer);
+	}
+
+	// 캐시 layer 의 깊이값을 실제 shadow map 텍스쳐의 같은 layer 로 복사 (두 텍스쳐의 포맷 및 해상도가 같아야 함)
+	void restore(unsigned int shadowMap, unsigned int layer)
+	{
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, readFBO);
+		attach(GL_READ_FRAMEBUFFER, ID, layer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFBO);
+		attach(GL_DRAW_FRAMEBUFFER, shadowMap, layer);
+		glBlitFramebuffer(0, 0, size, size, 0, 0, size, size, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		restores++;
+	}
+
+	// 지금까지 static caster 를 다시 렌더링한 layer 개수 (누적)
+	unsigned int staticRenderCount() const
+	{
+		return renders;
+	}
+
+	// 지금까지 캐시에서 복사한 layer 개수 (누적)
+	unsigned int restoreCount() const
+	{
+		return restores;
+	}
+
+private:
+	GLenum target;
+	unsigned int size;
+	unsigned int layers;
+	unsigned int FBO;
+	unsigned int readFBO;
+	unsigned int drawFBO;
+	unsigned int staticVersion;
+	unsigned int renders;
+	unsigned int restores;
+	std::vector<bool> dirty; // layer 별 static caster 를 다시 렌더링해야 하는 지 여부
+	std::vector<glm::mat4> keys; // layer 별 캐시를 렌더링할 때 사용한 light space 행렬
+
+	// 텍스쳐의 layer 하나를 현재 바인딩된 프레임버퍼의 깊이 attachment 로 attach (큐브맵은 면 단위로 attach 해야 함)
+	void attach(GLenum framebufferTarget, unsigned int texture, unsigned int layer)
+	{
+		if (target == GL_TEXTURE_CUBE_MAP)
+		{
+			glFramebufferTexture2D(framebufferTarget, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + layer, texture, 0);
+		}
+		else
+		{
+			glFramebufferTextureLayer(framebufferTarget, GL_DEPTH_ATTACHMENT, texture, 0, layer);
+		}
+	}
+};
+
+
+#endif // !SHADOW_CACHE_H
+
+/*
+	Static shadow map caching
+
+
+	shadow map 은 광원 시점에서 씬 전체를 한 번 더 렌더링하는 것이므로,
+	광원도 그대로이고 caster 도 움직이지 않았다면 매 프레임 똑같은 깊이 버퍼를 다시 그리는 셈임.
+
+	그런데 보통의 씬은 바닥, 벽, 건물처럼 움직이지 않는 static caster 가 대부분이고,
+	캐릭터처럼 움직이는 dynamic caster 는 일부에 불과하므로,
+
+	1. static caster 는 캐시 깊이 텍스쳐에 한 번만 렌더링해두고,
+	2. 매 프레임 캐시를 실제 shadow map 으로 복사(blit)한 뒤,
+	3. 그 위에 dynamic caster 만 깊이 테스트를 켠 채로 덧그리면,
+
+	static caster 의 vertex 처리 및 래스터화 비용을 매 프레임 아낄 수 있음.
+	(깊이 버퍼는 '더 가까운 값' 만 남기므로, 두 번에 나눠 그려도 한 번에 그린 것과 결과가 같음)
+
+
+	단, 광원이 움직이거나(light space 행렬이 바뀜), static caster 자체가 바뀌면
+	캐시에 저장된 깊이값이 더 이상 유효하지 않으므로, 해당 layer 의 캐시를 다시 렌더링해야 함.
+
+	이를 위해 layer 별로 캐시를 렌더링할 때의 light space 행렬과 static 씬 버전을 기억해두고,
+	값이 바뀐 layer 만 dirty 로 표시해서 다시 렌더링함.
+
+	(GL 3.3 에는 glCopyImageSubData 가 없으므로, layer 를 하나씩 attach 한 프레임버퍼끼리 glBlitFramebuffer 로 깊이값을 복사함)
+*/
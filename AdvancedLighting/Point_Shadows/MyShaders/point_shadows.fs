@@ -11,17 +11,107 @@ in VS_OUT {
 
 // OpenGL 에서 전송해 줄 uniform 변수들 선언
 uniform sampler2D diffuseTexture; // 바닥 평면 텍스쳐 (0번 texture unit 에 바인딩된 텍스쳐 객체 샘플링)
-uniform samplerCube shadowMap; // omnidirectional shadow map 텍스쳐 (1번 texture unit 에 바인딩된 큐브맵 텍스쳐 객체 샘플링)
+uniform samplerCubeShadow shadowMap; // 깊이 비교 모드로 설정된 omnidirectional shadow map 텍스쳐 (1번 texture unit 에 바인딩된 큐브맵 텍스쳐 객체 샘플링)
 
 uniform vec3 lightPos; // 광원 위치 > 조명벡터 계산에서 사용
 uniform vec3 viewPos; // 카메라 위치 > 뷰 벡터 계산에서 사용
 
 uniform float far_plane; // [0, 1] 사이로 정규화된 '광원 ~ 각 프래그먼트 사이의 월드공간 거리값'을 [0, far_plane] 사이의 거리값으로 복구할 때 사용
 uniform bool shadows; // point shadow 활성화 여부 상태값
+uniform int pcfSamples; // PCF 에서 fetch 할 횟수 (1 이면 현재 방향벡터로 1번만, 8 이면 큐브 꼭짓점 방향, 20 이면 gridSamplingDisk 전체)
+
+/* shadow atlas 모드 관련 uniform 변수 (shadow_atlas.h 필기 참고) */
+uniform bool atlasMode; // true 면 여러 point light 의 그림자를 shadow atlas 로 계산
+uniform sampler2DShadow shadowAtlas; // 모든 광원의 큐브맵 6면을 타일로 나눠 담은 깊이 비교 모드 atlas 텍스쳐 (2번 texture unit)
+uniform int atlasLightCount; // atlas 를 사용하는 광원 개수 (최대 8개)
+uniform vec3 atlasLightPositions[8];
+uniform vec3 atlasLightColors[8];
+uniform float atlasLightRanges[8]; // 광원의 영향 범위 (atlas 에는 '광원 ~ 프래그먼트 거리 / range' 가 저장됨)
+uniform vec4 atlasFaceRects[48]; // 광원 별 6면이 저장된 타일의 (atlas uv offset.xy, uv scale, 반 texel 크기) -> 아직 렌더링되지 않은 면은 scale 이 0
+uniform bool atlasParaboloid; // true 면 광원마다 큐브맵 6면 대신 dual-paraboloid 반구 2개(앞쪽 타일 2개만 사용)로 그림자를 저장
 
 // omnidirectional shadow map 큐브맵으로부터 샘플링할 현재의 방향벡터(광원 ~ 현재 프래그먼트)에 적용할 offset 벡터들을 정적 배열에 초기화
 vec3 gridSamplingDisk[20] = vec3[](vec3(1, 1, 1), vec3(1, -1, 1), vec3(-1, -1, 1), vec3(-1, 1, 1), vec3(1, 1, -1), vec3(1, -1, -1), vec3(-1, -1, -1), vec3(-1, 1, -1), vec3(1, 1, 0), vec3(1, -1, 0), vec3(-1, -1, 0), vec3(-1, 1, 0), vec3(1, 0, 1), vec3(-1, 0, 1), vec3(1, 0, -1), vec3(-1, 0, -1), vec3(0, 1, 1), vec3(0, -1, 1), vec3(0, -1, -1), vec3(0, 1, -1));
 
+// 방향벡터로 큐브맵의 면 인덱스와 그 면 안에서의 [0, 1] uv 좌표를 계산 (OpenGL 이 큐브맵을 샘플링할 때의 규칙과 동일)
+// -> point_shadows.cpp 에서 각 면을 렌더링할 때 사용한 lookAt 행렬이 이 규칙에 맞춰져 있으므로, atlas 타일도 같은 uv 로 샘플링할 수 있음
+int CubeFaceUV(vec3 dir, out vec2 uv) {
+  vec3 absDir = abs(dir);
+  int face;
+  float ma;
+  vec2 sc;
+  if(absDir.x >= absDir.y && absDir.x >= absDir.z) {
+    face = dir.x > 0.0 ? 0 : 1;
+    ma = absDir.x;
+    sc = vec2(dir.x > 0.0 ? -dir.z : dir.z, -dir.y);
+  } else if(absDir.y >= absDir.z) {
+    face = dir.y > 0.0 ? 2 : 3;
+    ma = absDir.y;
+    sc = vec2(dir.x, dir.y > 0.0 ? dir.z : -dir.z);
+  } else {
+    face = dir.z > 0.0 ? 4 : 5;
+    ma = absDir.z;
+    sc = vec2(dir.z > 0.0 ? dir.x : -dir.x, -dir.y);
+  }
+  uv = sc / ma * 0.5 + 0.5;
+  return face;
+}
+
+// 방향벡터로 dual-paraboloid 반구 인덱스(0 : +z, 1 : -z)와 그 반구 안에서의 [0, 1] uv 좌표를 계산
+// -> point_shadows_paraboloid_depth.vs 에서 반구를 렌더링할 때와 같은 변환을 사용해야 함
+int ParaboloidUV(vec3 dir, out vec2 uv) {
+  int face = dir.z >= 0.0 ? 0 : 1;
+  vec3 n = normalize(dir);
+  if(face == 1) {
+    n.xz = -n.xz;
+  }
+  uv = n.xy / (1.0 + n.z) * 0.5 + 0.5;
+  return face;
+}
+
+// shadow atlas 에서 light 번째 광원에 대해 현재 프래그먼트가 그림자 안에 있는지 여부를 반환해주는 함수
+float AtlasShadowCalculation(vec3 fragPos, int light) {
+  vec3 fragToLight = fragPos - atlasLightPositions[light];
+  float currentDepth = length(fragToLight);
+
+  // 방향벡터가 가리키는 큐브맵 면(또는 paraboloid 반구)과 그 면이 저장된 타일을 찾음
+  vec2 faceUV;
+  int face = atlasParaboloid ? ParaboloidUV(fragToLight, faceUV) : CubeFaceUV(fragToLight, faceUV);
+  vec4 rect = atlasFaceRects[light * 6 + face];
+
+  // 아직 한 번도 렌더링되지 않은 면이라면 그림자 영역 밖으로 판정
+  if(rect.z <= 0.0) {
+    return 0.0;
+  }
+
+  // 타일이 작을수록 texel 1개가 덮는 각도가 커지므로, 타일 해상도에 맞춰 bias 를 키워줌 (90도 면의 texel 1개 ~= 거리 * 2 / 타일 해상도)
+  // (paraboloid 는 타일 1개에 180도를 담으므로, 반구 중심의 texel 1개가 덮는 각도는 큐브맵 면의 2배)
+  float tileTexels = rect.z / (2.0 * rect.w);
+  float texelAngle = (atlasParaboloid ? 4.0 : 2.0) / tileTexels;
+  float bias = 0.05 + currentDepth * 3.0 * texelAngle;
+  float refDepth = (currentDepth - bias) / atlasLightRanges[light];
+
+  // 타일 안의 uv -> atlas uv 로 변환한 뒤, PCF fetch 가 이웃 타일을 샘플링하지 않도록 타일 안쪽으로 clamping
+  vec2 uv = rect.xy + faceUV * rect.z;
+  vec2 minUV = rect.xy + vec2(3.0 * rect.w);
+  vec2 maxUV = rect.xy + vec2(rect.z - 3.0 * rect.w);
+
+  if(pcfSamples <= 1) {
+    return 1.0 - texture(shadowAtlas, vec3(clamp(uv, minUV, maxUV), refDepth));
+  }
+
+  // 1 texel 씩 떨어진 4번의 fetch 가 각각 2x2 texel 을 비교하므로, 4x4 texel 을 비교한 PCF 결과를 얻을 수 있음
+  float shadow = 0.0;
+  float texel = 2.0 * rect.w;
+  for(int x = 0; x < 2; x++) {
+    for(int y = 0; y < 2; y++) {
+      vec2 offset = (vec2(x, y) * 2.0 - 1.0) * texel;
+      shadow += 1.0 - texture(shadowAtlas, vec3(clamp(uv + offset, minUV, maxUV), refDepth));
+    }
+  }
+  return shadow / 4.0;
+}
+
 // 현재 프래그먼트가 그림자 안에 있는지 여부를 반환해주는 함수
 float ShadowCalculation(vec3 fragPos) {
   // '광원 ~ 현재 프래그먼트 사이'의 월드공간 벡터 계산
@@ -43,8 +133,16 @@ float ShadowCalculation(vec3 fragPos) {
   */
   float bias = 0.15;
 
-  // PCF 알고리즘을 위해 '광원 ~ 현재 프래그먼트' 방향벡터의 주변을 샘플링할 횟수 -> '광원 ~ 현재 프래그먼트' 방향벡터에 적용할 offset 벡터(== vec3 gridSamplingDisk[20]) 개수와 일치
-  int samples = 20;
+  // shadow testing 시 비교할 기준 깊이값 (큐브맵에는 [0, 1] 사이로 정규화된 거리값이 저장되어 있으므로, bias 를 뺀 거리값도 같은 범위로 정규화)
+  float refDepth = (currentDepth - bias) / far_plane;
+
+  // 큐브맵의 깊이 비교 모드 + GL_LINEAR 필터링 덕분에, fetch 1번으로도 주변 2x2 texel 의 비교 결과가 bilinear 필터링되어 반환됨 (하단 필기 참고)
+  if(pcfSamples <= 1) {
+    return 1.0 - texture(shadowMap, vec4(fragToLight, refDepth));
+  }
+
+  // PCF 알고리즘을 위해 '광원 ~ 현재 프래그먼트' 방향벡터의 주변을 샘플링할 횟수 -> gridSamplingDisk 앞쪽부터 사용 (앞의 8개는 큐브 꼭짓점 방향)
+  int samples = min(pcfSamples, 20);
 
   // 카메라에서 현재 프래그먼트와의 거리 계산
   float viewDistance = length(viewPos - fragPos);
@@ -96,16 +194,10 @@ float ShadowCalculation(vec3 fragPos) {
       원본 방향벡터의 각 컴포넌트들이 일정한 비율로 uniform scaling 되는 것이 아니기 때문에,
       '아예 다른 방향을 갖는 벡터'가 도출된다는 것을 알 수 있음!
     */
-    float closestDepth = texture(shadowMap, fragToLight + gridSamplingDisk[i] * diskRadius).r;
-
-    // 큐브맵에서 가져온 깊이값은 [0, 1] 사이로 정규화된 '광원 ~ 가장 가까운 프래그먼트 사이의 거리값' 으로 저장되었기 때문에, 이를 다시 [0, far_plane] 범위의 값으로 복구시킴
-    closestDepth *= far_plane;
-
-    // 큐브맵에서 샘플링한 깊이값(closestDepth)과 현재 프래그먼트의 깊이값(currentDepth)을 비교하여,
-    // 현재 프래그먼트가 그림자 영역 내에 존재할 때, shadow 값을 누산함
-    if(currentDepth - bias > closestDepth) {
-      shadow += 1.0;
-    }
+    // samplerCubeShadow 는 (방향벡터, 기준 깊이값) 을 전달하면,
+    // 큐브맵에 저장된 깊이값(closestDepth)과 기준 깊이값을 하드웨어에서 비교한 뒤, 그림자 밖인 비율을 [0, 1] 사이로 반환함
+    // -> 이를 1.0 에서 빼면 현재 프래그먼트가 그림자 영역 내에 존재하는 비율이 되므로, shadow 값에 누산함
+    shadow += 1.0 - texture(shadowMap, vec4(fragToLight + gridSamplingDisk[i] * diskRadius, refDepth));
   }
 
   // 누산된 shadow 결과값을 샘플링 횟수로 나눠서 평균을 구함 -> '그림자 영역에 얼마만큼 포함되는지(Percentage-Closer)'의 비율값을 구할 수 있음!
@@ -171,6 +263,31 @@ void main() {
   */
   vec3 lighting = (ambient + (1.0 - shadow) * (diffuse + specular)) * color;
 
+  // shadow atlas 모드에서는 atlas 에 그림자가 저장된 여러 광원의 조명을 누산함
+  if(atlasMode) {
+    lighting = ambient * color;
+    for(int i = 0; i < atlasLightCount; i++) {
+      vec3 toLight = atlasLightPositions[i] - fs_in.FragPos;
+      float lightDistance = length(toLight);
+
+      // 광원의 영향 범위 밖이라면 조명 및 그림자 계산 생략
+      if(lightDistance >= atlasLightRanges[i]) {
+        continue;
+      }
+
+      // 영향 범위 끝에서 0 이 되도록 부드럽게 감쇠
+      float attenuation = 1.0 - lightDistance / atlasLightRanges[i];
+      attenuation *= attenuation;
+
+      vec3 L = toLight / lightDistance;
+      float lightDiff = max(dot(L, normal), 0.0);
+      float lightSpec = pow(max(dot(normal, normalize(L + viewDir)), 0.0), 64.0);
+      float lightShadow = shadows ? AtlasShadowCalculation(fs_in.FragPos, i) : 0.0;
+
+      lighting += (1.0 - lightShadow) * (lightDiff + lightSpec) * atlasLightColors[i] * attenuation * color;
+    }
+  }
+
   FragColor = vec4(lighting, 1.0);
 }
 
@@ -296,4 +413,19 @@ void main() {
 
 	만약, offset 으로 사용하는 단위 texel 의 크기인 texelSize 를 조절하고,
 	주변 texel 샘플링 횟수를 증가시킨다면, 훨씬 더 부드러운 그림자를 렌더링 할 수 있을 것임!
-*/
\ No newline at end of file
+*/
+
+/*
+  Hardware PCF (samplerCubeShadow)
+
+
+  큐브맵 깊이 텍스쳐에 GL_TEXTURE_COMPARE_MODE 를 GL_COMPARE_REF_TO_TEXTURE 로 지정하고
+  samplerCubeShadow 로 샘플링하면, texture(shadowMap, vec4(방향벡터, 기준 깊이값)) 함수가
+  깊이값 대신 '기준 깊이값 <= 저장된 깊이값' 비교 결과를 반환함.
+
+  이때 필터링 모드를 GL_LINEAR 로 지정하면, 샘플링 방향 주변 2x2 texel 각각의 비교 결과를
+  하드웨어가 bilinear 보간해서 반환하므로, fetch 1번이 2x2 texel PCF 역할을 하게 됨.
+
+  그래서 기존처럼 20번 fetch 해서 직접 비교하던 것을,
+  8번(또는 1번) fetch 만으로도 비슷하게 부드러운 그림자 경계를 얻을 수 있음.
+*/
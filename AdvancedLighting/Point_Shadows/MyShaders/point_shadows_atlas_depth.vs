@@ -0,0 +1,20 @@
+#version 330 core
+
+layout(location = 0) in vec3 aPos;
+
+/* 변환 행렬을 전송받는 uniform 변수 선언 */
+
+uniform mat4 model;
+
+// 현재 렌더링 중인 광원의 큐브맵 면(face) 1개에 대한 light space 변환행렬 (atlas 의 타일 1개에 렌더링)
+uniform mat4 shadowMatrix;
+
+// point_shadows_depth.fs 에서 '광원 ~ 프래그먼트 사이의 거리' 를 계산할 수 있도록 월드공간 좌표를 보간해서 전달
+out vec4 FragPos;
+
+void main() {
+  FragPos = model * vec4(aPos, 1.0);
+
+  // geometry shader 없이 면 1개의 light space 로 곧바로 변환 (atlas 는 2D 텍스쳐이므로 gl_Layer 가 필요 없음)
+  gl_Position = shadowMatrix * FragPos;
+}
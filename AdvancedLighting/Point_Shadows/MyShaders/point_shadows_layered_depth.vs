@@ -0,0 +1,49 @@
+#version 330 core
+
+// vertex shader 에서 gl_Layer 에 값을 쓸 수 있도록 해주는 extension (둘 중 하나만 지원해도 됨 -> 하단 필기 참고)
+#extension GL_ARB_shader_viewport_layer_array : enable
+#extension GL_AMD_vertex_shader_layer : enable
+
+layout(location = 0) in vec3 aPos;
+
+/* 변환 행렬을 전송받는 uniform 변수 선언 */
+
+uniform mat4 model;
+
+// 큐브맵의 각 6면을 바라보는 light space 좌표계로 변환해주는 행렬들
+uniform mat4 shadowMatrices[6];
+
+// 현재 오브젝트가 보이는 면들의 index 목록 (instance 마다 하나씩 사용하며, 보이는 면 개수만큼 instancing 으로 렌더링함)
+uniform int faceIndices[6];
+
+// point_shadows_depth.fs 에서 '광원 ~ 프래그먼트 사이의 거리' 를 계산할 수 있도록 월드공간 좌표를 보간해서 전달
+out vec4 FragPos;
+
+void main() {
+  int face = faceIndices[gl_InstanceID];
+
+  FragPos = model * vec4(aPos, 1.0);
+
+  // geometry shader 대신 vertex shader 에서 곧바로 렌더링할 큐브맵 면을 지정
+  gl_Layer = face;
+  gl_Position = shadowMatrices[face] * FragPos;
+}
+
+/*
+  geometry shader 없이 큐브맵의 여러 면에 렌더링하기
+
+
+  point_shadows_depth.gs 는 모든 삼각형을 6면에 복제(amplification)하므로,
+  광원의 한쪽 면에서만 보이는 오브젝트도 항상 6번씩 래스터화되고,
+  geometry shader 의 출력 정점 개수가 가변적이라서 대부분의 GPU 에서 느린 편임.
+
+
+  그래서 CPU 에서 오브젝트의 bounding sphere 를 큐브맵 면 별 frustum 과 미리 비교한 뒤,
+  보이는 면 개수만큼만 instancing 으로 그리고, 각 instance 가 gl_InstanceID 로 자신이 그릴 면을 골라
+  vertex shader 에서 곧바로 gl_Layer 를 지정하면, geometry shader 단계를 통째로 생략할 수 있음.
+
+
+  단, GLSL 330 에서는 gl_Layer 가 geometry shader 의 출력 변수이므로,
+  vertex shader 에서 쓰려면 GL_ARB_shader_viewport_layer_array 또는 GL_AMD_vertex_shader_layer extension 이 필요함.
+  (지원하지 않는 드라이버에서는 면마다 프레임버퍼에 면 1개만 attach 해서 따로 렌더링하는 방식으로 대체함)
+*/
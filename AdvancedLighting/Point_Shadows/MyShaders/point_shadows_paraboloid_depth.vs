@@ -0,0 +1,50 @@
+#version 330 core
+
+layout(location = 0) in vec3 aPos;
+
+/* uniform 변수 선언 */
+
+uniform mat4 model;
+
+// 광원 위치 및 영향 범위 (point_shadows_depth.fs 와 같은 값으로 거리를 [0, 1] 로 정규화)
+uniform vec3 lightPos;
+uniform float far_plane;
+
+// 렌더링할 반구 (1 이면 광원 기준 +z 쪽 반구, -1 이면 y 축으로 180도 돌려서 -z 쪽 반구)
+uniform float hemisphere;
+
+// point_shadows_depth.fs 에서 '광원 ~ 프래그먼트 사이의 거리' 를 계산할 수 있도록 월드공간 좌표를 보간해서 전달
+out vec4 FragPos;
+
+void main() {
+  FragPos = model * vec4(aPos, 1.0);
+
+  // 광원 기준 방향벡터를 반구 좌표계로 변환 (x, z 를 함께 뒤집으면 y 축 180도 회전이므로 삼각형의 감기는 방향이 유지됨)
+  vec3 dir = FragPos.xyz - lightPos;
+  dir.xz *= hemisphere;
+  float lightDistance = length(dir);
+  vec3 n = dir / lightDistance;
+
+  // 포물면(paraboloid) 투영 : 반구 전체의 방향벡터를 반지름 1 인 원 안의 좌표로 펼침 (하단 필기 참고)
+  // 깊이는 원근 투영 대신 [0, 1] 로 정규화한 거리를 [-1, 1] 로 옮겨서 사용하므로, far_plane 너머의 정점은 깊이 clipping 됨
+  gl_Position = vec4(n.xy / (1.0 + n.z), lightDistance / far_plane * 2.0 - 1.0, 1.0);
+
+  // 반대쪽 반구에 있는 정점은 잘라냄 (경계에서 두 반구가 살짝 겹치도록 여유를 줌)
+  gl_ClipDistance[0] = n.z + 0.1;
+}
+
+/*
+  Dual-paraboloid shadow map
+
+
+  큐브맵 shadow map 은 광원 주변 전체를 6면으로 나눠서 caster 를 6번 렌더링해야 하는데,
+  반구 하나를 포물면 거울에 비친 모습처럼 원 안에 펼치면(uv = n.xy / (1 + n.z)),
+  반구 2개, 즉 2번의 렌더링만으로 광원 주변 전체를 담을 수 있음.
+
+  단, 이 변환은 원근 투영과 달리 직선을 곡선으로 휘게 만드는 비선형 변환인데,
+  래스터라이저는 정점 사이를 직선으로 이어서 채우므로 삼각형이 클수록 깊이와 모양이 틀어짐.
+  그래서 dual-paraboloid 를 쓰려면 caster 를 충분히 잘게 쪼갠(tessellation) 메쉬로 렌더링해야 하고,
+  반구 경계 근처의 texel 은 중심보다 넓은 각도를 덮으므로 그림자 품질이 큐브맵보다 떨어짐.
+
+  즉, 광원이 많아서 광원 당 caster pass 횟수(6 -> 2)를 줄이는 게 품질보다 중요한 씬에서 고려할 만한 기법!
+*/
@@ -13,8 +13,44 @@
 
 #include "MyHeaders/shader_s.h"
 #include "MyHeaders/camera.h"
+#include "MyHeaders/gpu_timer.h"
+#include "MyHeaders/shadow_cache.h"
+#include "MyHeaders/shadow_atlas.h"
 
 #include <iostream>
+#include <vector>
+#include <string>
+#include <utility>
+#include <functional>
+
+
+// shadow atlas 모드에서 사용할 point light 1개의 정보
+struct AtlasLight
+{
+	glm::vec3 center; // 광원이 원을 그리며 움직일 중심
+	float orbitRadius;
+	float speed;
+	float phase; // 현재 회전 각도 (광원이 멈춰 있는 동안에는 증가하지 않음)
+	glm::vec3 color;
+	float range; // 광원의 영향 범위 (= 면 별 원근 투영행렬의 far plane)
+	glm::vec3 position;
+	unsigned int desiredTileSize; // screen coverage 로 계산한 타일 해상도
+	unsigned int tileSize; // 실제로 할당된 타일 해상도 (atlas 공간이 부족하면 desiredTileSize 보다 작을 수 있음)
+	ShadowAtlas::Tile tiles[6]; // 큐브맵 6면이 저장된 타일
+	bool dirty[6]; // 면을 다시 렌더링해야 하는 지 여부
+	bool ready[6]; // 현재 타일에 한 번이라도 렌더링했는 지 여부 (false 면 샘플링하지 않음)
+	unsigned int waitFrames[6]; // dirty 가 된 뒤 예산 부족으로 렌더링이 미뤄진 프레임 수
+};
+
+// 씬에 배치할 큐브 1개의 정보 (shadow pass 에서 큐브맵 면 별 culling 에 사용할 world space bounding sphere 포함)
+struct SceneObject
+{
+	glm::mat4 model;
+	bool isRoom; // true 면 안쪽 면을 렌더링하는 Room 큐브
+	bool dynamic; // true 면 매 프레임 움직이는 caster (shadow cache 에 저장하지 않고 매 프레임 다시 렌더링)
+	glm::vec3 center;
+	float radius;
+};
 
 
 /* 콜백함수 전방선언 */
@@ -34,11 +70,40 @@ void processInput(GLFWwindow* window);
 // 텍스쳐 이미지 로드 및 객체 생성 함수 선언 (텍스쳐 객체 참조 id 반환)
 unsigned int loadTexture(const char* path);
 
-// shadow map 에 깊이 버퍼를 저장할 씬을 렌더링하는 함수 선언
-void renderScene(const Shader& shader);
+// renderScene() 함수에서 렌더링할 caster 종류
+enum SceneCasters
+{
+	CASTERS_STATIC = 1, // Room 큐브 및 움직이지 않는 큐브들
+	CASTERS_DYNAMIC = 2, // 회전하는 큐브
+	CASTERS_ALL = CASTERS_STATIC | CASTERS_DYNAMIC
+};
+
+// 큐브맵 shadow map 의 6면을 렌더링하는 방식 (G 키로 순환)
+enum CubeShadowPath
+{
+	CUBE_PATH_GEOMETRY_SHADER = 0, // geometry shader 가 모든 삼각형을 6면으로 복제
+	CUBE_PATH_INSTANCED = 1, // 오브젝트가 보이는 면 개수만큼 instancing 하고, vertex shader 에서 gl_Layer 지정
+	CUBE_PATH_PER_FACE = 2 // 면마다 프레임버퍼에 면 1개만 attach 해서 보이는 오브젝트만 렌더링
+};
+
+// shadow map 에 깊이 버퍼를 저장할 씬을 렌더링하는 함수 선언 (렌더링한 오브젝트 개수 반환)
+// (positionOnly 가 true 면 위치값만 저장된 정점 버퍼로 렌더링 -> depth pass 에서 사용)
+unsigned int renderScene(const Shader& shader, int casters = CASTERS_ALL, const std::vector<bool>* visible = nullptr, bool positionOnly = false);
+
+// 씬에 배치된 오브젝트 1개를 렌더링하는 함수 선언
+void renderSceneObject(const Shader& shader, const SceneObject& object, unsigned int instances = 1, bool positionOnly = false);
+
+// 씬에 큐브를 렌더링하는 함수 선언 (instances 가 1 보다 크면 instancing 으로 렌더링, positionOnly 가 true 면 위치값 전용 VAO 로 렌더링)
+void renderCube(unsigned int instances = 1, bool positionOnly = false);
+
+// 면마다 잘게 쪼갠 위치값 전용 큐브를 렌더링하는 함수 선언 (dual-paraboloid 처럼 비선형 변환을 적용하는 depth pass 용)
+void renderSubdividedCube();
 
-// 씬에 큐브를 렌더링하는 함수 선언
-void renderCube();
+// bounding sphere 가 광원 큐브맵의 face 번째 면의 시야(90도 frustum) 안에 들어오는 지 검사하는 함수 선언
+bool sphereInCubeFace(const glm::vec3& lightPos, unsigned int face, const glm::vec3& center, float radius, float farPlane);
+
+// 광원의 screen coverage 로 shadow atlas 타일 해상도를 결정하는 함수 선언
+unsigned int atlasTileSize(float coverage, unsigned int currentSize);
 
 
 // 윈도우 창 생성 옵션
@@ -50,6 +115,48 @@ const unsigned int SCR_HEIGHT = 600; // 윈도우 창 높이
 bool shadows = true;
 bool shadowKeyPressed = false;
 
+// hardware PCF 에서 fetch 할 횟수를 전역변수로 선언 (P 키로 1 -> 8 -> 20 순환)
+int pcfSamples = 8;
+bool pcfSamplesKeyPressed = false;
+
+// static caster 를 shadow cache 에 저장해두고 재사용할 지 여부 (C 키로 on/off)
+bool shadowCaching = true;
+bool shadowCachingKeyPressed = false;
+
+// 광원을 움직일 지 여부 (M 키로 on/off -> 광원이 멈춰 있어야 shadow cache 를 재사용할 수 있음)
+bool lightMoving = true;
+bool lightMovingKeyPressed = false;
+
+// shadow cache 를 다시 켤 때 캐시 전체를 무효화하기 위한 static 씬 버전
+unsigned int staticSceneVersion = 0;
+
+// 씬에 배치할 오브젝트 목록 (renderScene() 함수에서 참조)
+std::vector<SceneObject> sceneObjects;
+
+// 큐브맵 shadow map 의 6면을 렌더링하는 방식 (G 키로 순환)
+int cubeShadowPath = CUBE_PATH_GEOMETRY_SHADER;
+bool cubeShadowPathKeyPressed = false;
+
+// vertex shader 에서 gl_Layer 를 쓸 수 있는 extension 지원 여부 (지원하지 않으면 instancing 경로는 면 별 렌더링으로 대체)
+bool vertexLayerSupported = false;
+
+// 여러 point light 의 그림자를 shadow atlas 로 렌더링할 지 여부 (T 키로 on/off)
+bool atlasMode = false;
+bool atlasModeKeyPressed = false;
+
+// shadow atlas 모드에서 한 프레임에 다시 렌더링할 수 있는 최대 면 개수 (B 키로 6 -> 12 -> 24 -> 48 순환)
+unsigned int atlasFaceBudget = 12;
+bool atlasFaceBudgetKeyPressed = false;
+
+// shadow atlas 모드에서 광원마다 큐브맵 6면 대신 dual-paraboloid 반구 2개로 그림자를 렌더링할 지 여부 (Y 키로 on/off)
+bool atlasParaboloid = false;
+bool atlasParaboloidKeyPressed = false;
+
+// shadow atlas 타일 해상도 범위
+const unsigned int ATLAS_SIZE = 2048;
+const unsigned int ATLAS_MAX_TILE = 512;
+const unsigned int ATLAS_MIN_TILE = 64;
+
 // 카메라 클래스 생성 (카메라 위치값만 매개변수로 전달함.)
 Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
 
@@ -144,6 +251,28 @@ int main()
 	// second pass 를 렌더링할 때 적용할 쉐이더 객체 생성
 	Shader shader("MyShaders/point_shadows.vs", "MyShaders/point_shadows.fs");
 
+	// geometry shader 없이 instancing 으로 큐브맵의 보이는 면에만 렌더링할 쉐이더 객체 생성 (point_shadows_layered_depth.vs 필기 참고)
+	// -> vertex shader 에서 gl_Layer 를 쓰려면 extension 이 필요하므로, 지원하는 드라이버에서만 컴파일함
+	GLint extensionCount = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+	for (GLint i = 0; i < extensionCount; i++)
+	{
+		std::string extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+		if (extension == "GL_ARB_shader_viewport_layer_array" || extension == "GL_AMD_vertex_shader_layer")
+		{
+			vertexLayerSupported = true;
+		}
+	}
+	Shader* layeredDepthShader = nullptr;
+	if (vertexLayerSupported)
+	{
+		layeredDepthShader = new Shader("MyShaders/point_shadows_layered_depth.vs", "MyShaders/point_shadows_depth.fs");
+	}
+	else
+	{
+		std::cout << "gl_Layer in vertex shader is not supported, instanced path falls back to per-face rendering" << std::endl;
+	}
+
 
 	/* 텍스쳐 객체 생성 및 쉐이더 프로그램 전송 */
 
@@ -178,8 +307,13 @@ int main()
 	}
 
 	// Texture Filtering(텍셀 필터링(보간)) 모드 설정
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	// (GL_LINEAR 로 설정하면, samplerCubeShadow 로 샘플링할 때 주변 2x2 texel 의 깊이 비교 결과가 bilinear 필터링됨)
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// 깊이값 대신 깊이 비교 결과를 반환하도록 깊이 비교 모드 설정 (point_shadows.fs 필기 참고)
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
 
 	// Over Sampling 이슈를 방지하기 위해, Texture Wrapping 모드를 clamp to border 로 설정 (관련 내용 하단 필기 참고)
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
@@ -209,10 +343,107 @@ int main()
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
 
+	// static caster 의 깊이만 큐브맵 면 별로 보관해 둘 shadow cache 생성 (shadow_cache.h 필기 참고)
+	// (깊이값을 blit 으로 복사하려면 포맷이 같아야 하므로, depthCubeMap 과 같은 GL_DEPTH_COMPONENT 포맷 사용)
+	ShadowCache shadowCache(GL_TEXTURE_CUBE_MAP, GL_DEPTH_COMPONENT, SHADOW_WIDTH, 6);
+
+	// shadow pass 가 GPU 에서 실행되는 데 걸린 시간을 측정할 타이머 생성
+	GpuTimer shadowTimer;
+
+
+	/* 여러 point light 의 큐브맵 6면을 타일로 나눠 담을 shadow atlas 생성 (shadow_atlas.h 필기 참고) */
+
+	ShadowAtlas atlas(ATLAS_SIZE, ATLAS_MAX_TILE, ATLAS_MIN_TILE);
+
+	// geometry shader 없이 면 1개씩 atlas 타일에 렌더링할 쉐이더 객체 생성 (프래그먼트 쉐이더는 큐브맵과 같은 거리값을 기록하므로 재사용)
+	Shader atlasDepthShader("MyShaders/point_shadows_atlas_depth.vs", "MyShaders/point_shadows_depth.fs");
+
+	// 반구 1개를 paraboloid 로 펼쳐서 atlas 타일에 렌더링할 쉐이더 객체 생성 (point_shadows_paraboloid_depth.vs 필기 참고)
+	Shader paraboloidDepthShader("MyShaders/point_shadows_paraboloid_depth.vs", "MyShaders/point_shadows_depth.fs");
+
+	// 현재 atlas 타일이 할당된 방식 (Y 키로 방식을 바꾸면 모든 광원의 타일을 다시 할당)
+	bool atlasTilesParaboloid = atlasParaboloid;
+
+	// 방식 별로 마지막으로 측정한 '광원 1개의 모든 면을 다시 렌더링하는 데 걸리는 시간' 추정치 (0 : 큐브맵, 1 : dual-paraboloid)
+	double atlasLightMs[2] = { 0.0, 0.0 };
+
+	// 큐브맵 각 면을 바라보는 방향 및 up 벡터 (omnidirectional shadow map 의 shadowTransforms 와 같은 순서와 값)
+	const glm::vec3 faceDirections[6] = {
+		glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f),
+		glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f)
+	};
+	const glm::vec3 faceUps[6] = {
+		glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f),
+		glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)
+	};
+
+	// Room 큐브 안에 배치할 광원들 (중심, 회전 반지름, 회전 속도, 초기 각도, 색상, 영향 범위)
+	std::vector<AtlasLight> atlasLights;
+	const glm::vec3 atlasLightSetup[6][2] = {
+		{ glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.9f, 0.8f) },
+		{ glm::vec3(3.0f, -2.5f, 3.0f), glm::vec3(1.0f, 0.3f, 0.3f) },
+		{ glm::vec3(-3.0f, -2.5f, 3.0f), glm::vec3(0.3f, 1.0f, 0.3f) },
+		{ glm::vec3(3.0f, 2.5f, -3.0f), glm::vec3(0.3f, 0.3f, 1.0f) },
+		{ glm::vec3(-3.0f, 2.5f, -3.0f), glm::vec3(1.0f, 1.0f, 0.3f) },
+		{ glm::vec3(0.0f, -3.5f, -3.0f), glm::vec3(1.0f, 0.3f, 1.0f) }
+	};
+	for (unsigned int l = 0; l < 6; l++)
+	{
+		AtlasLight light;
+		light.center = atlasLightSetup[l][0];
+		light.orbitRadius = l == 0 ? 0.0f : 1.0f;
+		light.speed = 0.3f + 0.15f * l;
+		light.phase = 1.3f * l;
+		light.color = atlasLightSetup[l][1];
+		light.range = l == 0 ? 6.0f : 4.5f;
+		light.position = glm::vec3(1e30f);
+		light.desiredTileSize = 0;
+		light.tileSize = 0;
+		for (unsigned int f = 0; f < 6; f++)
+		{
+			light.tiles[f] = { 0, 0, 0 };
+			light.dirty[f] = true;
+			light.ready[f] = false;
+			light.waitFrames[f] = 0;
+		}
+		atlasLights.push_back(light);
+	}
+
+
+	/* 씬에 배치할 오브젝트 목록 초기화 (크기가 2 인 큐브를 scale 한 것이므로, bounding sphere 반지름은 scale * sqrt(3)) */
+
+	// 다섯 번째 큐브 (dynamic caster, 모델행렬은 렌더링 루프에서 매 프레임 갱신)
+	const unsigned int dynamicCubeIndex = (unsigned int)sceneObjects.size();
+	sceneObjects.push_back({ glm::mat4(1.0f), false, true, glm::vec3(-1.5f, 2.0f, -3.0f), 0.75f * std::sqrt(3.0f) });
+
+	// Room 큐브 (광원이 항상 안쪽에 있으므로, 큐브맵의 모든 면에서 보임)
+	sceneObjects.push_back({ glm::scale(glm::mat4(1.0f), glm::vec3(5.0f)), true, false, glm::vec3(0.0f), 5.0f * std::sqrt(3.0f) });
+
+	// 나머지 static 큐브들 (위치, scale)
+	const glm::vec4 staticCubes[4] = {
+		glm::vec4(4.0f, -3.5f, 0.0f, 0.5f), glm::vec4(2.0f, 3.0f, 1.0f, 0.75f),
+		glm::vec4(-3.0f, -1.0f, 0.0f, 0.5f), glm::vec4(-1.5f, 1.0f, 1.5f, 0.5f)
+	};
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		glm::vec3 position = glm::vec3(staticCubes[i]);
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
+		model = glm::scale(model, glm::vec3(staticCubes[i].w));
+		sceneObjects.push_back({ model, false, false, position, staticCubes[i].w * std::sqrt(3.0f) });
+	}
+
+	// 면 별 culling 결과 (faceVisible[f][i] : i 번째 오브젝트가 f 번째 면에서 보이는 지 여부)
+	std::vector<bool> faceVisible[6];
+
+	// 방식 별로 마지막으로 측정한 shadow pass 소요 시간 (방식을 바꿔가며 비교하기 위해 보관)
+	double cubePathMs[3] = { 0.0, 0.0, 0.0 };
+
+
 	// second pass 프래그먼트 쉐이더에 선언된 uniform sampler 변수(diffuse map, shadow map) 각각에 0번, 1번 texture unit 위치값 전송
 	shader.use();
 	shader.setInt("diffuseTexture", 0);
 	shader.setInt("shadowMap", 1);
+	shader.setInt("shadowAtlas", 2);
 
 
 	// 광원 위치값 초기화
@@ -235,7 +466,16 @@ int main()
 
 
 		// 경과시간에 따라 광원의 z 좌표값을 [-3.0, 3.0] 사이의 값으로 움직여주기
-		lightPos.z = static_cast<float>(sin(glfwGetTime() * 0.5) * 3.0);
+		if (lightMoving)
+		{
+			lightPos.z = static_cast<float>(sin(glfwGetTime() * 0.5) * 3.0);
+		}
+
+		// 경과시간에 따라 다섯 번째 큐브(dynamic caster) 회전
+		SceneObject& dynamicCube = sceneObjects[dynamicCubeIndex];
+		dynamicCube.model = glm::translate(glm::mat4(1.0f), dynamicCube.center);
+		dynamicCube.model = glm::rotate(dynamicCube.model, glm::radians(60.0f + currentFrame * 45.0f), glm::normalize(glm::vec3(1.0f, 0.0f, 1.0f)));
+		dynamicCube.model = glm::scale(dynamicCube.model, glm::vec3(0.75f));
 
 
 		// 윈도우 창 및 키 입력 감지 밎 이벤트 처리
@@ -281,29 +521,385 @@ int main()
 		// GLFWwindow 상에 렌더링될 뷰포트 영역을 shadow map 해상도에 맞게 resize
 		glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
 
-		// shadow map 텍스쳐 객체가 attach 된 framebuffer 바인딩
-		glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
+		// shadow pass 의 GPU 소요 시간 측정 시작
+		shadowTimer.begin();
+
+		// 이번 프레임에 atlas 에 렌더링한 면 개수, 예산 부족으로 미뤄진 면 개수, 타일을 다시 할당한 광원 개수
+		unsigned int facesRendered = 0;
+		unsigned int facesPending = 0;
+		unsigned int tileChanges = 0;
 
-		// 현재 바인딩된 framebuffer 의 깊이 버퍼 초기화
-		glClear(GL_DEPTH_BUFFER_BIT);
+		// 이번 프레임에 static caster 를 다시 렌더링했는 지 여부
+		bool staticRerendered = false;
 
-		// uniform 변수를 전송할 쉐이더 객체 바인딩
-		simpleDepthShader.use();
+		// 이번 프레임에 큐브맵 면 단위로 렌더링한 오브젝트 개수 (geometry shader 경로는 모든 오브젝트를 6면에 렌더링)
+		unsigned int faceDraws = 0;
 
-		// 지오메트리 쉐이더에서 각 정점들을 큐브맵의 각 6면의 light space 로 변환시킬 때 사용할 변환행렬 전송
-		for (unsigned int i = 0; i < 6; i++)
+		// 실제로 사용한 큐브맵 렌더링 방식 (instancing 을 지원하지 않으면 면 별 렌더링으로 대체)
+		int activeCubePath = cubeShadowPath;
+		if (activeCubePath == CUBE_PATH_INSTANCED && !vertexLayerSupported)
 		{
-			simpleDepthShader.setMat4("shadowMatrices[" + std::to_string(i) + "]", shadowTransforms[i]);
+			activeCubePath = CUBE_PATH_PER_FACE;
 		}
+
+		if (!atlasMode)
+		{
+			// uniform 변수를 전송할 쉐이더 객체 바인딩
+			simpleDepthShader.use();
+
+			// 지오메트리 쉐이더에서 각 정점들을 큐브맵의 각 6면의 light space 로 변환시킬 때 사용할 변환행렬 전송
+			for (unsigned int i = 0; i < 6; i++)
+			{
+				simpleDepthShader.setMat4("shadowMatrices[" + std::to_string(i) + "]", shadowTransforms[i]);
+			}
 		
-		// 프래그먼트 쉐이더에서 '조명으로부터 각 프래그먼트까지의 월드 공간 거리값'을 [0, 1] 사이로 정규화하기 위해 필요한 far_plane 값 전송
-		simpleDepthShader.setFloat("far_plane", far_plane);
+			// 프래그먼트 쉐이더에서 '조명으로부터 각 프래그먼트까지의 월드 공간 거리값'을 [0, 1] 사이로 정규화하기 위해 필요한 far_plane 값 전송
+			simpleDepthShader.setFloat("far_plane", far_plane);
+
+			// 광원의 위치값 전송
+			simpleDepthShader.setVec3("lightPos", lightPos);
+
+			if (!shadowCaching && activeCubePath == CUBE_PATH_GEOMETRY_SHADER)
+			{
+				// shadow map 텍스쳐 객체가 attach 된 framebuffer 바인딩
+				glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
+
+				// 현재 바인딩된 framebuffer 의 깊이 버퍼 초기화
+				glClear(GL_DEPTH_BUFFER_BIT);
+
+				// shadow map 에 깊이 버퍼를 기록할 씬 렌더링
+				faceDraws = renderScene(simpleDepthShader, CASTERS_ALL, nullptr, true) * 6;
+			}
+			else if (!shadowCaching)
+			{
+				/* CPU 에서 오브젝트의 bounding sphere 를 큐브맵 면 별 frustum 과 비교해서, 보이는 면에만 렌더링 */
+
+				for (unsigned int f = 0; f < 6; f++)
+				{
+					faceVisible[f].assign(sceneObjects.size(), false);
+					for (unsigned int i = 0; i < sceneObjects.size(); i++)
+					{
+						const SceneObject& object = sceneObjects[i];
+						faceVisible[f][i] = object.isRoom || sphereInCubeFace(lightPos, f, object.center, object.radius, far_plane);
+					}
+				}
+
+				if (activeCubePath == CUBE_PATH_INSTANCED)
+				{
+					// 6면을 모두 attach 한 framebuffer 에 한 번만 초기화한 뒤,
+					// 오브젝트마다 보이는 면 목록을 전송하고 면 개수만큼 instancing 으로 렌더링 (instance 마다 gl_Layer 가 다름)
+					glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
+					glClear(GL_DEPTH_BUFFER_BIT);
+
+					layeredDepthShader->use();
+					for (unsigned int f = 0; f < 6; f++)
+					{
+						layeredDepthShader->setMat4("shadowMatrices[" + std::to_string(f) + "]", shadowTransforms[f]);
+					}
+					layeredDepthShader->setFloat("far_plane", far_plane);
+					layeredDepthShader->setVec3("lightPos", lightPos);
+
+					for (unsigned int i = 0; i < sceneObjects.size(); i++)
+					{
+						unsigned int faceCount = 0;
+						for (unsigned int f = 0; f < 6; f++)
+						{
+							if (faceVisible[f][i])
+							{
+								layeredDepthShader->setInt("faceIndices[" + std::to_string(faceCount) + "]", f);
+								faceCount++;
+							}
+						}
+						if (faceCount > 0)
+						{
+							renderSceneObject(*layeredDepthShader, sceneObjects[i], faceCount, true);
+							faceDraws += faceCount;
+						}
+					}
+				}
+				else
+				{
+					// 면마다 큐브맵의 면 1개만 attach 해서 초기화한 뒤, 그 면에서 보이는 오브젝트만 렌더링
+					// (면 1개의 light space 로 곧바로 변환하는 atlas 용 쉐이더를 그대로 사용)
+					glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
+					atlasDepthShader.use();
+					atlasDepthShader.setFloat("far_plane", far_plane);
+					atlasDepthShader.setVec3("lightPos", lightPos);
+					for (unsigned int f = 0; f < 6; f++)
+					{
+						glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + f, depthCubeMap, 0);
+						glClear(GL_DEPTH_BUFFER_BIT);
+						atlasDepthShader.setMat4("shadowMatrix", shadowTransforms[f]);
+						faceDraws += renderScene(atlasDepthShader, CASTERS_ALL, &faceVisible[f], true);
+					}
+
+					// geometry shader / instancing 경로에서 gl_Layer 로 렌더링할 수 있도록 6면 전체를 다시 attach
+					glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthCubeMap, 0);
+				}
+			}
+			else
+			{
+				/* 1. 광원이 움직였다면(== 면 별 light space 행렬이 바뀌었다면) shadow cache 에 static caster 를 다시 렌더링 */
+
+				shadowCache.trackStaticScene(staticSceneVersion);
+				bool anyDirty = false;
+				for (unsigned int i = 0; i < 6; i++)
+				{
+					shadowCache.track(i, shadowTransforms[i]);
+					anyDirty = anyDirty || shadowCache.isDirty(i);
+				}
+
+				// (shadow cache 는 static caster 를 드물게 다시 렌더링하므로, 렌더링 방식과 관계없이 geometry shader 경로만 사용)
+				if (anyDirty)
+				{
+					// 지오메트리 쉐이더가 6면에 한꺼번에 렌더링하므로, 모든 면을 다시 렌더링
+					shadowCache.bindLayered();
+					glClear(GL_DEPTH_BUFFER_BIT);
+					renderScene(simpleDepthShader, CASTERS_STATIC, nullptr, true);
+					for (unsigned int i = 0; i < 6; i++)
+					{
+						shadowCache.markClean(i);
+					}
+					staticRerendered = true;
+				}
+
+				/* 2. 캐시된 static caster 깊이를 shadow map 으로 복사한 뒤, 그 위에 dynamic caster 만 덧그림 */
+
+				for (unsigned int i = 0; i < 6; i++)
+				{
+					shadowCache.restore(depthCubeMap, i);
+				}
+
+				glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
+				renderScene(simpleDepthShader, CASTERS_DYNAMIC, nullptr, true);
+			}
+		}
+		else
+		{
+			/* 1. 광원 이동, 타일 해상도 변경, dynamic caster 때문에 다시 렌더링해야 하는 면을 dirty 로 표시 */
+
+			// 광원 1개 당 렌더링할 면 개수 (큐브맵 6면, 또는 dual-paraboloid 반구 2개)
+			unsigned int faceCount = atlasParaboloid ? 2 : 6;
+
+			// 방식이 바뀌었다면 모든 광원의 타일을 반납하고, 아래에서 새 방식의 면 개수만큼 다시 할당
+			if (atlasParaboloid != atlasTilesParaboloid)
+			{
+				for (unsigned int l = 0; l < atlasLights.size(); l++)
+				{
+					for (unsigned int f = 0; f < 6; f++)
+					{
+						atlas.release(atlasLights[l].tiles[f]);
+						atlasLights[l].ready[f] = false;
+						atlasLights[l].dirty[f] = false;
+					}
+					atlasLights[l].desiredTileSize = 0;
+					atlasLights[l].tileSize = 0;
+				}
+				atlasTilesParaboloid = atlasParaboloid;
+			}
+
+			float tanHalfFov = std::tan(glm::radians(camera.Zoom) * 0.5f);
+			const glm::vec3& dynamicCubeCenter = sceneObjects[dynamicCubeIndex].center;
+			float dynamicCubeRadius = sceneObjects[dynamicCubeIndex].radius;
+
+			for (unsigned int l = 0; l < atlasLights.size(); l++)
+			{
+				AtlasLight& light = atlasLights[l];
+
+				// 광원이 움직였다면 6면 모두 다시 렌더링
+				if (lightMoving)
+				{
+					light.phase += deltaTime * light.speed;
+				}
+				glm::vec3 position = light.center + light.orbitRadius * glm::vec3(std::cos(light.phase), 0.0f, std::sin(light.phase));
+				if (position != light.position)
+				{
+					light.position = position;
+					for (unsigned int f = 0; f < faceCount; f++)
+					{
+						light.dirty[f] = true;
+					}
+				}
+
+				// 광원의 영향 범위가 화면에서 차지하는 비율(screen coverage)로 타일 해상도 결정 (카메라가 범위 안에 있으면 1)
+				float cameraDistance = glm::length(camera.Position - light.position);
+				float coverage = cameraDistance <= light.range ? 1.0f : std::min(1.0f, light.range / (cameraDistance * tanHalfFov));
+				unsigned int desired = atlasTileSize(coverage, light.desiredTileSize);
+
+				if (desired != light.desiredTileSize)
+				{
+					// 기존 타일을 반납하고, 원하는 해상도부터 한 단계씩 줄여가며 6면을 모두 담을 수 있는 타일 할당
+					for (unsigned int f = 0; f < faceCount; f++)
+					{
+						atlas.release(light.tiles[f]);
+					}
+					light.desiredTileSize = desired;
+					light.tileSize = 0;
+					for (unsigned int size = desired; size >= ATLAS_MIN_TILE && light.tileSize == 0; size /= 2)
+					{
+						bool allocated = true;
+						for (unsigned int f = 0; f < faceCount; f++)
+						{
+							light.tiles[f] = atlas.allocate(size);
+							allocated = allocated && light.tiles[f].size != 0;
+						}
+						if (allocated)
+						{
+							light.tileSize = size;
+						}
+						else
+						{
+							for (unsigned int f = 0; f < faceCount; f++)
+							{
+								atlas.release(light.tiles[f]);
+							}
+						}
+					}
+
+					// 새로 할당한 타일에는 다른 광원의 깊이값이 남아있을 수 있으므로, 렌더링하기 전까지는 샘플링하지 않음
+					for (unsigned int f = 0; f < faceCount; f++)
+					{
+						light.dirty[f] = true;
+						light.ready[f] = false;
+						light.waitFrames[f] = 0;
+					}
+					tileChanges++;
+				}
+
+				// dynamic caster 가 광원의 영향 범위 안에 있다면, 움직일 때마다 6면 모두 다시 렌더링
+				if (glm::length(dynamicCubeCenter - light.position) < light.range + dynamicCubeRadius)
+				{
+					for (unsigned int f = 0; f < faceCount; f++)
+					{
+						light.dirty[f] = true;
+					}
+				}
+			}
+
+			/* 2. dirty 인 면들을 우선순위 순서로 정렬한 뒤, 예산(atlasFaceBudget) 만큼만 렌더링 */
+
+			// 우선순위 : 아직 한 번도 렌더링되지 않은 면 > 오래 기다린 면, 카메라에 가까운 광원의 면
+			std::vector<std::pair<float, unsigned int>> requests;
+			for (unsigned int l = 0; l < atlasLights.size(); l++)
+			{
+				const AtlasLight& light = atlasLights[l];
+				if (light.tileSize == 0)
+				{
+					continue;
+				}
+
+				float cameraDistance = glm::length(camera.Position - light.position);
+				for (unsigned int f = 0; f < faceCount; f++)
+				{
+					if (light.dirty[f])
+					{
+						float priority = (light.ready[f] ? 0.0f : 1000.0f) + (1.0f + light.waitFrames[f]) / (1.0f + cameraDistance);
+						requests.push_back(std::make_pair(priority, l * 6 + f));
+					}
+				}
+			}
+			std::sort(requests.begin(), requests.end(), std::greater<std::pair<float, unsigned int>>());
+
+			atlas.bind();
+			if (atlasParaboloid)
+			{
+				// paraboloid 로 펼치면 삼각형의 감기는 방향을 보장할 수 없으므로 Face Culling 을 끄고,
+				// 반대쪽 반구의 정점을 잘라내도록 gl_ClipDistance[0] 활성화
+				paraboloidDepthShader.use();
+				glDisable(GL_CULL_FACE);
+				glEnable(GL_CLIP_DISTANCE0);
+			}
+			else
+			{
+				atlasDepthShader.use();
+			}
+			for (unsigned int r = 0; r < requests.size(); r++)
+			{
+				AtlasLight& light = atlasLights[requests[r].second / 6];
+				unsigned int f = requests[r].second % 6;
+
+				// 예산을 다 쓴 뒤의 면은 다음 프레임으로 미룸
+				if (facesRendered >= atlasFaceBudget)
+				{
+					light.waitFrames[f]++;
+					facesPending++;
+					continue;
+				}
+
+				// 타일 영역만 초기화
+				atlas.beginTile(light.tiles[f]);
+
+				if (atlasParaboloid)
+				{
+					// 반구 1개를 paraboloid 로 펼쳐서 렌더링 (비선형 변환이므로 잘게 쪼갠 큐브로 렌더링)
+					paraboloidDepthShader.setVec3("lightPos", light.position);
+					paraboloidDepthShader.setFloat("far_plane", light.range);
+					paraboloidDepthShader.setFloat("hemisphere", f == 0 ? 1.0f : -1.0f);
+					for (unsigned int i = 0; i < sceneObjects.size(); i++)
+					{
+						paraboloidDepthShader.setMat4("model", sceneObjects[i].model);
+						renderSubdividedCube();
+					}
+				}
+				else
+				{
+					// 면 1개의 light space 변환행렬 계산 (큐브맵과 마찬가지로 시야각 90도의 원근 투영)
+					glm::mat4 faceProjection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, light.range);
+					atlasDepthShader.setMat4("shadowMatrix", faceProjection * glm::lookAt(light.position, light.position + faceDirections[f], faceUps[f]));
+					atlasDepthShader.setVec3("lightPos", light.position);
+					atlasDepthShader.setFloat("far_plane", light.range);
+					renderScene(atlasDepthShader, CASTERS_ALL, nullptr, true);
+				}
+
+				light.dirty[f] = false;
+				light.ready[f] = true;
+				light.waitFrames[f] = 0;
+				facesRendered++;
+			}
+			atlas.endTiles();
+			glEnable(GL_CULL_FACE);
+			glDisable(GL_CLIP_DISTANCE0);
+		}
 
-		// 광원의 위치값 전송
-		simpleDepthShader.setVec3("lightPos", lightPos);
+		// shadow pass 의 GPU 소요 시간 측정 종료
+		shadowTimer.end();
 
-		// shadow map 에 깊이 버퍼를 기록할 씬 렌더링
-		renderScene(simpleDepthShader);
+		if (!atlasMode && shadowCaching)
+		{
+			// shadow cache 사용 여부, static caster 재렌더링 여부 및 누적 횟수, shadow pass 소요 시간 콘솔 출력
+			std::cout << "Shadow cache: " << (shadowCaching ? "on" : "off") << " | light: " << (lightMoving ? "moving" : "still")
+				<< " | static re-rendered: " << (staticRerendered ? "yes" : "no") << " (total " << shadowCache.staticRenderCount() / 6 << ")"
+				<< " | shadow pass: " << shadowTimer.elapsedMs() << " ms" << std::endl;
+		}
+		else if (!atlasMode)
+		{
+			// 큐브맵 렌더링 방식, 면 단위로 렌더링한 오브젝트 개수, 방식 별 마지막 shadow pass 소요 시간 콘솔 출력
+			const char* cubePathNames[3] = { "geometry shader", "instanced gl_Layer", "per-face FBO" };
+			cubePathMs[activeCubePath] = shadowTimer.elapsedMs();
+			std::cout << "Cube shadow path: " << cubePathNames[activeCubePath] << " | face draws: " << faceDraws << "/" << sceneObjects.size() * 6
+				<< " | GS " << cubePathMs[CUBE_PATH_GEOMETRY_SHADER] << " ms, instanced " << cubePathMs[CUBE_PATH_INSTANCED]
+				<< " ms, per-face " << cubePathMs[CUBE_PATH_PER_FACE] << " ms" << std::endl;
+		}
+		else
+		{
+			// 광원 별 타일 해상도, 렌더링한 면 / 예산, 미뤄진 면, 타일 재할당 횟수, atlas 사용률, shadow pass 소요 시간 콘솔 출력
+			std::cout << "Shadow atlas: " << atlasLights.size() << " lights | tiles:";
+			for (unsigned int l = 0; l < atlasLights.size(); l++)
+			{
+				std::cout << " " << atlasLights[l].tileSize;
+			}
+			// 렌더링한 면 1개 당 소요 시간으로 '광원 1개의 모든 면을 다시 렌더링하는 비용' 을 추정해서 방식 별로 비교
+			unsigned int faceCount = atlasParaboloid ? 2 : 6;
+			if (facesRendered > 0)
+			{
+				atlasLightMs[atlasParaboloid ? 1 : 0] = shadowTimer.elapsedMs() / facesRendered * faceCount;
+			}
+			std::cout << " | " << (atlasParaboloid ? "dual-paraboloid" : "cube") << " (" << faceCount << " passes/light)"
+				<< " | per-light cost: cube " << atlasLightMs[0] << " ms, paraboloid " << atlasLightMs[1] << " ms";
+			std::cout << " | faces rendered: " << facesRendered << "/" << atlasFaceBudget << " | pending: " << facesPending
+				<< " | tile changes: " << tileChanges << " | occupancy: " << atlas.occupancy() * 100.0f << "%"
+				<< " | shadow pass: " << shadowTimer.elapsedMs() << " ms" << std::endl;
+		}
 
 		// default framebuffer 로 바인딩 복구
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -344,6 +940,30 @@ int main()
 		// point shadow 활성화 상태값 전송
 		shader.setInt("shadows", shadows);
 
+		// PCF fetch 횟수 전송
+		shader.setInt("pcfSamples", pcfSamples);
+
+		// shadow atlas 모드라면, 광원 정보 및 광원 별 6면이 저장된 타일의 atlas uv 영역 전송
+		shader.setBool("atlasMode", atlasMode);
+		shader.setBool("atlasParaboloid", atlasParaboloid);
+		if (atlasMode)
+		{
+			shader.setInt("atlasLightCount", (int)atlasLights.size());
+			for (unsigned int l = 0; l < atlasLights.size(); l++)
+			{
+				const AtlasLight& light = atlasLights[l];
+				std::string index = "[" + std::to_string(l) + "]";
+				shader.setVec3("atlasLightPositions" + index, light.position);
+				shader.setVec3("atlasLightColors" + index, light.color);
+				shader.setFloat("atlasLightRanges" + index, light.range);
+				for (unsigned int f = 0; f < 6; f++)
+				{
+					glm::vec4 rect = light.ready[f] ? atlas.uvRect(light.tiles[f]) : glm::vec4(0.0f);
+					shader.setVec4("atlasFaceRects[" + std::to_string(l * 6 + f) + "]", rect);
+				}
+			}
+		}
+
 		// First pass 에서 각 정점들을 light space 로 변환할 때 사용했던 원근 투영행렬의 far_plane 값 전송 
 		// -> 프래그먼트 쉐이더에서 [0, 1] 사이로 정규화되어 큐브맵 깊이 버퍼에 기록되었던 '조명으로부터 각 프래그먼트까지의 월드 공간 거리값'을 다시 [0, far_plane] 범위로 복구시키기 위해 필요함.
 		shader.setFloat("far_plane", far_plane);
@@ -360,6 +980,10 @@ int main()
 		// shadow map 텍스쳐 객체 바인딩
 		glBindTexture(GL_TEXTURE_CUBE_MAP, depthCubeMap);
 
+		// shadow atlas 텍스쳐 객체를 2번 texture unit 에 바인딩
+		glActiveTexture(GL_TEXTURE2);
+		glBindTexture(GL_TEXTURE_2D, atlas.ID);
+
 		// 실제 화면에 보여줄 씬 렌더링
 		renderScene(shader);
 
@@ -372,6 +996,9 @@ int main()
 	}
 
 
+	// instancing 경로용 쉐이더 객체 메모리 해제
+	delete layeredDepthShader;
+
 	// while 렌더링 루프 탈출 시, GLFWwindow 종료 및 리소스 메모리 해제
 	glfwTerminate();
 
@@ -383,104 +1010,89 @@ int main()
 
 
 /* shadow map 에 깊이 버퍼를 저장할 씬을 렌더링하는 함수 선언 */
-void renderScene(const Shader& shader)
+unsigned int renderScene(const Shader& shader, int casters, const std::vector<bool>* visible, bool positionOnly)
 {
-	/* Room 큐브 그리기 */
-
-	// Room 큐브에 적용할 모델행렬 계산
-	glm::mat4 model = glm::mat4(1.0f);
-	model = glm::scale(model, glm::vec3(5.0f));
-
-	// 매개변수로 전달받은 쉐이더 객체에 모델행렬 전송
-	shader.setMat4("model", model);
-
-	// Room 큐브는 안쪽 면을 렌더링해줘야 하므로, Face Culling 을 잠시 비활성화
-	glDisable(GL_CULL_FACE);
-
-	// Room 큐브 안쪽 면에 대해 정확히 조명계산을 처리하기 위해,
-	// 큐브의 각 면에 바깥쪽 방향을 기준으로 정의된 노멀벡터(renderCube() > float vertices[] 참고!)를
-	// 쉐이더 코드에서 안쪽 방향으로 뒤집어주도록 상태값을 true 로 전달함.
-	shader.setInt("reverse_normals", 1);
-
-	// 큐브 렌더링 함수 실행
-	renderCube();
-
-	// Room 큐브 렌더링 완료 시, 이후 렌더링할 큐브들을 위해 노멀벡터 방향을 뒤집는 상태값을 false 로 비활성화시킴.
-	shader.setInt("reverse_normals", 0);
-
-	// Room 큐브 렌더링 완료 시, 이후 렌더링할 큐브들을 위해 Face Culling 을 다시 활성화
-	glEnable(GL_CULL_FACE);
-
-
-	/* 첫 번째 큐브 그리기 */
-
-	// 첫 번째 큐브에 적용할 모델행렬 계산
-	model = glm::mat4(1.0f);
-	model = glm::translate(model, glm::vec3(4.0f, -3.5f, 0.0f));
-	model = glm::scale(model, glm::vec3(0.5f));
-
-	// 매개변수로 전달받은 쉐이더 객체에 모델행렬 전송
-	shader.setMat4("model", model);
-
-	// 큐브 렌더링 함수 실행
-	renderCube();
-
-
-	/* 두 번째 큐브 그리기 */
-
-	// 두 번째 큐브에 적용할 모델행렬 계산
-	model = glm::mat4(1.0f);
-	model = glm::translate(model, glm::vec3(2.0f, 3.0f, 1.0f));
-	model = glm::scale(model, glm::vec3(0.75f));
-
-	// 매개변수로 전달받은 쉐이더 객체에 모델행렬 전송
-	shader.setMat4("model", model);
-
-	// 큐브 렌더링 함수 실행
-	renderCube();
+	unsigned int drawCalls = 0;
 
+	// 씬에 배치된 오브젝트 목록을 순회하며 렌더링 (caster 종류가 다르거나, visible 배열에서 보이지 않는 오브젝트는 건너뜀)
+	for (unsigned int i = 0; i < sceneObjects.size(); i++)
+	{
+		int type = sceneObjects[i].dynamic ? CASTERS_DYNAMIC : CASTERS_STATIC;
+		if (!(casters & type) || (visible != nullptr && !(*visible)[i]))
+		{
+			continue;
+		}
 
-	/* 세 번째 큐브 그리기 */
+		renderSceneObject(shader, sceneObjects[i], 1, positionOnly);
+		drawCalls++;
+	}
 
-	// 세 번째 큐브에 적용할 모델행렬 계산
-	model = glm::mat4(1.0f);
-	model = glm::translate(model, glm::vec3(-3.0f, -1.0f, 0.0f));
-	model = glm::scale(model, glm::vec3(0.5f));
+	return drawCalls;
+}
 
+/* 씬에 배치된 오브젝트 1개를 렌더링하는 함수 구현 */
+void renderSceneObject(const Shader& shader, const SceneObject& object, unsigned int instances, bool positionOnly)
+{
 	// 매개변수로 전달받은 쉐이더 객체에 모델행렬 전송
-	shader.setMat4("model", model);
-
-	// 큐브 렌더링 함수 실행
-	renderCube();
+	shader.setMat4("model", object.model);
 
+	if (object.isRoom)
+	{
+		// Room 큐브는 안쪽 면을 렌더링해줘야 하므로, Face Culling 을 잠시 비활성화
+		glDisable(GL_CULL_FACE);
 
-	/* 네 번째 큐브 그리기 */
-
-	// 네 번째 큐브에 적용할 모델행렬 계산
-	model = glm::mat4(1.0f);
-	model = glm::translate(model, glm::vec3(-1.5f, 1.0f, 1.5f));
-	model = glm::scale(model, glm::vec3(0.5f));
-
-	// 매개변수로 전달받은 쉐이더 객체에 모델행렬 전송
-	shader.setMat4("model", model);
+		// Room 큐브 안쪽 면에 대해 정확히 조명계산을 처리하기 위해,
+		// 큐브의 각 면에 바깥쪽 방향을 기준으로 정의된 노멀벡터(renderCube() > float vertices[] 참고!)를
+		// 쉐이더 코드에서 안쪽 방향으로 뒤집어주도록 상태값을 true 로 전달함.
+		shader.setInt("reverse_normals", 1);
 
-	// 큐브 렌더링 함수 실행
-	renderCube();
+		// 큐브 렌더링 함수 실행
+		renderCube(instances, positionOnly);
 
+		// Room 큐브 렌더링 완료 시, 이후 렌더링할 큐브들을 위해 노멀벡터 방향을 뒤집는 상태값을 false 로 비활성화시킴.
+		shader.setInt("reverse_normals", 0);
 
-	/* 다섯 번째 큐브 그리기 */
+		// Room 큐브 렌더링 완료 시, 이후 렌더링할 큐브들을 위해 Face Culling 을 다시 활성화
+		glEnable(GL_CULL_FACE);
+	}
+	else
+	{
+		// 큐브 렌더링 함수 실행
+		renderCube(instances, positionOnly);
+	}
+}
 
-	// 다섯 번째 큐브에 적용할 모델행렬 계산
-	model = glm::mat4(1.0f);
-	model = glm::translate(model, glm::vec3(-1.5f, 2.0f, -3.0f));
-	model = glm::rotate(model, glm::radians(60.0f), glm::normalize(glm::vec3(1.0f, 0.0f, 1.0f)));
-	model = glm::scale(model, glm::vec3(0.75f));
+/* bounding sphere 가 광원 큐브맵의 face 번째 면의 시야(90도 frustum) 안에 들어오는 지 검사하는 함수 구현 */
+bool sphereInCubeFace(const glm::vec3& lightPos, unsigned int face, const glm::vec3& center, float radius, float farPlane)
+{
+	// 광원 기준 bounding sphere 중심 위치, 면이 바라보는 축(0: x, 1: y, 2: z)과 방향(+, -)
+	glm::vec3 c = center - lightPos;
+	int axis = face / 2;
+	float sign = face % 2 == 0 ? 1.0f : -1.0f;
+	float forward = sign * c[axis];
+
+	// far plane 너머에 있으면 보이지 않음
+	if (forward - radius > farPlane)
+	{
+		return false;
+	}
 
-	// 매개변수로 전달받은 쉐이더 객체에 모델행렬 전송
-	shader.setMat4("model", model);
+	// 시야각이 90도이므로, 나머지 두 축 방향의 옆면 4개는 (면 방향 +- 다른 축 방향) / sqrt(2) 를 노멀로 하는 평면들임
+	// -> 중심이 네 평면 모두의 안쪽, 또는 반지름 이내에 있어야 보임
+	const float invSqrt2 = 0.70710678f;
+	for (int other = 0; other < 3; other++)
+	{
+		if (other == axis)
+		{
+			continue;
+		}
+		if ((forward + c[other]) * invSqrt2 < -radius || (forward - c[other]) * invSqrt2 < -radius)
+		{
+			return false;
+		}
+	}
 
-	// 큐브 렌더링 함수 실행
-	renderCube();
+	return true;
 }
 
 
@@ -490,7 +1102,11 @@ void renderScene(const Shader& shader)
 unsigned int cubeVAO = 0;
 unsigned int cubeVBO = 0;
 
-void renderCube()
+// depth pass 에서 사용할 위치값 전용 Cube VBO, VAO 객체 참조 id 전역 선언 (하단 필기 참고)
+unsigned int cubeDepthVAO = 0;
+unsigned int cubeDepthVBO = 0;
+
+void renderCube(unsigned int instances, bool positionOnly)
 {
 	/*
 		VAO 참조 ID 가 아직 할당되지 않았을 경우,
@@ -584,21 +1200,110 @@ void renderCube()
 
 		// 마찬가지로, VAO 객체도 OpenGL 컨텍스트로부터 바인딩 해제 
 		glBindVertexArray(0);
+
+		// depth pass 용 위치값 전용 VBO, VAO 생성 (정점마다 8개의 float 중 위치값 3개만 빽빽하게 모아서 저장)
+		float positions[36 * 3];
+		for (unsigned int i = 0; i < 36; i++)
+		{
+			positions[i * 3 + 0] = vertices[i * 8 + 0];
+			positions[i * 3 + 1] = vertices[i * 8 + 1];
+			positions[i * 3 + 2] = vertices[i * 8 + 2];
+		}
+
+		glGenVertexArrays(1, &cubeDepthVAO);
+		glGenBuffers(1, &cubeDepthVBO);
+		glBindVertexArray(cubeDepthVAO);
+		glBindBuffer(GL_ARRAY_BUFFER, cubeDepthVBO);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(positions), positions, GL_STATIC_DRAW);
+
+		// 정점 위치 데이터(0번 location 입력변수 in vec3 aPos 에 전달할 데이터)만 사용 (stride 도 위치값 크기인 12 byte)
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindVertexArray(0);
 	}
 
 	/* 큐브 그리기 */
 
 	// 큐브에 적용할 VAO 객체를 바인딩하여, 해당 객체에 저장된 VBO 객체와 설정대로 그리도록 명령
-	glBindVertexArray(cubeVAO);
+	// (depth pass 라면 위치값 전용 VAO 를 바인딩해서, 사용하지 않는 노멀과 uv 데이터까지 읽어오지 않도록 함)
+	glBindVertexArray(positionOnly ? cubeDepthVAO : cubeVAO);
 
-	// 큐브 그리기 명령
-	glDrawArrays(GL_TRIANGLES, 0, 36);
+	// 큐브 그리기 명령 (instances 가 1 보다 크면 같은 큐브를 instances 개수만큼 한 번에 그림)
+	if (instances > 1)
+	{
+		glDrawArraysInstanced(GL_TRIANGLES, 0, 36, instances);
+	}
+	else
+	{
+		glDrawArrays(GL_TRIANGLES, 0, 36);
+	}
 
 	// 그리기 명령 종료 후, VAO 객체 바인딩 해제
 	glBindVertexArray(0);
 }
 
 
+/* 면마다 잘게 쪼갠 위치값 전용 큐브를 렌더링하는 함수 구현 */
+
+// 잘게 쪼갠 큐브의 VBO, VAO 객체 참조 id 및 정점 개수 전역 선언
+unsigned int subdividedCubeVAO = 0;
+unsigned int subdividedCubeVBO = 0;
+unsigned int subdividedCubeVertexCount = 0;
+void renderSubdividedCube()
+{
+	// VAO 참조 ID 가 아직 할당되지 않았을 경우, renderCube() 와 같은 크기(-1 ~ 1)의 큐브를 면마다 16 x 16 격자로 쪼개서 생성
+	if (subdividedCubeVAO == 0)
+	{
+		const int divisions = 16;
+		const int quadCorners[6][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 0 }, { 1, 1 }, { 0, 1 } };
+		std::vector<float> vertices;
+		for (int face = 0; face < 6; face++)
+		{
+			// 면이 수직인 축과 방향, 면 위의 격자를 이루는 나머지 두 축
+			int axis = face / 2;
+			float sign = face % 2 == 0 ? 1.0f : -1.0f;
+			int u = (axis + 1) % 3;
+			int v = (axis + 2) % 3;
+			for (int i = 0; i < divisions; i++)
+			{
+				for (int j = 0; j < divisions; j++)
+				{
+					// 격자 칸 1개를 삼각형 2개로 나눠서 정점 위치만 추가 (depth pass 는 노멀과 uv 를 사용하지 않음)
+					for (int k = 0; k < 6; k++)
+					{
+						glm::vec3 position;
+						position[axis] = sign;
+						position[u] = -1.0f + 2.0f * (i + quadCorners[k][0]) / divisions;
+						position[v] = -1.0f + 2.0f * (j + quadCorners[k][1]) / divisions;
+						vertices.push_back(position.x);
+						vertices.push_back(position.y);
+						vertices.push_back(position.z);
+					}
+				}
+			}
+		}
+		subdividedCubeVertexCount = (unsigned int)(vertices.size() / 3);
+
+		glGenVertexArrays(1, &subdividedCubeVAO);
+		glGenBuffers(1, &subdividedCubeVBO);
+		glBindVertexArray(subdividedCubeVAO);
+		glBindBuffer(GL_ARRAY_BUFFER, subdividedCubeVBO);
+		glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+
+		// 정점 위치 데이터(0번 location 입력변수 in vec3 aPos 에 전달할 데이터)만 사용
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindVertexArray(0);
+	}
+
+	glBindVertexArray(subdividedCubeVAO);
+	glDrawArrays(GL_TRIANGLES, 0, subdividedCubeVertexCount);
+	glBindVertexArray(0);
+}
+
+
 // GLFWwindow 윈도우 창 리사이징 감지 시, 호출할 콜백 함수 정의
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
@@ -681,6 +1386,109 @@ void processInput(GLFWwindow* window)
 	{
 		shadowKeyPressed = false;
 	}
+
+	if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS && !pcfSamplesKeyPressed)
+	{
+		// P 키 입력 시, PCF fetch 횟수 변경 (fetch 1번이 2x2 texel 을 비교하므로, 실제 비교하는 texel 개수는 4배)
+		pcfSamples = pcfSamples == 1 ? 8 : (pcfSamples == 8 ? 20 : 1);
+		pcfSamplesKeyPressed = true;
+		std::cout << "PCF fetches: " << pcfSamples << " (" << pcfSamples * 4 << " texel comparisons)" << std::endl;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_P) == GLFW_RELEASE)
+	{
+		pcfSamplesKeyPressed = false;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS && !shadowCachingKeyPressed)
+	{
+		// C 키 입력 시, shadow cache 사용 on/off (다시 켤 때는 캐시 전체를 다시 렌더링하도록 static 씬 버전 증가)
+		shadowCaching = !shadowCaching;
+		staticSceneVersion++;
+		shadowCachingKeyPressed = true;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_C) == GLFW_RELEASE)
+	{
+		shadowCachingKeyPressed = false;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS && !lightMovingKeyPressed)
+	{
+		// M 키 입력 시, 광원 움직임 on/off
+		lightMoving = !lightMoving;
+		lightMovingKeyPressed = true;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_M) == GLFW_RELEASE)
+	{
+		lightMovingKeyPressed = false;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_T) == GLFW_PRESS && !atlasModeKeyPressed)
+	{
+		// T 키 입력 시, 광원 1개 + 큐브맵 <-> 여러 광원 + shadow atlas 모드 전환
+		atlasMode = !atlasMode;
+		atlasModeKeyPressed = true;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_T) == GLFW_RELEASE)
+	{
+		atlasModeKeyPressed = false;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_B) == GLFW_PRESS && !atlasFaceBudgetKeyPressed)
+	{
+		// B 키 입력 시, 한 프레임에 다시 렌더링할 수 있는 면 개수 변경
+		atlasFaceBudget = atlasFaceBudget >= 48 ? 6 : atlasFaceBudget * 2;
+		atlasFaceBudgetKeyPressed = true;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_B) == GLFW_RELEASE)
+	{
+		atlasFaceBudgetKeyPressed = false;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_Y) == GLFW_PRESS && !atlasParaboloidKeyPressed)
+	{
+		// Y 키 입력 시, shadow atlas 모드의 광원 별 그림자 방식 전환 (큐브맵 6면 <-> dual-paraboloid 반구 2개)
+		atlasParaboloid = !atlasParaboloid;
+		atlasParaboloidKeyPressed = true;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_Y) == GLFW_RELEASE)
+	{
+		atlasParaboloidKeyPressed = false;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_G) == GLFW_PRESS && !cubeShadowPathKeyPressed)
+	{
+		// G 키 입력 시, 큐브맵 렌더링 방식 변경 (geometry shader -> instanced gl_Layer -> 면 별 FBO, shadow cache 를 끈 상태에서 적용됨)
+		cubeShadowPath = (cubeShadowPath + 1) % 3;
+		cubeShadowPathKeyPressed = true;
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_G) == GLFW_RELEASE)
+	{
+		cubeShadowPathKeyPressed = false;
+	}
+}
+
+// 광원의 screen coverage 로 shadow atlas 타일 해상도를 결정하는 함수 구현
+// (coverage 가 구간 경계 근처에서 흔들릴 때 타일이 계속 재할당되지 않도록, 해상도를 올릴 때는 경계보다 20% 더 커야 올림)
+unsigned int atlasTileSize(float coverage, unsigned int currentSize)
+{
+	unsigned int size = ATLAS_MIN_TILE;
+	float threshold = 0.125f;
+	for (unsigned int s = ATLAS_MIN_TILE * 2; s <= ATLAS_MAX_TILE; s *= 2, threshold *= 2.0f)
+	{
+		float required = s > currentSize ? threshold * 1.2f : threshold;
+		if (coverage >= required)
+		{
+			size = s;
+		}
+	}
+	return size;
 }
 
 // 텍스쳐 이미지 로드 및 객체 생성 함수 구현부 (텍스쳐 객체 참조 id 반환)
@@ -890,4 +1698,27 @@ unsigned int loadTexture(const char* path)
 	물론, shadow map 의 깊이값이 1.0 으로 샘플링되려면,
 	GL_TEXTURE_BORDER_COLOR 를 흰색({ 1.0, 1.0, 1.0, 1.0 })으로
 	설정하면 되겠지?
-*/
\ No newline at end of file
+*/
+/*
+	depth pass 용 위치값 전용 정점 버퍼
+
+
+	renderCube() 의 정점 데이터는 위치값, 노멀, uv 를 하나의 버퍼에 번갈아 저장(interleaved)하므로,
+	정점 1개가 8 * 4 = 32 byte 를 차지함.
+
+	그런데 shadow map 을 렌더링하는 depth pass 의 버텍스 쉐이더들은
+	0번 location 의 aPos 만 사용하고 노멀과 uv 는 전혀 사용하지 않음.
+
+	GPU 는 정점 데이터를 cache line 단위로 읽어오므로,
+	위치값 12 byte 만 필요하더라도 stride 가 32 byte 라면
+	그 사이에 끼어있는 노멀과 uv 까지 함께 읽어오게 되어 대역폭이 낭비됨.
+
+
+	그래서 위치값만 빽빽하게(stride 12 byte) 모아둔 VBO 와
+	0번 location 만 활성화한 VAO 를 따로 만들어두고,
+	depth pass 에서만 이 VAO 로 렌더링하면
+	정점 당 읽어오는 데이터 양이 32 byte -> 12 byte 로 줄어듦.
+
+	특히 point shadow 는 큐브맵 6면(또는 여러 광원의 atlas 타일)에
+	같은 오브젝트를 여러 번 렌더링하므로, 줄어든 정점 fetch 비용도 그만큼 여러 번 절약됨!
+*/
@@ -0,0 +1,248 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+/*
+	dynamic_resolution.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > query 객체 관련 OpenGL 함수가 필요하니까!
+
+#include <algorithm>
+#include <cmath>
+
+/*
+	DynamicResolution 클래스
+
+	GL_TIMESTAMP query 로 한 프레임 동안의 GPU 소요 시간을 측정하고,
+	목표 프레임 시간(targetMs)을 넘지 않도록 G-buffer 및 lighting pass 를 렌더링할 내부 해상도 배율(scale)을
+	minScale ~ maxScale 범위에서 자동으로 조절하는 클래스! (하단 필기 참고)
+
+	- 목표 시간보다 hysteresis 비율 이상 느려지면, GPU 비용이 pixel 개수(scale^2)에 비례한다고 가정하고
+	  목표 시간에 맞는 배율까지 한 번에 낮추고,
+	- 목표 시간보다 hysteresis 비율 이상 빨라지면, 한 단계(scaleStep)씩만 천천히 높이되
+	  높인 배율에서 예상되는 시간이 다시 목표 시간을 넘는다면 높이지 않음.
+	- 배율을 바꾼 뒤에는 측정 결과가 새 배율을 반영할 때까지 cooldownFrames 프레임 동안 다시 바꾸지 않음.
+
+	배율은 scaleStep 단위로만 바뀌므로, 배율이 바뀔 때만 render target 을 재할당하면 됨.
+
+	(GL_TIMESTAMP query 는 GL_TIME_ELAPSED query 와 달리 구간이 겹쳐도 되므로, GpuTimer 로 측정 중인 구간 밖에서 호출해도 됨)
+*/
+class DynamicResolution
+{
+public:
+	// 돌아가며 사용할 query 쌍 개수 (결과를 몇 프레임 늦게 읽어올 지 결정)
+	static const unsigned int QUERY_COUNT = 4;
+
+	float targetMs; // 목표 GPU 프레임 시간 (millisecond 단위)
+	float minScale; // 내부 해상도 배율의 최솟값
+	float maxScale; // 내부 해상도 배율의 최댓값
+	float scaleStep; // 배율 조절 단위
+	float hysteresis; // 목표 시간 대비 이 비율 이상 벗어나야 배율을 조절함
+	unsigned int cooldownFrames; // 배율을 바꾼 뒤 다시 바꿀 수 있을 때까지 기다릴 측정 횟수
+	bool enabled; // false 면 GPU 시간만 측정하고 배율은 조절하지 않음
+
+	// 생성자에서 query 객체들을 미리 생성해 둠
+	DynamicResolution(float targetFrameMs = 16.6f)
+		: targetMs(targetFrameMs), minScale(0.5f), maxScale(1.0f), scaleStep(0.05f), hysteresis(0.1f), cooldownFrames(15), enabled(true),
+		current(0), currentScale(1.0f), smoothedMs(0.0), lastMs(0.0), framesSinceChange(0), changes(0), dropped(0)
+	{
+		glGenQueries(QUERY_COUNT, beginQueries);
+		glGenQueries(QUERY_COUNT, endQueries);
+		for (unsigned int i = 0; i < QUERY_COUNT; i++)
+		{
+			pending[i] = false;
+		}
+	}
+
+	// 프레임의 첫 렌더링 명령 전에 호출
+	void beginFrame()
+	{
+		// 이번에 사용할 query 쌍의 이전 결과를 아직 읽지 않았다면, 준비된 경우에만 읽어서 보관
+		// -> GPU 가 QUERY_COUNT 프레임 이상 밀려 있어서 아직 준비되지 않았다면, CPU 를 멈추지 않도록 그 측정값은 버림
+		if (pending[current])
+		{
+			GLint available = 0;
+			glGetQueryObjectiv(endQueries[current], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (available)
+			{
+				readResult(current);
+			}
+			else
+			{
+				pending[current] = false;
+				dropped++;
+			}
+		}
+
+		glQueryCounter(beginQueries[current], GL_TIMESTAMP);
+	}
+
+	// 프레임의 마지막 렌더링 명령 후에 호출 -> 준비된 측정 결과가 있다면 배율을 조절함
+	void endFrame()
+	{
+		glQueryCounter(endQueries[current], GL_TIMESTAMP);
+		pending[current] = true;
+
+		// 다음 프레임에 사용할 query 쌍으로 넘어감
+		current = (current + 1) % QUERY_COUNT;
+
+		// 다음에 사용할 query 쌍(== 가장 오래 전에 측정한 query 쌍)의 결과가 준비되었다면, CPU 를 멈추지 않고 읽어옴
+		if (pending[current])
+		{
+			GLint available = 0;
+			glGetQueryObjectiv(endQueries[current], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (available)
+			{
+				readResult(current);
+			}
+		}
+	}
+
+	// 배율을 maxScale 로 되돌리고 측정 기록 초기화 (dynamic resolution 을 끌 때 호출)
+	void reset()
+	{
+		currentScale = maxScale;
+		smoothedMs = 0.0;
+		framesSinceChange = 0;
+	}
+
+	// 현재 내부 해상도 배율
+	float scale() const
+	{
+		return currentScale;
+	}
+
+	// 출력 해상도에 현재 배율을 적용한 내부 해상도 (올림 처리)
+	unsigned int scaledSize(unsigned int size) const
+	{
+		return std::max(1u, (unsigned int)std::ceil(size * currentScale - 0.001f));
+	}
+
+	// 여러 프레임에 걸쳐 평균낸 GPU 프레임 시간 (millisecond 단위)
+	double gpuFrameMs() const
+	{
+		return smoothedMs;
+	}
+
+	// 가장 최근에 측정된 GPU 프레임 시간 (millisecond 단위)
+	double lastGpuFrameMs() const
+	{
+		return lastMs;
+	}
+
+	// 지금까지 배율을 바꾼 횟수
+	unsigned int changeCount() const
+	{
+		return changes;
+	}
+
+	// 결과가 준비되기 전에 query 쌍을 재사용해야 해서 버린 측정 횟수
+	unsigned int droppedCount() const
+	{
+		return dropped;
+	}
+
+private:
+	unsigned int beginQueries[QUERY_COUNT]; // 프레임 시작 시점을 기록할 query 객체들
+	unsigned int endQueries[QUERY_COUNT]; // 프레임 종료 시점을 기록할 query 객체들
+	bool pending[QUERY_COUNT]; // 측정은 끝났지만 아직 결과를 읽지 않은 query 쌍인지 여부
+	unsigned int current; // 이번 프레임에 사용할 query 쌍 인덱스
+	float currentScale;
+	double smoothedMs;
+	double lastMs;
+	unsigned int framesSinceChange;
+	unsigned int changes;
+	unsigned int dropped;
+
+	// query 쌍의 결과를 읽어서 GPU 프레임 시간을 갱신하고 배율 조절
+	void readResult(unsigned int index)
+	{
+		GLuint64 beginNs = 0, endNs = 0;
+		glGetQueryObjectui64v(beginQueries[index], GL_QUERY_RESULT, &beginNs);
+		glGetQueryObjectui64v(endQueries[index], GL_QUERY_RESULT, &endNs);
+		pending[index] = false;
+
+		// nanosecond -> millisecond 변환 후, 프레임마다 튀는 값을 줄이기 위해 지수 이동 평균으로 누적
+		lastMs = (endNs - beginNs) / 1000000.0;
+		smoothedMs = smoothedMs > 0.0 ? smoothedMs + (lastMs - smoothedMs) * 0.2 : lastMs;
+
+		framesSinceChange++;
+		adjust();
+	}
+
+	// 평균 GPU 프레임 시간과 목표 시간을 비교해서 배율 조절
+	void adjust()
+	{
+		// 배율을 바꾼 직후의 측정 결과는 이전 배율로 렌더링한 프레임일 수 있으므로 무시
+		if (!enabled || framesSinceChange < cooldownFrames || smoothedMs <= 0.0)
+		{
+			return;
+		}
+
+		float newScale = currentScale;
+		if (smoothedMs > targetMs * (1.0f + hysteresis))
+		{
+			// GPU 비용이 pixel 개수(scale^2)에 비례한다고 가정하고, 목표 시간에 맞는 배율을 한 번에 계산 (최소 한 단계는 낮춤)
+			float ideal = currentScale * (float)std::sqrt(targetMs / smoothedMs);
+			newScale = std::min(std::floor(ideal / scaleStep + 0.001f) * scaleStep, currentScale - scaleStep);
+		}
+		else if (smoothedMs < targetMs * (1.0f - hysteresis))
+		{
+			// 한 단계만 높이되, 높인 배율에서 예상되는 시간이 목표 시간을 넘는다면 높이지 않음 (배율이 오르내리기를 반복하는 것을 방지)
+			float candidate = currentScale + scaleStep;
+			double predictedMs = smoothedMs * (candidate * candidate) / (currentScale * currentScale);
+			if (predictedMs < targetMs)
+			{
+				newScale = candidate;
+			}
+		}
+
+		// 부동소수점 오차가 누적되지 않도록 scaleStep 단위로 반올림
+		newScale = std::max(minScale, std::min(maxScale, newScale));
+		newScale = std::floor(newScale / scaleStep + 0.5f) * scaleStep;
+		if (std::abs(newScale - currentScale) < scaleStep * 0.5f)
+		{
+			return;
+		}
+
+		// 새 배율에서 예상되는 시간으로 평균값을 미리 옮겨둬서, 이전 배율의 측정값이 다음 판단에 섞이지 않도록 함
+		smoothedMs *= (newScale * newScale) / (currentScale * currentScale);
+		currentScale = newScale;
+		framesSinceChange = 0;
+		changes++;
+	}
+};
+
+
+#endif // !DYNAMIC_RESOLUTION_H
+
+/*
+	Dynamic Resolution Scaling
+
+
+	deferred shading, SSAO 처럼 pixel 단위 연산이 많은 렌더링 방식은
+	GPU 비용이 화면 해상도(pixel 개수)에 거의 비례하므로,
+	복잡한 장면이나 느린 GPU 에서 목표 프레임 시간을 넘기기 쉬움.
+
+	그래서 G-buffer 와 lighting pass 는 출력 해상도보다 작은 내부 해상도로 렌더링한 뒤,
+	마지막에 bilinear 필터링으로 출력 해상도까지 확대(upscale)하면,
+	화면이 약간 흐려지는 대신 pixel 비용을 scale^2 만큼 줄일 수 있음.
+
+
+	이때, 매 프레임 측정한 GPU 시간을 그대로 배율에 반영하면
+	측정값의 작은 흔들림에도 배율이 계속 오르내리면서(oscillation) 화면 선명도가 깜빡이므로,
+
+	1. 목표 시간 주변에 hysteresis 구간을 두어, 구간을 벗어날 때만 배율을 조절하고,
+	2. 배율을 낮출 때는 빠르게(한 번에), 높일 때는 천천히(한 단계씩) 조절하며,
+	3. 배율을 바꾼 뒤에는 query 결과가 몇 프레임 늦게 도착하는 것을 고려해서 일정 프레임 동안 다시 바꾸지 않음.
+
+
+	또한 GPU 시간은 GL_TIMESTAMP query 로 프레임 시작 / 종료 시점을 기록해서 측정하는데,
+	query 결과를 곧바로 읽으면 CPU 가 GPU 를 기다려야 하므로(stall),
+	GpuTimer 처럼 query 를 여러 쌍 만들어두고 몇 프레임 전의 결과를 읽어옴.
+
+	단, GpuTimer 와 달리 재사용할 query 쌍의 결과가 아직 준비되지 않았더라도 기다리지 않고 그 측정값을 버림.
+	GPU 가 그만큼 밀려 있다는 것은 이미 프레임 시간이 목표를 넘었다는 뜻인데,
+	여기서 CPU 까지 멈추면 측정하려던 프레임 시간을 오히려 늘리게 되기 때문!
+	(버려진 측정값은 다음에 준비되는 결과로 충분히 대체되므로, 배율 조절이 조금 늦어질 뿐임)
+*/
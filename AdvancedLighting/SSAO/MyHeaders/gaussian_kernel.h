@@ -0,0 +1,106 @@
+#ifndef GAUSSIAN_KERNEL_H
+#define GAUSSIAN_KERNEL_H
+/*
+	gaussian_kernel.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+/*
+	GaussianKernel 구조체
+
+	반경이 radius 인 1차원 가우시안 blur 의 가중치를 저장하는 구조체
+	(weights[0] 이 중심 texel 의 가중치, weights[i] 가 중심에서 i 번째 떨어진 texel 의 가중치)
+
+	constexpr 함수로 생성하면 가중치 계산이 모두 컴파일 타임에 끝나고,
+	런타임에는 계산된 상수 배열을 쉐이더에 전송하기만 하면 됨.
+*/
+const int GAUSSIAN_MAX_RADIUS = 8;
+
+struct GaussianKernel
+{
+	int radius;
+	float weights[GAUSSIAN_MAX_RADIUS + 1];
+};
+
+/*
+	이항계수(binomial coefficient)로 가우시안 가중치 계산 (하단 필기 참고)
+
+	exp() 는 constexpr 함수가 아니라서 컴파일 타임에 계산할 수 없으므로,
+	정수 연산만으로 계산되는 파스칼 삼각형의 (2 * radius) 번째 행을 가우시안 분포의 근사값으로 사용함.
+*/
+constexpr GaussianKernel makeGaussianKernel(int radius)
+{
+	GaussianKernel kernel{ radius, {} };
+
+	// 파스칼 삼각형의 (2 * radius) 번째 행 계산 (중심을 포함한 오른쪽 절반만 필요함)
+	// C(n, k) = C(n, k - 1) * (n - k + 1) / k
+	const int n = 2 * radius;
+	double coefficient = 1.0; // C(n, 0)
+	double coefficients[2 * GAUSSIAN_MAX_RADIUS + 1] = {};
+	double sum = 0.0;
+	for (int k = 0; k <= n; k++)
+	{
+		coefficients[k] = coefficient;
+		sum += coefficient;
+		coefficient = coefficient * (n - k) / (k + 1);
+	}
+
+	// 전체 합이 1 이 되도록 정규화하여 중심 ~ 오른쪽 절반의 가중치 저장
+	for (int i = 0; i <= radius; i++)
+	{
+		kernel.weights[i] = (float)(coefficients[radius + i] / sum);
+	}
+
+	return kernel;
+}
+
+/*
+	반경 1 ~ GAUSSIAN_MAX_RADIUS 까지의 가우시안 가중치를 모두 저장하는 테이블
+
+	런타임에 blur 반경을 바꾸더라도 테이블에서 꺼내 쓰기만 하면 되도록
+	constexpr 생성자에서 모든 반경의 가중치를 컴파일 타임에 계산해 둠.
+*/
+struct GaussianKernelTable
+{
+	GaussianKernel kernels[GAUSSIAN_MAX_RADIUS + 1];
+
+	constexpr GaussianKernelTable()
+		: kernels()
+	{
+		for (int r = 0; r <= GAUSSIAN_MAX_RADIUS; r++)
+		{
+			kernels[r] = makeGaussianKernel(r);
+		}
+	}
+
+	constexpr const GaussianKernel& operator[](int radius) const
+	{
+		return kernels[radius];
+	}
+};
+
+// 반경 1 짜리 가중치는 [0.25, 0.5, 0.25] 의 중심 ~ 오른쪽 절반이어야 함 -> 컴파일 타임에 검증
+static_assert(makeGaussianKernel(1).weights[0] == 0.5f && makeGaussianKernel(1).weights[1] == 0.25f, "binomial weights of radius 1 must be [0.25, 0.5, 0.25]");
+
+
+#endif // !GAUSSIAN_KERNEL_H
+
+/*
+	이항계수로 가우시안 분포 근사하기
+
+
+	파스칼 삼각형의 n 번째 행, 즉 이항계수 C(n, 0) ~ C(n, n) 을
+	전체 합(2^n)으로 나눈 값은 이항분포의 확률질량함수가 되는데,
+
+	중심극한정리에 의해 n 이 커질수록 이항분포는
+	분산이 n / 4 인 정규분포(가우시안 분포)에 가까워짐.
+
+
+	그래서 반경이 r 인 blur 에는 (2r + 1) 개의 값을 갖는
+	파스칼 삼각형의 2r 번째 행을 가중치로 사용하면,
+	표준편차가 sqrt(2r) / 2 인 가우시안 blur 와 거의 같은 결과를 얻을 수 있음!
+
+
+	또한, 이항계수는 곱셈과 나눗셈만으로 계산되므로
+	constexpr 함수 안에서 컴파일 타임에 계산할 수 있다는 장점이 있음.
+*/
@@ -0,0 +1,32 @@
+#version 330 core
+
+// Hi-Z mip chain 텍스쳐의 내부 포맷이 GL_RG32F 이므로, vec2 타입으로 (min, max) 깊이값 출력
+out vec2 FragColor;
+
+/*
+  OpenGL 에서 전송해 줄 uniform 변수들 선언
+*/
+
+// G-buffer 에 attach 된 깊이 텍스쳐의 sampler 변수 선언
+uniform sampler2D depthMap;
+
+// G-buffer 를 렌더링할 때 사용한 원근 투영 행렬의 near, far 값
+uniform float nearPlane;
+uniform float farPlane;
+
+// 비선형 깊이값을 카메라로부터의 view space 거리(linear depth)로 변환
+// (관련 내용 https://github.com/jooo0922/opengl-study/blob/main/AdvancedOpenGL/Depth_Testing/MyShaders/depth_testing.fs 참고)
+float LinearizeDepth(float depth) {
+  // [0, 1] 범위의 깊이값을 [-1, 1] 범위의 NDC 좌표계로 변환
+  float z = depth * 2.0 - 1.0;
+  return (2.0 * nearPlane * farPlane) / (farPlane + nearPlane - z * (farPlane - nearPlane));
+}
+
+void main() {
+  // level 0 은 깊이 버퍼와 해상도가 같으므로, 현재 pixel 좌표의 texel 을 그대로 가져옴
+  float depth = texelFetch(depthMap, ivec2(gl_FragCoord.xy), 0).r;
+  float linearDepth = LinearizeDepth(depth);
+
+  // texel 1개 영역의 최소 / 최대 깊이값은 자기 자신
+  FragColor = vec2(linearDepth, linearDepth);
+}
@@ -29,10 +29,31 @@ uniform vec3 samples[64];
 // view space 기준 sample points 위치값을 NDC 좌표계로 변환하는 과정에서 사용할 투영 행렬
 uniform mat4 projection;
 
-/* SSAO Parameters */
+// 반구 영역 내의 sample kernel 중 실제로 사용할 개수 (64 의 약수로 전송받음 -> 8, 16, 32, 64)
+uniform int kernelSize;
+
+/*
+  4*4 크기의 Random rotation vector 텍스쳐 버퍼를 
+  SSAO 를 계산하는 해상도 전체 영역에 걸쳐 tiling 하기 위해,
+
+  텍스쳐 버퍼를 GL_REPEAT 모드로 반복 샘플링하여 사용할 수 있도록 
+  보간된 uv 좌표에 적용할 scale 값
+  (SSAO 해상도가 runtime 에 바뀔 수 있으므로, 상수 대신 uniform 으로 전송받음)
+*/
+uniform vec2 noiseScale;
+
+/*
+  temporal 모드에서 매 프레임 다른 sample set 을 사용하기 위한 값들
+  (temporal 모드가 아닐 때에는 둘 다 0 으로 전송됨)
+*/
+
+// sampleStride 간격으로 건너뛰며 sample kernel 을 고를 때의 시작 인덱스
+uniform int sampleOffset;
 
-// 반구 영역 내의 sample kernel 개수
-int kernelSize = 64;
+// random rotation vector 를 view space z 축 기준으로 추가 회전시킬 각도 (radian)
+uniform float noiseRotation;
+
+/* SSAO Parameters */
 
 // 반구 영역의 반지름 (sample kernel 이동 벡터의 길이를 반구 영역의 반지름에 맞게 전체적으로 조정할 때 사용)
 float radius = 0.5;
@@ -41,15 +62,6 @@ float radius = 0.5;
 // (acne 현상 관련 https://github.com/jooo0922/opengl-study/blob/main/AdvancedLighting/Shadow_Mapping_2/MyShaders/shadow_mapping.fs 참고)
 float bias = 0.025;
 
-/*
-  4*4 크기의 Random rotation vector 텍스쳐 버퍼를 
-  800*600 크기의 해상도 전체 영역에 걸쳐 tiling 하기 위해,
-
-  텍스쳐 버퍼를 GL_REPEAT 모드로 반복 샘플링하여 사용할 수 있도록 
-  보간된 uv 좌표에 적용할 scale 값 계산
-*/
-const vec2 noiseScale = vec2(800.0 / 4.0, 600.0 / 4.0);
-
 void main() {
   /* G-buffer 로부터 geometry data 가져오기 */
 
@@ -62,6 +74,11 @@ void main() {
   // 보간된 uv 좌표를 scaling 하여 4*4 크기의 Random rotation vector 텍스쳐 버퍼를 반복 샘플링
   vec3 randomVec = texture(texNoise, TexCoords * noiseScale).xyz;
 
+  // 프레임마다 달라지는 각도만큼 random rotation vector 를 z 축 기준으로 회전 -> 반구 영역의 sample kernel 들도 함께 회전됨
+  float cosR = cos(noiseRotation);
+  float sinR = sin(noiseRotation);
+  randomVec.xy = vec2(cosR * randomVec.x - sinR * randomVec.y, sinR * randomVec.x + cosR * randomVec.y);
+
   /* 
     tangent space 로 계산된 sample kernel 이동 벡터를 
     view space 로 변환할 때 사용할 TBN 행렬 계산 
@@ -85,10 +102,14 @@ void main() {
   // 반복문을 순회하며 누산할 occlusion factor 변수 초기화
   float occlusion = 0.0;
 
+  // 64개의 sample kernel 중 kernelSize 개만 사용할 때, 건너뛸 간격 계산
+  // -> sample kernel 은 인덱스가 클수록 길이가 길어지도록 정렬되어 있으므로, 앞에서부터 잘라 쓰면 반구 바깥쪽을 샘플링하지 못함!
+  int sampleStride = 64 / kernelSize;
+
   // 반구 영역 내의 sample kernel 개수만큼 반복문 순회
   for(int i = 0; i < kernelSize; i++) {
     // tangent space 기준으로 정의된 sample kernel 이동 벡터를 view space 로 변환
-    vec3 samplePos = TBN * samples[i];
+    vec3 samplePos = TBN * samples[i * sampleStride + sampleOffset];
 
     // 현재 프래그먼트 위치에서 각 sample kernel 이동 벡터를 더해 sample point 좌표값 계산
     samplePos = fragPos + samplePos * radius;
@@ -121,10 +142,10 @@ void main() {
     occlusion += (sampleDepth >= samplePos.z + bias ? 1.0 : 0.0) * rangeCheck;
   }
 
-  // 누산된 occlusion factor 의 최댓값이 64 일테니까, 누산된 결과값을 64.0 으로 나눠서 [0.0, 1.0] 사이의 값으로 normalize
+  // 누산된 occlusion factor 의 최댓값이 kernelSize 일테니까, 누산된 결과값을 kernelSize 로 나눠서 [0.0, 1.0] 사이의 값으로 normalize
   // + 정규화된 occlusion factor 값을 1.0 에서 빼서 뒤집어 줌 
   // -> occlusion 이 많이 발생한 프래그먼트 일수록 occlusion 값이 0 에 가까워지겠군!
-  occlusion = 1.0 - (occlusion / kernelSize);
+  occlusion = 1.0 - (occlusion / float(kernelSize));
 
   // FragColor 출력 변수에 누산된 최종 색상값 할당
   /*
@@ -0,0 +1,92 @@
+#version 330 core
+
+// 최종 색상을 할당할 출력 변수 선언
+// (SSAO Blur 텍스쳐 버퍼도 내부 포맷이 GL_RED 이므로, float 타입의 값만 출력함)
+out float FragColor;
+
+// vertex shader 단계에서 전달되면서 보간된 텍스쳐 좌표 입력 변수 선언
+in vec2 TexCoords;
+
+/*
+  OpenGL 에서 전송해 줄 uniform 변수들 선언
+*/
+
+// blur 를 적용할 SSAO occlusion factor 텍스쳐 버퍼의 sampler 변수 선언
+uniform sampler2D ssaoInput;
+
+// 가중치 계산에 사용할 G-buffer 의 sampler 변수 선언 (ssaoInput 과 같은 해상도의 G-buffer 를 바인딩해야 함)
+uniform sampler2D gPosition;
+uniform sampler2D gNormal;
+
+// blur 방향 (수평 방향이면 (1, 0), 수직 방향이면 (0, 1))
+uniform vec2 direction;
+
+// blur 반경 (중심 texel 로부터 한쪽 방향으로 샘플링할 texel 개수)
+uniform int radius;
+
+// CPU 에서 컴파일 타임에 미리 계산해 둔 1차원 가우시안 가중치 (weights[0] 이 중심 texel 의 가중치, 최대 반경 8)
+uniform float weights[9];
+
+/* Bilateral Blur Parameters */
+
+// 깊이값 차이에 따른 가중치 감소 정도 (현재 pixel 깊이값에 대한 비율)
+float depthSigma = 0.05;
+
+// 노멀벡터 차이에 따른 가중치 감소 정도 (내적값의 거듭제곱 지수)
+float normalPower = 16.0;
+
+void main() {
+  // blur 방향으로 1 texel 만큼 이동할 uv offset 계산
+  vec2 texelStep = direction / vec2(textureSize(ssaoInput, 0));
+
+  // 중심 texel 의 깊이값 및 노멀벡터
+  float centerDepth = texture(gPosition, TexCoords).z;
+  vec3 centerNormal = texture(gNormal, TexCoords).rgb;
+
+  // 중심 texel 은 깊이값 및 노멀벡터 가중치가 항상 1 이므로, 가우시안 가중치만 적용하여 누산 시작
+  float result = texture(ssaoInput, TexCoords).r * weights[0];
+  float totalWeight = weights[0];
+
+  // 중심 texel 의 양쪽 방향으로 radius 개씩 texel 을 샘플링하며 누산
+  for(int i = 1; i <= radius; i++) {
+    for(int side = -1; side <= 1; side += 2) {
+      vec2 uv = TexCoords + texelStep * float(i * side);
+
+      float ao = texture(ssaoInput, uv).r;
+      float depth = texture(gPosition, uv).z;
+      vec3 normal = texture(gNormal, uv).rgb;
+
+      // 깊이값이 비슷할수록 1 에 가까워지는 가중치
+      float depthWeight = 1.0 / (1.0 + abs(depth - centerDepth) / (depthSigma * abs(centerDepth) + 0.0001));
+
+      // 노멀벡터 방향이 비슷할수록 1 에 가까워지는 가중치
+      float normalWeight = pow(max(dot(normal, centerNormal), 0.0), normalPower);
+
+      float weight = weights[i] * depthWeight * normalWeight;
+      result += ao * weight;
+      totalWeight += weight;
+    }
+  }
+
+  FragColor = result / totalWeight;
+}
+
+/*
+  Separable Bilateral Blur
+
+
+  기존 ssao_blur.fs 는 4*4 영역의 texel 을 모두 같은 가중치로 더하는 box blur 라서,
+  16번 샘플링으로 4*4 영역밖에 흐리게 만들지 못하고,
+  물체의 edge 를 넘어서 앞쪽/뒤쪽 표면의 occlusion factor 가 서로 번지게 됨.
+
+
+  가우시안 blur 는 2차원 가중치가 1차원 가중치의 곱으로 분리(separable)되므로,
+  수평 방향 -> 수직 방향으로 2번 나눠서 적용하면
+  (2r + 1)^2 번이 아니라 2 * (2r + 1) 번의 샘플링만으로 같은 결과를 얻을 수 있음.
+
+  또한, 각 texel 의 가중치에 깊이값 및 노멀벡터 유사도를 곱해주면(bilateral),
+  다른 표면에 속한 texel 은 거의 더해지지 않으므로 edge 가 깔끔하게 유지됨!
+
+  (엄밀히 말하면 bilateral 가중치가 곱해지는 순간 완전히 separable 하지는 않지만,
+  SSAO 처럼 저주파 신호에서는 그 차이가 눈에 띄지 않음)
+*/
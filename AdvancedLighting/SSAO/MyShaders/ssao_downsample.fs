@@ -0,0 +1,81 @@
+#version 330 core
+
+// layout location specifier 로 저해상도 프레임버퍼에 바인딩된 각 color attachment 에 대응되는 출력 변수 선언
+layout(location = 0) out vec3 gPositionLow;
+layout(location = 1) out vec3 gNormalLow;
+
+// vertex shader 단계에서 전달되면서 보간된 텍스쳐 좌표 입력 변수 선언
+in vec2 TexCoords;
+
+/*
+  OpenGL 에서 전송해 줄 uniform 변수들 선언
+*/
+
+// Geometry pass 에서 저장한 full-res G-buffer 의 sampler 변수 선언
+uniform sampler2D gPosition;
+uniform sampler2D gNormal;
+
+// 해상도 축소 배율 (2: half-res, 4: quarter-res)
+uniform int downScale;
+
+void main() {
+  // 현재 저해상도 pixel 에 대응되는 full-res G-buffer 상의 downScale * downScale 블록의 시작 좌표 계산
+  ivec2 lowCoord = ivec2(gl_FragCoord.xy);
+  ivec2 baseCoord = lowCoord * downScale;
+
+  // full-res G-buffer 의 크기를 벗어나는 texel 은 가져오지 않도록 최대 좌표 계산
+  ivec2 maxCoord = textureSize(gPosition, 0) - 1;
+
+  /*
+    checkerboard 패턴으로 min/max 깊이값 선택 (하단 필기 참고)
+
+    짝수 pixel 은 블록 내에서 카메라에 가장 가까운 texel 을,
+    홀수 pixel 은 블록 내에서 카메라에서 가장 먼 texel 을 대표값으로 선택함.
+  */
+  bool pickNearest = ((lowCoord.x + lowCoord.y) & 1) == 0;
+
+  // 블록의 첫 번째 texel 을 대표값으로 초기화
+  ivec2 bestCoord = min(baseCoord, maxCoord);
+  float bestDepth = texelFetch(gPosition, bestCoord, 0).z;
+
+  // 블록 내의 나머지 texel 들을 순회하며 대표값 갱신
+  for(int y = 0; y < downScale; y++) {
+    for(int x = 0; x < downScale; x++) {
+      ivec2 coord = min(baseCoord + ivec2(x, y), maxCoord);
+      float depth = texelFetch(gPosition, coord, 0).z;
+
+      // view space 는 카메라에서 멀어질수록 z 값이 작아지므로, z 값이 클수록 카메라에 가까운 texel 임!
+      if((pickNearest && depth > bestDepth) || (!pickNearest && depth < bestDepth)) {
+        bestDepth = depth;
+        bestCoord = coord;
+      }
+    }
+  }
+
+  // position 과 normal 은 반드시 같은 texel 에서 가져와야 서로 어긋나지 않음
+  gPositionLow = texelFetch(gPosition, bestCoord, 0).rgb;
+  gNormalLow = texelFetch(gNormal, bestCoord, 0).rgb;
+}
+
+/*
+  G-buffer 를 downsampling 할 때 평균값을 사용하지 않는 이유
+
+
+  저해상도 SSAO 를 계산하려면 G-buffer 의 position, normal 도
+  같은 해상도로 줄여야 하는데, 이때 여러 texel 의 평균값을 사용하면
+
+  물체의 edge 처럼 깊이값이 급격하게 변하는 지점에서
+  실제로는 존재하지 않는 '중간 깊이'의 표면이 만들어져 버림.
+
+
+  그래서 블록 내의 texel 중 하나를 골라서 그대로 사용하는데,
+  항상 가장 가까운(min) 깊이만 고르면 뒤쪽 표면의 정보가,
+  항상 가장 먼(max) 깊이만 고르면 앞쪽 표면의 정보가 사라지게 됨.
+
+
+  따라서, pixel 마다 min/max 를 번갈아가며 선택하는 checkerboard 패턴을 사용하면,
+  edge 부근에서도 앞쪽/뒤쪽 표면 정보가 저해상도 버퍼에 골고루 남아있게 되어
+
+  bilateral upsampling 시 full-res pixel 과 깊이가 비슷한 texel 을
+  찾을 수 있는 확률이 높아지는 것!
+*/
@@ -0,0 +1,126 @@
+#version 330 core
+
+// 최종 색상을 할당할 출력 변수 선언
+// (ssao.fs 와 같은 텍스쳐 버퍼에 렌더링하므로, 마찬가지로 float 타입의 값만 출력함)
+out float FragColor;
+
+// vertex shader 단계에서 전달되면서 보간된 텍스쳐 좌표 입력 변수 선언
+in vec2 TexCoords;
+
+/*
+  OpenGL 에서 전송해 줄 uniform 변수들 선언
+*/
+
+// Geometry pass 에서 저장한 geometry data 가 담긴 각 G-buffer 의 sampler 변수 선언
+uniform sampler2D gPosition;
+uniform sampler2D gNormal;
+
+// 16개의 Random rotation vector 가 저장된 4*4 텍스쳐 버퍼의 sampler 변수 선언 (ssao.fs 와 공유)
+uniform sampler2D texNoise;
+
+// 4*4 크기의 noise 텍스쳐를 SSAO 해상도 전체에 tiling 하기 위한 scale 값
+uniform vec2 noiseScale;
+
+// temporal 모드에서 매 프레임 샘플링 방향을 추가로 회전시킬 각도 (radian)
+uniform float noiseRotation;
+
+// view space 반경을 screen space(uv) 반경으로 변환할 때 사용할 투영 행렬
+uniform mat4 projection;
+
+// 화면 공간에서 horizon 을 탐색할 방향 개수 및 각 방향마다 전진할 step 개수 (전체 샘플링 횟수 = directions * steps)
+uniform int directions;
+uniform int steps;
+
+/* HBAO Parameters */
+
+// horizon 을 탐색할 view space 반경 (ssao.fs 의 반구 영역 반지름과 동일하게 맞춤)
+float radius = 0.5;
+
+// 평평한 표면에서 발생하는 acne 현상 방지를 위해, tangent plane 보다 이 각도(sin 값)만큼 위에서부터 horizon 을 탐색함
+float angleBias = 0.1;
+
+const float PI = 3.14159265359;
+
+void main() {
+  // G-buffer 로부터 현재 pixel 의 view space position 및 normal 값 샘플링
+  vec3 fragPos = texture(gPosition, TexCoords).rgb;
+  vec3 normal = normalize(texture(gNormal, TexCoords).rgb);
+
+  // view space 반경 radius 가 화면상에서 차지하는 uv 좌표계 기준 반경 계산 (원근 투영이므로 멀리 있을수록 작아짐)
+  vec2 radiusUV = 0.5 * radius * vec2(projection[0][0], projection[1][1]) / -fragPos.z;
+
+  // noise 텍스쳐로부터 pixel 마다 다른 회전 각도 및 step 시작 위치(jitter) 계산 -> blur pass 에서 noise pattern 이 흐려짐
+  vec3 randomVec = texture(texNoise, TexCoords * noiseScale).xyz;
+  float rotation = atan(randomVec.y, randomVec.x) + noiseRotation;
+  float jitter = fract(length(randomVec.xy) * 7.0);
+
+  // 각 방향에서 구한 occlusion 값을 누산할 변수 초기화
+  float occlusion = 0.0;
+
+  for(int d = 0; d < directions; d++) {
+    // 화면 공간에서 horizon 을 탐색할 방향 계산
+    float angle = rotation + 2.0 * PI * float(d) / float(directions);
+    vec2 dir = vec2(cos(angle), sin(angle));
+
+    // 현재까지 찾은 가장 높은 horizon 의 sin 값 (tangent plane + angleBias 에서 시작)
+    float maxSinH = angleBias;
+
+    // 현재 방향에서의 occlusion 값
+    float dirOcclusion = 0.0;
+
+    for(int s = 0; s < steps; s++) {
+      // 현재 방향으로 radiusUV 범위 내에서 전진한 uv 좌표 계산
+      float t = (float(s) + jitter) / float(steps);
+      vec2 sampleUV = TexCoords + dir * radiusUV * t;
+
+      // 해당 uv 좌표의 view space 위치값과 현재 프래그먼트로부터의 벡터 계산
+      vec3 samplePos = texture(gPosition, sampleUV).rgb;
+      vec3 V = samplePos - fragPos;
+      float dist2 = dot(V, V);
+
+      // 노멀벡터 기준 sample 지점의 elevation(sin 값) 계산 -> tangent plane 위로 올라갈수록 1 에 가까워짐
+      float sinH = dot(normal, V) * inversesqrt(dist2 + 0.0001);
+
+      // 반경 밖의 sample 일수록 기여도가 0 에 가까워지도록 감쇄
+      float falloff = clamp(1.0 - dist2 / (radius * radius), 0.0, 1.0);
+
+      // 지금까지 찾은 horizon 보다 높은 지점을 만나면, 높아진 만큼을 occlusion 으로 누산하고 horizon 갱신 (하단 필기 참고)
+      if(sinH > maxSinH) {
+        dirOcclusion += (sinH - maxSinH) * falloff;
+        maxSinH = sinH;
+      }
+    }
+
+    occlusion += dirOcclusion;
+  }
+
+  // 방향 개수로 평균을 내서 [0.0, 1.0] 범위로 정규화한 뒤 뒤집어 줌 (ssao.fs 와 동일하게 1.0 이 차폐 없음)
+  FragColor = 1.0 - occlusion / float(directions);
+}
+
+/*
+  Horizon-Based Ambient Occlusion (HBAO)
+
+
+  ssao.fs 는 반구 영역 안에 랜덤하게 흩뿌린 점들이
+  깊이 버퍼보다 뒤에 있는지 하나씩 테스트하므로,
+  noise 없이 깔끔한 결과를 얻으려면 64개 정도의 sample 이 필요함.
+
+
+  반면 HBAO 는 화면 공간에서 몇 개의 방향을 정하고,
+  각 방향으로 깊이 버퍼 위를 걸어가면서(ray marching)
+  '하늘을 가리는 가장 높은 지점', 즉 horizon 의 각도를 찾음.
+
+  horizon 이 높을수록 그 방향의 하늘이 많이 가려진 것이므로,
+  horizon 각도의 sin 값 자체가 해당 방향의 occlusion 이 되는 것!
+
+
+  이때 위 코드처럼 horizon 이 갱신될 때마다 '높아진 만큼'만 누산하면,
+  최종적으로는 (가장 높은 horizon 의 sin 값 - angleBias) 가 누산되면서도,
+  각 구간에 거리에 따른 falloff 를 따로 적용할 수 있음.
+
+
+  sample 이 반구 안에 무작위로 흩어지는 대신 표면을 따라 체계적으로 배치되므로,
+  4 방향 * 4 step = 16번 정도의 샘플링만으로도
+  64개 sample 을 사용한 SSAO 와 비슷한 품질을 얻을 수 있음.
+*/
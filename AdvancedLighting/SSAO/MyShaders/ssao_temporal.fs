@@ -0,0 +1,103 @@
+#version 330 core
+
+// 최종 색상을 할당할 출력 변수 선언
+/*
+  history 텍스쳐 버퍼는 내부 포맷이 GL_RG16F 로 설정되어 있으므로,
+  r 성분에는 누적된 occlusion factor 를,
+  g 성분에는 다음 프레임에서 disocclusion 검사에 사용할 view space 깊이값을 저장함.
+*/
+out vec2 FragColor;
+
+// vertex shader 단계에서 전달되면서 보간된 텍스쳐 좌표 입력 변수 선언
+in vec2 TexCoords;
+
+/*
+  OpenGL 에서 전송해 줄 uniform 변수들 선언
+*/
+
+// 현재 프레임에서 blur 까지 적용된 full-res SSAO 텍스쳐 버퍼의 sampler 변수 선언
+uniform sampler2D ssaoInput;
+
+// 현재 프레임의 view space position 이 저장된 G-buffer 의 sampler 변수 선언
+uniform sampler2D gPosition;
+
+// 이전 프레임까지 누적된 history 텍스쳐 버퍼의 sampler 변수 선언
+uniform sampler2D history;
+
+// 현재 프레임의 view space 위치값을 world space 로 되돌릴 때 사용할 뷰 행렬의 역행렬
+uniform mat4 invView;
+
+// 이전 프레임의 뷰 행렬 및 (투영 행렬 * 뷰 행렬)
+uniform mat4 prevView;
+uniform mat4 prevViewProjection;
+
+// 현재 프레임의 occlusion factor 를 history 에 섞는 비율 (작을수록 더 많은 프레임이 누적됨)
+uniform float blendFactor;
+
+// history 텍스쳐 버퍼에 유효한 데이터가 있는지 여부 (첫 프레임, 리사이즈 직후에는 false)
+uniform bool historyValid;
+
+/* Disocclusion Parameters */
+
+// 이전 프레임의 깊이값과 이 비율 이상 차이나면 다른 표면으로 판단하고 history 를 버림
+float depthTolerance = 0.05;
+
+void main() {
+  // 현재 프레임에서 계산된 occlusion factor 및 view space 위치값 샘플링
+  float current = texture(ssaoInput, TexCoords).r;
+  vec3 fragPos = texture(gPosition, TexCoords).rgb;
+
+  // 기본적으로는 현재 프레임 결과를 그대로 출력
+  float result = current;
+
+  if(historyValid) {
+    /* 현재 pixel 이 이전 프레임에서는 화면의 어디에 있었는지 재투영(reprojection) */
+
+    // view space -> world space
+    vec4 worldPos = invView * vec4(fragPos, 1.0);
+
+    // world space -> 이전 프레임의 clip space -> NDC -> [0, 1] 범위의 uv 좌표
+    vec4 prevClip = prevViewProjection * worldPos;
+    vec2 prevUV = (prevClip.xy / prevClip.w) * 0.5 + 0.5;
+
+    // 이전 프레임의 view space 에서 현재 pixel 이 가져야 할 깊이값
+    float expectedDepth = (prevView * worldPos).z;
+
+    // 이전 프레임에서 화면 밖에 있었던 pixel 은 history 가 없음
+    bool insideScreen = all(greaterThanEqual(prevUV, vec2(0.0))) && all(lessThanEqual(prevUV, vec2(1.0)));
+
+    if(insideScreen) {
+      vec2 prev = texture(history, prevUV).rg;
+
+      // disocclusion 검사 (하단 필기 참고)
+      // -> 이전 프레임에 저장된 깊이값과 재투영으로 계산한 깊이값이 비슷할 때에만 같은 표면으로 보고 history 를 사용함
+      float depthDiff = abs(prev.g - expectedDepth);
+      if(depthDiff < depthTolerance * abs(expectedDepth)) {
+        // 지수 이동 평균(exponential moving average) 으로 누적
+        result = mix(prev.r, current, blendFactor);
+      }
+    }
+  }
+
+  FragColor = vec2(result, fragPos.z);
+}
+
+/*
+  Temporal Accumulation 과 Disocclusion
+
+
+  매 프레임마다 sample kernel 의 다른 부분집합을 다른 각도로 회전시켜 사용하면,
+  한 프레임의 결과는 noise 가 많지만 프레임들을 누적하면 평균적으로 64개 sample 을 모두 사용한 결과에 수렴함.
+
+  다만, 카메라가 움직이면 같은 pixel 위치에 다른 표면이 보이게 되므로,
+  현재 pixel 의 위치를 이전 프레임의 view-projection 행렬로 재투영해서
+  '이전 프레임에서 이 표면이 보였던 위치'의 history 를 읽어와야 함.
+
+
+  그런데 카메라가 움직이면서 앞쪽 물체에 가려져 있던 표면이 새로 드러나는 경우(disocclusion)에는,
+  재투영한 위치의 history 에 앞쪽 물체의 occlusion factor 가 저장되어 있겠지?
+
+  그래서 history 에 깊이값도 함께 저장해두고,
+  재투영으로 계산한 깊이값과 비교했을 때 차이가 크면
+  history 를 버리고 현재 프레임 결과만 사용하는 것!
+*/
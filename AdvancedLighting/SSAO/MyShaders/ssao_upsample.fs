@@ -0,0 +1,103 @@
+#version 330 core
+
+// 최종 색상을 할당할 출력 변수 선언
+// (full-res SSAO 텍스쳐 버퍼도 내부 포맷이 GL_RED 이므로, float 타입의 값만 출력함)
+out float FragColor;
+
+// vertex shader 단계에서 전달되면서 보간된 텍스쳐 좌표 입력 변수 선언
+in vec2 TexCoords;
+
+/*
+  OpenGL 에서 전송해 줄 uniform 변수들 선언
+*/
+
+// 저해상도에서 blur 까지 적용된 SSAO occlusion factor 텍스쳐 버퍼의 sampler 변수 선언
+uniform sampler2D ssaoInput;
+
+// full-res G-buffer 의 sampler 변수 선언
+uniform sampler2D gPosition;
+uniform sampler2D gNormal;
+
+// 저해상도로 downsampling 된 G-buffer 의 sampler 변수 선언
+uniform sampler2D gPositionLow;
+uniform sampler2D gNormalLow;
+
+/* Bilateral Upsampling Parameters */
+
+// 깊이값 차이에 따른 가중치 감소 정도 (현재 pixel 깊이값에 대한 비율)
+float depthSigma = 0.05;
+
+// 노멀벡터 차이에 따른 가중치 감소 정도 (내적값의 거듭제곱 지수)
+float normalPower = 16.0;
+
+void main() {
+  // 현재 full-res pixel 의 view space position 및 normal 값 샘플링
+  vec3 fragPos = texture(gPosition, TexCoords).rgb;
+  vec3 normal = texture(gNormal, TexCoords).rgb;
+
+  // 저해상도 텍스쳐 버퍼의 크기
+  ivec2 lowSize = textureSize(ssaoInput, 0);
+
+  // 현재 pixel 을 둘러싼 저해상도 texel 4개 중 좌하단 texel 좌표 및 bilinear 보간 비율 계산
+  vec2 lowCoord = TexCoords * vec2(lowSize) - 0.5;
+  ivec2 baseCoord = ivec2(floor(lowCoord));
+  vec2 f = lowCoord - vec2(baseCoord);
+
+  // 4개 texel 의 가중치를 누산할 변수 초기화
+  float result = 0.0;
+  float totalWeight = 0.0;
+
+  // 모든 가중치가 0 에 가까울 경우를 대비하여, 깊이값이 가장 비슷한 texel 의 occlusion factor 를 기억해 둠
+  float nearestAO = 1.0;
+  float nearestDepthDiff = 1e10;
+
+  for(int y = 0; y < 2; y++) {
+    for(int x = 0; x < 2; x++) {
+      // 저해상도 텍스쳐 버퍼 범위를 벗어나지 않도록 texel 좌표 clamping
+      ivec2 coord = clamp(baseCoord + ivec2(x, y), ivec2(0), lowSize - 1);
+
+      float ao = texelFetch(ssaoInput, coord, 0).r;
+      vec3 lowPos = texelFetch(gPositionLow, coord, 0).rgb;
+      vec3 lowNormal = texelFetch(gNormalLow, coord, 0).rgb;
+
+      // 일반적인 bilinear 보간 가중치
+      float bilinearWeight = (x == 1 ? f.x : 1.0 - f.x) * (y == 1 ? f.y : 1.0 - f.y);
+
+      // 깊이값이 비슷할수록 1 에 가까워지는 가중치 (멀리 있는 표면일수록 깊이 차이를 더 관대하게 허용함)
+      float depthDiff = abs(lowPos.z - fragPos.z);
+      float depthWeight = 1.0 / (1.0 + depthDiff / (depthSigma * abs(fragPos.z) + 0.0001));
+
+      // 노멀벡터 방향이 비슷할수록 1 에 가까워지는 가중치
+      float normalWeight = pow(max(dot(lowNormal, normal), 0.0), normalPower);
+
+      float weight = bilinearWeight * depthWeight * normalWeight;
+      result += ao * weight;
+      totalWeight += weight;
+
+      if(depthDiff < nearestDepthDiff) {
+        nearestDepthDiff = depthDiff;
+        nearestAO = ao;
+      }
+    }
+  }
+
+  // 가중치 합이 너무 작으면 (주변 4개 texel 이 모두 다른 표면이면) 깊이값이 가장 비슷한 texel 값을 그대로 사용
+  FragColor = totalWeight > 0.0001 ? result / totalWeight : nearestAO;
+}
+
+/*
+  Bilateral Upsampling
+
+
+  저해상도에서 계산한 occlusion factor 를 단순히 bilinear 보간으로 확대하면,
+  물체의 edge 부근에서 앞쪽 표면과 뒤쪽 표면의 occlusion factor 가 섞여서
+  edge 주변에 번지는 듯한 halo 가 생기게 됨.
+
+
+  그래서 bilinear 보간 가중치에 더해,
+  full-res pixel 과 저해상도 texel 의 깊이값 및 노멀벡터가
+  얼마나 비슷한 지에 따른 가중치를 곱해줌으로써,
+
+  '같은 표면에 속한 texel' 의 occlusion factor 만
+  보간에 반영되도록 하는 게 bilateral upsampling 의 핵심!
+*/
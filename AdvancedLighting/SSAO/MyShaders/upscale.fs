@@ -0,0 +1,16 @@
+#version 330 core
+
+out vec4 FragColor;
+
+// 버텍스 쉐이더에서 전송받은 텍스쳐 좌표 입력변수 선언
+in vec2 TexCoords;
+
+/* uniform 변수 선언 */
+
+// 출력 해상도보다 작은 내부 해상도로 lighting pass 결과를 렌더링한 텍스쳐
+uniform sampler2D sceneTexture;
+
+void main() {
+  // 텍스쳐의 필터링 모드가 GL_LINEAR 이므로, 출력 해상도의 pixel 사이를 bilinear 보간으로 채우며 확대됨
+  FragColor = vec4(texture(sceneTexture, TexCoords).rgb, 1.0);
+}
@@ -14,9 +14,16 @@
 #include "MyHeaders/shader_s.h"
 #include "MyHeaders/camera.h"
 #include "MyHeaders/model.h"
+#include "MyHeaders/gpu_timer.h"
+#include "MyHeaders/gaussian_kernel.h"
+#include "MyHeaders/hiz_builder.h"
+#include "MyHeaders/render_target_pool.h"
+#include "MyHeaders/render_target_registry.h"
+#include "MyHeaders/dynamic_resolution.h"
 
 #include <iostream>
 #include <cstdlib> // srand() 및 rand() 함수 사용을 위해 포함
+#include <cmath> // std::sqrt() 를 사용하기 위해 포함
 #include <random> // c++ 11 부터 들어온 랜덤 라이브러리 (난수 생성기, 난수 분포 조작 클래스 (std::uniform_real_distribution<> 등...) 사용을 위해 포함)
 
 /* 콜백함수 전방선언 */
@@ -39,12 +46,62 @@ void renderCube();
 // shadow map 을 샘플링하여 깊이 버퍼를 시각화할 QuadMesh 를 렌더링하는 함수 선언
 void renderQuad();
 
+// 이미 생성된 텍스쳐 객체의 메모리 공간을 새로운 해상도로 재할당하는 함수 선언
+void resizeTexture(unsigned int texture, GLint internalFormat, unsigned int width, unsigned int height, GLenum format, GLenum type);
+
+// Van der Corput 수열(Hammersley 수열의 두 번째 성분)의 i 번째 값을 계산하는 함수 선언
+float RadicalInverse_VdC(unsigned int bits);
+
 
 // 윈도우 창 생성 옵션
 // 너비와 높이는 음수가 없으므로, 부호가 없는 정수형 타입으로 심볼릭 상수 지정 (가급적 전역변수 사용 자제...)
 const unsigned int SCR_WIDTH = 800; // 윈도우 창 너비
 const unsigned int SCR_HEIGHT = 600; // 윈도우 창 높이
 
+// 윈도우 framebuffer 크기(출력 해상도)를 추적할 registry 생성 (render_target_registry.h 필기 참고)
+// -> 크기 변경이 멈춘 뒤에만 출력 해상도를 갱신하고, 내부 해상도 render target 들은 이 크기에 배율을 곱해서 internalTargets 가 재할당함
+RenderTargetRegistry outputTargets(SCR_WIDTH, SCR_HEIGHT);
+
+// SSAO 를 계산할 해상도의 축소 배율 초기화 (1: full-res, 2: half-res, 4: quarter-res)
+unsigned int aoDownScale = 2;
+
+// 반구 영역 내의 sample kernel 중 실제로 사용할 개수 초기화 (8, 16, 32, 64 중 하나)
+int aoKernelSize = 64;
+bool aoKernelKeyPressed = false;
+
+// horizon-based AO(HBAO) 모드 활성화 상태값 초기화 (false 면 기존 반구 영역 sample kernel 방식 사용)
+bool aoHorizonBased = false;
+bool aoHorizonKeyPressed = false;
+
+// full-res reference 대비 SSAO 오차 측정 요청 상태값 초기화
+bool aoErrorReportRequested = false;
+bool aoErrorKeyPressed = false;
+
+// Hi-Z mip chain 의 level 별 해상도 및 GPU 소요 시간 출력 요청 상태값 초기화
+// (아직 Hi-Z 를 샘플링하는 pass 가 없으므로, 출력을 요청한 뒤 남은 프레임 동안에만 mip chain 을 생성함)
+unsigned int hiZReportFramesLeft = 0;
+bool hiZReportKeyPressed = false;
+
+// temporal accumulation 모드 활성화 상태값 초기화
+bool aoTemporal = false;
+bool aoTemporalKeyPressed = false;
+
+// separable bilateral blur 활성화 상태값 초기화 (false 면 기존 4*4 box blur 사용)
+bool aoBilateralBlur = true;
+bool aoBlurKeyPressed = false;
+
+// separable bilateral blur 의 반경 초기화 (1 ~ GAUSSIAN_MAX_RADIUS)
+int aoBlurRadius = 4;
+bool aoBlurRadiusKeyPressed = false;
+
+// dynamic resolution 활성화 여부 및 목표 GPU 프레임 시간(millisecond 단위) 초기화 (R 키로 on/off, 위/아래 방향키로 목표 시간 조절)
+bool dynamicResolution = false;
+bool dynamicResolutionKeyPressed = false;
+float dynamicResolutionTargetMs = 16.6f;
+
+// 반경 0 ~ GAUSSIAN_MAX_RADIUS 까지의 가우시안 가중치를 컴파일 타임에 미리 계산해 둔 테이블
+constexpr GaussianKernelTable gaussianKernels;
+
 // 카메라 클래스 생성 (카메라 위치값만 매개변수로 전달함.)
 Camera camera(glm::vec3(0.0f, 0.0f, 5.0f));
 
@@ -142,9 +199,27 @@ int main()
 	// G-buffer, sample kernel, random rotation buffer 로부터 샘플링된 데이터로 SSAO 효과를 적용할 쉐이더 객체 생성
 	Shader shaderSSAO("MyShaders/ssao.vs", "MyShaders/ssao.fs");
 
+	// SSAO 대신 horizon-based AO 로 occlusion factor 를 계산할 쉐이더 객체 생성 (blur 및 lighting pass 는 공유함)
+	Shader shaderHBAO("MyShaders/ssao.vs", "MyShaders/ssao_hbao.fs");
+
 	// SSAO 가 적용된 텍스쳐 버퍼에 blur 효과를 적용할 쉐이더 객체 생성
 	Shader shaderSSAOBlur("MyShaders/ssao.vs", "MyShaders/ssao_blur.fs");
 
+	// SSAO 가 적용된 텍스쳐 버퍼에 깊이값 및 노멀벡터를 고려한 separable blur 효과를 적용할 쉐이더 객체 생성
+	Shader shaderSSAOBlurBilateral("MyShaders/ssao.vs", "MyShaders/ssao_blur_bilateral.fs");
+
+	// full-res G-buffer 를 저해상도로 downsampling 할 쉐이더 객체 생성
+	Shader shaderSSAODownsample("MyShaders/ssao.vs", "MyShaders/ssao_downsample.fs");
+
+	// 저해상도 SSAO 결과를 full-res 로 bilateral upsampling 할 쉐이더 객체 생성
+	Shader shaderSSAOUpsample("MyShaders/ssao.vs", "MyShaders/ssao_upsample.fs");
+
+	// 이전 프레임까지 누적된 SSAO 결과를 재투영하여 현재 프레임 결과와 섞어줄 쉐이더 객체 생성
+	Shader shaderSSAOTemporal("MyShaders/ssao.vs", "MyShaders/ssao_temporal.fs");
+
+	// 내부 해상도로 렌더링한 lighting pass 결과를 출력 해상도로 확대할 쉐이더 객체 생성
+	Shader shaderUpscale("MyShaders/ssao.vs", "MyShaders/upscale.fs");
+
 
 	/* Assimp 를 사용하여 모델 업로드 */
 
@@ -155,6 +230,13 @@ int main()
 	Model backpack("resources/models/backpack/backpack.obj");
 
 
+	// high-DPI 모니터에서는 framebuffer 크기가 윈도우 크기(SCR_WIDTH * SCR_HEIGHT)와 다를 수 있으므로,
+	// render target 들을 생성하기 전에 실제 framebuffer 크기로 출력 해상도를 맞춰줌
+	int framebufferWidth, framebufferHeight;
+	glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+	outputTargets.resize(framebufferWidth, framebufferHeight);
+
+
 	/* G-buffer 로 사용할 프레임버퍼(Floating point framebuffer) 생성 및 설정 */
 	/* 또한, 이 프레임버퍼는 Multiple Render Target(MRT) 로 설정. */
 
@@ -200,19 +282,24 @@ int main()
 	unsigned int attachments[3] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 };
 	glDrawBuffers(3, attachments);
 
-	// FBO 객체에 attach 할 RBO(RenderBufferObject) 객체 생성 및 바인딩
-	unsigned int rboDepth;
-	glGenRenderbuffers(1, &rboDepth);
-	glBindRenderbuffer(GL_RENDERBUFFER, rboDepth);
+	// FBO 객체에 attach 할 깊이 텍스쳐 객체 생성 및 바인딩
+	/*
+		Hi-Z mip chain 생성 시 깊이 버퍼를 샘플링해야 하므로,
+		RBO(RenderBufferObject) 대신 샘플링 가능한 텍스쳐 객체를 깊이 버퍼로 사용함.
 
-	// RBO 객체 메모리 공간 할당
-	// 단일 Renderbuffer 에 depth 값만 저장하는 데이터 포맷 지정 -> GL_DEPTH_COMPONENT 
-	// 또한, 텍스쳐 객체와 마찬가지로 스크린 해상도와 Renderbuffer 해상도를 일치시킴 -> 그래야 SCR_WIDTH * SCR_HEIGHT 개수 만큼의 데이터 저장 공간 확보 가능!
-	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT, SCR_WIDTH, SCR_HEIGHT);
+		단일 텍스쳐에 depth 값만 저장하는 데이터 포맷 지정 -> GL_DEPTH_COMPONENT
+	*/
+	unsigned int gDepth;
+	glGenTextures(1, &gDepth);
+	glBindTexture(GL_TEXTURE_2D, gDepth);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, SCR_WIDTH, SCR_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-	// FBO 객체에 생성한 RBO 객체 attach (자세한 매개변수 설명은 LearnOpenGL 본문 참고!)
-	// off-screen framebuffer 에 렌더링 시, RBO 객체에는 depth 값만 저장할 것이므로, GL_DEPTH_STENCIL_ATTACHMENT 를 적용함!
-	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rboDepth);
+	// FBO 객체에 생성한 깊이 텍스쳐 객체 attach
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, gDepth, 0);
 
 	// 현재 GL_FRAMEBUFFER 상태에 바인딩된 FBO 객체 설정 완료 여부 검사 (설정 완료 조건은 LearnOpenGL 본문 참고)
 	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
@@ -225,32 +312,6 @@ int main()
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
 
-	/* SSAO 효과를 적용할 프레임버퍼(Floating point framebuffer) 생성 및 설정 */
-
-	// FBO(FrameBufferObject) 객체 생성 및 바인딩
-	unsigned int ssaoFBO;
-	glGenFramebuffers(1, &ssaoFBO);
-	glBindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
-
-	// FBO 객체에 attach 할 텍스쳐 버퍼 객체의 참조 id 를 반환받을 변수 초기화
-	unsigned int ssaoColorBuffer;
-
-	// FBO 객체에 attach 할 SSAO 적용 결과를 렌더링할 텍스쳐 버퍼 객체 생성 및 바인딩 (GL_RED 관련 하단 필기 참고)
-	glGenTextures(1, &ssaoColorBuffer);
-	glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, SCR_WIDTH, SCR_HEIGHT, 0, GL_RED, GL_FLOAT, NULL);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ssaoColorBuffer, 0);
-
-	// 현재 GL_FRAMEBUFFER 상태에 바인딩된 FBO 객체 설정 완료 여부 검사
-	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-	{
-		// FBO 객체가 제대로 설정되지 않았을 시 에러 메시지 출력
-		std::cout << "SSAO Framebuffer is not complete!" << std::endl;
-	}
-
-
 	/* blur 효과를 적용할 프레임버퍼(Floating point framebuffer) 생성 및 설정 */
 
 	// FBO(FrameBufferObject) 객체 생성 및 바인딩
@@ -277,6 +338,125 @@ int main()
 	}
 
 
+	/*
+		SSAO 계산 ~ blur ~ upsampling 사이에서만 사용되는 중간 결과 텍스쳐들을 관리할 render target pool 생성 (render_target_pool.h 필기 참고)
+
+		저해상도 G-buffer, occlusion factor, blur 임시 결과, reference SSAO 결과 텍스쳐는
+		매 프레임 pool 에 요청해서 사용하고 다 쓰면 바로 반납하므로,
+		사용 기간이 겹치지 않는 pass 끼리 같은 텍스쳐를 재사용하고, 해상도 축소 배율이 바뀌면 이전 해상도 텍스쳐는 자동으로 해제됨.
+
+		단, Lighting Pass 에서 사용하는 G-buffer 와 ssaoColorBufferBlur,
+		그리고 다음 프레임까지 내용이 유지되어야 하는 history 텍스쳐 버퍼는 pool 에 넣지 않고 고정으로 할당함.
+	*/
+	RenderTargetPool targetPool;
+
+	// 생성한 FBO 객체 설정 완료 후, 다시 default framebuffer 바인딩하여 원상복구
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+
+	/* 내부 해상도로 lighting pass 결과를 렌더링할 프레임버퍼 생성 (dynamic_resolution.h 필기 참고) */
+
+	// 내부 해상도가 출력 해상도보다 작을 때만 사용하며, 이후 upscale pass 에서 default framebuffer 로 확대해서 출력함
+	unsigned int sceneFBO;
+	glGenFramebuffers(1, &sceneFBO);
+	glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+
+	// 확대할 때 bilinear 보간을 적용하기 위해 GL_LINEAR 필터링 모드 사용
+	unsigned int sceneColor;
+	glGenTextures(1, &sceneColor);
+	glBindTexture(GL_TEXTURE_2D, sceneColor);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, sceneColor, 0);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Scene Framebuffer is not complete!" << std::endl;
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	/*
+		G-buffer, 최종 SSAO 결과, lighting pass 결과 텍스쳐들을 등록해두고, 내부 해상도 배율이 바뀔 때마다 한꺼번에 재할당
+		(저해상도 G-buffer 및 중간 결과 텍스쳐들은 내부 해상도 기준으로 pool 에 요청하므로 자동으로 따라감)
+	*/
+	RenderTargetRegistry internalTargets(outputTargets.width(), outputTargets.height());
+	internalTargets.registerTexture(gPosition, GL_RGBA16F, GL_RGBA, GL_FLOAT);
+	internalTargets.registerTexture(gNormal, GL_RGBA16F, GL_RGBA, GL_FLOAT);
+	internalTargets.registerTexture(gAlbedo, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
+	internalTargets.registerTexture(gDepth, GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT, GL_FLOAT);
+	internalTargets.registerTexture(ssaoColorBufferBlur, GL_RED, GL_RED, GL_FLOAT);
+	internalTargets.registerTexture(sceneColor, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE);
+
+	// GPU 프레임 시간을 측정해서 내부 해상도 배율을 50% ~ 100% 범위에서 조절할 controller 생성
+	DynamicResolution resolution(dynamicResolutionTargetMs);
+
+	// 오차 측정 시 GPU 로부터 읽어온 두 텍스쳐 버퍼의 occlusion factor 를 저장할 동적 배열 선언
+	std::vector<float> aoResultPixels(outputTargets.width() * outputTargets.height());
+	std::vector<float> aoReferencePixels(outputTargets.width() * outputTargets.height());
+
+
+	/* temporal 모드에서 프레임 간 누적된 SSAO 결과를 저장할 history 프레임버퍼 생성 및 설정 (ping-pong 방식으로 2개 생성) */
+
+	// history 텍스쳐 버퍼가 현재 할당된 해상도
+	unsigned int historyWidth = outputTargets.width();
+	unsigned int historyHeight = outputTargets.height();
+
+	unsigned int historyFBO[2];
+	unsigned int historyBuffer[2];
+	glGenFramebuffers(2, historyFBO);
+	glGenTextures(2, historyBuffer);
+
+	for (unsigned int i = 0; i < 2; i++)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, historyFBO[i]);
+
+		// r 성분에는 누적된 occlusion factor, g 성분에는 view space 깊이값을 저장
+		// 재투영된 uv 좌표는 texel 중심과 어긋나므로, bilinear 보간으로 샘플링하도록 GL_LINEAR 사용
+		glBindTexture(GL_TEXTURE_2D, historyBuffer[i]);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, historyWidth, historyHeight, 0, GL_RG, GL_FLOAT, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, historyBuffer[i], 0);
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cout << "SSAO History Framebuffer is not complete!" << std::endl;
+		}
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	// 가장 최근에 누적 결과를 저장한 history 텍스쳐 버퍼 인덱스 및 history 유효 여부
+	unsigned int historyIndex = 0;
+	bool historyValid = false;
+
+	// 매 프레임 다른 sample set 을 고르는 데 사용할 프레임 카운터
+	unsigned int aoFrameIndex = 0;
+
+	// 재투영에 사용할 이전 프레임의 뷰 행렬 및 투영 행렬
+	glm::mat4 prevView = glm::mat4(1.0f);
+	glm::mat4 prevProjection = glm::mat4(1.0f);
+
+	/*
+		SSAO 관련 pass 들이 GPU 에서 실행되는 데 걸린 시간을 측정할 타이머 생성
+		(GL_TIME_ELAPSED query 는 중첩할 수 없으므로, 서로 겹치지 않는 구간별로 타이머를 나눔)
+	*/
+	GpuTimer aoTimer; // downsampling + occlusion factor 계산
+	GpuTimer blurTimer; // blur
+	GpuTimer resolveTimer; // upsampling + temporal accumulation
+
+	// 현재 bilateral blur 쉐이더에 전송된 가우시안 가중치의 반경 (-1 이면 아직 전송하지 않음)
+	int uploadedBlurRadius = -1;
+
+	// G-buffer 깊이 버퍼로부터 min/max 깊이값 mip chain 을 생성할 Hi-Z builder 생성
+	HiZBuilder hiZ(outputTargets.width(), outputTargets.height());
+
+
 	/* 반구 영역 내의 랜덤한 sample kernel 계산 (SSAO sample kernel 관련 하단 필기 참고) */
 
 	// [0.0, 1.0] 사이의 실수형 난수 생성 시 따를 균등 분포 생성
@@ -389,8 +569,31 @@ int main()
 	shaderSSAO.setInt("gPosition", 0);
 	shaderSSAO.setInt("gNormal", 1);
 	shaderSSAO.setInt("texNoise", 2);
+	shaderHBAO.use();
+	shaderHBAO.setInt("gPosition", 0);
+	shaderHBAO.setInt("gNormal", 1);
+	shaderHBAO.setInt("texNoise", 2);
 	shaderSSAOBlur.use();
 	shaderSSAOBlur.setInt("ssaoInput", 0);
+	shaderSSAOBlurBilateral.use();
+	shaderSSAOBlurBilateral.setInt("ssaoInput", 0);
+	shaderSSAOBlurBilateral.setInt("gPosition", 1);
+	shaderSSAOBlurBilateral.setInt("gNormal", 2);
+	shaderSSAODownsample.use();
+	shaderSSAODownsample.setInt("gPosition", 0);
+	shaderSSAODownsample.setInt("gNormal", 1);
+	shaderSSAOUpsample.use();
+	shaderSSAOUpsample.setInt("ssaoInput", 0);
+	shaderSSAOUpsample.setInt("gPosition", 1);
+	shaderSSAOUpsample.setInt("gNormal", 2);
+	shaderSSAOUpsample.setInt("gPositionLow", 3);
+	shaderSSAOUpsample.setInt("gNormalLow", 4);
+	shaderSSAOTemporal.use();
+	shaderSSAOTemporal.setInt("ssaoInput", 0);
+	shaderSSAOTemporal.setInt("gPosition", 1);
+	shaderSSAOTemporal.setInt("history", 2);
+	shaderUpscale.use();
+	shaderUpscale.setInt("sceneTexture", 0);
 
 
 	// while 문으로 렌더링 루프 구현
@@ -411,6 +614,44 @@ int main()
 		// 윈도우 창 및 키 입력 감지 밎 이벤트 처리
 		processInput(window);
 
+		// 이번 프레임의 GPU 소요 시간 측정 시작
+		resolution.beginFrame();
+
+
+		/* 출력 해상도 및 내부 해상도 결정 */
+
+		// 윈도우 크기 변경이 멈춘 뒤 일정 시간이 지났다면, 출력 해상도를 새로운 framebuffer 크기로 갱신
+		if (outputTargets.update(glfwGetTime()))
+		{
+			std::cout << "output resolution changed to " << outputTargets.width() << "x" << outputTargets.height() << std::endl;
+		}
+
+		// default framebuffer 에 렌더링하는 pass 는 현재 윈도우 framebuffer 크기를 사용
+		// (출력 해상도 갱신 대기 중에는 이전 크기의 결과를 늘려서 출력함)
+		glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+
+		// dynamic resolution 을 끄면 배율을 100% 로 되돌리고, GPU 시간만 측정함
+		resolution.targetMs = dynamicResolutionTargetMs;
+		resolution.enabled = dynamicResolution;
+		if (!dynamicResolution && resolution.scale() != resolution.maxScale)
+		{
+			resolution.reset();
+		}
+
+		// 배율은 scaleStep 단위로만 바뀌므로, 내부 해상도가 실제로 바뀐 프레임에서만 render target 들을 재할당함
+		// (temporal 모드의 history 텍스쳐는 ssaoColorBufferBlur 의 크기가 바뀐 것을 감지해서 자동으로 재할당 및 무효화됨)
+		unsigned int internalWidth = resolution.scaledSize(outputTargets.width());
+		unsigned int internalHeight = resolution.scaledSize(outputTargets.height());
+		if (internalWidth != internalTargets.width() || internalHeight != internalTargets.height())
+		{
+			internalTargets.resize(internalWidth, internalHeight);
+			hiZ.resize(internalWidth, internalHeight);
+			std::cout << "internal render targets resized to " << internalWidth << "x" << internalHeight << std::endl;
+		}
+
+		// 내부 해상도가 윈도우 framebuffer 크기와 다르다면, lighting pass 결과를 sceneFBO 에 렌더링한 뒤 확대해서 출력
+		bool upscale = internalWidth != (unsigned int)framebufferWidth || internalHeight != (unsigned int)framebufferHeight;
+
 		// 현재까지 저장되어 있는 프레임 버퍼(그 중에서도 색상 버퍼) 초기화하기
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
@@ -426,11 +667,14 @@ int main()
 		// MRT framebuffer 바인딩
 		glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
 
+		// G-buffer 는 내부 해상도로 할당되어 있으므로, 뷰포트도 내부 해상도에 맞춤
+		glViewport(0, 0, internalWidth, internalHeight);
+
 		// 현재 바인딩된 framebuffer 의 색상 및 깊이 버퍼 초기화
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		// 카메라의 zoom 값으로부터 투영 행렬 계산
-		glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+		glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)outputTargets.width() / (float)outputTargets.height(), 0.1f, 100.0f);
 
 		// 카메라 클래스로부터 뷰 행렬(= LookAt 행렬) 가져오기
 		glm::mat4 view = camera.GetViewMatrix();
@@ -480,37 +724,135 @@ int main()
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
 
-		/* 
-			SSAO Pass 
-			
-			G-buffer, sample kernel, random rotation buffer 로부터 샘플링된 데이터로 
-			SSAO 효과를 적용하여 계산한 occlusion factor 들을 ssaoFBO 프레임버퍼에 attach 된 
-			ssaoColorBuffer 텍스쳐 버퍼 객체에 렌더링 
+		/*
+			Hi-Z Pass
+
+			G-buffer 의 깊이 버퍼로부터 min/max linear depth mip chain 생성
+			(HiZBuilder 내부에서 level 별로 GPU 타이머를 사용하므로, 다른 타이머 구간보다 먼저 실행함)
+		*/
+		// M 키 입력 시에만 몇 프레임 동안 생성한 뒤, Hi-Z mip chain 의 level 별 해상도 및 GPU 소요 시간 출력
+		if (hiZReportFramesLeft > 0)
+		{
+			hiZ.build(gDepth, 0.1f, 100.0f);
+			hiZReportFramesLeft--;
+
+			if (hiZReportFramesLeft == 0)
+			{
+				for (unsigned int level = 0; level < hiZ.levelCount(); level++)
+				{
+					std::cout << "Hi-Z level " << level << " | " << hiZ.levelWidth(level) << "x" << hiZ.levelHeight(level)
+						<< " | " << hiZ.levelCostMs(level) << " ms" << std::endl;
+				}
+				std::cout << "Hi-Z total | " << hiZ.levelCount() << " levels | " << hiZ.totalCostMs() << " ms" << std::endl;
+			}
+		}
+
+
+		/*
+			SSAO Pass
+
+			G-buffer, sample kernel, random rotation buffer 로부터 샘플링된 데이터로
+			SSAO 효과를 적용하여 계산한 occlusion factor 들을 render target pool 에 요청한
+			ssaoColorBuffer 텍스쳐 버퍼 객체에 렌더링
+
+			이때, half-res 또는 quarter-res 모드라면, G-buffer 를 먼저 저해상도로 downsampling 한 뒤,
+			저해상도 프레임버퍼에 occlusion factor 를 계산하고,
+			blur 까지 적용한 결과를 full-res 로 bilateral upsampling 함.
 		*/
 
-		// SSAO 효과를 적용하여 렌더링할 framebuffer 바인딩
-		glBindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
+		// 현재 해상도 축소 배율에 따른 저해상도 크기 계산 (배율이 바뀌면 pool 이 새로운 해상도의 텍스쳐를 할당함)
+		// (dynamic resolution 이 켜져 있다면 출력 해상도가 아닌 내부 해상도를 기준으로 축소함)
+		unsigned int lowWidth = (internalWidth + aoDownScale - 1) / aoDownScale;
+		unsigned int lowHeight = (internalHeight + aoDownScale - 1) / aoDownScale;
+
+		// 저해상도로 SSAO 를 계산할 지 여부 및 SSAO 를 계산할 해상도 결정
+		bool lowResAO = aoDownScale > 1;
+		unsigned int aoWidth = lowResAO ? lowWidth : internalWidth;
+		unsigned int aoHeight = lowResAO ? lowHeight : internalHeight;
+
+		// downsampling + occlusion factor 계산 pass 의 GPU 소요 시간 측정 시작
+		aoTimer.begin();
+
+		// 저해상도 모드라면, full-res G-buffer 를 저해상도로 downsampling
+		unsigned int gPositionLow = 0, gNormalLow = 0;
+		if (lowResAO)
+		{
+			// 저해상도 프레임버퍼 크기에 맞게 뷰포트 변경
+			glViewport(0, 0, lowWidth, lowHeight);
+
+			// downsampling 된 G-buffer 를 렌더링할 저해상도 텍스쳐들을 pool 에 요청하여 MRT 로 바인딩 및 색상 버퍼 초기화
+			// (blur, upsampling pass 에서도 가중치 계산에 사용하므로 upsampling 이 끝난 뒤에 반납)
+			gPositionLow = targetPool.acquire(lowWidth, lowHeight, GL_RGBA16F);
+			gNormalLow = targetPool.acquire(lowWidth, lowHeight, GL_RGBA16F);
+			unsigned int lowTargets[2] = { gPositionLow, gNormalLow };
+			targetPool.bindTargets(lowTargets, 2);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			// downsampling 쉐이더 프로그램 바인딩 및 해상도 축소 배율 전송
+			shaderSSAODownsample.use();
+			shaderSSAODownsample.setInt("downScale", aoDownScale);
+
+			// full-res G-buffer 들을 각 texture unit 에 바인딩
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, gPosition);
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, gNormal);
+
+			renderQuad();
+		}
+
+		// SSAO 효과를 적용하여 렌더링할 텍스쳐를 pool 에 요청하여 바인딩 (저해상도 모드라면 저해상도 텍스쳐 요청)
+		unsigned int ssaoColorBuffer = targetPool.acquire(aoWidth, aoHeight, GL_RED);
+		targetPool.bindTarget(ssaoColorBuffer);
 
 		// 현재 바인딩된 framebuffer 의 색상 버퍼 초기화
 		glClear(GL_COLOR_BUFFER_BIT);
 
-		// SSAO 효과를 적용하여 occlusion factor 계산을 수행하는 쉐이더 프로그램 바인딩
-		shaderSSAO.use();
+		// temporal 모드라면, 매 프레임 sample kernel 의 다른 부분집합을 사용하고 random rotation vector 도 다른 각도로 회전시킴
+		// -> sampleStride 프레임 동안 64개 sample kernel 이 모두 한 번씩 사용되고, 회전 각도는 Van der Corput 수열로 고르게 분포시킴
+		int sampleStride = 64 / aoKernelSize;
+		float noiseRotation = aoTemporal ? RadicalInverse_VdC(aoFrameIndex) * 2.0f * 3.14159265359f : 0.0f;
+
+		// HBAO 모드에서 사용할 방향 개수 및 방향별 step 개수 계산 (전체 샘플링 횟수를 sample kernel 개수와 동일하게 맞춤)
+		int hbaoDirections = aoKernelSize >= 32 ? 8 : 4;
+		int hbaoSteps = aoKernelSize / hbaoDirections;
 
-		// 미리 계산해 둔 64개의 sample kernel 이동 벡터를 쉐이더 프로그램에 전송
-		for (unsigned int i = 0; i < 64; i++)
+		// 현재 모드에 따라 occlusion factor 계산을 수행할 쉐이더 프로그램 선택
+		Shader& shaderAO = aoHorizonBased ? shaderHBAO : shaderSSAO;
+		shaderAO.use();
+
+		if (aoHorizonBased)
+		{
+			// 화면 공간에서 horizon 을 탐색할 방향 개수 및 방향별 step 개수 전송
+			shaderHBAO.setInt("directions", hbaoDirections);
+			shaderHBAO.setInt("steps", hbaoSteps);
+		}
+		else
 		{
-			shaderSSAO.setVec3("samples[" + std::to_string(i) + "]", ssaoKernel[i]);
+			// 미리 계산해 둔 64개의 sample kernel 이동 벡터를 쉐이더 프로그램에 전송
+			for (unsigned int i = 0; i < 64; i++)
+			{
+				shaderSSAO.setVec3("samples[" + std::to_string(i) + "]", ssaoKernel[i]);
+			}
+
+			// 실제로 사용할 sample kernel 개수 및 이번 프레임에 사용할 sample kernel 시작 인덱스 전송
+			shaderSSAO.setInt("kernelSize", aoKernelSize);
+			shaderSSAO.setInt("sampleOffset", aoTemporal ? (int)(aoFrameIndex % sampleStride) : 0);
 		}
 
+		// 현재 SSAO 해상도에 맞는 noise 텍스쳐 tiling scale 값 및 회전 각도 전송
+		shaderAO.setVec2("noiseScale", glm::vec2(aoWidth / 4.0f, aoHeight / 4.0f));
+		shaderAO.setFloat("noiseRotation", noiseRotation);
+
 		// view space 기준 sample points 위치값을 NDC 좌표계로 변환하는 과정에서 사용할 투영 행렬을 쉐이더 프로그램에 전송
-		shaderSSAO.setMat4("projection", projection);
+		shaderAO.setMat4("projection", projection);
 
 		// 미리 생성해 둔 2개의 G-buffer 들과 random rotation vector 텍스쳐 버퍼를 각 texture unit 에 바인딩
+		// (저해상도 모드라면 downsampling 된 G-buffer 들을 바인딩)
 		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, gPosition);
+		glBindTexture(GL_TEXTURE_2D, lowResAO ? gPositionLow : gPosition);
 		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, gNormal);
+		glBindTexture(GL_TEXTURE_2D, lowResAO ? gNormalLow : gNormal);
 		glActiveTexture(GL_TEXTURE2);
 		glBindTexture(GL_TEXTURE_2D, noiseTexture);
 
@@ -520,6 +862,9 @@ int main()
 		// default framebuffer 로 바인딩 복구
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
+		// downsampling + occlusion factor 계산 pass 의 GPU 소요 시간 측정 종료
+		aoTimer.end();
+
 
 		/*
 			SSAO Blur Pass
@@ -528,28 +873,288 @@ int main()
 			noise pattern 을 blur 처리하여 fix 하는 단계
 		*/
 
-		// SSAO Blur 효과를 적용하여 렌더링할 framebuffer 바인딩
-		glBindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
+		// blur pass 의 GPU 소요 시간 측정 시작
+		blurTimer.begin();
 
-		// 현재 바인딩된 framebuffer 의 색상 버퍼 초기화
-		glClear(GL_COLOR_BUFFER_BIT);
+		// 저해상도 모드라면 blur 결과를 저장할 저해상도 텍스쳐 (full-res 모드라면 ssaoBlurFBO 에 바로 렌더링하므로 사용하지 않음)
+		unsigned int ssaoColorBufferLowBlur = 0;
 
-		// SSAO Blur 효과를 적용할 쉐이더 프로그램 바인딩
-		shaderSSAOBlur.use();
+		if (aoBilateralBlur)
+		{
+			/* 깊이값 및 노멀벡터를 고려한 separable blur 를 수평 -> 수직 방향 순서로 2번 적용 (ssao_blur_bilateral.fs 필기 참고) */
+
+			shaderSSAOBlurBilateral.use();
+
+			// blur 반경이 바뀌었을 때에만, 컴파일 타임에 계산해 둔 가우시안 가중치를 쉐이더 프로그램에 전송
+			if (uploadedBlurRadius != aoBlurRadius)
+			{
+				const GaussianKernel& kernel = gaussianKernels[aoBlurRadius];
+				for (int i = 0; i <= kernel.radius; i++)
+				{
+					shaderSSAOBlurBilateral.setFloat("weights[" + std::to_string(i) + "]", kernel.weights[i]);
+				}
+				shaderSSAOBlurBilateral.setInt("radius", kernel.radius);
+				uploadedBlurRadius = aoBlurRadius;
+			}
+
+			// 가중치 계산에 사용할 G-buffer 들을 texture unit 에 바인딩 (SSAO 를 계산한 해상도와 같은 G-buffer 사용)
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, lowResAO ? gPositionLow : gPosition);
+			glActiveTexture(GL_TEXTURE2);
+			glBindTexture(GL_TEXTURE_2D, lowResAO ? gNormalLow : gNormal);
+
+			// 수평 방향 blur 결과를 pool 에 요청한 임시 텍스쳐에 렌더링
+			unsigned int ssaoColorBufferBlurTemp = targetPool.acquire(aoWidth, aoHeight, GL_RED);
+			targetPool.bindTarget(ssaoColorBufferBlurTemp);
+			glClear(GL_COLOR_BUFFER_BIT);
+			shaderSSAOBlurBilateral.setVec2("direction", glm::vec2(1.0f, 0.0f));
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
+			renderQuad();
+
+			// occlusion factor 텍스쳐는 수평 방향 blur 에서 다 읽었으므로 반납
+			// -> 저해상도 모드라면 바로 아래에서 요청하는 수직 방향 blur 결과 텍스쳐로 재사용됨
+			targetPool.release(ssaoColorBuffer);
+
+			// 수평 방향 blur 결과에 수직 방향 blur 를 적용하여 최종 blur framebuffer 에 렌더링
+			if (lowResAO)
+			{
+				ssaoColorBufferLowBlur = targetPool.acquire(aoWidth, aoHeight, GL_RED);
+				targetPool.bindTarget(ssaoColorBufferLowBlur);
+			}
+			else
+			{
+				glBindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
+			}
+			glClear(GL_COLOR_BUFFER_BIT);
+			shaderSSAOBlurBilateral.setVec2("direction", glm::vec2(0.0f, 1.0f));
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, ssaoColorBufferBlurTemp);
+			renderQuad();
+
+			targetPool.release(ssaoColorBufferBlurTemp);
+		}
+		else
+		{
+			// SSAO Blur 효과를 적용하여 렌더링할 framebuffer 바인딩 (저해상도 모드라면 pool 에 요청한 저해상도 텍스쳐 바인딩)
+			if (lowResAO)
+			{
+				ssaoColorBufferLowBlur = targetPool.acquire(aoWidth, aoHeight, GL_RED);
+				targetPool.bindTarget(ssaoColorBufferLowBlur);
+			}
+			else
+			{
+				glBindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
+			}
+
+			// 현재 바인딩된 framebuffer 의 색상 버퍼 초기화
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			// SSAO Blur 효과를 적용할 쉐이더 프로그램 바인딩
+			shaderSSAOBlur.use();
+
+			// SSAO occlusion factor 계산 결과가 렌더링된 텍스쳐 버퍼를 texture unit 에 바인딩
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
+
+			// pixel 단위 Blur 효과를 렌더링할 QuadMesh 그리기
+			renderQuad();
+
+			// blur 결과를 렌더링한 뒤에 반납해야 blur 결과 텍스쳐와 같은 텍스쳐로 재사용되지 않음
+			targetPool.release(ssaoColorBuffer);
+		}
 
-		// SSAO occlusion factor 계산 결과가 렌더링된 텍스쳐 버퍼를 texture unit 에 바인딩
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
+		// blur pass 의 GPU 소요 시간 측정 종료
+		blurTimer.end();
 
-		// pixel 단위 Blur 효과를 렌더링할 QuadMesh 그리기
-		renderQuad();
+		// upsampling + temporal accumulation pass 의 GPU 소요 시간 측정 시작
+		resolveTimer.begin();
+
+		// 저해상도 모드라면, blur 까지 적용된 저해상도 결과를 full-res 로 bilateral upsampling
+		if (lowResAO)
+		{
+			// full-res(내부 해상도) 프레임버퍼 크기에 맞게 뷰포트 복구
+			glViewport(0, 0, internalWidth, internalHeight);
+
+			// Lighting Pass 에서 사용할 full-res framebuffer 에 upsampling 결과를 렌더링
+			glBindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			shaderSSAOUpsample.use();
+
+			// 저해상도 SSAO 결과와, 가중치 계산에 사용할 full-res 및 저해상도 G-buffer 들을 각 texture unit 에 바인딩
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, ssaoColorBufferLowBlur);
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, gPosition);
+			glActiveTexture(GL_TEXTURE2);
+			glBindTexture(GL_TEXTURE_2D, gNormal);
+			glActiveTexture(GL_TEXTURE3);
+			glBindTexture(GL_TEXTURE_2D, gPositionLow);
+			glActiveTexture(GL_TEXTURE4);
+			glBindTexture(GL_TEXTURE_2D, gNormalLow);
+
+			renderQuad();
+
+			// 저해상도 중간 결과들은 더 이상 사용하지 않으므로 모두 반납
+			targetPool.release(ssaoColorBufferLowBlur);
+			targetPool.release(gPositionLow);
+			targetPool.release(gNormalLow);
+		}
 
 		// default framebuffer 로 바인딩 복구
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
 
+		/*
+			SSAO Temporal Pass
+
+			temporal 모드라면, 이전 프레임까지 누적된 history 를 현재 프레임 위치로 재투영하여
+			현재 프레임 SSAO 결과와 섞어서 누적함. (ssao_temporal.fs 필기 참고)
+		*/
+		if (aoTemporal)
+		{
+			// SSAO 결과 텍스쳐 버퍼의 현재 크기를 조회하여, history 텍스쳐 버퍼와 크기가 다르면 재할당 후 history 를 무효화
+			GLint aoOutputWidth = 0, aoOutputHeight = 0;
+			glBindTexture(GL_TEXTURE_2D, ssaoColorBufferBlur);
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &aoOutputWidth);
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &aoOutputHeight);
+			if ((unsigned int)aoOutputWidth != historyWidth || (unsigned int)aoOutputHeight != historyHeight)
+			{
+				historyWidth = aoOutputWidth;
+				historyHeight = aoOutputHeight;
+				resizeTexture(historyBuffer[0], GL_RG16F, historyWidth, historyHeight, GL_RG, GL_FLOAT);
+				resizeTexture(historyBuffer[1], GL_RG16F, historyWidth, historyHeight, GL_RG, GL_FLOAT);
+				historyValid = false;
+			}
+
+			// 이번 프레임의 누적 결과는 이전 프레임에 사용하지 않은 나머지 history 텍스쳐 버퍼에 렌더링
+			unsigned int nextIndex = 1 - historyIndex;
+			glBindFramebuffer(GL_FRAMEBUFFER, historyFBO[nextIndex]);
+
+			shaderSSAOTemporal.use();
+
+			// 재투영에 필요한 현재 프레임의 뷰 행렬의 역행렬과 이전 프레임의 뷰 행렬 및 view-projection 행렬 전송
+			shaderSSAOTemporal.setMat4("invView", glm::inverse(view));
+			shaderSSAOTemporal.setMat4("prevView", prevView);
+			shaderSSAOTemporal.setMat4("prevViewProjection", prevProjection * prevView);
+
+			// 현재 프레임 결과를 섞는 비율 전송 (sample kernel 을 적게 쓸수록 더 많은 프레임을 누적해야 하므로 비율을 낮춤)
+			shaderSSAOTemporal.setFloat("blendFactor", std::max(1.0f / (2.0f * sampleStride), 0.05f));
+			shaderSSAOTemporal.setBool("historyValid", historyValid);
+
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, ssaoColorBufferBlur);
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, gPosition);
+			glActiveTexture(GL_TEXTURE2);
+			glBindTexture(GL_TEXTURE_2D, historyBuffer[historyIndex]);
+
+			renderQuad();
+
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+			// 방금 렌더링한 history 텍스쳐 버퍼를 최신 누적 결과로 지정
+			historyIndex = nextIndex;
+			historyValid = true;
+		}
+		else
+		{
+			// temporal 모드가 꺼지면 history 를 무효화하여, 다시 켜질 때 오래된 누적 결과가 섞이지 않도록 함
+			historyValid = false;
+		}
+
+		// upsampling + temporal accumulation pass 의 GPU 소요 시간 측정 종료
+		resolveTimer.end();
+
+		// 다음 프레임의 재투영에 사용할 현재 프레임의 뷰 행렬 및 투영 행렬 저장
+		prevView = view;
+		prevProjection = projection;
+		aoFrameIndex++;
+
+
+		/*
+			full-res reference 대비 SSAO 오차 측정 (P 키 입력 시 1번만 실행)
+
+			full-res, 64개 sample kernel 로 계산한 SSAO 결과를 reference 로 렌더링한 뒤,
+			현재 모드로 계산한 결과와 pixel 단위로 비교함.
+		*/
+		if (aoErrorReportRequested)
+		{
+			// full-res, 64개 sample kernel 로 occlusion factor 계산
+			// (dynamic resolution 이 켜져 있다면 내부 해상도의 G-buffer 를 기준으로 비교)
+			unsigned int referenceAO = targetPool.acquire(internalWidth, internalHeight, GL_RED);
+			targetPool.bindTarget(referenceAO);
+			glClear(GL_COLOR_BUFFER_BIT);
+			shaderSSAO.use();
+			shaderSSAO.setInt("kernelSize", 64);
+			shaderSSAO.setVec2("noiseScale", glm::vec2(internalWidth / 4.0f, internalHeight / 4.0f));
+			shaderSSAO.setInt("sampleOffset", 0);
+			shaderSSAO.setFloat("noiseRotation", 0.0f);
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, gPosition);
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, gNormal);
+			glActiveTexture(GL_TEXTURE2);
+			glBindTexture(GL_TEXTURE_2D, noiseTexture);
+			renderQuad();
+
+			// reference 결과에는 원래 예제와 동일한 4*4 box blur 적용
+			unsigned int ssaoReferenceBuffer = targetPool.acquire(internalWidth, internalHeight, GL_RED);
+			targetPool.bindTarget(ssaoReferenceBuffer);
+			glClear(GL_COLOR_BUFFER_BIT);
+			shaderSSAOBlur.use();
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, referenceAO);
+			renderQuad();
+			targetPool.release(referenceAO);
+
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+			// 현재 모드의 결과와 reference 결과를 CPU 메모리로 읽어옴 (GPU 를 기다리게 되므로 매 프레임 실행하지 않음!)
+			// (temporal 모드라면 lighting pass 에서 실제로 사용하는 누적 결과를 읽어옴)
+			aoResultPixels.resize(internalWidth * internalHeight);
+			aoReferencePixels.resize(internalWidth * internalHeight);
+			glBindTexture(GL_TEXTURE_2D, aoTemporal ? historyBuffer[historyIndex] : ssaoColorBufferBlur);
+			glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, &aoResultPixels[0]);
+			glBindTexture(GL_TEXTURE_2D, ssaoReferenceBuffer);
+			glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, &aoReferencePixels[0]);
+			targetPool.release(ssaoReferenceBuffer);
+
+			// pixel 단위 오차의 평균, RMSE, 최댓값 계산
+			double sumAbsError = 0.0;
+			double sumSqError = 0.0;
+			float maxError = 0.0f;
+			for (size_t i = 0; i < aoResultPixels.size(); i++)
+			{
+				float error = std::abs(aoResultPixels[i] - aoReferencePixels[i]);
+				sumAbsError += error;
+				sumSqError += (double)error * error;
+				maxError = std::max(maxError, error);
+			}
+			double pixelCount = (double)aoResultPixels.size();
+
+			std::cout << "AO error vs reference (full-res, 64 samples, box blur) | mean: " << sumAbsError / pixelCount
+				<< " | rmse: " << std::sqrt(sumSqError / pixelCount)
+				<< " | max: " << maxError << std::endl;
+
+			aoErrorReportRequested = false;
+		}
+
+
 		/* Lighting Pass (G-buffer 및 SSAO occlusion factor 가 적용된 텍스쳐 버퍼에서 pixel 단위로 데이터를 샘플링하여 조명 연산하여 QuadMesh 에 렌더링) */
 
+		// 확대가 필요하다면 내부 해상도의 sceneFBO 에, 아니라면 곧바로 default framebuffer 에 렌더링
+		if (upscale)
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+			glViewport(0, 0, internalWidth, internalHeight);
+		}
+		else
+		{
+			glViewport(0, 0, framebufferWidth, framebufferHeight);
+		}
+
 		// 현재 바인딩된 framebuffer 의 색상 및 깊이 버퍼 초기화
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -578,13 +1183,59 @@ int main()
 		glBindTexture(GL_TEXTURE_2D, gAlbedo);
 
 		// Blur 처리까지 적용된 SSAO occlusion factor 텍스쳐 버퍼를 texture unit 에 바인딩
+		// (temporal 모드라면 프레임 간 누적된 history 텍스쳐 버퍼를 바인딩)
 		glActiveTexture(GL_TEXTURE3);
-		glBindTexture(GL_TEXTURE_2D, ssaoColorBufferBlur);
+		glBindTexture(GL_TEXTURE_2D, aoTemporal ? historyBuffer[historyIndex] : ssaoColorBufferBlur);
 
 		// pixel 단위 조명 연산 결과를 렌더링할 QuadMesh 그리기
 		renderQuad();
 
 
+		/* Upscale Pass (내부 해상도의 lighting pass 결과를 출력 해상도의 default framebuffer 로 확대) */
+		if (upscale)
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glViewport(0, 0, framebufferWidth, framebufferHeight);
+
+			shaderUpscale.use();
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, sceneColor);
+			renderQuad();
+		}
+
+		// 이번 프레임의 GPU 소요 시간 측정 종료 (몇 프레임 전에 측정한 결과가 준비되었다면 배율 조절)
+		resolution.endFrame();
+
+
+		// SSAO 해상도, sample 개수, blur 방식 및 GPU 에서 측정한 각 pass 소요 시간 콘솔 출력
+		// blur 방식별 pixel 당 텍스쳐 샘플링 횟수 계산 (box blur: 4*4, separable blur: 수평 + 수직 방향 각각 (2r + 1))
+		int blurTaps = aoBilateralBlur ? 2 * (2 * aoBlurRadius + 1) : 16;
+		std::cout << "AO: " << (aoHorizonBased ? "HBAO " + std::to_string(hbaoDirections) + "x" + std::to_string(hbaoSteps) : std::string("SSAO"))
+			<< " | scale: 1/" << aoDownScale << " | samples: " << aoKernelSize << " | temporal: " << (aoTemporal ? "on" : "off")
+			<< " | AO pass: " << aoTimer.elapsedMs() << " ms"
+			<< " | blur: " << (aoBilateralBlur ? "bilateral r=" + std::to_string(aoBlurRadius) : std::string("box")) << " (" << blurTaps << " taps) " << blurTimer.elapsedMs() << " ms"
+			<< " | resolve: " << resolveTimer.elapsedMs() << " ms" << std::endl;
+
+		// 중간 결과 텍스쳐들의 메모리 사용량 콘솔 출력
+		// fixed: pool 도입 이전처럼 full-res (AO, blur 임시, reference) 3장 + 저해상도 (G-buffer 2장, AO, blur, blur 임시) 5장을 고정 할당했을 때의 메모리 양
+		// no-alias: 요청마다 텍스쳐를 따로 만들었을 때의 최대 메모리 양, pooled: 실제로 pool 이 할당한 최대 메모리 양
+		double fixedTargetBytes = 3.0 * RenderTargetPool::textureBytes(internalWidth, internalHeight, GL_RED)
+			+ 2.0 * RenderTargetPool::textureBytes(lowWidth, lowHeight, GL_RGBA16F)
+			+ 3.0 * RenderTargetPool::textureBytes(lowWidth, lowHeight, GL_RED);
+		std::cout << "AO targets peak VRAM | fixed: " << fixedTargetBytes / (1024.0 * 1024.0) << " MB"
+			<< " | no-alias: " << targetPool.peakRequestedBytes() / (1024.0 * 1024.0) << " MB"
+			<< " | pooled: " << targetPool.peakAllocatedBytes() / (1024.0 * 1024.0) << " MB"
+			<< " (now " << targetPool.allocatedBytes() / (1024.0 * 1024.0) << " MB, " << targetPool.textureCount() << " textures)" << std::endl;
+
+		// 이번 프레임에 사용한 내부 해상도 배율 및 GPU 프레임 시간 콘솔 출력
+		std::cout << "dynamic resolution " << (dynamicResolution ? "on" : "off") << " | scale " << resolution.scale() * 100.0f << "% | "
+			<< internalWidth << "x" << internalHeight << " | GPU " << resolution.gpuFrameMs() << " ms / target " << resolution.targetMs
+			<< " ms | changes " << resolution.changeCount() << " | dropped " << resolution.droppedCount() << std::endl;
+
+		// 반납되지 않은 텍스쳐 검사 및 오랫동안 요청되지 않은 텍스쳐 해제
+		targetPool.endFrame();
+
+
 		// Double Buffer 상에서 Back Buffer 에 픽셀들이 모두 그려지면, Front Buffer 와 교체(swap)해버림.
 		glfwSwapBuffers(window);
 
@@ -791,10 +1442,34 @@ void renderQuad()
 }
 
 
+// 이미 생성된 텍스쳐 객체의 메모리 공간을 새로운 해상도로 재할당하는 함수 구현
+void resizeTexture(unsigned int texture, GLint internalFormat, unsigned int width, unsigned int height, GLenum format, GLenum type)
+{
+	// 텍스쳐 객체를 바인딩한 뒤 glTexImage2D() 를 다시 호출하면, 참조 id 와 FBO attach 상태는 그대로 유지된 채 메모리 공간만 재할당됨
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, NULL);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// Van der Corput 수열의 i 번째 값을 계산하는 함수 구현
+// (비트 순서를 뒤집어 [0, 1) 범위의 소수로 해석 -> prefilter.fs 의 RadicalInverse_VdC() 와 동일한 알고리즘)
+float RadicalInverse_VdC(unsigned int bits)
+{
+	bits = (bits << 16u) | (bits >> 16u);
+	bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+	bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+	bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+	bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+	return float(bits) * 2.3283064365386963e-10f; // / 0x100000000
+}
+
 // GLFWwindow 윈도우 창 리사이징 감지 시, 호출할 콜백 함수 정의
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
 	glViewport(0, 0, width, height); // GLFWwindow 상에 렌더링될 뷰포트 영역을 정의. (뷰포트 영역의 좌상단 좌표, 뷰포트 영역의 너비와 높이)
+
+	// 출력 해상도는 곧바로 바꾸지 않고, 크기 변경이 멈춘 뒤 렌더링 루프에서 한 번만 갱신 (내부 해상도 render target 들도 그때 재할당됨)
+	outputTargets.requestResize(width, height, glfwGetTime());
 }
 
 // GLFW 윈도우에 마우스 입력 감지 시, 호출할 콜백함수 정의
@@ -842,6 +1517,138 @@ void processInput(GLFWwindow* window)
 		glfwSetWindowShouldClose(window, true); // GLFWwindow 의 WindowShouldClose 플래그(상태값)을 true 로 설정 -> main() 함수의 while 조건문에서 렌더링 루프 탈출 > 렌더링 종료!
 	}
 
+	// 숫자 1, 2, 3 키 입력 시, SSAO 를 계산할 해상도를 각각 full-res, half-res, quarter-res 로 변경
+	if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS)
+	{
+		aoDownScale = 1;
+	}
+	if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS)
+	{
+		aoDownScale = 2;
+	}
+	if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS)
+	{
+		aoDownScale = 4;
+	}
+
+	/*
+		Z 키 입력 시, sample kernel 개수를 절반으로 줄이고,
+		X 키 입력 시, sample kernel 개수를 2배로 늘림. (8 ~ 64 범위)
+	*/
+	if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_PRESS && !aoKernelKeyPressed)
+	{
+		aoKernelSize = std::max(aoKernelSize / 2, 8);
+		aoKernelKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_X) == GLFW_PRESS && !aoKernelKeyPressed)
+	{
+		aoKernelSize = std::min(aoKernelSize * 2, 64);
+		aoKernelKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_RELEASE && glfwGetKey(window, GLFW_KEY_X) == GLFW_RELEASE)
+	{
+		aoKernelKeyPressed = false;
+	}
+
+	// P 키 입력 시, full-res reference 대비 SSAO 오차 측정 요청
+	if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS && !aoErrorKeyPressed)
+	{
+		aoErrorReportRequested = true;
+		aoErrorKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_P) == GLFW_RELEASE)
+	{
+		aoErrorKeyPressed = false;
+	}
+
+	// M 키 입력 시, Hi-Z mip chain 의 level 별 GPU 소요 시간 출력 요청
+	if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS && !hiZReportKeyPressed)
+	{
+		// GpuTimer 는 몇 프레임 전에 측정한 결과를 읽어오므로, query 개수보다 1 프레임 더 생성한 뒤에 출력
+		if (hiZReportFramesLeft == 0)
+		{
+			hiZReportFramesLeft = GpuTimer::QUERY_COUNT + 1;
+		}
+		hiZReportKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_M) == GLFW_RELEASE)
+	{
+		hiZReportKeyPressed = false;
+	}
+
+	// R 키 입력 시, dynamic resolution on/off
+	if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS && !dynamicResolutionKeyPressed)
+	{
+		dynamicResolution = !dynamicResolution;
+		dynamicResolutionKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_R) == GLFW_RELEASE)
+	{
+		dynamicResolutionKeyPressed = false;
+	}
+
+	// 위/아래 방향키를 누르고 있는 동안 dynamic resolution 의 목표 GPU 프레임 시간 조절 (초당 5 ms)
+	if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
+	{
+		dynamicResolutionTargetMs += 5.0f * deltaTime;
+	}
+	if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
+	{
+		dynamicResolutionTargetMs = std::max(1.0f, dynamicResolutionTargetMs - 5.0f * deltaTime);
+	}
+
+	// T 키 입력 시, temporal accumulation 모드 활성화 상태값 변경
+	if (glfwGetKey(window, GLFW_KEY_T) == GLFW_PRESS && !aoTemporalKeyPressed)
+	{
+		aoTemporal = !aoTemporal;
+		aoTemporalKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_T) == GLFW_RELEASE)
+	{
+		aoTemporalKeyPressed = false;
+	}
+
+	// B 키 입력 시, separable bilateral blur <-> 4*4 box blur 전환
+	if (glfwGetKey(window, GLFW_KEY_B) == GLFW_PRESS && !aoBlurKeyPressed)
+	{
+		aoBilateralBlur = !aoBilateralBlur;
+		aoBlurKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_B) == GLFW_RELEASE)
+	{
+		aoBlurKeyPressed = false;
+	}
+
+	/*
+		[ 키 입력 시, separable bilateral blur 반경을 줄이고,
+		] 키 입력 시, 반경을 늘림. (1 ~ GAUSSIAN_MAX_RADIUS 범위)
+	*/
+	if (glfwGetKey(window, GLFW_KEY_LEFT_BRACKET) == GLFW_PRESS && !aoBlurRadiusKeyPressed)
+	{
+		aoBlurRadius = std::max(aoBlurRadius - 1, 1);
+		aoBlurRadiusKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_RIGHT_BRACKET) == GLFW_PRESS && !aoBlurRadiusKeyPressed)
+	{
+		aoBlurRadius = std::min(aoBlurRadius + 1, GAUSSIAN_MAX_RADIUS);
+		aoBlurRadiusKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_LEFT_BRACKET) == GLFW_RELEASE && glfwGetKey(window, GLFW_KEY_RIGHT_BRACKET) == GLFW_RELEASE)
+	{
+		aoBlurRadiusKeyPressed = false;
+	}
+
+	// H 키 입력 시, 반구 영역 sample kernel 방식 SSAO <-> horizon-based AO 전환
+	if (glfwGetKey(window, GLFW_KEY_H) == GLFW_PRESS && !aoHorizonKeyPressed)
+	{
+		aoHorizonBased = !aoHorizonBased;
+		aoHorizonKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_H) == GLFW_RELEASE)
+	{
+		aoHorizonKeyPressed = false;
+	}
+
 	// 카메라 이동속도 보정 (기본 속도 2.5 가 어느 컴퓨터에서든 유지될 수 있도록 deltaTime 값으로 속도 보정)
 	float cameraSpeed = static_cast<float>(2.5 * deltaTime);
 
@@ -1143,4 +1950,39 @@ void processInput(GLFWwindow* window)
 
 	한 번 생성해 둔 16개의 Random rotation vector 를
 	전체 QuadMesh 의 프래그먼트들을 돌면서 반복적으로 재사용하려는 것임! 
-*/
\ No newline at end of file
+*/
+/*
+	저해상도 SSAO
+
+
+	SSAO 는 pixel 마다 64개의 sample kernel 을 순회하며 G-buffer 를 샘플링하므로,
+	이 예제에서 가장 비용이 큰 pass 임.
+
+	그런데 occlusion factor 는 원래 주변 표면에 의해 서서히 변하는
+	저주파(low-frequency) 신호이고, 어차피 blur 까지 적용하므로
+	굳이 모든 pixel 마다 계산할 필요가 없음.
+
+
+	그래서 G-buffer 를 half-res(1/4 pixel 수) 또는 quarter-res(1/16 pixel 수) 로
+	downsampling 한 뒤 SSAO 와 blur 를 저해상도에서 계산하고,
+
+	마지막에 full-res G-buffer 의 깊이값 및 노멀벡터를 참고하는
+	bilateral upsampling 으로 edge 를 보존하며 full-res 로 확대하는 것!
+
+
+	1, 2, 3 키로 해상도를, Z, X 키로 sample kernel 개수를 바꿔가며
+	콘솔에 출력되는 AO pass 소요 시간을 비교해볼 수 있고,
+
+	P 키를 누르면 full-res, 64개 sample kernel 로 계산한 결과 대비
+	현재 모드의 오차(mean, rmse, max)를 출력함.
+
+
+	또한, T 키로 temporal 모드를 켜면 sample kernel 을 8 ~ 16개만 사용하더라도
+	매 프레임 다른 sample set 으로 계산한 결과가 history 에 누적되면서
+	64개 sample kernel 을 사용한 결과에 가깝게 수렴함. (ssao_temporal.fs 필기 참고)
+
+
+	H 키로 HBAO 모드를 켜면, 같은 샘플링 횟수(방향 개수 * step 개수)를
+	반구 영역의 랜덤한 점들 대신 화면 공간의 horizon 탐색에 사용함. (ssao_hbao.fs 필기 참고)
+	blur, upsampling, temporal, lighting pass 는 두 모드가 그대로 공유함.
+*/
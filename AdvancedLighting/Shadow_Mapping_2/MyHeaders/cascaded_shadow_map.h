@@ -0,0 +1,353 @@
+#ifndef CASCADED_SHADOW_MAP_H
+#define CASCADED_SHADOW_MAP_H
+/*
+	cascaded_shadow_map.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > 텍스쳐 배열 및 프레임버퍼 관련 OpenGL 함수가 필요하니까!
+
+// 행렬 및 벡터 계산에서 사용할 Header Only 라이브러리 include
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+/*
+	CascadedShadowMap 클래스
+
+	카메라 view frustum 을 깊이 방향으로 여러 구간(cascade)으로 나누고,
+	각 구간에 딱 맞는 직교 투영 light space 행렬을 계산해서
+	GL_TEXTURE_2D_ARRAY 깊이 텍스쳐의 layer 마다 하나씩 shadow map 을 렌더링하는 클래스! (하단 필기 참고)
+
+	- 구간 경계는 log 분할과 균등 분할을 splitLambda 비율로 섞는 practical split scheme 으로 계산함.
+	- bindLayered() 로 바인딩하면 모든 layer 가 한꺼번에 attach 되므로,
+	  geometry shader 에서 gl_Layer 를 지정해서 한 번의 pass 로 모든 cascade 에 렌더링할 수 있고,
+	- bindLayer() 로 바인딩하면 layer 하나만 attach 되므로, cascade 마다 따로 렌더링할 수 있음.
+	- intersects() 로 bounding sphere 가 각 cascade 의 light frustum 과 겹치는 지 검사해서 CPU 에서 culling 할 수 있음.
+	- stableFit 이 true 면 cascade 를 감싸는 구(sphere)에 맞춰 크기를 고정하고 texel 단위로 위치를 snapping 해서,
+	  카메라가 움직이거나 회전해도 그림자 경계가 떨리지(shimmering) 않도록 함.
+	- setSceneBounds() 로 씬 전체의 AABB 를 전달하면, near / far plane 을 씬 범위에 딱 맞게 계산함.
+*/
+class CascadedShadowMap
+{
+public:
+	// 최대 cascade 개수 (텍스쳐 배열은 항상 이 개수만큼 layer 를 할당해 둠)
+	static const unsigned int MAX_CASCADES = 4;
+
+	unsigned int ID; // shadow map 텍스쳐 배열 객체의 참조 id
+
+	float splitLambda; // 0 이면 균등 분할, 1 이면 log 분할
+	float casterMargin; // 씬 범위를 모를 때, cascade 영역 밖에서 광원 쪽으로 떨어져 있는 그림자 caster 까지 포함하도록 near plane 을 당겨줄 거리
+	bool stableFit; // true 면 bounding sphere + texel snapping 으로 안정적인 영역, false 면 cascade 꼭짓점에 딱 맞는 AABB 영역
+
+	// 생성자에서 깊이 텍스쳐 배열 및 프레임버퍼 생성
+	CascadedShadowMap(unsigned int resolution, unsigned int cascades = 3)
+		: splitLambda(0.5f), casterMargin(10.0f), stableFit(true), size(resolution), count(1), hasSceneBounds(false)
+	{
+		setCascadeCount(cascades);
+
+		glGenTextures(1, &ID);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, ID);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, size, size, MAX_CASCADES, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+
+		// sampler2DArrayShadow 로 샘플링하면 깊이 비교 결과를 하드웨어가 2x2 texel 에 대해 bilinear 필터링해서 반환하도록 설정 (하단 필기 참고)
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+
+		// cascade 영역을 벗어난 uv 좌표는 항상 그림자 밖으로 판정되도록 clamp to border 및 흰색 border 사용
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+		float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+		// 색상 버퍼 없이 깊이 버퍼만 사용하는 프레임버퍼 생성
+		glGenFramebuffers(1, &FBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, ID, 0);
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cout << "Cascaded shadow map framebuffer is not complete!" << std::endl;
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		for (unsigned int i = 0; i <= MAX_CASCADES; i++)
+		{
+			splits[i] = 0.0f;
+		}
+	}
+
+	// 사용할 cascade 개수 변경 (2 ~ MAX_CASCADES 사이로 clamping)
+	void setCascadeCount(unsigned int cascades)
+	{
+		count = std::max(2u, std::min(cascades, MAX_CASCADES));
+	}
+
+	// 그림자 caster 및 receiver 를 모두 감싸는 world space AABB 전달 (near / far plane 을 씬 범위에 맞춰 계산하는 데 사용)
+	void setSceneBounds(const glm::vec3& minCorner, const glm::vec3& maxCorner)
+	{
+		sceneMin = minCorner;
+		sceneMax = maxCorner;
+		hasSceneBounds = true;
+	}
+
+	// 카메라의 view 행렬 및 원근 투영 파라미터와 광원 방향(프래그먼트 -> 광원)으로부터 cascade 별 light space 행렬 계산
+	void update(const glm::mat4& view, float fovy, float aspect, float nearPlane, float farPlane, const glm::vec3& lightDir)
+	{
+		// practical split scheme 으로 각 cascade 의 far 거리 계산
+		splits[0] = nearPlane;
+		for (unsigned int i = 1; i <= count; i++)
+		{
+			float t = (float)i / count;
+			float logSplit = nearPlane * std::pow(farPlane / nearPlane, t);
+			float uniformSplit = nearPlane + (farPlane - nearPlane) * t;
+			splits[i] = splitLambda * logSplit + (1.0f - splitLambda) * uniformSplit;
+		}
+
+		glm::vec3 direction = glm::normalize(lightDir);
+		glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+
+		for (unsigned int c = 0; c < count; c++)
+		{
+			// 현재 cascade 구간만큼 잘라낸 view frustum 의 8개 꼭짓점을 world space 로 계산
+			glm::mat4 invViewProj = glm::inverse(glm::perspective(fovy, aspect, splits[c], splits[c + 1]) * view);
+			glm::vec3 corners[8];
+			glm::vec3 center(0.0f);
+			for (unsigned int i = 0; i < 8; i++)
+			{
+				glm::vec4 ndc((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+				glm::vec4 world = invViewProj * ndc;
+				corners[i] = glm::vec3(world) / world.w;
+				center += corners[i];
+			}
+			center /= 8.0f;
+
+			glm::vec3 minCorner(1e30f), maxCorner(-1e30f);
+			if (stableFit)
+			{
+				// 구간을 감싸는 구의 반지름은 카메라가 회전해도 변하지 않으므로, 영역의 크기(== texel 크기)가 고정됨
+				// (부동소수점 오차로 반지름이 미세하게 흔들리지 않도록 1/16 단위로 올림)
+				float radius = 0.0f;
+				for (unsigned int i = 0; i < 8; i++)
+				{
+					radius = std::max(radius, glm::length(corners[i] - center));
+				}
+				radius = std::ceil(radius * 16.0f) / 16.0f;
+
+				// light view 는 카메라와 무관하게 원점 기준으로 고정하고, 구의 중심을 texel 격자에 맞춰 snapping 해서
+				// 카메라가 움직여도 shadow map texel 이 world space 에서 항상 같은 위치에 래스터화되도록 함
+				lightViews[c] = glm::lookAt(direction, glm::vec3(0.0f), up);
+				glm::vec3 p = glm::vec3(lightViews[c] * glm::vec4(center, 1.0f));
+				float texel = 2.0f * radius / size;
+				p.x = std::floor(p.x / texel) * texel;
+				p.y = std::floor(p.y / texel) * texel;
+				minCorner = p - glm::vec3(radius);
+				maxCorner = p + glm::vec3(radius);
+			}
+			else
+			{
+				// 구간의 중심을 바라보는 light view 행렬 계산 후, 꼭짓점들을 감싸는 light space AABB 계산
+				lightViews[c] = glm::lookAt(center + direction, center, up);
+				for (unsigned int i = 0; i < 8; i++)
+				{
+					glm::vec3 p = glm::vec3(lightViews[c] * glm::vec4(corners[i], 1.0f));
+					minCorner = glm::min(minCorner, p);
+					maxCorner = glm::max(maxCorner, p);
+				}
+			}
+
+			if (hasSceneBounds)
+			{
+				// 씬 AABB 의 8개 꼭짓점을 light view space 로 변환한 범위
+				glm::vec3 sceneLightMin(1e30f), sceneLightMax(-1e30f);
+				for (unsigned int i = 0; i < 8; i++)
+				{
+					glm::vec3 corner((i & 1) ? sceneMax.x : sceneMin.x, (i & 2) ? sceneMax.y : sceneMin.y, (i & 4) ? sceneMax.z : sceneMin.z);
+					glm::vec3 p = glm::vec3(lightViews[c] * glm::vec4(corner, 1.0f));
+					sceneLightMin = glm::min(sceneLightMin, p);
+					sceneLightMax = glm::max(sceneLightMax, p);
+				}
+
+				// near plane 은 광원에 가장 가까운 씬의 caster 까지만 당기고, far plane 은 씬이 끝나는 곳에서 자름
+				// (light view 는 -z 방향을 바라보므로 z 가 클수록 광원에 가까움)
+				maxCorner.z = sceneLightMax.z;
+				minCorner.z = std::min(std::max(minCorner.z, sceneLightMin.z), maxCorner.z - 0.01f);
+
+				// 안정적인 영역이 아니라면, 씬 밖의 빈 공간에 texel 을 낭비하지 않도록 x, y 범위도 씬 범위로 자름
+				if (!stableFit)
+				{
+					minCorner.x = std::max(minCorner.x, sceneLightMin.x);
+					minCorner.y = std::max(minCorner.y, sceneLightMin.y);
+					maxCorner.x = std::max(std::min(maxCorner.x, sceneLightMax.x), minCorner.x + 0.01f);
+					maxCorner.y = std::max(std::min(maxCorner.y, sceneLightMax.y), minCorner.y + 0.01f);
+				}
+			}
+			else
+			{
+				// light view 는 -z 방향을 바라보므로, 광원 쪽(z 가 큰 쪽)으로 casterMargin 만큼 near plane 을 당겨줌
+				maxCorner.z += casterMargin;
+			}
+			boxMin[c] = minCorner;
+			boxMax[c] = maxCorner;
+
+			glm::mat4 lightProjection = glm::ortho(minCorner.x, maxCorner.x, minCorner.y, maxCorner.y, -maxCorner.z, -minCorner.z);
+			matrices[c] = lightProjection * lightViews[c];
+		}
+	}
+
+	// 깊이 비교 모드 on/off (debug_quad.fs 처럼 sampler2DArray 로 깊이값을 직접 읽으려면 비교 모드를 꺼야 함)
+	void setCompareMode(bool enabled)
+	{
+		glBindTexture(GL_TEXTURE_2D_ARRAY, ID);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, enabled ? GL_COMPARE_REF_TO_TEXTURE : GL_NONE);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	}
+
+	// 모든 layer 를 attach 해서 바인딩 (geometry shader 에서 gl_Layer 로 cascade 를 선택하는 single pass 용)
+	void bindLayered()
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, ID, 0);
+	}
+
+	// cascade 하나의 layer 만 attach 해서 바인딩 (cascade 마다 따로 렌더링하는 pass 용)
+	void bindLayer(unsigned int cascade)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, ID, 0, cascade);
+	}
+
+	// world space bounding sphere 가 cascade 의 light frustum 과 겹치는 지 검사
+	bool intersects(unsigned int cascade, const glm::vec3& center, float radius) const
+	{
+		glm::vec3 p = glm::vec3(lightViews[cascade] * glm::vec4(center, 1.0f));
+		return p.x + radius >= boxMin[cascade].x && p.x - radius <= boxMax[cascade].x
+			&& p.y + radius >= boxMin[cascade].y && p.y - radius <= boxMax[cascade].y
+			&& p.z + radius >= boxMin[cascade].z && p.z - radius <= boxMax[cascade].z;
+	}
+
+	// cascade 의 world space -> light space(clip space) 변환 행렬
+	const glm::mat4& lightSpaceMatrix(unsigned int cascade) const
+	{
+		return matrices[cascade];
+	}
+
+	// cascade 가 담당하는 view space 깊이 구간의 끝(far) 거리
+	float splitDistance(unsigned int cascade) const
+	{
+		return splits[cascade + 1];
+	}
+
+	// cascade 의 texel 1개가 덮는 world space 크기 (깊이 bias 계산용)
+	float texelWorldSize(unsigned int cascade) const
+	{
+		return std::max(boxMax[cascade].x - boxMin[cascade].x, boxMax[cascade].y - boxMin[cascade].y) / size;
+	}
+
+	// cascade 의 light space 깊이 범위 (깊이 버퍼의 [0, 1] 이 덮는 world space 거리)
+	float depthRange(unsigned int cascade) const
+	{
+		return boxMax[cascade].z - boxMin[cascade].z;
+	}
+
+	unsigned int cascadeCount() const
+	{
+		return count;
+	}
+
+	unsigned int resolution() const
+	{
+		return size;
+	}
+
+private:
+	unsigned int FBO;
+	unsigned int size; // 각 layer 의 해상도
+	unsigned int count; // 현재 사용 중인 cascade 개수
+	float splits[MAX_CASCADES + 1]; // cascade 경계의 view space 거리 (splits[0] 은 카메라 near)
+	glm::mat4 lightViews[MAX_CASCADES];
+	glm::mat4 matrices[MAX_CASCADES];
+	glm::vec3 boxMin[MAX_CASCADES]; // light view space 기준 cascade 영역의 AABB
+	glm::vec3 boxMax[MAX_CASCADES];
+	bool hasSceneBounds;
+	glm::vec3 sceneMin; // setSceneBounds() 로 전달받은 world space 씬 AABB
+	glm::vec3 sceneMax;
+};
+
+
+#endif // !CASCADED_SHADOW_MAP_H
+
+/*
+	Cascaded Shadow Maps (CSM)
+
+
+	directional light 의 shadow map 을 glm::ortho(-10, 10, -10, 10) 처럼 고정된 영역으로 렌더링하면,
+	씬이 넓어질수록 texel 하나가 덮는 면적이 커져서 카메라 가까이의 그림자가 계단처럼 깨지고(aliasing),
+	반대로 영역을 좁히면 멀리 있는 그림자는 아예 잘려버림.
+
+	그런데 원근 투영에서는 가까운 물체일수록 화면에서 크게 보이므로,
+	가까운 영역은 촘촘하게, 먼 영역은 듬성듬성하게 shadow map texel 을 배분하면
+	같은 해상도로도 화면에 보이는 그림자 품질을 훨씬 높일 수 있음.
+
+
+	그래서 view frustum 을 깊이 방향으로 몇 개의 구간(cascade)으로 자르고,
+	구간마다 그 구간만 딱 감싸는 직교 투영 shadow map 을 따로 렌더링한 뒤,
+	fragment shader 에서는 프래그먼트의 view space 깊이가 속한 구간의 shadow map 을 샘플링함.
+
+
+	이때, 구간 경계를 균등하게 나누면 가까운 구간이 너무 길어지고,
+	log 스케일로 나누면(원근 투영의 해상도 분포와 일치) 가까운 구간이 지나치게 짧아지므로,
+	두 분할 결과를 lambda 비율로 섞는 'practical split scheme' 을 주로 사용함.
+
+		split_i = lambda * near * (far / near)^(i / N) + (1 - lambda) * (near + (far - near) * i / N)
+
+
+	또한 cascade 별 shadow map 을 GL_TEXTURE_2D_ARRAY 의 layer 로 저장해두면,
+	텍스쳐 1개만 바인딩해서 layer 인덱스로 cascade 를 고를 수 있고,
+	geometry shader 에서 gl_Layer 를 지정하면 draw call 한 번으로 모든 cascade 에 caster 를 렌더링할 수 있음.
+	(대신 geometry shader 의 primitive 복제 비용이 생기므로, cascade 별 pass 와 소요 시간을 비교해 볼 것!)
+
+
+	Hardware PCF (GL_COMPARE_REF_TO_TEXTURE)
+
+
+	깊이 텍스쳐에 GL_TEXTURE_COMPARE_MODE 를 GL_COMPARE_REF_TO_TEXTURE 로 지정하고
+	쉐이더에서 sampler2DShadow (텍스쳐 배열은 sampler2DArrayShadow) 로 샘플링하면,
+	texture() 함수가 깊이값 대신 '전달한 기준 깊이값(ref)과 저장된 깊이값의 비교 결과(0 또는 1)' 를 반환함.
+
+	이때 필터링 모드가 GL_LINEAR 라면, 주변 2x2 texel 각각의 비교 결과를 bilinear 보간해서 반환하므로,
+	fetch 1번으로 4개 texel 을 비교한 PCF 결과를 얻을 수 있음.
+	(깊이값 자체를 보간한 뒤 비교하는 게 아니라, '비교 결과' 를 보간하는 것이므로 그림자 경계가 올바르게 부드러워짐)
+
+	그래서 fetch 위치를 2 texel 간격으로 배치하면 각 fetch 가 덮는 2x2 texel 이 겹치지 않으므로,
+	N x N 번의 fetch 로 2N x 2N texel 을 비교한 것과 같은 결과를 얻을 수 있음. (ex> 2 x 2 = 4 번의 fetch 로 16 texel)
+
+
+	Stable cascade (shimmering 방지)
+
+
+	cascade 꼭짓점에 딱 맞는 AABB 로 직교 투영 영역을 잡으면 texel 을 가장 알뜰하게 쓸 수 있지만,
+	카메라가 회전할 때마다 AABB 의 크기가, 이동할 때마다 AABB 의 위치가 texel 보다 작은 단위로 바뀌므로
+	같은 caster 가 매 프레임 조금씩 다른 texel 에 래스터화되어 그림자 경계가 반짝거리며 떨림. (shimmering)
+
+	그래서
+
+	1. 영역의 크기는 cascade 를 감싸는 구(sphere)의 지름으로 고정하고, (구는 회전해도 크기가 변하지 않음)
+	2. 영역의 위치는 light view space 에서 texel 크기의 정수배로 snapping 하면,
+
+	카메라가 어떻게 움직여도 shadow map texel 격자가 world space 에서 제자리에 고정되므로 떨림이 사라짐.
+	(대신 구가 AABB 보다 크므로 texel 해상도가 약간 손해를 보는데, 이 대가로 안정성을 얻는 것!)
+
+
+	또한 near / far plane 을 cascade 영역 대신 씬 전체의 범위에 맞추면,
+	cascade 밖에서 그림자를 드리우는 caster 를 놓치지 않으면서도 깊이 버퍼의 [0, 1] 범위가 실제 씬에만 쓰이므로
+	깊이 정밀도(== 깊이 bias 를 줄일 수 있는 여유)가 좋아짐.
+*/
@@ -0,0 +1,161 @@
+#ifndef MOMENT_SHADOW_MAP_H
+#define MOMENT_SHADOW_MAP_H
+/*
+	moment_shadow_map.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > 텍스쳐 배열 및 프레임버퍼 관련 OpenGL 함수가 필요하니까!
+
+#include <string>
+#include <algorithm>
+#include <iostream>
+
+// GL 3.3 core 에는 없는 anisotropic filtering extension(GL_EXT_texture_filter_anisotropic) 의 enum 값
+#ifndef GL_TEXTURE_MAX_ANISOTROPY_EXT
+#define GL_TEXTURE_MAX_ANISOTROPY_EXT 0x84FE
+#endif
+#ifndef GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT 0x84FF
+#endif
+
+/*
+	MomentShadowMap 클래스
+
+	cascade 별 깊이값 대신 깊이의 moment(평균, 제곱의 평균)를 저장하는 텍스쳐 배열을 관리하는 클래스! (하단 필기 참고)
+
+	- 깊이 shadow map 을 렌더링한 뒤, bindTemp() 로 임시 텍스쳐에 '깊이 -> moment 변환 + 가로 방향 blur' 를,
+	  bindLayer() 로 cascade layer 에 '세로 방향 blur' 를 렌더링하는 2-pass separable blur 로 moment 를 만들고,
+	- generateMipmaps() 로 mipmap 을 만들어두면, 쉐이더에서 trilinear + anisotropic 필터링된 fetch 1번으로 그림자를 계산할 수 있음.
+	- moment 는 RGBA16F 로 저장하며, VSM 은 rg 채널만, EVSM 은 양수 / 음수 exponent 로 warp 한 moment 를 rgba 채널 모두 사용함.
+*/
+class MomentShadowMap
+{
+public:
+	unsigned int ID; // cascade 별 moment 를 layer 로 저장하는 텍스쳐 배열 객체의 참조 id
+	unsigned int tempID; // 가로 방향 blur 결과를 저장할 임시 2D 텍스쳐 객체의 참조 id
+
+	// 생성자에서 moment 텍스쳐 배열, 임시 텍스쳐 및 프레임버퍼 생성
+	MomentShadowMap(unsigned int resolution, unsigned int layerCount)
+		: size(resolution), layers(layerCount), anisotropy(1.0f)
+	{
+		glGenTextures(1, &ID);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, ID);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA16F, size, size, layers, 0, GL_RGBA, GL_FLOAT, NULL);
+
+		// moment 는 선형적으로 보간해도 의미가 유지되므로(평균의 평균 == 평균), 일반 텍스쳐처럼 mipmap 및 trilinear 필터링 사용
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		// 비스듬한 바닥처럼 화면에서 한 방향으로만 축소되는 표면도 흐려지지 않도록, 지원한다면 anisotropic 필터링 적용
+		GLint extensionCount = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+		for (GLint i = 0; i < extensionCount; i++)
+		{
+			std::string extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+			if (extension == "GL_EXT_texture_filter_anisotropic" || extension == "GL_ARB_texture_filter_anisotropic")
+			{
+				glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &anisotropy);
+				anisotropy = std::min(anisotropy, 8.0f);
+				glTexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_ANISOTROPY_EXT, anisotropy);
+			}
+		}
+
+		// mipmap 메모리 공간 할당
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+		glGenTextures(1, &tempID);
+		glBindTexture(GL_TEXTURE_2D, tempID);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, size, size, 0, GL_RGBA, GL_FLOAT, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		// 색상 버퍼 1개만 사용하는 프레임버퍼 생성 (깊이 테스트가 필요 없는 full screen pass 만 렌더링)
+		glGenFramebuffers(1, &FBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tempID, 0);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cout << "Moment shadow map framebuffer is not complete!" << std::endl;
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	// 임시 텍스쳐를 attach 해서 바인딩 (깊이 -> moment 변환 + 가로 방향 blur pass 용)
+	void bindTemp()
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tempID, 0);
+	}
+
+	// moment 텍스쳐 배열의 layer 하나를 attach 해서 바인딩 (세로 방향 blur pass 용)
+	void bindLayer(unsigned int layer)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, ID, 0, layer);
+	}
+
+	// 모든 layer 의 moment 를 렌더링한 뒤 mipmap 재생성
+	void generateMipmaps()
+	{
+		glBindTexture(GL_TEXTURE_2D_ARRAY, ID);
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	}
+
+	unsigned int resolution() const
+	{
+		return size;
+	}
+
+	// 실제로 적용된 anisotropic 필터링 배율 (지원하지 않으면 1)
+	float maxAnisotropy() const
+	{
+		return anisotropy;
+	}
+
+private:
+	unsigned int FBO;
+	unsigned int size;
+	unsigned int layers;
+	float anisotropy;
+};
+
+
+#endif // !MOMENT_SHADOW_MAP_H
+
+/*
+	Variance Shadow Maps (VSM) / Exponential Variance Shadow Maps (EVSM)
+
+
+	PCF 는 깊이 비교 결과를 평균내는 것이므로, 깊이값 자체를 미리 blur 해두는 방식으로는 대체할 수 없고
+	(깊이값을 평균낸 뒤 비교하면 엉뚱한 결과가 나옴), 커널이 N x N 이면 fetch 도 N x N 번 필요함.
+
+
+	그런데 깊이 대신 깊이의 moment (M1 = E[d], M2 = E[d^2]) 를 저장해두면,
+	moment 는 평균내도 의미가 그대로 유지되므로 separable blur, mipmap, anisotropic 필터링을 모두 적용할 수 있고,
+	필터링된 moment 에서 구한 평균과 분산으로 Chebyshev 부등식을 적용하면
+	'필터 영역 안에서 기준 깊이값 t 보다 멀리 있는(== 빛을 받는) 비율' 의 상한을 fetch 1번으로 근사할 수 있음.
+
+		variance = M2 - M1^2
+		P(d >= t) <= variance / (variance + (t - M1)^2)    (t > M1 일 때)
+
+	즉, 그림자를 부드럽게 만드는 비용이 fragment 마다의 fetch 횟수가 아니라
+	shadow map 해상도에 비례하는 blur pass 비용으로 바뀌므로, 넓은 커널일수록 PCF 보다 유리해짐.
+
+
+	단, 서로 깊이가 크게 다른 caster 두 개가 겹쳐 있으면 분산이 커져서 그림자 안쪽이 밝게 새어나오는
+	light bleeding 현상이 생기는데,
+
+	1. Chebyshev 결과에서 일정 값(lightBleedReduction) 이하는 0 으로 잘라낸 뒤 [0, 1] 로 다시 늘리거나,
+	2. 깊이를 exp(c * d) 로 warp 해서 moment 를 저장하면(EVSM), 먼 caster 와 가까운 receiver 의 차이가 지수적으로 벌어져서
+	   bleeding 이 크게 줄어듦. (양수 exponent 와 음수 exponent 로 warp 한 두 결과 중 작은 값을 사용)
+
+	RGBA16F 의 최댓값은 65504 이므로, exp(2c) 가 넘치지 않도록 exponent 는 5.54 보다 작게 잡아야 함.
+*/
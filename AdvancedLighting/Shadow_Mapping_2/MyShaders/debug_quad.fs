@@ -7,8 +7,11 @@ in vec2 TexCoords;
 
 /* uniform 변수 선언 */
 
-// shadow map 텍스쳐
-uniform sampler2D depthMap;
+// cascade 별 shadow map 이 layer 로 저장된 텍스쳐 배열
+uniform sampler2DArray depthMap;
+
+// 시각화할 cascade 의 layer 인덱스
+uniform int layer;
 
 // 깊이값을 non-linear(logarithmic) > linear 로 변환할 때 사용할 near 값
 uniform float near_plane;
@@ -28,7 +31,7 @@ float LinearizeDepth(float depth) {
 
 void main() {
   // shadow map 에서 샘플링한 텍셀의 임의의 컴포넌트(흑백이라 r, g, b 값이 모두 동일하니 어떤 걸 사용하든 무방)를 깊이값으로 할당
-  float depthValue = texture2D(depthMap, TexCoords).r;
+  float depthValue = texture(depthMap, vec3(TexCoords, layer)).r;
 
   /*
     만약, 원근 투영(perspective projection)행렬로 렌더링된 shadow map 이라면, 
@@ -7,26 +7,93 @@ in VS_OUT {
   vec3 FragPos;
   vec3 Normal;
   vec2 TexCoords;
-  vec4 FragPosLightSpace;
+  float ViewDepth;
 } fs_in;
 
 // OpenGL 에서 전송해 줄 uniform 변수들 선언
 uniform sampler2D diffuseTexture; // 바닥 평면 텍스쳐 (0번 texture unit 에 바인딩된 텍스쳐 객체 샘플링)
-uniform sampler2D shadowMap; // shadow map 텍스쳐 (1번 texture unit 에 바인딩된 텍스쳐 객체 샘플링)
-uniform vec3 lightPos; // 광원 위치 > 조명벡터 계산에서 사용
+uniform sampler2DArrayShadow shadowMap; // cascade 별 shadow map 이 layer 로 저장된 깊이 비교 모드 텍스쳐 배열 (1번 texture unit 에 바인딩된 텍스쳐 객체 샘플링)
+uniform vec3 lightDir; // 프래그먼트에서 광원을 향하는 방향 (directional light 이므로 모든 프래그먼트에서 동일) > 조명벡터 계산에서 사용
 uniform vec3 viewPos; // 카메라 위치 > 뷰 벡터 계산에서 사용
 
-// 현재 프래그먼트가 그림자 안에 있는지 여부를 반환해주는 함수
-float ShadowCalculation(vec4 fragPosLightSpace) {
+/* cascaded shadow map 관련 uniform 변수 (cascaded_shadow_map.h 필기 참고) */
+uniform mat4 lightSpaceMatrices[4]; // cascade 별 world space > light space 좌표계로의 변환 행렬
+uniform float cascadeSplits[4]; // cascade 별로 담당하는 view space 깊이 구간의 끝(far) 거리
+uniform float cascadeTexelSizes[4]; // cascade 별 texel 1개가 덮는 world space 크기
+uniform float cascadeDepthRanges[4]; // cascade 별 light space 깊이 범위 (world space 거리)
+uniform int cascadeCount; // 현재 사용 중인 cascade 개수
+uniform bool showCascades; // cascade 별로 색상을 입혀서 구간을 시각화할 지 여부
+
+uniform int pcfTaps; // PCF 에서 각 축 방향으로 fetch 할 횟수 (1 ~ 3 -> 총 1, 4, 9 번 fetch 로 2x2, 4x4, 6x6 texel 비교)
+
+/* VSM / EVSM 관련 uniform 변수 (moment_shadow_map.h 필기 참고) */
+uniform int shadowFilter; // 0 이면 PCF, 1 이면 VSM, 2 이면 EVSM
+uniform sampler2DArray momentMap; // cascade 별로 blur 및 mipmap 이 적용된 moment 텍스쳐 배열 (2번 texture unit 에 바인딩된 텍스쳐 객체 샘플링)
+uniform vec2 evsmExponents; // EVSM 에서 깊이를 warp 할 양수 / 음수 exponent (shadow_moments.fs 와 같은 값)
+uniform float minVariance; // 평평한 표면에서 분산이 0 이 되어 생기는 self shadowing(acne) 을 막기 위한 최소 분산
+uniform float lightBleedReduction; // Chebyshev 결과에서 잘라낼 light bleeding 비율 [0, 1)
+
+// 프래그먼트의 view space 깊이가 속한 cascade 인덱스 반환 (모든 구간을 벗어나면 cascadeCount 반환)
+int SelectCascade(float viewDepth) {
+  for(int i = 0; i < cascadeCount; i++) {
+    if(viewDepth < cascadeSplits[i]) {
+      return i;
+    }
+  }
+  return cascadeCount;
+}
+
+// Chebyshev 부등식으로 '필터 영역 안에서 기준 깊이값 t 보다 멀리 있는(== 빛을 받는) 비율' 의 상한을 계산
+float ChebyshevUpperBound(vec2 moments, float t, float varianceFloor) {
+  // 기준 깊이값이 평균보다 광원에 가까우면 빛을 받는 것으로 판정
+  if(t <= moments.x) {
+    return 1.0;
+  }
+
+  float variance = max(moments.y - moments.x * moments.x, varianceFloor);
+  float d = t - moments.x;
+  float pMax = variance / (variance + d * d);
+
+  // light bleeding 이 생기는 낮은 pMax 영역을 잘라낸 뒤 [0, 1] 로 다시 늘림
+  return clamp((pMax - lightBleedReduction) / (1.0 - lightBleedReduction), 0.0, 1.0);
+}
+
+// 필터링된 moment 를 fetch 1번으로 샘플링해서 그림자 값을 계산 (dx, dy 는 shadow map uv 의 화면 공간 미분값)
+float MomentShadowCalculation(vec3 projCoords, int cascade, float refDepth, vec2 dx, vec2 dy) {
+  // textureGrad() 로 미분값을 직접 전달해야, cascade 경계에서 uv 가 불연속이어도 엉뚱한 mipmap level 이 선택되지 않음
+  vec4 moments = textureGrad(momentMap, vec3(projCoords.xy, float(cascade)), dx, dy);
+
+  if(shadowFilter == 2) {
+    // 기준 깊이값도 moment 와 똑같이 warp 해서 비교 (warp 된 공간에서는 깊이 변화량이 2 * exponent * warp 값 배만큼 커지므로, 최소 분산도 그만큼 키움)
+    float d = 2.0 * refDepth - 1.0;
+    float pos = exp(evsmExponents.x * d);
+    float neg = -exp(-evsmExponents.y * d);
+    float posScale = 2.0 * evsmExponents.x * pos;
+    float negScale = 2.0 * evsmExponents.y * neg;
+    float posLit = ChebyshevUpperBound(moments.xy, pos, minVariance * posScale * posScale);
+    float negLit = ChebyshevUpperBound(moments.zw, neg, minVariance * negScale * negScale);
+    return 1.0 - min(posLit, negLit);
+  }
+
+  return 1.0 - ChebyshevUpperBound(moments.xy, refDepth, minVariance);
+}
+
+// 현재 프래그먼트가 그림자 안에 있는지 여부를 반환해주는 함수 (dPdx, dPdy 는 world space 위치의 화면 공간 미분값)
+float ShadowCalculation(vec3 fragPos, int cascade, vec3 dPdx, vec3 dPdy) {
+  // 가장 먼 cascade 보다 멀리 있는 프래그먼트는 shadow map 이 없으므로 그림자 영역 밖으로 판정
+  if(cascade >= cascadeCount) {
+    return 0.0;
+  }
+
+  // 선택한 cascade 의 light space 행렬로 현재 프래그먼트 위치값을 변환
+  vec4 fragPosLightSpace = lightSpaceMatrices[cascade] * vec4(fragPos, 1.0);
+
   // 현재 프래그먼트 위치값을 light space 좌표계(== projection 행렬까지 적용된 clip space 라고 봐도 무방) > NDC 좌표계로 변환 (자세한 내용은 하단 참고)
   vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
 
   // [-1, 1] 사이의 NDC 좌표계 > [0, 1] 사이의 범위로 맵핑 (-> uv 좌표로 쓰기 위해...) (자세한 내용은 하단 참고)
   projCoords = projCoords * 0.5 + 0.5;
 
-  // [0, 1] 사이로 맵핑된 좌표의 x, y 값을 uv 좌표로 사용해서 shadow map 샘플링
-  float closestDepth = texture2D(shadowMap, projCoords.xy).r;
-
   // [0, 1] 사이로 맵핑된 좌표의 z 값을 현재 프래그먼트의 깊이값으로 할당
   float currentDepth = projCoords.z;
 
@@ -36,10 +103,23 @@ float ShadowCalculation(vec4 fragPosLightSpace) {
 
   // shadow acne 현상 해결을 위해, 조명벡터와 프래그먼트의 방향벡터(노멀벡터) 각도를 내적하여 shadow bias 계산 (하단 필기 참고)
   vec3 normal = normalize(fs_in.Normal);
-  vec3 lightDir = normalize(lightPos - fs_in.FragPos);
+  vec3 L = normalize(lightDir);
 
-  // bias 계산 시, [0.005, 0.05] 범위 내의 값으로 계산되도록 clamping 내적
-  float bias = max(0.05 * (1.0 - dot(normal, lightDir)), 0.005);
+  // cascade 마다 texel 크기와 깊이 범위가 다르므로, bias 를 texel 크기 단위(world space)로 계산한 뒤 [0, 1] 깊이값 단위로 변환
+  // (표면이 조명벡터와 기울어질수록 texel 1개 안에서의 깊이 변화가 커지므로 1 ~ 4 texel 사이에서 키워줌)
+  float bias = cascadeTexelSizes[cascade] * mix(1.0, 4.0, 1.0 - max(dot(normal, L), 0.0)) / cascadeDepthRanges[cascade];
+
+  // VSM / EVSM 모드라면, PCF 대신 moment 를 fetch 1번으로 샘플링 (cascade 영역을 벗어나면 그림자 영역 밖으로 판정)
+  if(shadowFilter != 0) {
+    if(projCoords.z > 1.0 || any(lessThan(projCoords.xy, vec2(0.0))) || any(greaterThan(projCoords.xy, vec2(1.0)))) {
+      return 0.0;
+    }
+
+    // 직교 투영이므로, world space 미분값에 light space 행렬을 곱하면 곧바로 shadow map uv 의 미분값이 됨 ([-1, 1] -> [0, 1] 이므로 0.5 배)
+    vec2 dx = (lightSpaceMatrices[cascade] * vec4(dPdx, 0.0)).xy * 0.5;
+    vec2 dy = (lightSpaceMatrices[cascade] * vec4(dPdy, 0.0)).xy * 0.5;
+    return MomentShadowCalculation(projCoords, cascade, currentDepth - bias, dx, dy);
+  }
 
   /* PCF 알고리즘 적용 (자세한 설명 하단 참고) */
 
@@ -48,35 +128,25 @@ float ShadowCalculation(vec4 fragPosLightSpace) {
 
   // shadow map 텍스쳐의 단위 texel 당 크기 계산 (-> 주변 texel 을 샘플링할 때 uv 좌표값에 더해줄 offset 으로 사용할 예정)
   // 참고로, textureSize() built-in 함수는 특정 LOD 레벨(여기서는 0) 상에서의 텍스쳐 width, height 값을 vec2 타입으로 반환함.
-  vec2 texelSize = 1.0 / textureSize(shadowMap, 0);
-
-  // 이중 for-loop 내에서 현재 프래그먼트를 중심으로 주변 texel 들의 깊이값을 shadow map 으로부터 샘플링하여 깊이값 누산 
-  // 'u축(== x축) 방향으로 3회 * v축(== y축) 방향으로 3회' => 총 9회의 shadow map 깊이값 샘플링
-  for(int x = -1; x <= 1; x++) {
-    // -1 ~ 1 까지 u축 방향으로 3회 순회
-
-    for(int y = -1; y <= 1; y++) {
-      // -1 ~ 1 까지 v축 방향으로 3회 순회
-
-      /*
-        현재 프래그먼트의 uv 좌표값(projCoords.xy)을 중심으로,
-        각 방향으로 단위 texel 크기 만큼의 offset 을 적용하여(vec2(x, y) * texelSize)
-
-        shadow map 으로부터 주변 texel 의 깊이값을 샘플링
-      */
-      float pcfDepth = texture2D(shadowMap, projCoords.xy + vec2(x, y) * texelSize).r;
-
-      /*
-        shadow map 으로부터 샘플링한 주변 texel 의 깊이값을 가지고서
-        shadow testing 을 수행한 결과를 shadow 변수에 누산함.
-      */
-      // shadow testing 시, 현재 프래그먼트의 깊이값에 bias 값만큼 빼서 깊이값이 광원에 더 가까워지도록 보정
-      shadow += currentDepth - bias > pcfDepth ? 1.0 : 0.0;
+  vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+
+  // shadow testing 시, 현재 프래그먼트의 깊이값에 bias 값만큼 빼서 깊이값이 광원에 더 가까워지도록 보정한 기준 깊이값
+  float refDepth = currentDepth - bias;
+
+  // 각 fetch 는 하드웨어가 주변 2x2 texel 의 비교 결과를 bilinear 필터링해서 반환하므로,
+  // fetch 위치를 2 texel 간격으로 배치해서 fetch 마다 서로 겹치지 않는 2x2 texel 을 비교하도록 함 (cascaded_shadow_map.h 필기 참고)
+  float start = -float(pcfTaps - 1);
+  for(int x = 0; x < pcfTaps; x++) {
+    for(int y = 0; y < pcfTaps; y++) {
+      vec2 offset = (vec2(start) + 2.0 * vec2(x, y)) * texelSize;
+
+      // sampler2DArrayShadow 는 (uv, layer, 기준 깊이값) 을 전달하면, 기준 깊이값 <= 저장된 깊이값인 비율(== 그림자 밖인 비율)을 반환함
+      shadow += 1.0 - texture(shadowMap, vec4(projCoords.xy + offset, float(cascade), refDepth));
     }
   }
 
-  // 주변 texel 로부터 깊이값을 샘플링하여 shadow testing 결과를 누산한 횟수만큼 나눠서 평균값을 구함
-  shadow /= 9.0;
+  // fetch 횟수만큼 나눠서 평균값을 구함
+  shadow /= float(pcfTaps * pcfTaps);
 
   // 현재 프래그먼트의 깊이값(projCoords.z)이 NDC 좌표계 상의 far plane 의 깊이값(1.0)을 넘어서면,
   // 무조건 그림자 영역이 아닌 것으로 판정하도록 함으로써, Over sampling 이슈 해결 (관련 필기 하단 참고)
@@ -105,8 +175,8 @@ void main() {
 
   /* diffuse 성분 계산 */
   // 조명계산에 사용되는 모든 방향벡터들은 항상 정규화를 해줄 것! -> 그래야 내적계산 시 정확한 cos 값만 얻을 수 있음!
-  vec3 lightDir = normalize(lightPos - fs_in.FragPos); // 조명벡터 (프래그먼트 위치 ~ 광원 위치)
-  float diff = max(dot(lightDir, normal), 0.0); // 노멀벡터와 조명벡터 내적 > diffuse 성분의 세기(조도) 계산 (참고로, 음수인 diffuse 값은 조명값 계산을 부정확하게 만들기 때문에, 0.0 으로 clamping 시킴)
+  vec3 L = normalize(lightDir); // 조명벡터 (directional light 이므로 프래그먼트 위치와 무관)
+  float diff = max(dot(L, normal), 0.0); // 노멀벡터와 조명벡터 내적 > diffuse 성분의 세기(조도) 계산 (참고로, 음수인 diffuse 값은 조명값 계산을 부정확하게 만들기 때문에, 0.0 으로 clamping 시킴)
   vec3 diffuse = diff * lightColor; // diffuse 조도에 조명 색상 곱해서 최종 diffuse 성분값 계산
 
   /* specular 성분 계산 */
@@ -114,7 +184,7 @@ void main() {
   float spec = 0.0; // specular 조도 선언 및 초기화
 
   // 뷰 벡터와 조명벡터 사이의 halfway 벡터 계산 (두 벡터의 합 -> 두 벡터 사이를 가로지르는 하프 벡터 (<셰이더 코딩 입문> p.222 참고))
-  vec3 halfwayDir = normalize(lightDir + viewDir);
+  vec3 halfwayDir = normalize(L + viewDir);
 
   // specular 성분의 조도 계산
   // 프래그먼트 지점의 normal 벡터와 halfway 벡터를 clamping 내적함
@@ -125,8 +195,12 @@ void main() {
 
   vec3 specular = spec * lightColor; // specular 조도에 조명 색상을 곱해 specular 성분값 계산
 
-  // 현재 프래그먼트의 light space 좌표계를 매개변수로 전달하여 그림자 영역 내에 존재하는지 여부를 판단
-  float shadow = ShadowCalculation(fs_in.FragPosLightSpace);
+  // 현재 프래그먼트의 view space 깊이로 cascade 를 고른 뒤, 해당 cascade 의 shadow map 으로 그림자 영역 내에 존재하는지 여부를 판단
+  // (미분값은 모든 프래그먼트가 같은 흐름으로 실행되는 곳에서 계산해야 하므로, 분기가 있는 ShadowCalculation() 밖에서 미리 계산해서 전달)
+  vec3 dPdx = dFdx(fs_in.FragPos);
+  vec3 dPdy = dFdy(fs_in.FragPos);
+  int cascade = SelectCascade(fs_in.ViewDepth);
+  float shadow = ShadowCalculation(fs_in.FragPos, cascade, dPdx, dPdy);
 
   // 3가지 성분을 모두 더한 뒤, 바닥 평면 텍스쳐 색상값(diffuse color)를 곱하여 최종 색상 계산
   /*
@@ -142,6 +216,12 @@ void main() {
   */
   vec3 lighting = (ambient + (1.0 - shadow) * (diffuse + specular)) * color;
 
+  // cascade 시각화 모드라면, cascade 마다 다른 색상(빨강 -> 초록 -> 파랑 -> 노랑)을 섞어서 구간 경계를 확인
+  if(showCascades && cascade < cascadeCount) {
+    vec3 cascadeColors[4] = vec3[](vec3(1.0, 0.3, 0.3), vec3(0.3, 1.0, 0.3), vec3(0.3, 0.3, 1.0), vec3(1.0, 1.0, 0.3));
+    lighting *= cascadeColors[cascade];
+  }
+
   FragColor = vec4(lighting, 1.0);
 }
 
@@ -10,7 +10,7 @@ out VS_OUT {
   vec3 FragPos; // 정점 위치를 world space 좌표계까지 변환하여 전송
   vec3 Normal; // 정점 노멀을 world space 좌표계까지 변환하여 전송
   vec2 TexCoords; // 텍스쳐 좌표를 보간하여 전송
-  vec4 FragPosLightSpace; // 정점 위치를 light space 좌표계까지 변환하여 전송
+  float ViewDepth; // 카메라로부터의 view space 깊이(양수) -> 샘플링할 cascade 를 고르는 데 사용
 } vs_out;
 
 /* 변환 행렬을 전송받는 uniform 변수 선언 */ 
@@ -24,9 +24,6 @@ uniform mat4 view;
 // 모델 행렬
 uniform mat4 model;
 
-// world space > light space 좌표계로의 변환 행렬
-uniform mat4 lightSpaceMatrix;
-
 void main() {
   // 정점 위치를 world space 좌표계까지 변환하여 프래그먼트 쉐이더 단계로 전송
   vs_out.FragPos = vec3(model * vec4(aPos, 1.0));
@@ -37,8 +34,9 @@ void main() {
   // 텍스쳐 좌표를 보간하여 프래그먼트 쉐이더 단계로 전송
   vs_out.TexCoords = aTexCoords;
 
-  // 정점의 world space 좌표를 light space 좌표계까지 한방에 변환 후, 프래그먼트 쉐이더 단계로 전송
-  vs_out.FragPosLightSpace = lightSpaceMatrix * vec4(vs_out.FragPos, 1.0);
+  // view space 는 -z 방향을 바라보므로, 부호를 뒤집어서 카메라로부터의 깊이를 양수로 전송
+  // (cascade 별 light space 변환은 cascade 를 고른 뒤 fragment shader 에서 처리)
+  vs_out.ViewDepth = -(view * vec4(vs_out.FragPos, 1.0)).z;
 
   // 오브젝트 공간 좌표에 모델 행렬 > 뷰 행렬 > 투영 행렬 순으로 곱해서 좌표계를 변환시킴.
   gl_Position = projection * view * model * vec4(aPos, 1.0);
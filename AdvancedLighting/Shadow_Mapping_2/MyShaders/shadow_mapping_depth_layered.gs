@@ -0,0 +1,36 @@
+#version 330 core
+
+// 입력 primitive 지정자
+layout(triangles) in;
+
+// 출력 primitive 지정자 (삼각형 1개를 최대 4개의 cascade 에 복제하므로 최대 3 * 4 = 12 개의 정점 출력)
+layout(triangle_strip, max_vertices = 12) out;
+
+// cascade 별 world space -> light space 변환 행렬 및 현재 사용 중인 cascade 개수
+uniform mat4 lightSpaceMatrices[4];
+uniform int cascadeCount;
+
+void main() {
+  // 입력받은 삼각형을 cascade 마다 해당 light space 로 변환해서 텍스쳐 배열의 각 layer 에 렌더링
+  for(int cascade = 0; cascade < cascadeCount; cascade++) {
+    vec4 clipPos[3];
+    for(int i = 0; i < 3; i++) {
+      clipPos[i] = lightSpaceMatrices[cascade] * gl_in[i].gl_Position;
+    }
+
+    // 세 정점이 모두 cascade 영역의 같은 쪽 바깥에 있다면, 이 cascade 에는 복제하지 않음 (직교 투영이므로 w = 1)
+    vec3 minPos = min(min(clipPos[0].xyz, clipPos[1].xyz), clipPos[2].xyz);
+    vec3 maxPos = max(max(clipPos[0].xyz, clipPos[1].xyz), clipPos[2].xyz);
+    if(any(lessThan(maxPos.xy, vec2(-1.0))) || any(greaterThan(minPos.xy, vec2(1.0)))) {
+      continue;
+    }
+
+    for(int i = 0; i < 3; i++) {
+      // 현재 프레임버퍼에 바인딩된 텍스쳐 배열의 몇 번째 layer 에 렌더링할 지 지정 (정점마다 매번 지정해줘야 함)
+      gl_Layer = cascade;
+      gl_Position = clipPos[i];
+      EmitVertex();
+    }
+    EndPrimitive();
+  }
+}
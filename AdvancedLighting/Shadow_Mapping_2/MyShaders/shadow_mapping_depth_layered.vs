@@ -0,0 +1,11 @@
+#version 330 core
+
+layout(location = 0) in vec3 aPos;
+
+// light space 내부의 각 오브젝트들에 적용할 모델 행렬
+uniform mat4 model;
+
+void main() {
+  // cascade 별 light space 변환은 geometry shader 에서 처리하므로, 여기서는 world space 까지만 변환해서 넘겨줌
+  gl_Position = model * vec4(aPos, 1.0);
+}
@@ -0,0 +1,46 @@
+#version 330 core
+
+out vec4 FragColor;
+
+/* uniform 변수 선언 */
+
+// cascade 별 shadow map 이 layer 로 저장된 깊이 텍스쳐 배열 (깊이값을 직접 읽어야 하므로 깊이 비교 모드를 끄고 바인딩)
+uniform sampler2DArray depthMap;
+
+// moment 로 변환할 cascade 의 layer 인덱스
+uniform int layer;
+
+// 1 이면 VSM (깊이 그대로), 2 이면 EVSM (깊이를 exp 로 warp)
+uniform int momentMode;
+
+// EVSM 에서 깊이를 warp 할 양수 / 음수 exponent
+uniform vec2 evsmExponents;
+
+// blur 커널 반지름 (texel 단위, 커널 크기는 2 * blurRadius + 1)
+uniform int blurRadius;
+
+// 깊이값 1개를 moment 로 변환 (moment_shadow_map.h 필기 참고)
+vec4 ComputeMoments(float depth) {
+  if(momentMode == 2) {
+    // [0, 1] 깊이를 [-1, 1] 로 옮긴 뒤 warp 해야 양수 / 음수 exponent 가 대칭적으로 정밀도를 나눠 가짐
+    float d = 2.0 * depth - 1.0;
+    float pos = exp(evsmExponents.x * d);
+    float neg = -exp(-evsmExponents.y * d);
+    return vec4(pos, pos * pos, neg, neg * neg);
+  }
+  return vec4(depth, depth * depth, 0.0, 0.0);
+}
+
+void main() {
+  // 깊이 -> moment 변환과 가로 방향 box blur 를 한 번에 처리 (moment 는 선형이므로 변환 후 평균내도 됨)
+  ivec2 size = textureSize(depthMap, 0).xy;
+  ivec2 coord = ivec2(gl_FragCoord.xy);
+
+  vec4 moments = vec4(0.0);
+  for(int i = -blurRadius; i <= blurRadius; i++) {
+    int x = clamp(coord.x + i, 0, size.x - 1);
+    moments += ComputeMoments(texelFetch(depthMap, ivec3(x, coord.y, layer), 0).r);
+  }
+
+  FragColor = moments / float(2 * blurRadius + 1);
+}
@@ -0,0 +1,25 @@
+#version 330 core
+
+out vec4 FragColor;
+
+/* uniform 변수 선언 */
+
+// 가로 방향 blur 까지 적용된 moment 가 저장된 임시 텍스쳐
+uniform sampler2D momentTemp;
+
+// blur 커널 반지름 (texel 단위, 가로 방향 pass 와 같은 값 사용)
+uniform int blurRadius;
+
+void main() {
+  // 세로 방향 box blur (가로 -> 세로 두 번의 1D blur 로 2D blur 를 대체하면, 커널 크기가 k 일 때 fetch 횟수가 k * k -> 2k 로 줄어듦)
+  ivec2 size = textureSize(momentTemp, 0);
+  ivec2 coord = ivec2(gl_FragCoord.xy);
+
+  vec4 moments = vec4(0.0);
+  for(int i = -blurRadius; i <= blurRadius; i++) {
+    int y = clamp(coord.y + i, 0, size.y - 1);
+    moments += texelFetch(momentTemp, ivec2(coord.x, y), 0);
+  }
+
+  FragColor = moments / float(2 * blurRadius + 1);
+}
@@ -13,8 +13,25 @@
 
 #include "MyHeaders/shader_s.h"
 #include "MyHeaders/camera.h"
+#include "MyHeaders/gpu_timer.h"
+#include "MyHeaders/cascaded_shadow_map.h"
+#include "MyHeaders/shadow_cache.h"
+#include "MyHeaders/moment_shadow_map.h"
 
 #include <iostream>
+#include <vector>
+#include <string>
+
+
+// 씬에 배치할 오브젝트 1개의 정보 (shadow pass 에서 cascade 별 culling 에 사용할 world space bounding sphere 포함)
+struct SceneObject
+{
+	glm::mat4 model;
+	bool isPlane; // true 면 바닥 평면, false 면 큐브
+	glm::vec3 center;
+	float radius;
+	bool dynamic; // true 면 매 프레임 움직이는 caster (shadow cache 에 저장하지 않고 매 프레임 다시 렌더링)
+};
 
 
 /* 콜백함수 전방선언 */
@@ -35,10 +52,12 @@ void processInput(GLFWwindow* window);
 unsigned int loadTexture(const char* path);
 
 // shadow map 에 깊이 버퍼를 저장할 씬을 렌더링하는 함수 선언
-void renderScene(const Shader& shader);
+// (visible 배열을 전달하면 true 인 오브젝트만 렌더링하며, 호출한 draw call 개수를 반환)
+// (positionOnly 가 true 면 위치값만 저장된 정점 버퍼로 렌더링 -> depth pass 에서 사용)
+unsigned int renderScene(const Shader& shader, const std::vector<bool>* visible = nullptr, bool positionOnly = false);
 
-// 씬에 큐브를 렌더링하는 함수 선언
-void renderCube();
+// 씬에 큐브를 렌더링하는 함수 선언 (positionOnly 가 true 면 위치값 전용 VAO 로 렌더링)
+void renderCube(bool positionOnly = false);
 
 // shadow map 을 샘플링하여 깊이 버퍼를 시각화할 QuadMesh 를 렌더링하는 함수 선언
 void renderQuad();
@@ -66,6 +85,53 @@ float lastFrame = 0.0f; // 마지막에 그려진 프레임의 ElapsedTime(경
 // Plane VAO 객체(object) 참조 id 를 저장할 변수를 전역으로 선언 (why? renderScene() 함수에서도 참조해야 함.)
 unsigned int planeVAO;
 
+// depth pass 에서 사용할 위치값 전용 Plane VAO 객체 참조 id (하단 필기 참고)
+unsigned int planeDepthVAO;
+
+// 씬에 배치할 오브젝트 목록 (renderScene() 함수에서 참조)
+std::vector<SceneObject> sceneObjects;
+
+// 사용할 cascade 개수 초기화 (2, 3, 4 키로 변경)
+unsigned int cascadeCount = 3;
+
+// practical split scheme 의 log / 균등 분할 비율 초기화 ([, ] 키로 조절)
+float cascadeSplitLambda = 0.5f;
+
+// geometry shader 로 모든 cascade 를 한 번의 pass 로 렌더링할 지 여부 초기화 (false 면 cascade 마다 따로 렌더링)
+bool csmLayered = true;
+bool csmLayeredKeyPressed = false;
+
+// cascade 구간 시각화 여부 초기화
+bool showCascades = false;
+bool showCascadesKeyPressed = false;
+
+// hardware PCF 에서 각 축 방향으로 fetch 할 횟수 초기화 (P 키로 1 -> 2 -> 3 순환, 총 fetch 횟수는 제곱)
+int pcfTaps = 2;
+bool pcfTapsKeyPressed = false;
+
+// static caster 를 shadow cache 에 저장해두고 재사용할 지 여부 초기화 (C 키로 on/off)
+bool shadowCaching = true;
+bool shadowCachingKeyPressed = false;
+
+// static caster 가 바뀔 때마다 증가시킬 static 씬 버전 (N 키로 static 큐브를 옮기면 증가 -> shadow cache 전체 무효화)
+unsigned int staticSceneVersion = 0;
+bool moveStaticKeyPressed = false;
+
+// cascade 영역을 texel snapping 된 안정적인 영역으로 계산할 지 여부 초기화 (F 키로 stable <-> tight 전환)
+bool stableFit = true;
+bool stableFitKeyPressed = false;
+
+// 그림자 필터링 방식 초기화 (E 키로 0: PCF -> 1: VSM -> 2: EVSM 순환)
+int shadowFilter = 0;
+bool shadowFilterKeyPressed = false;
+
+// VSM / EVSM 의 moment blur 커널 반지름 초기화 (R 키로 1 -> 2 -> 4 순환, 커널 크기는 2 * 반지름 + 1)
+int momentBlurRadius = 2;
+bool momentBlurRadiusKeyPressed = false;
+
+// Chebyshev 결과에서 잘라낼 light bleeding 비율 초기화 (-, = 키로 조절)
+float lightBleedReduction = 0.2f;
+
 int main()
 {
 	// GLFW 초기화
@@ -142,6 +208,10 @@ int main()
 	// second pass 를 렌더링할 때 적용할 쉐이더 객체 생성
 	Shader shader("MyShaders/shadow_mapping.vs", "MyShaders/shadow_mapping.fs");
 
+	// 깊이 shadow map 을 moment 로 변환하면서 가로 / 세로 방향으로 blur 할 쉐이더 객체 생성 (QuadMesh 로 full screen pass 렌더링)
+	Shader momentShader("MyShaders/debug_quad.vs", "MyShaders/shadow_moments.fs");
+	Shader momentBlurShader("MyShaders/debug_quad.vs", "MyShaders/shadow_moments_blur.fs");
+
 	// 바닥 평면의 정점 데이터 정적 배열 초기화
 	float planeVertices[] = {
 		// positions            // normals         // texcoords
@@ -201,6 +271,28 @@ int main()
 	// 마찬가지로, VAO 객체도 OpenGL 컨텍스트로부터 바인딩 해제 
 	glBindVertexArray(0);
 
+	// depth pass 용 위치값 전용 VBO, VAO 생성 (정점마다 8개의 float 중 위치값 3개만 빽빽하게 모아서 저장)
+	float planePositions[6 * 3];
+	for (unsigned int i = 0; i < 6; i++)
+	{
+		planePositions[i * 3 + 0] = planeVertices[i * 8 + 0];
+		planePositions[i * 3 + 1] = planeVertices[i * 8 + 1];
+		planePositions[i * 3 + 2] = planeVertices[i * 8 + 2];
+	}
+
+	unsigned int planeDepthVBO;
+	glGenVertexArrays(1, &planeDepthVAO);
+	glGenBuffers(1, &planeDepthVBO);
+	glBindVertexArray(planeDepthVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, planeDepthVBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(planePositions), planePositions, GL_STATIC_DRAW);
+
+	// 정점 위치 데이터(0번 location 입력변수 in vec3 aPos 에 전달할 데이터)만 사용 (stride 도 위치값 크기인 12 byte)
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+
 
 	/* 텍스쳐 객체 생성 및 쉐이더 프로그램 전송 */
 
@@ -208,68 +300,88 @@ int main()
 	unsigned int woodTexture = loadTexture("resources/textures/wood.png");
 
 
-	/* shadow map 을 생성하기 위한 프레임버퍼 생성 및 설정 */
+	/* 씬에 배치할 오브젝트 목록 초기화 */
+
+	// 바닥 평면 (모델행렬은 단위행렬, bounding sphere 는 50 * 50 크기의 평면을 감싸는 구)
+	sceneObjects.push_back({ glm::mat4(1.0f), true, glm::vec3(0.0f, -0.5f, 0.0f), 25.0f * std::sqrt(2.0f), false });
+
+	// 큐브들 (크기가 2 인 큐브를 scale 한 것이므로, bounding sphere 반지름은 scale * sqrt(3))
+	glm::mat4 cubeModel = glm::mat4(1.0f);
+	cubeModel = glm::translate(cubeModel, glm::vec3(0.0f, 1.5f, 0.0f));
+	cubeModel = glm::scale(cubeModel, glm::vec3(0.5f));
+	sceneObjects.push_back({ cubeModel, false, glm::vec3(0.0f, 1.5f, 0.0f), 0.5f * std::sqrt(3.0f), false });
 
-	// shadow map 해상도 정의
-	const unsigned int SHADOW_WIDTH = 1024, SHADOW_HEIGHT = 1024;
+	cubeModel = glm::mat4(1.0f);
+	cubeModel = glm::translate(cubeModel, glm::vec3(2.0f, 0.0f, 1.0f));
+	cubeModel = glm::scale(cubeModel, glm::vec3(0.5f));
+	sceneObjects.push_back({ cubeModel, false, glm::vec3(2.0f, 0.0f, 1.0f), 0.5f * std::sqrt(3.0f), false });
 
-	// FBO(FrameBufferObject) 객체 생성
-	unsigned int depthMapFBO;
-	glGenFramebuffers(1, &depthMapFBO);
+	cubeModel = glm::mat4(1.0f);
+	cubeModel = glm::translate(cubeModel, glm::vec3(-1.0f, 0.0f, 2.0f));
+	cubeModel = glm::rotate(cubeModel, glm::radians(60.0f), glm::normalize(glm::vec3(1.0f, 0.0f, 1.0f)));
+	cubeModel = glm::scale(cubeModel, glm::vec3(0.25f));
+	sceneObjects.push_back({ cubeModel, false, glm::vec3(-1.0f, 0.0f, 2.0f), 0.25f * std::sqrt(3.0f), false });
 
-	// FBO 객체에 attach 할 텍스쳐 객체(== shadow map 텍스쳐) 생성 및 바인딩
-	unsigned int depthMap;
-	glGenTextures(1, &depthMap);
-	glBindTexture(GL_TEXTURE_2D, depthMap);
+	// 바닥 위를 맴도는 dynamic 큐브 (모델행렬과 bounding sphere 중심은 렌더링 루프에서 매 프레임 갱신)
+	const unsigned int dynamicCubeIndex = (unsigned int)sceneObjects.size();
+	sceneObjects.push_back({ glm::mat4(1.0f), false, glm::vec3(0.0f), 0.3f * std::sqrt(3.0f), true });
 
-	// 텍스쳐 객체 메모리 공간 할당 (loadTexture() 와 달리 할당된 메모리에 이미지 데이터를 덮어쓰지 않음! -> 대신 FBO 에서 렌더링된 데이터를 덮어쓸 거니까!)
-	// 텍스쳐 객체의 해상도는 shadow map 해상도와 일치시킴 -> 왜냐? 이 텍스쳐는 'shadow map'으로 사용할 거니까!
-	// 또한, 이 텍스쳐에는 깊이값만 덮어쓸 것이므로(== 깊이 버퍼 attachment), GL_RGB 가 아닌, 'GL_DEPTH_COMPONENT'으로 텍스쳐 포맷을 지정한다! 
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_BYTE, NULL);
 
-	// Texture Filtering(텍셀 필터링(보간)) 모드 설정
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	/* cascaded shadow map 생성 (cascaded_shadow_map.h 필기 참고) */
 
-	// Over Sampling 이슈를 방지하기 위해, Texture Wrapping 모드를 clamp to border 로 설정 (관련 내용 하단 필기 참고)
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+	// 각 cascade 의 shadow map 해상도 정의
+	const unsigned int SHADOW_RESOLUTION = 1024;
 
-	// clamp to border 로 샘플링할 색상을 흰색으로 설정
-	// -> [0, 1] 범위를 벗어난 uv 좌표값으로 shadow map 을 샘플링하면, 항상 이 색상으로 샘플링 될 것임.
-	float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-	glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
+	// cascade 별 shadow map 을 layer 로 저장할 GL_TEXTURE_2D_ARRAY 깊이 텍스쳐 및 프레임버퍼 생성
+	CascadedShadowMap csm(SHADOW_RESOLUTION, cascadeCount);
 
+	// cascade 로 나눌 카메라 view frustum 의 최대 거리 (카메라 far plane 까지 모두 나누면 가까운 cascade 의 해상도가 낭비됨)
+	const float SHADOW_DISTANCE = 40.0f;
 
-	// 생성했던 FBO 객체 바인딩
-	glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
+	// geometry shader 로 삼각형을 모든 cascade 의 layer 에 복제해서 한 번의 pass 로 렌더링할 쉐이더 객체 생성
+	Shader layeredDepthShader("MyShaders/shadow_mapping_depth_layered.vs", "MyShaders/shadow_mapping_depth.fs", "MyShaders/shadow_mapping_depth_layered.gs");
 
-	// FBO 객체에 생성한 텍스쳐 객체 attach (자세한 매개변수 설명은 LearnOpenGL 본문 참고!)
-	// shadow map 텍스쳐 객체에는 최종 depth buffer 만 저장하면 되므로, depth attachment 만 적용함!
-	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthMap, 0);
+	// static caster 의 깊이만 cascade 별로 보관해 둘 shadow cache 생성 (shadow_cache.h 필기 참고)
+	ShadowCache shadowCache(GL_TEXTURE_2D_ARRAY, GL_DEPTH_COMPONENT24, SHADOW_RESOLUTION, CascadedShadowMap::MAX_CASCADES);
 
-	// shadow map 을 위해 생성한 프레임버퍼는 색상 버퍼를 필요로 하지 않음.
-	// -> 따라서, 현재 GL_FRAMEBUFFER 에 바인딩된 프레임버퍼가 색상 버퍼를 이용해서 실제 화면에 렌더링하지 않음을 명시하면,
-	// 색상 버퍼(== color attachment)에 데이터를 굳이 저장하지 않아도 되도록 설정할 수 있음!
-	glDrawBuffer(GL_NONE);
-	glReadBuffer(GL_NONE);
+	// shadow pass 가 GPU 에서 실행되는 데 걸린 시간을 측정할 타이머 생성
+	GpuTimer shadowTimer;
 
-	// 생성한 FBO 객체 설정 완료 후, 다시 default framebuffer 바인딩하여 원상복구 (참고로, default framebuffer 의 참조 id 가 0임!)
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	// VSM / EVSM 모드에서 cascade 별 moment 를 저장할 텍스쳐 배열 생성 (moment_shadow_map.h 필기 참고)
+	MomentShadowMap momentMap(SHADOW_RESOLUTION, CascadedShadowMap::MAX_CASCADES);
+
+	// EVSM 의 양수 / 음수 exponent (RGBA16F 에 exp(2c) 가 넘치지 않는 범위)
+	const glm::vec2 EVSM_EXPONENTS(5.0f, 5.0f);
+
+	// moment 생성 pass 와 second pass 의 GPU 소요 시간을 측정할 타이머 생성 (GL_TIME_ELAPSED query 는 겹칠 수 없으므로 구간마다 따로 생성)
+	GpuTimer momentTimer;
+	GpuTimer lightingTimer;
+
+	// cascade 별로 shadow map 에 렌더링할 오브젝트 목록 (cascade 별 light frustum 과 bounding sphere 가 겹치는 오브젝트만 true)
+	std::vector<bool> cascadeVisible[CascadedShadowMap::MAX_CASCADES];
+	std::vector<bool> anyCascadeVisible;
+
+	// 위 목록을 static caster 와 dynamic caster 로 나눈 목록 (shadow cache 사용 시)
+	std::vector<bool> staticVisible[CascadedShadowMap::MAX_CASCADES];
+	std::vector<bool> dynamicVisible[CascadedShadowMap::MAX_CASCADES];
+	std::vector<bool> anyStaticVisible;
+	std::vector<bool> anyDynamicVisible;
 
 
 	// second pass 프래그먼트 쉐이더에 선언된 uniform sampler 변수(diffuse map, shadow map) 각각에 0번, 1번 texture unit 위치값 전송
 	shader.use();
 	shader.setInt("diffuseTexture", 0);
 	shader.setInt("shadowMap", 1);
+	shader.setInt("momentMap", 2);
 
 	// QuadMesh 프래그먼트 쉐이더에 선언된 uniform sampler 변수(shadow map)에 0번 texture unit 위치값 전송
 	debugDepthQuad.use();
 	debugDepthQuad.setInt("depthMap", 0);
 
 
-	// 광원 위치값 초기화
+	// 광원 위치값 초기화 (directional light 이므로, 원점에서 광원 위치를 향하는 방향만 조명 방향으로 사용)
 	glm::vec3 lightPos(-2.0f, 4.0f, -1.0f);
+	glm::vec3 lightDir = glm::normalize(lightPos);
 
 	// while 문으로 렌더링 루프 구현
 	while (!glfwWindowShouldClose(window))
@@ -299,59 +411,270 @@ int main()
 		/* 여기서부터 루프에서 실행시킬 모든 렌더링 명령(rendering commands)을 작성함. */
 
 
-		/* shadow map 에 기록할 씬에 적용할 변환행렬 계산 및 쉐이더 객체에 전송 */
-
-		// light space 좌표계로 변환 시 적용할 투영 행렬과 뷰 행렬 변수 초기화
-		glm::mat4 lightProjection, lightView;
-
-		// light space 좌표계로 변환 시 적용할 lightSpaceMatrix 변수 초기화
-		glm::mat4 lightSpaceMatrix;
-
-		// 투영행렬 계산에 사용할 near 값 초기화
-		float near_plane = 1.0f;
-
-		// 투영행렬 계산에 사용할 far 값 초기화
-		float far_plane = 7.5f;
-
-		// directional light 가 적용된 shadow map 을 구하려면, '직교 투영행렬'을 사용할 것! (하단 필기 참고)
-		lightProjection = glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, near_plane, far_plane);
-
-		// '광원의 위치가 원점이고, 방향은 '월드공간 원점'을 바라보는' light space 좌표계로 변환하는 뷰 행렬(= LookAt 행렬) 계산
-		lightView = glm::lookAt(lightPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-
-		// 쉐이더로 변환행렬을 전송하기 전, cpp 단계에서 lightProjection 과 lightView 를 미리 한 번에 곱해둠
-		lightSpaceMatrix = lightProjection * lightView;
-
-		// 변환행렬을 전송할 QuadMesh 쉐이더 프로그램 바인딩
-		simpleDepthShader.use();
-
-		// 계산된 lightSpaceMatrix 를 쉐이더 프로그램에 전송
-		simpleDepthShader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
-
-
-		/* First Pass (shadow map 에 깊이버퍼 기록) */
+		/* dynamic 큐브를 원을 그리며 회전시킴 */
+
+		SceneObject& dynamicCube = sceneObjects[dynamicCubeIndex];
+		dynamicCube.center = glm::vec3(2.5f * std::cos(currentFrame * 0.8f), 0.5f, 2.5f * std::sin(currentFrame * 0.8f));
+		dynamicCube.model = glm::mat4(1.0f);
+		dynamicCube.model = glm::translate(dynamicCube.model, dynamicCube.center);
+		dynamicCube.model = glm::rotate(dynamicCube.model, currentFrame, glm::normalize(glm::vec3(0.0f, 1.0f, 1.0f)));
+		dynamicCube.model = glm::scale(dynamicCube.model, glm::vec3(0.3f));
+
+
+		/* 카메라 view frustum 을 cascade 로 나누고, cascade 별 light space 행렬 계산 */
+
+		// 씬 오브젝트들을 모두 감싸는 AABB 계산 (바닥 평면은 두께가 없으므로 bounding sphere 대신 실제 크기 사용)
+		glm::vec3 sceneMin(1e30f), sceneMax(-1e30f);
+		for (unsigned int i = 0; i < sceneObjects.size(); i++)
+		{
+			glm::vec3 extent = sceneObjects[i].isPlane ? glm::vec3(25.0f, 0.0f, 25.0f) : glm::vec3(sceneObjects[i].radius);
+			sceneMin = glm::min(sceneMin, sceneObjects[i].center - extent);
+			sceneMax = glm::max(sceneMax, sceneObjects[i].center + extent);
+		}
+
+		csm.setCascadeCount(cascadeCount);
+		csm.splitLambda = cascadeSplitLambda;
+		csm.stableFit = stableFit;
+		csm.setSceneBounds(sceneMin, sceneMax);
+		csm.update(camera.GetViewMatrix(), glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, SHADOW_DISTANCE, lightDir);
+
+		// cascade 별로 light frustum 과 bounding sphere 가 겹치는 오브젝트만 골라냄 (CPU culling)
+		unsigned int cascadeObjects[CascadedShadowMap::MAX_CASCADES] = { 0, 0, 0, 0 };
+		anyCascadeVisible.assign(sceneObjects.size(), false);
+		anyStaticVisible.assign(sceneObjects.size(), false);
+		anyDynamicVisible.assign(sceneObjects.size(), false);
+		for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+		{
+			cascadeVisible[c].assign(sceneObjects.size(), false);
+			staticVisible[c].assign(sceneObjects.size(), false);
+			dynamicVisible[c].assign(sceneObjects.size(), false);
+			for (unsigned int i = 0; i < sceneObjects.size(); i++)
+			{
+				if (csm.intersects(c, sceneObjects[i].center, sceneObjects[i].radius))
+				{
+					cascadeVisible[c][i] = true;
+					anyCascadeVisible[i] = true;
+					cascadeObjects[c]++;
+
+					if (sceneObjects[i].dynamic)
+					{
+						dynamicVisible[c][i] = true;
+						anyDynamicVisible[i] = true;
+					}
+					else
+					{
+						staticVisible[c][i] = true;
+						anyStaticVisible[i] = true;
+					}
+				}
+			}
+		}
+
+
+		/* First Pass (cascade 별 shadow map 에 깊이버퍼 기록) */
 
 		// GLFWwindow 상에 렌더링될 뷰포트 영역을 shadow map 해상도에 맞게 resize
-		glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
-
-		// shadow map 텍스쳐 객체가 attach 된 framebuffer 바인딩
-		glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
-
-		// 현재 바인딩된 framebuffer 의 깊이 버퍼 초기화
-		glClear(GL_DEPTH_BUFFER_BIT);
-
-		// shadow map 텍스쳐 객체를 바인딩할 0번 texture unit 활성화
-		glActiveTexture(GL_TEXTURE0);
-
-		// 씬 안의 큐브와 바닥평면에 적용할 woodTexture 텍스쳐 객체 바인딩
-		glBindTexture(GL_TEXTURE_2D, woodTexture);
-
-		// shadow map 에 깊이 버퍼를 기록할 씬 렌더링
-		renderScene(simpleDepthShader);
+		glViewport(0, 0, csm.resolution(), csm.resolution());
+
+		// shadow pass 의 GPU 소요 시간 측정 시작
+		shadowTimer.begin();
+
+		// 이번 프레임의 shadow pass 에서 호출한 draw call 개수
+		unsigned int shadowDrawCalls = 0;
+
+		// 이번 프레임에 static caster 를 다시 렌더링한 cascade 개수
+		unsigned int staticRerendered = 0;
+
+		// cascade 별 light space 행렬을 geometry shader 에 전송
+		if (csmLayered)
+		{
+			layeredDepthShader.use();
+			for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+			{
+				layeredDepthShader.setMat4("lightSpaceMatrices[" + std::to_string(c) + "]", csm.lightSpaceMatrix(c));
+			}
+			layeredDepthShader.setInt("cascadeCount", csm.cascadeCount());
+		}
+
+		if (!shadowCaching)
+		{
+			if (csmLayered)
+			{
+				// 모든 layer 를 attach 하고 한꺼번에 깊이 버퍼 초기화
+				csm.bindLayered();
+				glClear(GL_DEPTH_BUFFER_BIT);
+
+				// 어느 cascade 에든 걸치는 오브젝트를 1번씩만 그리면, geometry shader 가 삼각형을 걸치는 cascade 의 layer 에만 복제함
+				shadowDrawCalls = renderScene(layeredDepthShader, &anyCascadeVisible, true);
+			}
+			else
+			{
+				// cascade 마다 해당 layer 만 attach 하고, 그 cascade 에 걸치는 오브젝트만 그림
+				simpleDepthShader.use();
+				for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+				{
+					csm.bindLayer(c);
+					glClear(GL_DEPTH_BUFFER_BIT);
+
+					simpleDepthShader.setMat4("lightSpaceMatrix", csm.lightSpaceMatrix(c));
+					shadowDrawCalls += renderScene(simpleDepthShader, &cascadeVisible[c], true);
+				}
+			}
+		}
+		else
+		{
+			/* 1. light space 행렬이나 static 씬이 바뀐 cascade 만 shadow cache 에 static caster 를 다시 렌더링 */
+
+			shadowCache.trackStaticScene(staticSceneVersion);
+			bool anyDirty = false;
+			for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+			{
+				shadowCache.track(c, csm.lightSpaceMatrix(c));
+				anyDirty = anyDirty || shadowCache.isDirty(c);
+			}
+
+			if (anyDirty)
+			{
+				if (csmLayered)
+				{
+					// geometry shader 는 모든 layer 에 한꺼번에 렌더링하므로, 하나라도 dirty 면 모든 cascade 를 다시 렌더링
+					shadowCache.bindLayered();
+					glClear(GL_DEPTH_BUFFER_BIT);
+					shadowDrawCalls += renderScene(layeredDepthShader, &anyStaticVisible, true);
+					for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+					{
+						shadowCache.markClean(c);
+						staticRerendered++;
+					}
+				}
+				else
+				{
+					simpleDepthShader.use();
+					for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+					{
+						if (!shadowCache.isDirty(c))
+						{
+							continue;
+						}
+
+						shadowCache.bindLayer(c);
+						glClear(GL_DEPTH_BUFFER_BIT);
+						simpleDepthShader.setMat4("lightSpaceMatrix", csm.lightSpaceMatrix(c));
+						shadowDrawCalls += renderScene(simpleDepthShader, &staticVisible[c], true);
+						shadowCache.markClean(c);
+						staticRerendered++;
+					}
+				}
+			}
+
+			/* 2. 캐시된 static caster 깊이를 shadow map 으로 복사한 뒤, 그 위에 dynamic caster 만 덧그림 */
+
+			for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+			{
+				shadowCache.restore(csm.ID, c);
+			}
+
+			if (csmLayered)
+			{
+				csm.bindLayered();
+				shadowDrawCalls += renderScene(layeredDepthShader, &anyDynamicVisible, true);
+			}
+			else
+			{
+				simpleDepthShader.use();
+				for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+				{
+					csm.bindLayer(c);
+					simpleDepthShader.setMat4("lightSpaceMatrix", csm.lightSpaceMatrix(c));
+					shadowDrawCalls += renderScene(simpleDepthShader, &dynamicVisible[c], true);
+				}
+			}
+		}
+
+		// shadow pass 의 GPU 소요 시간 측정 종료
+		shadowTimer.end();
+
+		/* VSM / EVSM 모드라면, 깊이 shadow map 을 cascade 별 moment 로 변환한 뒤 blur 및 mipmap 생성 */
+
+		momentTimer.begin();
+		if (shadowFilter != 0)
+		{
+			// full screen pass 이므로 깊이 테스트를 끄고, 깊이값을 직접 읽기 위해 깊이 비교 모드도 끔
+			glDisable(GL_DEPTH_TEST);
+			csm.setCompareMode(false);
+
+			for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+			{
+				// 1. 깊이 -> moment 변환 + 가로 방향 blur (임시 텍스쳐에 렌더링)
+				momentMap.bindTemp();
+				momentShader.use();
+				momentShader.setInt("depthMap", 0);
+				momentShader.setInt("layer", c);
+				momentShader.setInt("momentMode", shadowFilter);
+				momentShader.setVec2("evsmExponents", EVSM_EXPONENTS);
+				momentShader.setInt("blurRadius", momentBlurRadius);
+				glActiveTexture(GL_TEXTURE0);
+				glBindTexture(GL_TEXTURE_2D_ARRAY, csm.ID);
+				renderQuad();
+
+				// 2. 세로 방향 blur (cascade layer 에 렌더링)
+				momentMap.bindLayer(c);
+				momentBlurShader.use();
+				momentBlurShader.setInt("momentTemp", 0);
+				momentBlurShader.setInt("blurRadius", momentBlurRadius);
+				glBindTexture(GL_TEXTURE_2D, momentMap.tempID);
+				renderQuad();
+			}
+
+			// blur 된 moment 로 mipmap 생성 (멀리 있는 표면은 축소된 mipmap 을 샘플링하므로 aliasing 없이 부드러운 그림자가 됨)
+			momentMap.generateMipmaps();
+
+			csm.setCompareMode(true);
+			glEnable(GL_DEPTH_TEST);
+		}
+		momentTimer.end();
 
 		// default framebuffer 로 바인딩 복구
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
+		// cascade 개수, 분할 거리, cascade 별 caster 개수, draw call 개수 및 shadow pass 소요 시간 콘솔 출력
+		std::cout << "CSM: " << csm.cascadeCount() << " cascades | " << (csmLayered ? "layered (GS, 1 pass)" : "per-cascade passes")
+			<< " | lambda " << csm.splitLambda << " | splits:";
+		for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+		{
+			std::cout << " " << csm.splitDistance(c);
+		}
+		std::cout << " | casters per cascade:";
+		for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+		{
+			std::cout << " " << cascadeObjects[c];
+		}
+		std::cout << " | fit: " << (csm.stableFit ? "stable" : "tight") << " | texel size:";
+		for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+		{
+			std::cout << " " << csm.texelWorldSize(c);
+		}
+		if (shadowFilter == 0)
+		{
+			std::cout << " | PCF: " << pcfTaps * pcfTaps << " fetches (" << 4 * pcfTaps * pcfTaps << " texels)";
+		}
+		else
+		{
+			std::cout << " | " << (shadowFilter == 1 ? "VSM" : "EVSM") << ": 1 fetch, blur " << 2 * momentBlurRadius + 1 << "x" << 2 * momentBlurRadius + 1
+				<< ", bleed reduction " << lightBleedReduction << ", aniso " << momentMap.maxAnisotropy() << "x";
+		}
+		if (shadowCaching)
+		{
+			std::cout << " | cache: static re-rendered " << staticRerendered << "/" << csm.cascadeCount()
+				<< " (total " << shadowCache.staticRenderCount() << ")";
+		}
+		else
+		{
+			std::cout << " | cache: off";
+		}
+		std::cout << " | draw calls: " << shadowDrawCalls << " | shadow pass: " << shadowTimer.elapsedMs() << " ms"
+			<< " | moment pass: " << momentTimer.elapsedMs() << " ms | lighting pass: " << lightingTimer.elapsedMs() << " ms" << std::endl;
+
 
 		/* 이후 Pass 부터는 실제 스크린에 렌더링하므로, 뷰포트 영역 사이즈 복구 */
 
@@ -382,11 +705,29 @@ int main()
 		// 카메라 위치값 쉐이더 객체에 전송
 		shader.setVec3("viewPos", camera.Position);
 
-		// 광원 위치값 쉐이더 객체에 전송
-		shader.setVec3("lightPos", lightPos);
-
-		// First Pass 렌더링 시 계산해뒀던 lightSpaceMatrix 를 쉐이더 프로그램에 전송
-		shader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
+		// 조명 방향 쉐이더 객체에 전송
+		shader.setVec3("lightDir", lightDir);
+
+		// First Pass 렌더링 시 계산해뒀던 cascade 별 light space 행렬 및 cascade 정보를 쉐이더 프로그램에 전송
+		for (unsigned int c = 0; c < csm.cascadeCount(); c++)
+		{
+			std::string index = "[" + std::to_string(c) + "]";
+			shader.setMat4("lightSpaceMatrices" + index, csm.lightSpaceMatrix(c));
+			shader.setFloat("cascadeSplits" + index, csm.splitDistance(c));
+			shader.setFloat("cascadeTexelSizes" + index, csm.texelWorldSize(c));
+			shader.setFloat("cascadeDepthRanges" + index, csm.depthRange(c));
+		}
+		shader.setInt("cascadeCount", csm.cascadeCount());
+		shader.setBool("showCascades", showCascades);
+
+		// PCF fetch 횟수 전송
+		shader.setInt("pcfTaps", pcfTaps);
+
+		// 그림자 필터링 방식 및 VSM / EVSM 파라미터 전송
+		shader.setInt("shadowFilter", shadowFilter);
+		shader.setVec2("evsmExponents", EVSM_EXPONENTS);
+		shader.setFloat("minVariance", 0.00002f);
+		shader.setFloat("lightBleedReduction", lightBleedReduction);
 
 		// diffuse map 텍스쳐 객체를 바인딩할 0번 texture unit 활성화
 		glActiveTexture(GL_TEXTURE0);
@@ -397,11 +738,17 @@ int main()
 		// shadow map 텍스쳐 객체를 바인딩할 1번 texture unit 활성화
 		glActiveTexture(GL_TEXTURE1);
 
-		// shadow map 텍스쳐 객체 바인딩
-		glBindTexture(GL_TEXTURE_2D, depthMap);
+		// cascade 별 shadow map 이 저장된 텍스쳐 배열 객체 바인딩
+		glBindTexture(GL_TEXTURE_2D_ARRAY, csm.ID);
+
+		// cascade 별 moment 텍스쳐 배열 객체를 2번 texture unit 에 바인딩
+		glActiveTexture(GL_TEXTURE2);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, momentMap.ID);
 
-		// 실제 화면에 보여줄 씬 렌더링
+		// 실제 화면에 보여줄 씬 렌더링 (PCF 와 VSM / EVSM 의 shading 비용을 비교할 수 있도록 GPU 소요 시간 측정)
+		lightingTimer.begin();
 		renderScene(shader);
+		lightingTimer.end();
 
 
 		/* Third Pass (shadow map 을 QuadMesh 에 시각화) -> shadow map 디버깅 안할 시 주석 처리 */
@@ -409,18 +756,19 @@ int main()
 		//// QuadMesh 렌더링에 사용할 쉐이더 객체 바인딩
 		//debugDepthQuad.use();
 
-		//// QuadMesh 에 적용할 쉐이더에 uniform 변수 전송
-		//debugDepthQuad.setFloat("near_plane", near_plane);
-		//debugDepthQuad.setFloat("far_plane", far_plane);
+		//// QuadMesh 에 적용할 쉐이더에 시각화할 cascade 의 layer 인덱스 전송 (cascade 는 직교 투영이므로 깊이값 선형화가 필요 없음)
+		//debugDepthQuad.setInt("layer", 0);
 
 		//// shadow map 텍스쳐 객체를 바인딩할 0번 texture unit 활성화
 		//glActiveTexture(GL_TEXTURE0);
 
-		//// shadow map 텍스쳐 객체 바인딩
-		//glBindTexture(GL_TEXTURE_2D, depthMap);
+		//// cascade 별 shadow map 이 저장된 텍스쳐 배열 객체 바인딩 (깊이값을 직접 읽어야 하므로 깊이 비교 모드를 끔)
+		//csm.setCompareMode(false);
+		//glBindTexture(GL_TEXTURE_2D_ARRAY, csm.ID);
 
 		//// QuadMesh 렌더링
 		//renderQuad();
+		//csm.setCompareMode(true);
 
 
 		// Double Buffer 상에서 Back Buffer 에 픽셀들이 모두 그려지면, Front Buffer 와 교체(swap)해버림.
@@ -433,6 +781,8 @@ int main()
 	// 렌더링 루프 종료 시, 생성해 둔 VAO, VBO 객체들은 더 이상 필요가 없으므로 메모리 해제한다!
 	glDeleteVertexArrays(1, &planeVAO);
 	glDeleteBuffers(1, &planeVBO);
+	glDeleteVertexArrays(1, &planeDepthVAO);
+	glDeleteBuffers(1, &planeDepthVBO);
 
 	// while 렌더링 루프 탈출 시, GLFWwindow 종료 및 리소스 메모리 해제
 	glfwTerminate();
@@ -445,64 +795,39 @@ int main()
 
 
 /* shadow map 에 깊이 버퍼를 저장할 씬을 렌더링하는 함수 선언 */
-void renderScene(const Shader& shader)
+unsigned int renderScene(const Shader& shader, const std::vector<bool>* visible, bool positionOnly)
 {
-	/* 바닥 평면 그리기 */
-
-	// 바닥 평면에 적용할 모델행렬 초기화 (단위행렬 사용 -> 변환 x)
-	glm::mat4 model = glm::mat4(1.0f);
-
-	// 매개변수로 전달받은 쉐이더 객체에 모델행렬 전송
-	shader.setMat4("model", model);
+	unsigned int drawCalls = 0;
 
-	// 바닥 평면에 적용할 VAO 객체를 바인딩하여, 해당 객체에 저장된 VBO 객체와 설정대로 그리도록 명령
-	glBindVertexArray(planeVAO);
-
-	// 바닥 평면 그리기 명령
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-
-
-	/* 첫 번째 큐브 그리기 */
-
-	// 첫 번째 큐브에 적용할 모델행렬 계산
-	model = glm::mat4(1.0f);
-	model = glm::translate(model, glm::vec3(0.0f, 1.5f, 0.0f));
-	model = glm::scale(model, glm::vec3(0.5f));
-
-	// 매개변수로 전달받은 쉐이더 객체에 모델행렬 전송
-	shader.setMat4("model", model);
-
-	// 큐브 렌더링 함수 실행
-	renderCube();
-
-
-	/* 두 번째 큐브 그리기 */
-
-	// 두 번째 큐브에 적용할 모델행렬 계산
-	model = glm::mat4(1.0f);
-	model = glm::translate(model, glm::vec3(2.0f, 0.0f, 1.0f));
-	model = glm::scale(model, glm::vec3(0.5f));
-
-	// 매개변수로 전달받은 쉐이더 객체에 모델행렬 전송
-	shader.setMat4("model", model);
-
-	// 큐브 렌더링 함수 실행
-	renderCube();
-
-
-	/* 세 번째 큐브 그리기 */
-
-	// 세 번째 큐브에 적용할 모델행렬 계산
-	model = glm::mat4(1.0f);
-	model = glm::translate(model, glm::vec3(-1.0f, 0.0f, 2.0f));
-	model = glm::rotate(model, glm::radians(60.0f), glm::normalize(glm::vec3(1.0f, 0.0f, 1.0f)));
-	model = glm::scale(model, glm::vec3(0.25f));
-
-	// 매개변수로 전달받은 쉐이더 객체에 모델행렬 전송
-	shader.setMat4("model", model);
+	// 씬에 배치된 오브젝트 목록을 순회하며 렌더링 (visible 배열이 전달되었다면, 보이지 않는 오브젝트는 건너뜀)
+	for (unsigned int i = 0; i < sceneObjects.size(); i++)
+	{
+		if (visible != nullptr && !(*visible)[i])
+		{
+			continue;
+		}
+
+		// 매개변수로 전달받은 쉐이더 객체에 모델행렬 전송
+		shader.setMat4("model", sceneObjects[i].model);
+
+		if (sceneObjects[i].isPlane)
+		{
+			// 바닥 평면에 적용할 VAO 객체를 바인딩하여, 해당 객체에 저장된 VBO 객체와 설정대로 그리도록 명령
+			// (depth pass 라면 위치값 전용 VAO 를 바인딩)
+			glBindVertexArray(positionOnly ? planeDepthVAO : planeVAO);
+
+			// 바닥 평면 그리기 명령
+			glDrawArrays(GL_TRIANGLES, 0, 6);
+		}
+		else
+		{
+			// 큐브 렌더링 함수 실행
+			renderCube(positionOnly);
+		}
+		drawCalls++;
+	}
 
-	// 큐브 렌더링 함수 실행
-	renderCube();
+	return drawCalls;
 }
 
 
@@ -512,7 +837,11 @@ void renderScene(const Shader& shader)
 unsigned int cubeVAO = 0;
 unsigned int cubeVBO = 0;
 
-void renderCube()
+// depth pass 에서 사용할 위치값 전용 Cube VBO, VAO 객체 참조 id 전역 선언
+unsigned int cubeDepthVAO = 0;
+unsigned int cubeDepthVBO = 0;
+
+void renderCube(bool positionOnly)
 {
 	/*
 		VAO 참조 ID 가 아직 할당되지 않았을 경우,
@@ -606,12 +935,32 @@ void renderCube()
 
 		// 마찬가지로, VAO 객체도 OpenGL 컨텍스트로부터 바인딩 해제 
 		glBindVertexArray(0);
+
+		// depth pass 용 위치값 전용 VBO, VAO 생성 (바닥 평면과 같은 방식)
+		float positions[36 * 3];
+		for (unsigned int i = 0; i < 36; i++)
+		{
+			positions[i * 3 + 0] = vertices[i * 8 + 0];
+			positions[i * 3 + 1] = vertices[i * 8 + 1];
+			positions[i * 3 + 2] = vertices[i * 8 + 2];
+		}
+
+		glGenVertexArrays(1, &cubeDepthVAO);
+		glGenBuffers(1, &cubeDepthVBO);
+		glBindVertexArray(cubeDepthVAO);
+		glBindBuffer(GL_ARRAY_BUFFER, cubeDepthVBO);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(positions), positions, GL_STATIC_DRAW);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindVertexArray(0);
 	}
 
 	/* 큐브 그리기 */
 
 	// 큐브에 적용할 VAO 객체를 바인딩하여, 해당 객체에 저장된 VBO 객체와 설정대로 그리도록 명령
-	glBindVertexArray(cubeVAO);
+	// (depth pass 라면 위치값 전용 VAO 를 바인딩해서, 사용하지 않는 노멀과 uv 데이터까지 읽어오지 않도록 함)
+	glBindVertexArray(positionOnly ? cubeDepthVAO : cubeVAO);
 
 	// 큐브 그리기 명령
 	glDrawArrays(GL_TRIANGLES, 0, 36);
@@ -746,6 +1095,133 @@ void processInput(GLFWwindow* window)
 		glfwSetWindowShouldClose(window, true); // GLFWwindow 의 WindowShouldClose 플래그(상태값)을 true 로 설정 -> main() 함수의 while 조건문에서 렌더링 루프 탈출 > 렌더링 종료!
 	}
 
+	// 2, 3, 4 키 입력 시, 사용할 cascade 개수 변경
+	if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS)
+	{
+		cascadeCount = 2;
+	}
+	if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS)
+	{
+		cascadeCount = 3;
+	}
+	if (glfwGetKey(window, GLFW_KEY_4) == GLFW_PRESS)
+	{
+		cascadeCount = 4;
+	}
+
+	// [, ] 키를 누르고 있는 동안 practical split scheme 의 log 분할 비율 조절
+	if (glfwGetKey(window, GLFW_KEY_LEFT_BRACKET) == GLFW_PRESS)
+	{
+		cascadeSplitLambda = std::max(0.0f, cascadeSplitLambda - 0.5f * deltaTime);
+	}
+	if (glfwGetKey(window, GLFW_KEY_RIGHT_BRACKET) == GLFW_PRESS)
+	{
+		cascadeSplitLambda = std::min(1.0f, cascadeSplitLambda + 0.5f * deltaTime);
+	}
+
+	// L 키 입력 시, geometry shader 를 사용한 single pass 렌더링 <-> cascade 별 pass 렌더링 전환
+	if (glfwGetKey(window, GLFW_KEY_L) == GLFW_PRESS && !csmLayeredKeyPressed)
+	{
+		csmLayered = !csmLayered;
+		csmLayeredKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_L) == GLFW_RELEASE)
+	{
+		csmLayeredKeyPressed = false;
+	}
+
+	// V 키 입력 시, cascade 구간 시각화 on/off
+	if (glfwGetKey(window, GLFW_KEY_V) == GLFW_PRESS && !showCascadesKeyPressed)
+	{
+		showCascades = !showCascades;
+		showCascadesKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_V) == GLFW_RELEASE)
+	{
+		showCascadesKeyPressed = false;
+	}
+
+	// P 키 입력 시, PCF fetch 횟수 변경 (1x1 -> 2x2 -> 3x3 순환)
+	if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS && !pcfTapsKeyPressed)
+	{
+		pcfTaps = pcfTaps % 3 + 1;
+		pcfTapsKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_P) == GLFW_RELEASE)
+	{
+		pcfTapsKeyPressed = false;
+	}
+
+	// C 키 입력 시, shadow cache 사용 on/off (다시 켤 때는 꺼져 있던 동안의 변경 사항을 알 수 없으므로 캐시 전체를 다시 렌더링하도록 static 씬 버전 증가)
+	if (glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS && !shadowCachingKeyPressed)
+	{
+		shadowCaching = !shadowCaching;
+		staticSceneVersion++;
+		shadowCachingKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_C) == GLFW_RELEASE)
+	{
+		shadowCachingKeyPressed = false;
+	}
+
+	// N 키 입력 시, static 큐브 하나를 z 축 방향으로 옮김 -> static 씬이 바뀌었으므로 static 씬 버전 증가
+	if (glfwGetKey(window, GLFW_KEY_N) == GLFW_PRESS && !moveStaticKeyPressed)
+	{
+		SceneObject& movedCube = sceneObjects[2];
+		float offset = movedCube.center.z > 2.5f ? -2.0f : 0.5f;
+		movedCube.model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, offset)) * movedCube.model;
+		movedCube.center.z += offset;
+		staticSceneVersion++;
+		moveStaticKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_N) == GLFW_RELEASE)
+	{
+		moveStaticKeyPressed = false;
+	}
+
+	// E 키 입력 시, 그림자 필터링 방식 변경 (PCF -> VSM -> EVSM 순환)
+	if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS && !shadowFilterKeyPressed)
+	{
+		shadowFilter = (shadowFilter + 1) % 3;
+		shadowFilterKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_E) == GLFW_RELEASE)
+	{
+		shadowFilterKeyPressed = false;
+	}
+
+	// R 키 입력 시, moment blur 커널 반지름 변경 (1 -> 2 -> 4 순환)
+	if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS && !momentBlurRadiusKeyPressed)
+	{
+		momentBlurRadius = momentBlurRadius >= 4 ? 1 : momentBlurRadius * 2;
+		momentBlurRadiusKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_R) == GLFW_RELEASE)
+	{
+		momentBlurRadiusKeyPressed = false;
+	}
+
+	// -, = 키를 누르고 있는 동안 light bleeding 을 잘라낼 비율 조절
+	if (glfwGetKey(window, GLFW_KEY_MINUS) == GLFW_PRESS)
+	{
+		lightBleedReduction = std::max(0.0f, lightBleedReduction - 0.25f * deltaTime);
+	}
+	if (glfwGetKey(window, GLFW_KEY_EQUAL) == GLFW_PRESS)
+	{
+		lightBleedReduction = std::min(0.9f, lightBleedReduction + 0.25f * deltaTime);
+	}
+
+	// F 키 입력 시, cascade 영역 계산 방식 전환 (stable : bounding sphere + texel snapping, tight : cascade 꼭짓점 AABB)
+	if (glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS && !stableFitKeyPressed)
+	{
+		stableFit = !stableFit;
+		stableFitKeyPressed = true;
+	}
+	if (glfwGetKey(window, GLFW_KEY_F) == GLFW_RELEASE)
+	{
+		stableFitKeyPressed = false;
+	}
+
 	// 카메라 이동속도 보정 (기본 속도 2.5 가 어느 컴퓨터에서든 유지될 수 있도록 deltaTime 값으로 속도 보정)
 	float cameraSpeed = static_cast<float>(2.5 * deltaTime);
 
@@ -947,4 +1423,20 @@ unsigned int loadTexture(const char* path)
 	물론, shadow map 의 깊이값이 1.0 으로 샘플링되려면,
 	GL_TEXTURE_BORDER_COLOR 를 흰색({ 1.0, 1.0, 1.0, 1.0 })으로
 	설정하면 되겠지?
-*/
\ No newline at end of file
+*/
+
+/*
+	depth pass 용 위치값 전용 정점 버퍼
+
+
+	바닥 평면과 큐브의 정점 데이터는 위치값, 노멀, uv 가 번갈아 저장되어 있어서 정점 1개가 32 byte 인데,
+	cascade shadow map 을 렌더링하는 depth 쉐이더들(shadow_mapping_depth.vs, shadow_mapping_depth_layered.vs)은
+	그 중 위치값(12 byte)만 사용함.
+
+	stride 가 32 byte 인 버퍼로 렌더링하면 GPU 가 cache line 단위로 정점을 읽어오면서
+	사용하지 않는 노멀과 uv 까지 함께 읽어오므로,
+	위치값만 모아둔 VBO 와 0번 location 만 활성화한 VAO 를 따로 만들어서 depth pass 에서만 사용함.
+
+	cascade 마다 따로 렌더링하는 경우(csmLayered == false)에는
+	같은 오브젝트를 cascade 개수만큼 다시 그리므로, 정점 fetch 가 줄어드는 효과도 그만큼 커짐!
+*/
@@ -13,6 +13,7 @@
 
 #include "MyHeaders/shader_s.h"
 #include "MyHeaders/camera.h"
+#include "MyHeaders/render_target_registry.h"
 
 #include <iostream>
 
@@ -37,6 +38,9 @@ void processInput(GLFWwindow* window);
 const unsigned int SCR_WIDTH = 800; // 윈도우 창 너비
 const unsigned int SCR_HEIGHT = 600; // 윈도우 창 높이
 
+// 윈도우 framebuffer 크기가 바뀌면 off-screen 프레임버퍼의 render target 들을 재할당할 registry 생성 (render_target_registry.h 필기 참고)
+RenderTargetRegistry renderTargets(SCR_WIDTH, SCR_HEIGHT);
+
 // 카메라 클래스 생성 (카메라 위치값만 매개변수로 전달함.)
 Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
 
@@ -255,6 +259,12 @@ int main()
 
 	/* off-screen MSAA 지원 framebuffer 생성 및 설정 */
 
+	// high-DPI 모니터에서는 framebuffer 크기가 윈도우 크기(SCR_WIDTH * SCR_HEIGHT)와 다를 수 있으므로,
+	// render target 들을 등록하기 전에 실제 framebuffer 크기로 출력 해상도를 맞춰줌
+	int framebufferWidth, framebufferHeight;
+	glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+	renderTargets.resize(framebufferWidth, framebufferHeight);
+
 	// FBO(FrameBufferObject) 객체 생성 및 바인딩
 	unsigned int framebuffer;
 	glGenFramebuffers(1, &framebuffer);
@@ -270,7 +280,8 @@ int main()
 	// 텍스쳐 객체의 해상도는 스크린 해상도와 일치시킴 -> 왜냐? 이 텍스쳐는 '스크린 평면'에 적용할 거니까!
 	// multisampled buffer 를 지원하는 텍스쳐 객체일 경우, glTexImage2DMultisample() 함수를 이용해서 텍스쳐 메모리 할당
 	// 두 번째 매개변수는 multisampled buffer 에서 사용할 subsample 개수를 전달함.
-	glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, 4, GL_RGB, SCR_WIDTH, SCR_HEIGHT, GL_TRUE);
+	// -> registry 에 등록하면 윈도우 크기가 바뀌어도 같은 subsample 개수와 포맷으로 다시 할당해 줌
+	renderTargets.registerMultisampleTexture(textureColorBufferMultiSampled, 4, GL_RGB);
 
 	// GL_TEXTURE_2D_MULTISAMPLE 상태에 바인딩한 텍스쳐 객체 메모리 할당이 끝났으면 바인딩 해제
 	glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
@@ -288,7 +299,7 @@ int main()
 	// 단일 Renderbuffer 에 stencil 및 depth 값을 동시에 저장하는 데이터 포맷 지정 -> GL_DEPTH24_STENCIL8 
 	// multisampled buffer 를 지원하는 Renderbuffer 의 경우, glRenderbufferStorageMultisample() 함수를 이용해서 메모리 할당
 	// 또한, 텍스쳐 객체와 마찬가지로 스크린 해상도와 Renderbuffer 해상도를 일치시킴
-	glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_DEPTH24_STENCIL8, SCR_WIDTH, SCR_HEIGHT);
+	renderTargets.registerRenderbuffer(rbo, GL_DEPTH24_STENCIL8, 4);
 
 	// Renderbuffer 메모리 할당이 끝났으면 바인딩 해제
 	glBindRenderbuffer(GL_RENDERBUFFER, 0);
@@ -321,13 +332,13 @@ int main()
 	glGenTextures(1, &screenTexture);
 	glBindTexture(GL_TEXTURE_2D, screenTexture);
 
-	// 텍스쳐 객체 메모리 공간 할당
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-
 	// Texture Filtering(텍셀 필터링(보간)) 모드 설정 -> 스크린 평면은 축소/확대되지 않으므로 별로 중요 x
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
+	// 텍스쳐 객체 메모리 공간 할당 (registry 가 텍스쳐 바인딩을 해제하므로, 텍스쳐 파라미터를 먼저 설정한 뒤에 등록)
+	renderTargets.registerTexture(screenTexture, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE);
+
 	// FBO 객체에 생성한 텍스쳐 객체 attach (자세한 매개변수 설명은 LearnOpenGL 본문 참고!)
 	// off-screen framebuffer 에 렌더링 시, 텍스쳐 객체에는 최종 color buffer 만 저장하면 되므로, color attachment 만 적용 
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, screenTexture, 0);
@@ -366,8 +377,18 @@ int main()
 		// 윈도우 창 및 키 입력 감지 밎 이벤트 처리
 		processInput(window);
 
+		// 윈도우 크기 변경이 멈춘 뒤 일정 시간이 지났다면, off-screen render target 들을 새로운 framebuffer 크기로 재할당
+		if (renderTargets.update(glfwGetTime()))
+		{
+			std::cout << "render targets resized to " << renderTargets.width() << "x" << renderTargets.height()
+				<< " | " << renderTargets.targetCount() << " targets, " << renderTargets.allocatedBytes() / (1024.0 * 1024.0) << " MB"
+				<< " | reallocations: " << renderTargets.reallocationCount() << std::endl;
+		}
+
 		// off-screen MSAA 지원 framebuffer 바인딩하여, 이후의 렌더링 결과를 해당 multisampled buffer 에 저장
+		// (재할당 대기 중에는 윈도우 크기와 render target 크기가 다를 수 있으므로, 뷰포트는 render target 크기에 맞춤)
 		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glViewport(0, 0, renderTargets.width(), renderTargets.height());
 
 		// 현재까지 저장되어 있는 프레임 버퍼(그 중에서도 색상 버퍼) 초기화하기
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
@@ -385,7 +406,7 @@ int main()
 		shader.use();
 
 		// 카메라의 zoom 값으로부터 투영 행렬 계산
-		glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 1000.0f);
+		glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)renderTargets.width() / (float)renderTargets.height(), 0.1f, 1000.0f);
 
 		// 카메라 클래스로부터 뷰 행렬(= LookAt 행렬) 가져오기
 		glm::mat4 view = camera.GetViewMatrix();
@@ -419,13 +440,15 @@ int main()
 
 		// Blitting 을 수행함으로써, multisampled buffer 에 저장된 색상 버퍼가 
 		// screenTexture 텍스쳐 객체(color attachment) 로 저장됨.
-		glBlitFramebuffer(0, 0, SCR_WIDTH, SCR_HEIGHT, 0, 0, SCR_WIDTH, SCR_HEIGHT, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		glBlitFramebuffer(0, 0, renderTargets.width(), renderTargets.height(), 0, 0, renderTargets.width(), renderTargets.height(), GL_COLOR_BUFFER_BIT, GL_NEAREST);
 
 
 		/* second pass (default framebuffer 에 렌더링) */
 
-		// 스크린 평면을 렌더링할 default framebuffer 을 다시 바인딩
+		// 스크린 평면을 렌더링할 default framebuffer 을 다시 바인딩하고, 뷰포트를 현재 윈도우 framebuffer 크기로 복구
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+		glViewport(0, 0, framebufferWidth, framebufferHeight);
 
 		// default framebuffer 에는 스크린 평면만 렌더링하고, 스크린 평면의 프래그먼트가 폐기되면 안되므로, depth test 를 비활성화
 		glDisable(GL_DEPTH_TEST);
@@ -475,6 +498,9 @@ int main()
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
 	glViewport(0, 0, width, height); // GLFWwindow 상에 렌더링될 뷰포트 영역을 정의. (뷰포트 영역의 좌상단 좌표, 뷰포트 영역의 너비와 높이)
+
+	// off-screen render target 들은 곧바로 재할당하지 않고, 크기 변경이 멈춘 뒤 렌더링 루프에서 한 번만 재할당
+	renderTargets.requestResize(width, height, glfwGetTime());
 }
 
 // GLFW 윈도우에 마우스 입력 감지 시, 호출할 콜백함수 정의
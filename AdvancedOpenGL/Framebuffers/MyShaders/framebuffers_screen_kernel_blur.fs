@@ -7,46 +7,36 @@ in vec2 TexCoords;
 // off-screen framebuffer 에 attach 된 texture unit 위치값이 전달됨.
 uniform sampler2D screenTexture; 
 
-// 현재 uv 좌표를 중심으로 동서남북 방향으로 주변 텍셀들을 추가로 샘플링하기 위해,
-// 현재 uv 좌표에 각 방향으로 더해줄 offset 값 -> 주변 uv 좌표 계산에 사용
-const float offset = 1.0 / 300.0;
+/*
+  blur kernel 의 각 축 방향 샘플링 위치(texel 단위) 및 가중치
+
+  KERNEL_TAP_COUNT, KERNEL_OFFSETS, KERNEL_WEIGHTS 는
+  framebuffers.cpp 에서 컴파일 타임에 계산한 1차원 가우시안 kernel 을 #define 문자열로 변환하여 삽입해 줌.
+  (인접한 두 texel 을 1번의 bilinear 샘플링으로 합친 offset 및 가중치임. linear_gaussian_kernel.h 하단 필기 참고)
+*/
+const float offsets[KERNEL_TAP_COUNT] = KERNEL_OFFSETS;
+const float weights[KERNEL_TAP_COUNT] = KERNEL_WEIGHTS;
 
 void main() {
   /* blur kernel post-processing 적용 */
 
-  // 현재 uv 좌표 (offset 값이 vec2(0.0, 0.0) 인 것이 곧 현재 uv 좌표와 같음!)를 중심으로 
-  // 주변 uv 좌표 계산을 위해 각 방향마다 더해줄 offset 값의 정적 배열
-  vec2 offsets[9] = vec2[](
-  // 각 방향벡터 * offset
-  vec2(-offset, offset), // top-left
-  vec2(0.0, offset), // top-center
-  vec2(offset, offset), // top-right
-  vec2(-offset, 0.0),   // center-left
-  vec2(0.0, 0.0),   // center-center
-  vec2(offset, 0.0),   // center-right
-  vec2(-offset, -offset), // bottom-left
-  vec2(0.0, -offset), // bottom-center
-  vec2(offset, -offset)  // bottom-right    
-  );
-
-  // kernel (= convolution matrix) 선언 및 초기화 (관련 설명 하단 참고) -> blur kernel
-  float kernel[9] = float[](
-  // row-major
-  1.0 / 16, 2.0 / 16, 1.0 / 16, // row1
-  2.0 / 16, 4.0 / 16, 2.0 / 16, // row2
-  1.0 / 16, 2.0 / 16, 1.0 / 16  // row3
-  );
-
-  // 현재 텍셀과 그 주변 텍셀들을 샘플링하여 저장할 동적 배열
-  vec3 sampleTex[9];
-  for(int i = 0; i < 9; i++) {
-    sampleTex[i] = vec3(texture2D(screenTexture, TexCoords + offsets[i]));
-  }
+  // 단일 texel 사이즈
+  // (인접한 texel 사이를 bilinear 샘플링해야 하므로, 고정된 uv offset 대신 texel 단위로 offset 을 계산함)
+  vec2 texelSize = 1.0 / vec2(textureSize(screenTexture, 0));
+
+  /*
+    가우시안 kernel 은 2차원 가중치가 (x 축 가중치 * y 축 가중치) 로 분리되므로,
+    x, y 축의 bilinear tap 을 조합하여 샘플링하면
+    하나의 bilinear 샘플링이 2*2 texel 의 가중 평균을 한꺼번에 계산해 줌.
 
-  // 샘플링한 텍셀들에 가중치(kernel)를 적용하여 합산(convolution)
+    -> (2 * radius + 1)^2 개의 texel 을 (radius + 1)^2 번의 샘플링만으로 convolution
+  */
   vec3 col = vec3(0.0);
-  for(int i = 0; i < 9; i++) {
-    col += sampleTex[i] * kernel[i];
+  for(int y = 0; y < KERNEL_TAP_COUNT; y++) {
+    for(int x = 0; x < KERNEL_TAP_COUNT; x++) {
+      vec2 offset = vec2(offsets[x], offsets[y]) * texelSize;
+      col += texture(screenTexture, TexCoords + offset).rgb * weights[x] * weights[y];
+    }
   }
 
   FragColor = vec4(col, 1.0);
@@ -12,6 +12,8 @@
 
 #include "MyHeaders/shader_s.h"
 #include "MyHeaders/camera.h"
+#include "MyHeaders/render_target_registry.h"
+#include "MyHeaders/linear_gaussian_kernel.h"
 
 #include <iostream>
 
@@ -27,6 +29,12 @@ unsigned int loadTexture(const char* path); // 텍스쳐 이미지 로드 및 
 const unsigned int SCR_WIDTH = 800; // 윈도우 창 너비
 const unsigned int SCR_HEIGHT = 600; // 윈도우 창 높이
 
+// 윈도우 framebuffer 크기가 바뀌면 off-screen 프레임버퍼의 render target 들을 재할당할 registry 생성 (render_target_registry.h 필기 참고)
+RenderTargetRegistry renderTargets(SCR_WIDTH, SCR_HEIGHT);
+
+// blur kernel post-processing 에 사용할 반경 3 (7*7) 가우시안 kernel 을 컴파일 타임에 계산
+constexpr LinearGaussianKernel screenBlurKernel = makeLinearGaussianKernel(1.5f, 3);
+
 // 카메라 클래스 생성 (카메라 위치값만 매개변수로 전달함.)
 Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
 
@@ -105,7 +113,7 @@ int main()
 	//Shader screenShader("MyShaders/framebuffers_screen.vs", "MyShaders/framebuffers_screen_inversion.fs");
 	//Shader screenShader("MyShaders/framebuffers_screen.vs", "MyShaders/framebuffers_screen_grayscale.fs");
 	//Shader screenShader("MyShaders/framebuffers_screen.vs", "MyShaders/framebuffers_screen_kernel_sharpen.fs");
-	//Shader screenShader("MyShaders/framebuffers_screen.vs", "MyShaders/framebuffers_screen_kernel_blur.fs");
+	//Shader screenShader("MyShaders/framebuffers_screen.vs", "MyShaders/framebuffers_screen_kernel_blur.fs", linearGaussianDefines(screenBlurKernel)); // blur kernel 은 #define 문자열을 삽입해줘야 함
 	Shader screenShader("MyShaders/framebuffers_screen.vs", "MyShaders/framebuffers_screen_kernel_edge_detection.fs");
 
 	// 큐브의 정점 데이터 배열 초기화
@@ -271,6 +279,12 @@ int main()
 
 	/* off-screen framebuffer 생성 및 설정 */
 
+	// high-DPI 모니터에서는 framebuffer 크기가 윈도우 크기(SCR_WIDTH * SCR_HEIGHT)와 다를 수 있으므로,
+	// render target 들을 등록하기 전에 실제 framebuffer 크기로 출력 해상도를 맞춰줌
+	int framebufferWidth, framebufferHeight;
+	glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+	renderTargets.resize(framebufferWidth, framebufferHeight);
+
 	// FBO(FrameBufferObject) 객체 생성 및 바인딩
 	unsigned int framebuffer;
 	glGenFramebuffers(1, &framebuffer);
@@ -281,14 +295,15 @@ int main()
 	glGenTextures(1, &textureColorBuffer);
 	glBindTexture(GL_TEXTURE_2D, textureColorBuffer);
 
-	// 텍스쳐 객체 메모리 공간 할당 (loadTexture() 와 달리 할당된 메모리에 이미지 데이터를 덮어쓰지 않음! -> 대신 FBO 에서 렌더링된 데이터를 덮어쓸 거니까!)
-	// 텍스쳐 객체의 해상도는 스크린 해상도와 일치시킴 -> 왜냐? 이 텍스쳐는 '스크린 평면'에 적용할 거니까!
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-
 	// Texture Filtering(텍셀 필터링(보간)) 모드 설정 -> 스크린 평면은 축소/확대되지 않으므로 별로 중요 x
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
+	// 텍스쳐 객체 메모리 공간 할당 (loadTexture() 와 달리 할당된 메모리에 이미지 데이터를 덮어쓰지 않음! -> 대신 FBO 에서 렌더링된 데이터를 덮어쓸 거니까!)
+	// 텍스쳐 객체의 해상도는 스크린 해상도와 일치시킴 -> 왜냐? 이 텍스쳐는 '스크린 평면'에 적용할 거니까!
+	// -> registry 에 등록하면 윈도우 크기가 바뀌어도 같은 포맷으로 다시 할당해 줌 (registry 가 텍스쳐 바인딩을 해제하므로, 텍스쳐 파라미터를 먼저 설정한 뒤에 등록)
+	renderTargets.registerTexture(textureColorBuffer, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE);
+
 	// FBO 객체에 생성한 텍스쳐 객체 attach (자세한 매개변수 설명은 LearnOpenGL 본문 참고!)
 	// off-screen framebuffer 에 렌더링 시, 텍스쳐 객체에는 최종 color buffer 만 저장하면 되므로, color attachment 만 적용함! (attachment 관련 설명 하단 참고)
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureColorBuffer, 0);
@@ -301,8 +316,8 @@ int main()
 	// RBO 객체 메모리 공간 할당
 	// 단일 Renderbuffer 에 stencil 및 depth 값을 동시에 저장하는 데이터 포맷 지정 -> GL_DEPTH24_STENCIL8 
 	// (프래그먼트당 32 bits 데이터를 저장하되, 이 중에서 24 bits 는 depth 값을 저장하고, 나머지 8 bits 는 stencil 값을 저장하는 데이터 포맷!)
-	// 또한, 텍스쳐 객체와 마찬가지로 스크린 해상도와 Renderbuffer 해상도를 일치시킴 -> 그래야 SCR_WIDTH * SCR_HEIGHT 개수 만큼의 데이터 저장 공간 확보 가능!
-	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, SCR_WIDTH, SCR_HEIGHT);
+	// 또한, 텍스쳐 객체와 마찬가지로 스크린 해상도와 Renderbuffer 해상도를 일치시킴 -> 그래야 스크린 pixel 개수 만큼의 데이터 저장 공간 확보 가능!
+	renderTargets.registerRenderbuffer(rbo, GL_DEPTH24_STENCIL8);
 
 	// FBO 객체에 생성한 RBO 객체 attach (자세한 매개변수 설명은 LearnOpenGL 본문 참고!)
 	// off-screen framebuffer 에 렌더링 시, RBO 객체에는 stencil 및 depth buffer 를 저장할 것이므로, GL_DEPTH_STENCIL_ATTACHMENT 를 적용함!
@@ -332,6 +347,14 @@ int main()
 
 		processInput(window); // 윈도우 창 및 키 입력 감지 밎 이벤트 처리
 
+		// 윈도우 크기 변경이 멈춘 뒤 일정 시간이 지났다면, off-screen render target 들을 새로운 framebuffer 크기로 재할당
+		if (renderTargets.update(glfwGetTime()))
+		{
+			std::cout << "render targets resized to " << renderTargets.width() << "x" << renderTargets.height()
+				<< " | " << renderTargets.targetCount() << " targets, " << renderTargets.allocatedBytes() / (1024.0 * 1024.0) << " MB"
+				<< " | reallocations: " << renderTargets.reallocationCount() << std::endl;
+		}
+
 
 		/* 여기서부터 루프에서 실행시킬 모든 렌더링 명령(rendering commands)을 작성함. */
 
@@ -341,7 +364,9 @@ int main()
 
 
 		// 전체 scene 을 렌더링할 off-screen framebuffer 객체 바인딩
+		// (재할당 대기 중에는 윈도우 크기와 render target 크기가 다를 수 있으므로, 뷰포트는 render target 크기에 맞춤)
 		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glViewport(0, 0, renderTargets.width(), renderTargets.height());
 
 		// 전체 scene 은 여러 개의 물체들이 렌더링되므로, depth test 활성화
 		glEnable(GL_DEPTH_TEST);
@@ -365,7 +390,7 @@ int main()
 
 		// 카메라 줌 효과를 구현하기 위해 fov 값을 실시간으로 변경해야 하므로,
 		// fov 값으로 계산되는 투영행렬을 런타임에 매번 다시 계산해서 쉐이더 프로그램으로 전송해줘야 함. > 게임 루프에서 계산 및 전송
-		glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f); // 투영 행렬 생성
+		glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)renderTargets.width() / (float)renderTargets.height(), 0.1f, 100.0f); // 투영 행렬 생성
 
 		shader.setMat4("view", view); // 현재 바인딩된 쉐이더 프로그램의 uniform 변수에 mat4 뷰 행렬 전송
 		shader.setMat4("projection", projection); // 현재 바인딩된 쉐이더 프로그램의 uniform 변수에 mat4 투영 행렬 전송
@@ -422,8 +447,10 @@ int main()
 		/* second pass (default framebuffer 에 렌더링) */
 
 
-		// 스크린 평면을 렌더링할 default framebuffer 을 다시 바인딩
+		// 스크린 평면을 렌더링할 default framebuffer 을 다시 바인딩하고, 뷰포트를 현재 윈도우 framebuffer 크기로 복구
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+		glViewport(0, 0, framebufferWidth, framebufferHeight);
 
 		// default framebuffer 에는 스크린 평면만 렌더링하고, 스크린 평면의 프래그먼트가 폐기되면 안되므로, depth test 를 비활성화
 		glDisable(GL_DEPTH_TEST);
@@ -478,6 +505,9 @@ int main()
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
 	glViewport(0, 0, width, height); // GLFWwindow 상에 렌더링될 뷰포트 영역을 정의. (뷰포트 영역의 좌상단 좌표, 뷰포트 영역의 너비와 높이)
+
+	// off-screen render target 들은 곧바로 재할당하지 않고, 크기 변경이 멈춘 뒤 렌더링 루프에서 한 번만 재할당
+	renderTargets.requestResize(width, height, glfwGetTime());
 }
 
 // GLFW 윈도우에 마우스 입력 감지 시, 호출할 콜백함수 정의
@@ -13,6 +13,7 @@
 
 #include "MyHeaders/shader_s.h"
 #include "MyHeaders/camera.h"
+#include "MyHeaders/light_buffer.h"
 
 #include <iostream>
 
@@ -189,6 +190,15 @@ int main()
 	};
 
 
+	/* 광원 데이터를 저장할 UBO 생성 (light_buffer.h 필기 참고) */
+
+	// 쉐이더의 광원 배열 크기(4개)만큼의 광원 데이터를 std140 레이아웃으로 저장할 UBO 생성 후, 0번 binding point 에 연결
+	LightBuffer lightBuffer(4, 0);
+
+	// 쉐이더의 Lights uniform block 을 UBO 와 동일한 0번 binding point 에 연결
+	lightBuffer.bindBlock(pbrShader, "Lights");
+
+
 	// 각 구체의 모델 행렬 계산 시 사용할 구체의 행 수, 열 수, 간격값 초기화
 	int nrRows = 7;
 	int nrColumns = 7;
@@ -535,6 +545,27 @@ int main()
 		glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap);
 
 
+		/* 광원 데이터 UBO 업로드 */
+
+		// 광원 데이터 개수만큼 for-loop 순회
+		for (unsigned int i = 0; i < sizeof(lightPositions) / sizeof(lightPositions[0]); ++i)
+		{
+			// 시간에 따라 각 광원을 x 축 방향으로 [-5, 5] 범위 내에서 이동시키기 위한 위치값 재계산
+			glm::vec3 newPos = lightPositions[i] + glm::vec3(std::sin(glfwGetTime() * 5.0) * 5.0, 0.0, 0.0);
+
+			// 광원 위치를 이동시키고 싶다면 아래의 기존 위치 재할당 코드 주석 처리
+			newPos = lightPositions[i];
+
+			// 광원 위치 및 색상 데이터 갱신 (실제로 값이 바뀐 광원만 dirty range 에 포함됨)
+			lightBuffer.setPosition(i, newPos);
+			lightBuffer.setColor(i, lightColors[i]);
+		}
+
+		// 변경된 광원 데이터 범위만 glBufferSubData() 1번으로 UBO 에 업로드
+		// -> 광원이 움직이지 않으면 첫 프레임 이후로는 OpenGL 호출 없이 바로 반환됨
+		lightBuffer.upload();
+
+
 		/* 각 Sphere 에 적용할 모델행렬 계산 및 Sphere 렌더링 */
 
 		// 모델행렬을 단위행렬로 초기화
@@ -579,24 +610,14 @@ int main()
 		}
 
 
-		/* 광원 정보 쉐이더 전송 및 광원 위치 시각화를 위한 구체 렌더링 */
+		/* 광원 위치 시각화를 위한 구체 렌더링 */
 
 		// 광원 데이터 개수만큼 for-loop 순회
 		for (unsigned int i = 0; i < sizeof(lightPositions) / sizeof(lightPositions[0]); ++i)
 		{
-			// 시간에 따라 각 광원을 x 축 방향으로 [-5, 5] 범위 내에서 이동시키기 위한 위치값 재계산
-			glm::vec3 newPos = lightPositions[i] + glm::vec3(std::sin(glfwGetTime() * 5.0) * 5.0, 0.0, 0.0);
-
-			// 광원 위치를 이동시키고 싶다면 아래의 기존 위치 재할당 코드 주석 처리
-			newPos = lightPositions[i];
-
-			// 광원 위치 및 색상 데이터를 쉐이더 프로그램에 전송
-			pbrShader.setVec3("lightPositions[" + std::to_string(i) + "]", newPos);
-			pbrShader.setVec3("lightColors[" + std::to_string(i) + "]", lightColors[i]);
-
-			// 광원 위치 시각화를 위해 해당 위치에 구체 렌더링
+			// 광원 위치 시각화를 위해 UBO 에 업로드한 광원 위치에 구체 렌더링
 			model = glm::mat4(1.0f);
-			model = glm::translate(model, newPos);
+			model = glm::translate(model, lightBuffer.get(i).Position);
 			model = glm::scale(model, glm::vec3(0.5f));
 			pbrShader.setMat4("model", model);
 			pbrShader.setMat3("normalMatrix", glm::transpose(glm::inverse(glm::mat3(model))));
@@ -620,6 +641,11 @@ int main()
 		renderCube();
 
 
+		// 현재 프레임에서 호출된 glUniform~() 횟수 출력 후 카운터 초기화
+		std::cout << "uniform calls: " << Shader::uniformCallCount() << std::endl;
+		Shader::uniformCallCount() = 0;
+
+
 		// Double Buffer 상에서 Back Buffer 에 픽셀들이 모두 그려지면, Front Buffer 와 교체(swap)해버림.
 		glfwSwapBuffers(window);
 
@@ -0,0 +1,195 @@
+#ifndef LIGHT_BUFFER_H
+#define LIGHT_BUFFER_H
+/*
+	light_buffer.h 헤더파일에 대한
+	헤더가드 처리를 위해 전처리기 선언
+*/
+
+#include <glad/glad.h> // 운영체제(플랫폼)별 OpenGL 함수를 함수 포인터에 저장 및 초기화 > UBO 관련 OpenGL 함수가 필요하니까!
+#include <glm/glm.hpp> // 광원 위치값 및 색상값을 glm::vec3 타입으로 다루기 위해 include
+
+#include <string> // uniform block 이름을 std::string 으로 전달받기 위해 include
+#include <vector> // 광원 데이터를 CPU 메모리에 동적 배열로 보관하기 위해 include
+#include <algorithm> // dirty range 계산 시 std::min(), std::max() 를 사용하기 위해 include
+
+#include "shader_s.h" // uniform block 을 binding point 에 연결할 Shader 객체를 전달받기 위해 include
+
+/*
+	std140 레이아웃 규칙에 맞춰 패킹한 광원 데이터 구조체 (하단 필기 참고)
+
+	쉐이더의 uniform block 안에 선언된 Light 구조체와
+	멤버 순서 및 크기가 정확히 일치해야 함!
+*/
+struct LightData
+{
+	glm::vec3 Position; // 광원 위치 (vec3 는 16 bytes 단위로 정렬되므로, 남는 4 bytes 에 Linear 를 채워넣음)
+	float Linear; // 거리에 따른 조명 감쇄 계산식에서 사용할 Linear 항의 계수
+
+	glm::vec3 Color; // 광원 색상 (마찬가지로 남는 4 bytes 에 Quadratic 을 채워넣음)
+	float Quadratic; // 거리에 따른 조명 감쇄 계산식에서 사용할 Quadratic 항의 계수
+
+	float Radius; // light volume 의 반경
+	float padding[3]; // std140 에서 구조체 크기는 16 bytes 의 배수로 올림되므로, 나머지 12 bytes 를 padding 으로 채움
+};
+
+// std140 기준 Light 구조체 크기(48 bytes)와 C++ 구조체 크기가 다르면 컴파일 타임에 에러를 발생시킴
+static_assert(sizeof(LightData) == 48, "LightData must match the std140 layout of struct Light");
+
+/*
+	LightBuffer 클래스
+
+	여러 개의 광원 데이터를 std140 레이아웃으로 패킹된 배열 형태로
+	하나의 Uniform Buffer Object(UBO) 에 저장해두고,
+
+	매 프레임 변경된 광원 데이터의 범위(dirty range)만
+	glBufferSubData() 1번으로 업로드하는 클래스!
+
+	(UBO 관련 https://github.com/jooo0922/opengl-study/blob/main/AdvancedOpenGL/Uniform_Buffer_Object/uniform_buffer_object.cpp 참고)
+*/
+class LightBuffer
+{
+public:
+	unsigned int ID; // 생성된 UBO 객체의 참조 id
+	unsigned int bindingPoint; // UBO 객체와 uniform block 을 연결할 binding point
+
+	// 생성자에서 최대 광원 개수만큼의 UBO 메모리 공간 할당 및 binding point 연결
+	LightBuffer(unsigned int maxLights, unsigned int bindingPoint)
+		: bindingPoint(bindingPoint), lights(maxLights), dirtyBegin(maxLights), dirtyEnd(0)
+	{
+		// 할당되지 않은 광원 데이터는 모두 0 으로 초기화 -> 사용하지 않는 광원은 색상이 0 이므로 조명 계산에 기여하지 않음
+		for (unsigned int i = 0; i < maxLights; i++)
+		{
+			lights[i] = LightData();
+			lights[i].Position = glm::vec3(0.0f);
+			lights[i].Linear = 0.0f;
+			lights[i].Color = glm::vec3(0.0f);
+			lights[i].Quadratic = 0.0f;
+			lights[i].Radius = 0.0f;
+		}
+
+		// UBO 객체 생성 및 최대 광원 개수만큼의 메모리 공간 할당
+		// 매 프레임 일부 데이터를 덮어쓸 것이므로, GL_DYNAMIC_DRAW 로 사용 패턴을 명시함
+		glGenBuffers(1, &ID);
+		glBindBuffer(GL_UNIFORM_BUFFER, ID);
+		glBufferData(GL_UNIFORM_BUFFER, lights.size() * sizeof(LightData), &lights[0], GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		// UBO 객체 전체 범위를 binding point 에 연결
+		glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, ID, 0, lights.size() * sizeof(LightData));
+	}
+
+	// 쉐이더 프로그램에 선언된 uniform block 을 UBO 와 동일한 binding point 에 연결
+	void bindBlock(const Shader& shader, const std::string& blockName) const
+	{
+		unsigned int blockIndex = glGetUniformBlockIndex(shader.ID, blockName.c_str());
+		glUniformBlockBinding(shader.ID, blockIndex, bindingPoint);
+	}
+
+	// 광원 위치값 변경 (실제로 값이 바뀌었을 때만 dirty range 에 포함시킴)
+	void setPosition(unsigned int index, const glm::vec3& position)
+	{
+		if (lights[index].Position != position)
+		{
+			lights[index].Position = position;
+			markDirty(index);
+		}
+	}
+
+	// 광원 색상값 변경
+	void setColor(unsigned int index, const glm::vec3& color)
+	{
+		if (lights[index].Color != color)
+		{
+			lights[index].Color = color;
+			markDirty(index);
+		}
+	}
+
+	// 감쇄 계산식 계수 및 light volume 반경 변경
+	void setAttenuation(unsigned int index, float linear, float quadratic, float radius)
+	{
+		if (lights[index].Linear != linear || lights[index].Quadratic != quadratic || lights[index].Radius != radius)
+		{
+			lights[index].Linear = linear;
+			lights[index].Quadratic = quadratic;
+			lights[index].Radius = radius;
+			markDirty(index);
+		}
+	}
+
+	// 현재 프레임에서 변경된 광원들의 범위 [dirtyBegin, dirtyEnd) 만 glBufferSubData() 1번으로 UBO 에 업로드
+	// 업로드한 byte 수를 반환 (변경된 광원이 없으면 OpenGL 호출 없이 0 반환)
+	unsigned int upload()
+	{
+		if (dirtyBegin >= dirtyEnd)
+		{
+			return 0;
+		}
+
+		// 변경된 광원들의 시작 offset 및 크기 계산
+		// (LightData 가 16 bytes 의 배수 크기이므로, 각 광원의 offset 도 항상 std140 정렬 규칙을 만족함)
+		GLintptr offset = dirtyBegin * sizeof(LightData);
+		GLsizeiptr size = (dirtyEnd - dirtyBegin) * sizeof(LightData);
+
+		glBindBuffer(GL_UNIFORM_BUFFER, ID);
+		glBufferSubData(GL_UNIFORM_BUFFER, offset, size, &lights[dirtyBegin]);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		// dirty range 초기화
+		dirtyBegin = (unsigned int)lights.size();
+		dirtyEnd = 0;
+
+		return (unsigned int)size;
+	}
+
+	// CPU 메모리에 보관중인 광원 데이터 읽기
+	const LightData& get(unsigned int index) const
+	{
+		return lights[index];
+	}
+
+	// 최대 광원 개수 반환
+	unsigned int size() const
+	{
+		return (unsigned int)lights.size();
+	}
+
+private:
+	std::vector<LightData> lights; // UBO 에 업로드할 광원 데이터를 CPU 메모리에 보관하는 동적 배열
+	unsigned int dirtyBegin; // 변경된 광원 인덱스 범위의 시작 (포함)
+	unsigned int dirtyEnd; // 변경된 광원 인덱스 범위의 끝 (미포함)
+
+	// 변경된 광원 인덱스를 포함하도록 dirty range 를 확장
+	void markDirty(unsigned int index)
+	{
+		dirtyBegin = std::min(dirtyBegin, index);
+		dirtyEnd = std::max(dirtyEnd, index + 1);
+	}
+};
+
+
+#endif // !LIGHT_BUFFER_H
+
+/*
+	std140 레이아웃으로 광원 데이터 패킹하기
+
+
+	기존에는 "lights[" + std::to_string(i) + "].Position" 처럼
+	uniform 변수명 문자열을 매 프레임 만들어서,
+
+	광원 개수 * 멤버 개수만큼 glGetUniformLocation() + glUniform~() 을
+	호출해야 했음. (광원 32개 * 멤버 5개 = 160번!)
+
+
+	반면, 광원 데이터를 하나의 UBO 에 배열로 저장해두면,
+	쉐이더는 uniform block 안의 배열을 그대로 인덱싱해서 읽을 수 있고,
+	CPU 는 변경된 광원 범위만 glBufferSubData() 1번으로 덮어쓰면 됨.
+
+
+	이때, std140 규칙상 vec3 는 vec4 와 같은 16 bytes 단위로 정렬되므로,
+	vec3 바로 뒤에 float 를 선언하면 vec3 의 남는 4 bytes 자리에 채워짐.
+
+	또한, 구조체 배열의 각 요소 크기는 16 bytes 의 배수로 올림되므로,
+	Position(12) + Linear(4) + Color(12) + Quadratic(4) + Radius(4) = 36 bytes 를
+	48 bytes 로 맞추기 위해 padding 을 추가한 것!
+*/
@@ -24,9 +24,22 @@ uniform samplerCube prefilterMap;
 // specular term 에 대한 split-sum approximation 의 두 번째 적분식 계산 결과가 저장된 2D LUT 텍스쳐(= BRDF Integration map) 선언
 uniform sampler2D brdfLUT;
 
-// 광원 정보를 전송받는 uniform 변수 선언
-uniform vec3 lightPositions[4];
-uniform vec3 lightColors[4];
+// 광원 정보를 저장하는 구조체 선언
+// -> C++ 의 LightData 구조체와 멤버 순서가 일치하도록 std140 레이아웃 기준으로 선언 (light_buffer.h 필기 참고)
+struct Light {
+  vec3 Position; // 광원 위치
+  float Linear; // 거리에 따른 감쇄 계수 (PBR 에서는 역제곱 법칙으로 감쇄시키므로 사용하지 않음)
+
+  vec3 Color; // 광원 색상
+  float Quadratic; // 거리에 따른 감쇄 계수 (사용하지 않음)
+
+  float Radius; // light volume 의 반경 (사용하지 않음)
+};
+
+// 4개의 광원 정보를 UBO 로부터 전송받는 uniform block 선언
+layout(std140) uniform Lights {
+  Light lights[4];
+};
 
 // 카메라 위치값을 전송받는 uniform 변수 선언
 uniform vec3 camPos;
@@ -218,19 +231,19 @@ void main() {
     /* 각 direct lighting(직접광)이 방출하는 radiance(즉, 렌더링 방정식의 Li) 근사 */
 
     // 각 광원으로부터 들어오는 조명 벡터(Wi) 계산
-    vec3 L = normalize(lightPositions[i] - WorldPos);
+    vec3 L = normalize(lights[i].Position - WorldPos);
 
     // 조명 벡터(Wi)와 뷰 벡터(Wo) 사이의 하프 벡터 계산
     vec3 H = normalize(V + L);
 
     // 각 직접광과 surface point(p) 사이의 거리 계산
-    float distance = length(lightPositions[i] - WorldPos);
+    float distance = length(lights[i].Position - WorldPos);
 
     // 각 직접광과의 거리의 제곱에 반비례하는 감쇄 성분 계산
     float attenuation = 1.0 / (distance * distance);
 
     // 각 직접광에서 방사되는 radiance 계산
-    vec3 radiance = lightColors[i] * attenuation;
+    vec3 radiance = lights[i].Color * attenuation;
 
     /* Cook-Torrance BRDF 계산 */
 
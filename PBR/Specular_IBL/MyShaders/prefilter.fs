@@ -12,6 +12,12 @@ uniform samplerCube environmentMap;
 // mip level 에 따라 5단계로 나누어져 전송될 roughness 값
 uniform float roughness;
 
+// Monte Carlo 적분의 샘플링 개수 (기준(reference) 결과는 1024 개, filtered importance sampling 모드는 32 ~ 64 개)
+uniform int sampleCount;
+
+// 원본 HDR 큐브맵에서 fetch 할 mip level 에 더해줄 bias (샘플 개수가 적을 때 aliasing 을 줄이기 위해 사용 -> 하단 필기 참고)
+uniform float lodBias;
+
 // PI 상수값 정의
 const float PI = 3.14159265359;
 
@@ -140,8 +146,8 @@ void main() {
 
   /* surface point P 지점에서 specular lobe 영역으로 반사되는 빛들의 총합을 Monte Carlo 적분으로 계산 */
 
-  // Monte Carlo 적분의 샘플링 개수를 uint 상수값으로 정의
-  const uint SAMPLE_COUNT = 1024u;
+  // Monte Carlo 적분의 샘플링 개수를 uint 값으로 변환
+  uint SAMPLE_COUNT = uint(sampleCount);
 
   // split sum approximation 의 첫 번째 적분식을 계산할 때, 결과값을 누산할 변수 초기화 (노션 IBL 관련 필기 참고)
   vec3 prefilteredColor = vec3(0.0);
@@ -199,7 +205,7 @@ void main() {
         원본 HDR 큐브맵으로부터 어느 정도의 해상도를 갖는 mipmap 을 샘플링할 것인지 결정
         (노션 IBL 필기 참고)
       */
-      float mipLevel = roughness == 0.0 ? 0.0 : 0.5 * log2(saSample / saTexel);
+      float mipLevel = roughness == 0.0 ? 0.0 : 0.5 * log2(saSample / saTexel) + lodBias;
 
       /*
         원본 HDR 큐브맵으로부터 샘플링해온 값,
@@ -265,3 +271,21 @@ void main() {
   world space 로 변환된 Tangent, Bitangent, Normal
   기저 축을 열 벡터로 꽂아넣은 행렬이잖아!
 */
+
+/*
+  Filtered Importance Sampling (PDF 기반 mip level 선택)
+
+
+  샘플 1개가 대표하는 입체각 saSample = 1 / (N * pdf) 는 샘플 개수 N 이 줄어들수록 커지므로,
+  원본 HDR 큐브맵을 그만큼 더 흐릿한(== 미리 평균내둔) mip level 에서 fetch 하면,
+  각 샘플이 자기 주변 입체각의 평균 radiance 를 가져오게 되어 적은 샘플로도 노이즈 없이 적분할 수 있음.
+
+  -> 즉, 적분의 일부를 glGenerateMipmap() 으로 미리 만들어둔 mipmap 이 대신 처리해주는 셈!
+
+  그래서 1024 개의 샘플을 32 ~ 64 개로 줄여도 결과가 크게 달라지지 않으며,
+  샘플 개수가 적을수록 인접한 샘플이 덮는 영역 사이에 틈이 생겨 aliasing 이 보일 수 있으므로,
+  mip level 에 1 정도의 bias 를 더해서 한 단계 더 흐릿한 mipmap 을 사용하는 것이 일반적임.
+
+  참고로 roughness 가 0 인 mip 0 은 모든 샘플의 방향이 N 으로 같으므로 적분할 필요가 없어서,
+  쉐이더를 실행하지 않고 원본 HDR 큐브맵의 같은 해상도 mipmap 을 그대로 복사(blit)함.
+*/
@@ -13,8 +13,11 @@
 
 #include "MyHeaders/shader_s.h"
 #include "MyHeaders/camera.h"
+#include "MyHeaders/light_buffer.h"
 
 #include <iostream>
+#include <vector>
+#include <cmath>
 
 
 /* 콜백함수 전방선언 */
@@ -43,6 +46,15 @@ void renderCube();
 // QuadMesh 렌더링 함수 선언
 void renderQuad();
 
+// pre-filtered env map bake 함수 선언 (소요 시간(ms) 반환)
+float bakePrefilterMap(Shader& prefilterShader, unsigned int prefilterMap, unsigned int envCubemap, unsigned int captureFBO, unsigned int captureRBO, const glm::mat4& captureProjection, const glm::mat4* captureViews, bool filteredImportanceSampling);
+
+// 원본 HDR 큐브맵을 pre-filtered env map 의 mip 0 에 복사하는 함수 선언
+void copyEnvironmentToPrefilterMip0(unsigned int envCubemap, unsigned int prefilterMap, unsigned int readFBO, unsigned int drawFBO, unsigned int captureFBO);
+
+// 두 pre-filtered env map 의 mip level 별 오차 출력 함수 선언
+void comparePrefilterMaps(unsigned int referenceMap, unsigned int testMap);
+
 
 // 윈도우 창 생성 옵션
 // 너비와 높이는 음수가 없으므로, 부호가 없는 정수형 타입으로 심볼릭 상수 지정 (가급적 전역변수 사용 자제...)
@@ -63,6 +75,16 @@ bool firstMouse = true;
 float deltaTime = 0.0f; // 마지막에 그려진 프레임 ~ 현재 프레임 사이의 시간 간격
 float lastFrame = 0.0f; // 마지막에 그려진 프레임의 ElapsedTime(경과시간)
 
+// pre-filtered env map 의 mip level 개수 (roughness 0, 0.25, 0.5, 0.75, 1.0)
+const unsigned int PREFILTER_MIP_LEVELS = 5;
+
+// filtered importance sampling 모드에서 mip 1 부터 mip level 별로 사용할 샘플 개수 (mip 0 은 쉐이더로 적분하지 않고 복사하므로 제외)
+const int FIS_SAMPLE_COUNTS[PREFILTER_MIP_LEVELS - 1] = { 32, 48, 64, 64 };
+
+// 렌더링에 filtered importance sampling 결과를 사용할 지 여부 (F 키로 기준 결과와 번갈아 비교)
+bool useFilteredPrefilter = true;
+bool filteredPrefilterKeyPressed = false;
+
 int main()
 {
 	// GLFW 초기화
@@ -212,6 +234,15 @@ int main()
 	};
 
 
+	/* 광원 데이터를 저장할 UBO 생성 (light_buffer.h 필기 참고) */
+
+	// 쉐이더의 광원 배열 크기(4개)만큼의 광원 데이터를 std140 레이아웃으로 저장할 UBO 생성 후, 0번 binding point 에 연결
+	LightBuffer lightBuffer(4, 0);
+
+	// 쉐이더의 Lights uniform block 을 UBO 와 동일한 0번 binding point 에 연결
+	lightBuffer.bindBlock(pbrShader, "Lights");
+
+
 	// 각 구체의 모델 행렬 계산 시 사용할 구체의 행 수, 열 수, 간격값 초기화
 	int nrRows = 7;
 	int nrColumns = 7;
@@ -531,80 +562,37 @@ int main()
 	glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
 
-	/* prefilterShader 에 텍스쳐 및 행렬 전달 */
-
-	// prefilterShader 쉐이더 바인딩
-	prefilterShader.use();
-
-	// HDR 큐브맵 텍스쳐를 바인딩할 0번 texture unit 위치값 전송
-	prefilterShader.setInt("environmentMap", 0);
-
-	// fov(시야각)이 90로 고정된 투영행렬 전송
-	prefilterShader.setMat4("projection", captureProjection);
-
-	// HDR 큐브맵 텍스쳐를 바인딩할 0번 texture unit 활성화
-	glActiveTexture(GL_TEXTURE0);
-
-	// 0번 texture unit 에 HDR 큐브맵 텍스쳐 바인딩
-	glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
-
-
-	/* 렌더링 루프 진입 이전에 Cubemap 버퍼에 각 mip level 마다 pre-filtered env map 렌더링 */
-
-	// Cubemap 버퍼의 각 면을 attach 할 FBO 객체 바인딩
-	glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-
-	// 최대 mip level 변수 초기화
-	unsigned int maxMipLevels = 5;
-
-	// 각 mip level 을 순회하며 Cubemap 버퍼에 pre-filtered env map 렌더링
-	for (unsigned int mip = 0; mip < maxMipLevels; mip++)
+	/*
+		filtered importance sampling 결과를 저장할 Cubemap 텍스쳐 객체 생성
+		-> 기준(reference) 결과인 prefilterMap 과 비교할 수 있도록 같은 해상도 및 설정으로 하나 더 만듦.
+	*/
+	unsigned int fisPrefilterMap;
+	glGenTextures(1, &fisPrefilterMap);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, fisPrefilterMap);
+	for (unsigned int i = 0; i < 6; i++)
 	{
-		/*
-			각 mip level 에 따라 128^(1 / 2^n) 형태로
-			mipmap 의 최대 해상도 128 의 2^n 번째 거듭제곱근을 계산하여
-			각 mip level 에서 사용할 프레임버퍼와 viewport 의 해상도를 결정함.
-		*/
-		unsigned int mipWidth = 128 * std::pow(0.5, mip);
-		unsigned int mipHeight = 128 * std::pow(0.5, mip);
-		
-		// pre-filtered env map 을 렌더링할 때 사용할 RBO 객체 바인딩
-		glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
-
-		// RBO 객체 메모리 공간 할당 -> 단일 Renderbuffer 에 depth 값만 저장하는 데이터 포맷 지정(GL_DEPTH_COMPONENT24)
-		// Renderbuffer 해상도를 각 mipmap 의 해상도로 맞춤.
-		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mipWidth, mipHeight);
-
-		// Cubemap 버퍼의 각 면의 해상도를 각 mipmap 의 해상도로 맞춰 viewport 해상도 설정
-		glViewport(0, 0, mipWidth, mipHeight);
+		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 128, 128, 0, GL_RGB, GL_FLOAT, nullptr);
+	}
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
-		/*
-			각 mip level 에 따라 prefilterShader 쉐이더 객체에 전송할 [0.0, 1.0] 사이의 roughness 값 계산
-			-> mip level 이 높을수록 mipmap 의 해상도가 줄어들기 때문에, roughness 값이 그만큼 커지도록 계산함.
-		*/
-		float roughness = (float)mip / (float)(maxMipLevels - 1);
-		prefilterShader.setFloat("roughness", roughness);
 
-		// pre-filtered env map 을 렌더링할 단위 큐브의 각 면을 바라보도록 카메라를 회전시키며 6번 렌더링
-		for (unsigned int i = 0; i < 6; i++)
-		{
-			// 쉐이더 객체에 단위 큐브의 각 면을 바라보도록 계산하는 뷰 행렬 전송
-			prefilterShader.setMat4("view", captureViews[i]);
+	/* 렌더링 루프 진입 이전에 두 가지 방식으로 pre-filtered env map 을 bake 하고, 소요 시간 및 오차 비교 */
 
-			// Cubemap 버퍼의 각 면을 현재 바인딩된 FBO 객체에 돌아가며 attach
-			// glFramebufferTexture2D() 의 마지막 매개변수는 현재 바인딩된 프레임버퍼에 attach 할 Cubemap 의 mip level 을 전달함.
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, prefilterMap, mip);
+	// 기준 결과 : mip level 마다 1024 개의 GGX 샘플로 적분
+	float referenceBakeMs = bakePrefilterMap(prefilterShader, prefilterMap, envCubemap, captureFBO, captureRBO, captureProjection, captureViews, false);
 
-			// 단위 큐브를 attach 된 Cubemap 버퍼에 렌더링하기 전, 색상 버퍼와 깊이 버퍼를 깨끗하게 비워줌
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	// filtered importance sampling : mip 0 은 원본 HDR 큐브맵에서 복사하고, 나머지는 32 ~ 64 개의 샘플로 적분
+	float filteredBakeMs = bakePrefilterMap(prefilterShader, fisPrefilterMap, envCubemap, captureFBO, captureRBO, captureProjection, captureViews, true);
 
-			// 단위 큐브 렌더링 -> prefilterShader 에서 split sum approximation 의 첫 번째 적분식의 결과값을 풀어 Cubemap 버퍼에 저장함.
-			renderCube();
-		}
-	}
+	std::cout << "prefilter bake: reference " << referenceBakeMs << " ms, filtered importance sampling " << filteredBakeMs << " ms" << std::endl;
 
-	// Cubemap 버퍼에 렌더링 완료 후, 기본 프레임버퍼로 바인딩 초기화
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	// mip level 별로 기준 결과 대비 오차 출력
+	comparePrefilterMaps(prefilterMap, fisPrefilterMap);
 
 
 	/*
@@ -761,8 +749,8 @@ int main()
 		// pre-filtered env map 이 렌더링된 큐브맵 텍스쳐를 바인딩할 1번 texture unit 활성화
 		glActiveTexture(GL_TEXTURE1);
 
-		// prefilterMap 큐브맵 텍스쳐 바인딩
-		glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
+		// prefilterMap 큐브맵 텍스쳐 바인딩 (F 키로 기준 결과와 filtered importance sampling 결과 전환)
+		glBindTexture(GL_TEXTURE_CUBE_MAP, useFilteredPrefilter ? fisPrefilterMap : prefilterMap);
 
 
 		/* 미리 계산된 split-sum approximation 의 두 번째 적분식 결과값이 저장되어 있는 BRDF Integration map 을 바인딩 */
@@ -774,6 +762,27 @@ int main()
 		glBindTexture(GL_TEXTURE_2D, brdfLUTTexture);
 
 
+		/* 광원 데이터 UBO 업로드 */
+
+		// 광원 데이터 개수만큼 for-loop 순회
+		for (unsigned int i = 0; i < sizeof(lightPositions) / sizeof(lightPositions[0]); ++i)
+		{
+			// 시간에 따라 각 광원을 x 축 방향으로 [-5, 5] 범위 내에서 이동시키기 위한 위치값 재계산
+			glm::vec3 newPos = lightPositions[i] + glm::vec3(std::sin(glfwGetTime() * 5.0) * 5.0, 0.0, 0.0);
+
+			// 광원 위치를 이동시키고 싶다면 아래의 기존 위치 재할당 코드 주석 처리
+			newPos = lightPositions[i];
+
+			// 광원 위치 및 색상 데이터 갱신 (실제로 값이 바뀐 광원만 dirty range 에 포함됨)
+			lightBuffer.setPosition(i, newPos);
+			lightBuffer.setColor(i, lightColors[i]);
+		}
+
+		// 변경된 광원 데이터 범위만 glBufferSubData() 1번으로 UBO 에 업로드
+		// -> 광원이 움직이지 않으면 첫 프레임 이후로는 OpenGL 호출 없이 바로 반환됨
+		lightBuffer.upload();
+
+
 		/* 각 Sphere 에 적용할 모델행렬 계산 및 Sphere 렌더링 */
 
 		// 모델행렬을 단위행렬로 초기화
@@ -818,24 +827,14 @@ int main()
 		}
 
 
-		/* 광원 정보 쉐이더 전송 및 광원 위치 시각화를 위한 구체 렌더링 */
+		/* 광원 위치 시각화를 위한 구체 렌더링 */
 
 		// 광원 데이터 개수만큼 for-loop 순회
 		for (unsigned int i = 0; i < sizeof(lightPositions) / sizeof(lightPositions[0]); ++i)
 		{
-			// 시간에 따라 각 광원을 x 축 방향으로 [-5, 5] 범위 내에서 이동시키기 위한 위치값 재계산
-			glm::vec3 newPos = lightPositions[i] + glm::vec3(std::sin(glfwGetTime() * 5.0) * 5.0, 0.0, 0.0);
-
-			// 광원 위치를 이동시키고 싶다면 아래의 기존 위치 재할당 코드 주석 처리
-			newPos = lightPositions[i];
-
-			// 광원 위치 및 색상 데이터를 쉐이더 프로그램에 전송
-			pbrShader.setVec3("lightPositions[" + std::to_string(i) + "]", newPos);
-			pbrShader.setVec3("lightColors[" + std::to_string(i) + "]", lightColors[i]);
-
-			// 광원 위치 시각화를 위해 해당 위치에 구체 렌더링
+			// 광원 위치 시각화를 위해 UBO 에 업로드한 광원 위치에 구체 렌더링
 			model = glm::mat4(1.0f);
-			model = glm::translate(model, newPos);
+			model = glm::translate(model, lightBuffer.get(i).Position);
 			model = glm::scale(model, glm::vec3(0.5f));
 			pbrShader.setMat4("model", model);
 			pbrShader.setMat3("normalMatrix", glm::transpose(glm::inverse(glm::mat3(model))));
@@ -862,6 +861,11 @@ int main()
 		//brdfShader.use();
 		//renderQuad();
 
+		// 현재 프레임에서 호출된 glUniform~() 횟수 출력 후 카운터 초기화
+		std::cout << "uniform calls: " << Shader::uniformCallCount() << std::endl;
+		Shader::uniformCallCount() = 0;
+
+
 		// Double Buffer 상에서 Back Buffer 에 픽셀들이 모두 그려지면, Front Buffer 와 교체(swap)해버림.
 		glfwSwapBuffers(window);
 
@@ -946,9 +950,217 @@ void processInput(GLFWwindow* window)
 	{
 		camera.ProcessKeyboard(RIGHT, deltaTime); // 키 입력에 따른 카메라 이동 처리 (GLFW 키 입력 메서드에 독립적인 enum 사용)
 	}
+
+	// F 키 입력 시 기준(1024 샘플) pre-filtered env map 과 filtered importance sampling 결과를 번갈아 사용
+	if (glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS && !filteredPrefilterKeyPressed)
+	{
+		useFilteredPrefilter = !useFilteredPrefilter;
+		filteredPrefilterKeyPressed = true;
+		std::cout << "prefilter map: " << (useFilteredPrefilter ? "filtered importance sampling" : "reference (1024 samples)") << std::endl;
+	}
+	if (glfwGetKey(window, GLFW_KEY_F) == GLFW_RELEASE)
+	{
+		filteredPrefilterKeyPressed = false;
+	}
 }
 
 
+/* pre-filtered env map bake 함수 구현 */
+
+// pre-filtered env map 의 각 mip level 에 split sum approximation 의 첫 번째 적분식 결과값을 렌더링하고, 소요 시간(ms)을 반환함
+float bakePrefilterMap(Shader& prefilterShader, unsigned int prefilterMap, unsigned int envCubemap, unsigned int captureFBO, unsigned int captureRBO, const glm::mat4& captureProjection, const glm::mat4* captureViews, bool filteredImportanceSampling)
+{
+	/* prefilterShader 에 텍스쳐 및 행렬 전달 */
+
+	// prefilterShader 쉐이더 바인딩
+	prefilterShader.use();
+
+	// HDR 큐브맵 텍스쳐를 바인딩할 0번 texture unit 위치값 전송
+	prefilterShader.setInt("environmentMap", 0);
+
+	// fov(시야각)이 90로 고정된 투영행렬 전송
+	prefilterShader.setMat4("projection", captureProjection);
+
+	// HDR 큐브맵 텍스쳐를 바인딩할 0번 texture unit 활성화
+	glActiveTexture(GL_TEXTURE0);
+
+	// 0번 texture unit 에 HDR 큐브맵 텍스쳐 바인딩
+	glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
+
+
+	/* 렌더링 루프 진입 이전에 Cubemap 버퍼에 각 mip level 마다 pre-filtered env map 렌더링 */
+
+	// Cubemap 버퍼의 각 면을 attach 할 FBO 객체 바인딩
+	glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+
+	// mip 0 복사에 사용할 읽기용 / 쓰기용 FBO 는 측정 구간 밖에서 미리 생성 (FBO 생성 / 삭제 비용이 bake 시간에 섞이지 않도록)
+	unsigned int copyFBOs[2] = { 0, 0 };
+	if (filteredImportanceSampling)
+	{
+		glGenFramebuffers(2, copyFBOs);
+	}
+
+	// 소요 시간을 측정할 GPU timer query 생성 후 측정 시작
+	unsigned int timerQuery;
+	glGenQueries(1, &timerQuery);
+	glBeginQuery(GL_TIME_ELAPSED, timerQuery);
+
+	// roughness 가 0 인 mip 0 은 원본 HDR 큐브맵에서 그대로 복사하고, mip 1 부터 쉐이더로 적분함
+	unsigned int firstMip = 0;
+	if (filteredImportanceSampling)
+	{
+		copyEnvironmentToPrefilterMip0(envCubemap, prefilterMap, copyFBOs[0], copyFBOs[1], captureFBO);
+		firstMip = 1;
+	}
+
+	// 각 mip level 을 순회하며 Cubemap 버퍼에 pre-filtered env map 렌더링
+	for (unsigned int mip = firstMip; mip < PREFILTER_MIP_LEVELS; mip++)
+	{
+		/*
+			각 mip level 에 따라 128^(1 / 2^n) 형태로
+			mipmap 의 최대 해상도 128 의 2^n 번째 거듭제곱근을 계산하여
+			각 mip level 에서 사용할 프레임버퍼와 viewport 의 해상도를 결정함.
+		*/
+		unsigned int mipWidth = 128 * std::pow(0.5, mip);
+		unsigned int mipHeight = 128 * std::pow(0.5, mip);
+		
+		// pre-filtered env map 을 렌더링할 때 사용할 RBO 객체 바인딩
+		glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
+
+		// RBO 객체 메모리 공간 할당 -> 단일 Renderbuffer 에 depth 값만 저장하는 데이터 포맷 지정(GL_DEPTH_COMPONENT24)
+		// Renderbuffer 해상도를 각 mipmap 의 해상도로 맞춤.
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mipWidth, mipHeight);
+
+		// Cubemap 버퍼의 각 면의 해상도를 각 mipmap 의 해상도로 맞춰 viewport 해상도 설정
+		glViewport(0, 0, mipWidth, mipHeight);
+
+		/*
+			각 mip level 에 따라 prefilterShader 쉐이더 객체에 전송할 [0.0, 1.0] 사이의 roughness 값 계산
+			-> mip level 이 높을수록 mipmap 의 해상도가 줄어들기 때문에, roughness 값이 그만큼 커지도록 계산함.
+		*/
+		float roughness = (float)mip / (float)(PREFILTER_MIP_LEVELS - 1);
+		prefilterShader.setFloat("roughness", roughness);
+
+		// 기준 결과는 1024 개의 샘플, filtered importance sampling 은 roughness 에 따라 32 ~ 64 개의 샘플로 적분
+		// (샘플 개수가 적을수록 쉐이더에서 더 흐릿한 mipmap 을 fetch 하며, aliasing 을 줄이기 위해 mip level 에 bias 1 을 더함)
+		prefilterShader.setInt("sampleCount", filteredImportanceSampling ? FIS_SAMPLE_COUNTS[mip - 1] : 1024);
+		prefilterShader.setFloat("lodBias", filteredImportanceSampling ? 1.0f : 0.0f);
+
+		// pre-filtered env map 을 렌더링할 단위 큐브의 각 면을 바라보도록 카메라를 회전시키며 6번 렌더링
+		for (unsigned int i = 0; i < 6; i++)
+		{
+			// 쉐이더 객체에 단위 큐브의 각 면을 바라보도록 계산하는 뷰 행렬 전송
+			prefilterShader.setMat4("view", captureViews[i]);
+
+			// Cubemap 버퍼의 각 면을 현재 바인딩된 FBO 객체에 돌아가며 attach
+			// glFramebufferTexture2D() 의 마지막 매개변수는 현재 바인딩된 프레임버퍼에 attach 할 Cubemap 의 mip level 을 전달함.
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, prefilterMap, mip);
+
+			// 단위 큐브를 attach 된 Cubemap 버퍼에 렌더링하기 전, 색상 버퍼와 깊이 버퍼를 깨끗하게 비워줌
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+			// 단위 큐브 렌더링 -> prefilterShader 에서 split sum approximation 의 첫 번째 적분식의 결과값을 풀어 Cubemap 버퍼에 저장함.
+			renderCube();
+		}
+	}
+
+	// Cubemap 버퍼에 렌더링 완료 후, 기본 프레임버퍼로 바인딩 초기화
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	// 측정 종료 후, 결과가 나올 때까지 기다렸다가 ms 단위로 변환 (렌더링 루프 진입 전 1번만 실행하므로 대기해도 괜찮음)
+	glEndQuery(GL_TIME_ELAPSED);
+	GLuint64 elapsedNs = 0;
+	glGetQueryObjectui64v(timerQuery, GL_QUERY_RESULT, &elapsedNs);
+	glDeleteQueries(1, &timerQuery);
+
+	// 측정이 끝난 뒤 복사용 FBO 삭제
+	if (filteredImportanceSampling)
+	{
+		glDeleteFramebuffers(2, copyFBOs);
+	}
+
+	return (float)elapsedNs / 1000000.0f;
+}
+
+// 원본 HDR 큐브맵에서 pre-filtered env map 의 mip 0 과 해상도가 같은 mipmap 을 mip 0 에 그대로 복사(blit)하는 함수
+// (readFBO, drawFBO 는 복사할 두 큐브맵의 각 면을 attach 할 FBO 로, 호출하는 쪽에서 생성 / 삭제함)
+void copyEnvironmentToPrefilterMip0(unsigned int envCubemap, unsigned int prefilterMap, unsigned int readFBO, unsigned int drawFBO, unsigned int captureFBO)
+{
+	// 두 큐브맵의 mip 0 해상도를 읽어와서, 원본 HDR 큐브맵에서 pre-filtered env map 의 mip 0 과 해상도가 같은 mip level 계산
+	// (ex> 512 * 512 원본, 128 * 128 pre-filtered env map 이라면 mip 2)
+	GLint envSize = 0, prefilterSize = 0;
+	glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
+	glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_TEXTURE_WIDTH, &prefilterSize);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
+	glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_TEXTURE_WIDTH, &envSize);
+
+	int sourceMip = 0;
+	while ((envSize >> sourceMip) > prefilterSize)
+	{
+		sourceMip++;
+	}
+
+	/*
+		captureFBO 에는 이전 bake 의 마지막 mip level 해상도(8 * 8)로 할당된 captureRBO 가 attach 되어 있는데,
+		프레임버퍼의 렌더링 영역은 attach 된 모든 버퍼가 겹치는 영역이므로
+		captureFBO 에 blit 하면 일부 영역에만 복사되거나 결과가 정의되지 않음.
+
+		-> 색상 버퍼만 attach 하는 별도의 drawFBO 로 복사함.
+	*/
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, readFBO);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFBO);
+
+	for (unsigned int i = 0; i < 6; i++)
+	{
+		glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, envCubemap, sourceMip);
+		glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, prefilterMap, 0);
+
+		// 두 면의 해상도와 포맷(GL_RGB16F)이 같으므로 필터링 없이 texel 을 그대로 복사
+		glBlitFramebuffer(0, 0, prefilterSize, prefilterSize, 0, 0, prefilterSize, prefilterSize, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	}
+
+	// 이어서 나머지 mip level 을 렌더링할 수 있도록 captureFBO 를 다시 읽기 / 쓰기 모두에 바인딩
+	// (0번 texture unit 에는 prefilterShader 가 샘플링할 원본 HDR 큐브맵이 바인딩된 상태로 남아있음)
+	glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+}
+
+// 두 pre-filtered env map 을 mip level 별로 CPU 로 읽어와서, 기준 결과 대비 상대 RMSE 를 출력하는 함수
+void comparePrefilterMaps(unsigned int referenceMap, unsigned int testMap)
+{
+	for (unsigned int mip = 0; mip < PREFILTER_MIP_LEVELS; mip++)
+	{
+		unsigned int mipSize = 128 >> mip;
+		std::vector<float> reference(mipSize * mipSize * 3);
+		std::vector<float> test(mipSize * mipSize * 3);
+
+		double squaredError = 0.0;
+		double referenceSum = 0.0;
+		for (unsigned int i = 0; i < 6; i++)
+		{
+			glBindTexture(GL_TEXTURE_CUBE_MAP, referenceMap);
+			glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, mip, GL_RGB, GL_FLOAT, &reference[0]);
+			glBindTexture(GL_TEXTURE_CUBE_MAP, testMap);
+			glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, mip, GL_RGB, GL_FLOAT, &test[0]);
+
+			for (unsigned int j = 0; j < reference.size(); j++)
+			{
+				double diff = (double)test[j] - (double)reference[j];
+				squaredError += diff * diff;
+				referenceSum += reference[j];
+			}
+		}
+
+		// HDR 값은 밝기 범위가 넓으므로, RMSE 를 기준 결과의 평균 밝기로 나눠서 상대 오차로 출력
+		double count = 6.0 * reference.size();
+		double rmse = std::sqrt(squaredError / count);
+		double referenceMean = referenceSum / count;
+		std::cout << "prefilter mip " << mip << " (roughness " << (float)mip / (float)(PREFILTER_MIP_LEVELS - 1) << "): relative RMSE "
+			<< (referenceMean > 0.0 ? rmse / referenceMean : 0.0) << std::endl;
+	}
+
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+}
+
 /* 구체 렌더링 함수 구현 */
 
 // 'Sphere VAO 객체(object) 참조 id 를 저장할 변수' 및 '구체의 정점 인덱스 버퍼 갯수 저장할 변수' 전역 선언 